@@ -125,6 +125,49 @@ function setConfigValue(namespace, key, value, type) {
   });
 }
 
+/**
+ * Set several configuration values in one request
+ * @param {Array<{namespace: string, key: string, value: *, type: string}>} entries - Values to set
+ * @returns {Promise} Promise that resolves when all values are saved
+ */
+function setConfigValues(entries) {
+  const params = new URLSearchParams();
+  entries.forEach(entry => {
+    params.append('namespace', entry.namespace);
+    params.append('key', entry.key);
+    params.append('value', String(entry.value));
+    params.append('type', entry.type || 'string');
+  });
+
+  return fetch('/admin/config/setConfigValues', {
+    method: 'POST',
+    body: params,
+    credentials: 'include',
+    headers: {
+      'Content-Type': 'application/x-www-form-urlencoded',
+      'X-Requested-With': 'XMLHttpRequest'
+    }
+  })
+  .then(parseJsonResponse)
+  .then(data => {
+    if (data && data.success) {
+      showSuccessMessage(`${entries.length} Einstellungen gespeichert`);
+      return data;
+    } else {
+      const errorMsg = (data && (data.error || data.message)) || 'Unbekannter Fehler';
+      showErrorMessage('Fehler beim Speichern: ' + errorMsg);
+      throw new Error(errorMsg);
+    }
+  })
+  .catch(err => {
+    console.error('[admin.js] setConfigValues error:', err);
+    if (!err.message.includes('Fehler beim Speichern')) {
+      showErrorMessage('Fehler beim Speichern: ' + err.message);
+    }
+    throw err;
+  });
+}
+
 function confirmReboot() {
   if(confirm('Gerät wirklich neu starten?')) {
     window.location.href = '/admin/reboot';
@@ -380,38 +423,45 @@ function initConfigAutoSave() {
 
     let timer = null;
     const debounceMs = 1000; // 1s debounce
-    // Keep track of the last changed field so we can do atomic updates
-    let lastChanged = null; // { name, value, type }
+    // Fields changed since the last save, by name; sent together in one request
+    const pendingChanges = new Map(); // name -> { name, value, type }
 
     function submitForm() {
-      if (!lastChanged) return;
+      if (pendingChanges.size === 0) return;
 
       const sectionInput = form.querySelector('input[name="section"]');
       if (!sectionInput) {
         console.warn('[admin.js] No section input found in form');
-        lastChanged = null;
+        pendingChanges.clear();
         return;
       }
 
       const section = sectionInput.value;
-      const configMapping = mapFieldToConfig(lastChanged.name, section);
-
-      if (!configMapping) {
-        console.warn('[admin.js] No config mapping for field:', lastChanged.name, 'in section:', section);
-        lastChanged = null;
-        return;
-      }
-
-      // Use unified setConfigValue method
-      setConfigValue(configMapping.namespace, configMapping.key, lastChanged.value, configMapping.type)
-        .then(() => {
-          // Success message already shown by setConfigValue
-        })
-        .catch(err => {
-          // Error already logged and shown by setConfigValue
+      const entries = [];
+      pendingChanges.forEach(change => {
+        const configMapping = mapFieldToConfig(change.name, section);
+        if (!configMapping) {
+          console.warn('[admin.js] No config mapping for field:', change.name, 'in section:', section);
+          return;
+        }
+        entries.push({
+          namespace: configMapping.namespace,
+          key: configMapping.key,
+          value: change.value,
+          type: configMapping.type
         });
+      });
+      pendingChanges.clear();
+
+      if (entries.length === 0) return;
 
-      lastChanged = null;
+      // A single field keeps the detailed message of setConfigValue
+      const request = entries.length === 1
+        ? setConfigValue(entries[0].namespace, entries[0].key, entries[0].value, entries[0].type)
+        : setConfigValues(entries);
+      request.catch(err => {
+        // Error already logged and shown
+      });
     }
 
     function scheduleSubmit() {
@@ -427,11 +477,11 @@ function initConfigAutoSave() {
       // For text/number inputs use debounce
       const target = evt.target;
       if (target && target.name) {
-        lastChanged = {
+        pendingChanges.set(target.name, {
           name: target.name,
           value: target.value,
           type: target.type
-        };
+        });
       }
       scheduleSubmit();
     });
@@ -441,9 +491,9 @@ function initConfigAutoSave() {
       if (target && target.name) {
         // For checkboxes, value should reflect checked state
         if (target.type === 'checkbox') {
-          lastChanged = { name: target.name, value: target.checked ? 'true' : 'false' };
+          pendingChanges.set(target.name, { name: target.name, value: target.checked ? 'true' : 'false' });
         } else {
-          lastChanged = { name: target.name, value: target.value };
+          pendingChanges.set(target.name, { name: target.name, value: target.value });
         }
       }
       // For checkboxes/selects etc. also debounce
@@ -87,6 +87,16 @@ class LogViewer {
 
             // Send initialization message
             this.sendMessage('init', 'log_client');
+
+            // Optional filter from the URL, e.g. /logs?level=WARNING&modules=WiFi,Sensor
+            const params = new URLSearchParams(window.location.search);
+            if (params.has('level') || params.has('modules')) {
+                this.ws.send(JSON.stringify({
+                    type: 'subscribe',
+                    data: params.get('level') || '',
+                    modules: params.get('modules') || ''
+                }));
+            }
         });
 
         this.ws.addEventListener('message', (event) => {
@@ -122,6 +132,12 @@ class LogViewer {
                     return;
                 }
 
+                // Lines the device could not send in time
+                if (data.type === 'dropped' && data.count) {
+                    this.addLogEntry('warning', `${data.count} Logzeilen verworfen`, '#dcdcaa');
+                    return;
+                }
+
                 if (data.type === 'log_level_changed' && data.data) {
                     updateLogLevelButtons(data.data);
                     return;
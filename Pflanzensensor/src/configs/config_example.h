@@ -6,6 +6,7 @@
 // Geräteeinstellungen
 #define DEVICE_NAME "Fabmobil Pflanzensensor"
 #define LOG_LEVEL "Info" // Mögliche Werte: INFO, DEBUG, ERROR, WARNING
+#define LOG_MIN_LEVEL 0  // Kleinste einkompilierte Logstufe: 0=Debug, 1=Info, 2=Warning, 3=Error
 
 // Feature-Flags
 #define USE_DHT true               // DHT11 oder DHT22 Temperatur- und Feuchtesensoren
@@ -31,6 +32,21 @@
   500 // Mindestverzögerung zwischen Messungen in Millisekunden (erhöht von 100ms)
 #define MEASUREMENT_AVERAGE_COUNT 3 // Anzahl aufeinanderfolgender Messungen für Mittelwertbildung
 #define MEASUREMENT_ERROR_COUNT 5 // Anzahl aufeinanderfolgender Fehlmessungen vor Reinit und Fehler
+#define SENSOR_SAMPLE_WINDOW MEASUREMENT_AVERAGE_COUNT // Rohwerte pro Kanal für Schätzer (0 = keine)
+#define SENSOR_PERSISTENCE_FLUSH_INTERVAL 300 // Laufzeitwerte (lastValue, Min/Max) alle x Sekunden speichern
+#define SENSOR_PERSISTENCE_LOW_HEAP 6000 // Unterhalb dieses freien Heaps (Bytes) sofort speichern
+#define MEASUREMENT_HISTORY_SIZE 120 // Messwerte pro Messung im RAM-Verlauf (4 Bytes je Wert)
+#define MEASUREMENT_ROLLUP_MINUTES 60 // Minuten-Aggregate pro Messung (12 Bytes je Eintrag)
+#define MEASUREMENT_ROLLUP_HOURS 48   // Stunden-Aggregate pro Messung
+#define MEASUREMENT_ROLLUP_DAYS 31    // Tages-Aggregate pro Messung
+#define TIMESERIES_SEGMENT_SIZE 16384 // Größe einer Zeitreihen-Segmentdatei in /ts (Bytes)
+#define TIMESERIES_MAX_SEGMENTS 8     // Anzahl Segmente, älteste werden gelöscht
+#define TIMESERIES_BLOCK_SIZE 128     // Komprimierter RAM-Block pro Messung (max. 255 Bytes)
+#define MEASUREMENT_STORE_SEGMENT_SIZE 8192 // Größe der Messungs-Logdatei vor dem Kompaktieren (Bytes)
+#define FILE_IO_QUEUE_MAX_BYTES 4096 // Gepufferte Schreibdaten vor vorzeitigem Schreiben (Bytes)
+#define FILE_IO_QUEUE_MAX_FILES 8    // Dateien mit gleichzeitig ausstehenden Schreibvorgängen
+#define FILE_IO_SLICE_MS 20          // Zeitscheibe für Schreibvorgänge pro loop()-Durchlauf (ms)
+#define FILE_IO_MAX_DELAY_MS 2000    // Spätestens nach x ms schreiben, auch während HTTP-Anfragen
 
 // Netzwerkeinstellungen
 #define WIFI_SSID_1 ""
@@ -51,6 +67,7 @@
 // Webserver-Einstellungen
 #define LOG_ENTRIES_TO_DISPLAY 20
 #define ADMIN_PASSWORD "Fabmobil" // Initiales Admin-Passwort für Webinterface
+#define CONFIG_BATCH_MAX_ENTRIES 32 // Maximale Anzahl Einstellungen pro Sammel-Update
 
 // DHT-Sensor-Einstellungen
 #define DHT_PIN 0 // D3
@@ -198,7 +215,12 @@
 
 // alles hier drunter fliegt irgendwann raus ..
 #define FILE_LOGGING_ENABLED false
-#define MAX_LOG_FILE_SIZE 50000 // Maximale Logdateigröße in Bytes
+#define MAX_LOG_FILE_SIZE 50000     // Maximale Logdateigröße in Bytes
+#define LOG_SEGMENT_COUNT 4         // Logdateien /log.N, auf die MAX_LOG_FILE_SIZE aufgeteilt wird
+#define LOG_RING_SIZE 2048          // RAM-Puffer für Logzeilen vor der Logdatei (Bytes)
+#define LOG_FLUSH_INTERVAL_MS 10000 // Gepufferte Logzeilen spätestens nach x ms schreiben
+#define WEBSOCKET_MAX_CLIENTS 2     // Gleichzeitige WebSocket-Clients der Logansicht
+#define WEBSOCKET_LOG_QUEUE 16      // Logzeilen, die pro WebSocket-Client aufs Senden warten können
 #define USE_MAIL                                                                                   \
   false // E-Mail-Benachrichtigungen verwenden. Wir haben nicht genügend RAM für TLS :/
 #define DHT_TEMPERATURE_FIELD_NAME "lufttemperatur" // für InfluxDB
@@ -387,7 +387,7 @@ bool SSD1306Display::updateQrCodeIfNeeded(const String& url) {
     m_cachedQrVersion = 2;
     m_qrcodeValid = true;
     m_lastQrUrl = url;
-    logger.debug(F("DisplayM"), F("QR code cached (v2) for: ") + url);
+    LOG_DEBUG(F("DisplayM"), F("QR code cached (v2) for: ") + url);
     return true;
   }
 
@@ -396,14 +396,14 @@ bool SSD1306Display::updateQrCodeIfNeeded(const String& url) {
     m_cachedQrVersion = 3;
     m_qrcodeValid = true;
     m_lastQrUrl = url;
-    logger.debug(F("DisplayM"), F("QR code cached (v3) for: ") + url);
+    LOG_DEBUG(F("DisplayM"), F("QR code cached (v3) for: ") + url);
     return true;
   }
 
   // Failed to generate QR code
   m_qrcodeValid = false;
   m_lastQrUrl = "";
-  logger.debug(F("DisplayM"), F("QR code generation failed for: ") + url);
+  LOG_DEBUG(F("DisplayM"), F("QR code generation failed for: ") + url);
   return false;
 }
 
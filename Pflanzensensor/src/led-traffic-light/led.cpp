@@ -7,7 +7,7 @@
 
 // led.cpp
 ResourceResult LedLights::init() {
-  logger.debug(F("LED"), F("Initialisiere LED-Pins"));
+  LOG_DEBUG(F("LED"), F("Initialisiere LED-Pins"));
 
   pinMode(LED_RED_PIN, OUTPUT);
   pinMode(LED_YELLOW_PIN, OUTPUT);
@@ -48,7 +48,7 @@ ResourceResult LedLights::switchLedOn(int color) {
     break;
   }
 
-  // logger.debug(F("LED"), F("LED ") + String(color) + F(" switched on"));
+  // LOG_DEBUG(F("LED"), F("LED ") + String(color) + F(" switched on"));
   return ResourceResult::success();
 }
 
@@ -71,7 +71,7 @@ ResourceResult LedLights::switchLedOff(int color) {
     break;
   }
 
-  // logger.debug(F("LED"), F("LED ") + String(color) + F(" switched off"));
+  // LOG_DEBUG(F("LED"), F("LED ") + String(color) + F(" switched off"));
   return ResourceResult::success();
 }
 
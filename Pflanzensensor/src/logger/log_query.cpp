@@ -0,0 +1,412 @@
+/**
+ * @file log_query.cpp
+ * @brief Implementation of the log query
+ */
+
+#include "logger/log_query.h"
+
+#include <LittleFS.h>
+#include <time.h>
+
+#include <cstring>
+#include <utility>
+
+namespace {
+/// Length of "YYYY-MM-DD HH:MM:SS"
+constexpr size_t DATE_TIME_LENGTH = 19;
+
+/// Level prefixes as written by Logger, in LogLevel order
+const char LEVEL_PREFIXES[] = ".D.:I:!W!#E#";
+constexpr size_t LEVEL_PREFIX_LENGTH = 3;
+
+/**
+ * @brief Parse a fixed number of decimal digits
+ * @return Value, or -1 if a character is not a digit
+ */
+int parseDigits(const char* text, size_t count) {
+  int value = 0;
+  for (size_t i = 0; i < count; i++) {
+    if (!isdigit(static_cast<unsigned char>(text[i]))) {
+      return -1;
+    }
+    value = value * 10 + (text[i] - '0');
+  }
+  return value;
+}
+
+/**
+ * @brief Days since 1970-01-01 of a civil date
+ * @details Proleptic Gregorian calendar, without any time zone.
+ */
+int32_t daysFromCivil(int year, int month, int day) {
+  year -= month <= 2 ? 1 : 0;
+  int era = (year >= 0 ? year : year - 399) / 400;
+  int yearOfEra = year - era * 400;
+  int dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  int dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+  return era * 146097 + dayOfEra - 719468;
+}
+
+/**
+ * @brief Offset of the local time to UTC at an epoch time
+ * @details Uses the time zone set up by the logger.
+ */
+int32_t utcOffset(time_t epoch) {
+  struct tm parts;
+  localtime_r(&epoch, &parts);
+  int64_t local = static_cast<int64_t>(daysFromCivil(parts.tm_year + 1900, parts.tm_mon + 1,
+                                                     parts.tm_mday)) *
+                      86400 +
+                  parts.tm_hour * 3600 + parts.tm_min * 60 + parts.tm_sec;
+  return static_cast<int32_t>(local - epoch);
+}
+
+/**
+ * @brief Convert a local wall-clock time to UTC epoch time
+ * @details The offsets a day before and after cover both sides of a DST
+ *          change. In the hour repeated when DST ends both are valid; lines
+ *          are written in order, so the first one not before the previous
+ *          line is used.
+ * @param local Local time as seconds since 1970-01-01 00:00 local time
+ * @param previous Epoch time of the previous line, 0 if unknown
+ * @return Epoch time, 0 if not representable
+ */
+uint32_t localToEpoch(int64_t local, uint32_t previous) {
+  int64_t candidates[2] = {local - utcOffset(static_cast<time_t>(local - 86400)),
+                           local - utcOffset(static_cast<time_t>(local + 86400))};
+  if (candidates[0] > candidates[1]) {
+    std::swap(candidates[0], candidates[1]);
+  }
+  int64_t epoch = 0;
+  for (int64_t candidate : candidates) {
+    if (candidate <= 0 || utcOffset(static_cast<time_t>(candidate)) != local - candidate) {
+      continue;
+    }
+    epoch = candidate;
+    if (candidate >= previous) {
+      break;
+    }
+  }
+  if (epoch == 0) {
+    // Skipped hour when DST starts, not written by the logger
+    epoch = candidates[0];
+  }
+  return epoch > 0 && epoch <= UINT32_MAX ? static_cast<uint32_t>(epoch) : 0;
+}
+
+/**
+ * @brief Parse the timestamp at the start of a log line
+ * @param text Log line
+ * @param length Length of the line
+ * @param previous Epoch time of the previous line, 0 if unknown
+ * @param time Epoch time (UTC), 0 for seconds since boot (output)
+ * @return Length of the timestamp, 0 if the line does not start with one
+ */
+size_t parseTimestamp(const char* text, size_t length, uint32_t previous, uint32_t& time) {
+  time = 0;
+  if (length >= DATE_TIME_LENGTH && text[4] == '-' && text[7] == '-' && text[10] == ' ' &&
+      text[13] == ':' && text[16] == ':') {
+    int year = parseDigits(text, 4);
+    int month = parseDigits(text + 5, 2);
+    int day = parseDigits(text + 8, 2);
+    int hour = parseDigits(text + 11, 2);
+    int minute = parseDigits(text + 14, 2);
+    int second = parseDigits(text + 17, 2);
+    if (year < 1970 || month < 1 || month > 12 || day < 1 || day > 31 || hour < 0 ||
+        minute < 0 || second < 0) {
+      return 0;
+    }
+    // Logger writes local time, the index and filters use UTC
+    int64_t local = static_cast<int64_t>(daysFromCivil(year, month, day)) * 86400 +
+                    hour * 3600 + minute * 60 + second;
+    time = localToEpoch(local, previous);
+    return DATE_TIME_LENGTH;
+  }
+
+  size_t digits = 0;
+  while (digits < length && isdigit(static_cast<unsigned char>(text[digits]))) {
+    digits++;
+  }
+  if (digits > 0 && digits < length && text[digits] == 's') {
+    return digits + 1;
+  }
+  return 0;
+}
+
+/**
+ * @brief Reads a segment file line by line through a fixed buffer
+ */
+class LineReader {
+public:
+  /**
+   * @param file Segment file, positioned at offset
+   * @param offset Byte offset of the file position
+   */
+  LineReader(File& file, uint32_t offset) : m_file(file), m_offset(offset) {}
+
+  /**
+   * @brief Read the next line
+   * @details Lines longer than the buffer are cut. The line is only valid
+   *          until the next call.
+   * @param line Start of the line without line break (output)
+   * @param length Length of the line (output)
+   * @return false at the end of the file
+   */
+  bool next(const char*& line, size_t& length) {
+    if (!finishLine()) {
+      return false;
+    }
+    m_lineOffset = m_offset;
+    for (;;) {
+      char* newline = static_cast<char*>(memchr(m_buffer + m_start, '\n', m_end - m_start));
+      size_t end;
+      if (newline) {
+        end = newline - m_buffer;
+      } else if (m_end - m_start == BUFFER_SIZE) {
+        end = m_end;
+        m_skipRest = true;
+      } else if (fill()) {
+        continue;
+      } else if (m_end > m_start) {
+        end = m_end; // Last line without line break
+      } else {
+        return false;
+      }
+
+      line = m_buffer + m_start;
+      length = end - m_start;
+      if (length > 0 && line[length - 1] == '\r') {
+        length--;
+      }
+      size_t consumed = (newline ? end + 1 : end) - m_start;
+      m_start += consumed;
+      m_offset += consumed;
+      return true;
+    }
+  }
+
+  /**
+   * @brief Skip the rest of a line that was cut
+   * @details Called before offset() is used as a cursor.
+   * @return false at the end of the file
+   */
+  bool finishLine() {
+    while (m_skipRest) {
+      char* newline = static_cast<char*>(memchr(m_buffer + m_start, '\n', m_end - m_start));
+      size_t end = newline ? newline - m_buffer + 1 : m_end;
+      m_offset += end - m_start;
+      m_start = end;
+      m_skipRest = newline == nullptr;
+      if (m_skipRest && !fill()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /// Byte offset of the next line
+  uint32_t offset() const { return m_offset; }
+
+  /// Byte offset of the line returned last
+  uint32_t lineOffset() const { return m_lineOffset; }
+
+private:
+  static constexpr size_t BUFFER_SIZE = 256;
+
+  /**
+   * @brief Move the unread bytes to the front and read more
+   * @return false at the end of the file
+   */
+  bool fill() {
+    if (m_start > 0) {
+      memmove(m_buffer, m_buffer + m_start, m_end - m_start);
+      m_end -= m_start;
+      m_start = 0;
+    }
+    if (m_end == BUFFER_SIZE) {
+      return true;
+    }
+    int read = m_file.read(reinterpret_cast<uint8_t*>(m_buffer + m_end), BUFFER_SIZE - m_end);
+    if (read <= 0) {
+      return false;
+    }
+    m_end += static_cast<size_t>(read);
+    return true;
+  }
+
+  File& m_file;
+  uint32_t m_offset;
+  uint32_t m_lineOffset{0};
+  char m_buffer[BUFFER_SIZE];
+  size_t m_start{0};
+  size_t m_end{0};
+  bool m_skipRest{false};
+};
+} // namespace
+
+bool LogQuery::parseLine(const char* text, size_t length, Line& line, uint32_t previousTime) {
+  line = Line();
+  uint32_t time;
+  size_t position = parseTimestamp(text, length, previousTime, time);
+  // "<timestamp> <level prefix> [<module>] <message>"
+  if (position == 0 || position + LEVEL_PREFIX_LENGTH + 3 > length || text[position] != ' ' ||
+      text[position + LEVEL_PREFIX_LENGTH + 1] != ' ' ||
+      text[position + LEVEL_PREFIX_LENGTH + 2] != '[') {
+    return false;
+  }
+  int level = -1;
+  for (int i = 0; i < 4; i++) {
+    if (memcmp(text + position + 1, LEVEL_PREFIXES + i * LEVEL_PREFIX_LENGTH,
+               LEVEL_PREFIX_LENGTH) == 0) {
+      level = i;
+      break;
+    }
+  }
+  const char* module = text + position + LEVEL_PREFIX_LENGTH + 3;
+  const char* moduleEnd = static_cast<const char*>(memchr(module, ']', length - (module - text)));
+  if (level < 0 || moduleEnd == nullptr) {
+    return false;
+  }
+  line.time = time;
+  line.level = static_cast<uint8_t>(level);
+  line.module = module;
+  line.moduleLength = moduleEnd - module;
+  return true;
+}
+
+bool LogQuery::matches(const Line& line, const Filter& filter) {
+  if (line.level < filter.minLevel) {
+    return false;
+  }
+  if (filter.module && filter.module[0] != '\0' &&
+      (strlen(filter.module) != line.moduleLength ||
+       strncmp(filter.module, line.module, line.moduleLength) != 0)) {
+    return false;
+  }
+  if (filter.hasTimeWindow() &&
+      (line.time == 0 || line.time < filter.from || line.time > filter.to)) {
+    return false;
+  }
+  return true;
+}
+
+bool LogQuery::mayMatch(const LogSegments::Index& index, const Filter& filter) {
+  uint32_t lines = 0;
+  for (uint8_t level = filter.minLevel; level < 4; level++) {
+    lines += index.levelCounts[level];
+  }
+  if (lines == 0) {
+    return false;
+  }
+  if (filter.hasTimeWindow()) {
+    return index.firstTime != 0 && index.firstTime <= filter.to && index.lastTime >= filter.from;
+  }
+  return true;
+}
+
+LogSegments::Index* LogQuery::indexFor(LogSegments& segments, uint32_t sequence) {
+  LogSegments::Index* index = segments.index(sequence);
+  if (index == nullptr || index->complete) {
+    return index;
+  }
+
+  // Segments found at boot are read once. Lines appended since then are in
+  // the file as well, so the scan replaces what was counted so far.
+  LogSegments::Index scanned;
+  scanned.sequence = sequence;
+  scanned.complete = true;
+  char path[LogSegments::PATH_SIZE];
+  LogSegments::formatPath(sequence, path);
+  File file = LittleFS.open(path, "r");
+  if (file) {
+    LineReader reader(file, 0);
+    const char* text;
+    size_t length;
+    uint32_t previousTime = 0;
+    while (reader.next(text, length)) {
+      Line line;
+      parseLine(text, length, line, previousTime);
+      scanned.add(line.time, line.level);
+      if (line.time != 0) {
+        previousTime = line.time;
+      }
+    }
+    file.close();
+  }
+  *index = scanned;
+  yield();
+  return index;
+}
+
+LogQuery::Result LogQuery::run(LogSegments& segments, const Filter& filter, Cursor cursor,
+                               size_t limit, const LineCallback& callback) {
+  Result result;
+  if (limit == 0) {
+    result.next = cursor;
+    return result;
+  }
+
+  uint32_t sequence = cursor.sequence;
+  uint32_t offset = cursor.offset;
+  if (sequence < segments.first() || sequence > segments.current()) {
+    // The segment was deleted, or the cursor is from before the log was cleared
+    sequence = segments.first();
+    offset = 0;
+  }
+
+  for (; sequence <= segments.current(); sequence++, offset = 0) {
+    result.next.sequence = sequence;
+    result.next.offset = offset;
+
+    LogSegments::Index* index = indexFor(segments, sequence);
+    if (index && !mayMatch(*index, filter)) {
+      result.skippedSegments++;
+      continue;
+    }
+
+    char path[LogSegments::PATH_SIZE];
+    LogSegments::formatPath(sequence, path);
+    File file = LittleFS.open(path, "r");
+    if (!file) {
+      continue;
+    }
+    if (offset > 0 && !file.seek(offset)) {
+      file.close();
+      continue;
+    }
+
+    LineReader reader(file, offset);
+    const char* text;
+    size_t length;
+    uint32_t previousTime = 0;
+    while (reader.next(text, length)) {
+      result.scannedBytes += reader.offset() - result.next.offset;
+      result.next.offset = reader.offset();
+      Line line;
+      parseLine(text, length, line, previousTime);
+      if (line.time != 0) {
+        previousTime = line.time;
+      }
+      if (matches(line, filter)) {
+        if (result.count >= limit) {
+          // A further matching line exists; the next query starts with it
+          result.next.offset = reader.lineOffset();
+          result.more = true;
+          file.close();
+          return result;
+        }
+        callback(text, length);
+        result.count++;
+      }
+      if (result.scannedBytes >= SCAN_BUDGET) {
+        reader.finishLine();
+        result.next.offset = reader.offset();
+        result.more = true;
+        file.close();
+        return result;
+      }
+    }
+    file.close();
+  }
+  return result;
+}
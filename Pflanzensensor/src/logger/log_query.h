@@ -0,0 +1,125 @@
+/**
+ * @file log_query.h
+ * @brief Filtered reading of the log segment files
+ * @details Selects log lines by minimum level, module and time window on the
+ *          device, so clients do not have to download the whole log. Segments
+ *          whose index shows no matching line are skipped without being read.
+ *          A query returns at most a given number of lines and reads at most
+ *          SCAN_BUDGET bytes; the returned cursor continues where it stopped.
+ */
+#ifndef LOG_QUERY_H
+#define LOG_QUERY_H
+
+#include <Arduino.h>
+
+#include <functional>
+
+#include "logger/log_segments.h"
+
+/**
+ * @class LogQuery
+ * @brief Query over the log segments
+ */
+class LogQuery {
+public:
+  /// Bytes of log lines read per query at most
+  static constexpr size_t SCAN_BUDGET = 16384;
+
+  /**
+   * @brief Selection of log lines
+   */
+  struct Filter {
+    uint8_t minLevel{0};         ///< Lowest LogLevel as integer
+    const char* module{nullptr}; ///< Exact module name, nullptr or empty for all
+    uint32_t from{0};            ///< Earliest epoch time
+    uint32_t to{UINT32_MAX};     ///< Latest epoch time
+
+    /// Lines without epoch time only match if no time window is set
+    bool hasTimeWindow() const { return from > 0 || to < UINT32_MAX; }
+  };
+
+  /**
+   * @brief Position in the log
+   * @details Segments are only appended to, so the byte offset of a line in
+   *          its segment stays valid until the segment is deleted.
+   */
+  struct Cursor {
+    uint32_t sequence{0}; ///< Segment sequence number
+    uint32_t offset{0};   ///< Byte offset of the next line in the segment
+  };
+
+  /**
+   * @brief Outcome of a query
+   */
+  struct Result {
+    size_t count{0};            ///< Matching lines passed to the callback
+    size_t scannedBytes{0};     ///< Bytes of log lines read
+    uint8_t skippedSegments{0}; ///< Segments skipped because of their index
+    Cursor next;                ///< Where the next query continues
+    bool more{false};           ///< A further matching line follows, or the scan budget ran out
+  };
+
+  /**
+   * @brief Fields of a parsed log line
+   */
+  struct Line {
+    uint32_t time{0}; ///< Epoch time (UTC), 0 for lines with seconds since boot
+    uint8_t level{1}; ///< LogLevel as integer, INFO for unknown lines
+    const char* module{nullptr};
+    size_t moduleLength{0};
+  };
+
+  /// Receives a matching line without line break
+  using LineCallback = std::function<void(const char* line, size_t length)>;
+
+  /**
+   * @brief Pass matching lines to a callback
+   * @details Lines still buffered by the logger or the I/O queue are not
+   *          seen; Logger::queryFileLog() flushes them first.
+   * @param segments Log segments
+   * @param filter Selection of lines
+   * @param cursor Position to start at, a deleted segment continues at the oldest
+   * @param limit Maximum number of lines; once reached, the scan goes on until
+   *        a further matching line is seen, so more is false when none is left
+   * @param callback Receives the matching lines
+   * @return Counters and the cursor for the next query
+   */
+  static Result run(LogSegments& segments, const Filter& filter, Cursor cursor, size_t limit,
+                    const LineCallback& callback);
+
+  /**
+   * @brief Split a log line into its fields
+   * @param text Line as written by Logger, without line break
+   * @param length Length of the line
+   * @param line Fields of the line (output)
+   * @param previousTime Epoch time of the previous line in the segment, 0 if
+   *        unknown; resolves the local time repeated when DST ends
+   * @return false if the line does not have the logger's format
+   */
+  static bool parseLine(const char* text, size_t length, Line& line, uint32_t previousTime = 0);
+
+  /**
+   * @brief Check a parsed line against a filter
+   * @param line Fields of the line
+   * @param filter Selection of lines
+   * @return true if the line is selected
+   */
+  static bool matches(const Line& line, const Filter& filter);
+
+  /**
+   * @brief Check whether a segment can contain selected lines
+   * @param index Index of the segment
+   * @param filter Selection of lines
+   * @return false if the segment can be skipped
+   */
+  static bool mayMatch(const LogSegments::Index& index, const Filter& filter);
+
+private:
+  /**
+   * @brief Index of a segment, scanning segments found at boot
+   * @return nullptr if the segment no longer exists
+   */
+  static LogSegments::Index* indexFor(LogSegments& segments, uint32_t sequence);
+};
+
+#endif // LOG_QUERY_H
@@ -0,0 +1,117 @@
+/**
+ * @file log_ring.cpp
+ * @brief Implementation of the binary log record ring
+ */
+
+#include "logger/log_ring.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+int LogRing::findModule(const char* module, size_t length) {
+  if (length >= MODULE_NAME_SIZE) {
+    return -1;
+  }
+  for (uint8_t i = 0; i < m_moduleCount; i++) {
+    if (strncmp(m_modules[i], module, MODULE_NAME_SIZE) == 0) {
+      return i;
+    }
+  }
+  if (m_moduleCount >= MODULE_COUNT) {
+    return -1;
+  }
+  memcpy(m_modules[m_moduleCount], module, length);
+  m_modules[m_moduleCount][length] = '\0';
+  return m_moduleCount++;
+}
+
+void LogRing::push(uint32_t timestamp, bool epochTime, uint8_t level, const char* module,
+                   const char* message, size_t messageLength) {
+  size_t moduleLength = strlen(module);
+  int moduleId = findModule(module, moduleLength);
+  size_t inlineLength = moduleId < 0 ? std::min(moduleLength, MODULE_INLINE_MAX) : 0;
+  messageLength = std::min(messageLength, MESSAGE_MAX);
+  size_t size = sizeof(Header) + inlineLength + messageLength;
+
+  if (m_used == 0) {
+    m_head = 0;
+    m_tail = 0;
+  }
+  // A record that does not fit behind the write position starts at 0
+  size_t skipped = LOG_RING_SIZE - m_head < size ? LOG_RING_SIZE - m_head : 0;
+  while (LOG_RING_SIZE - m_used < skipped + size) {
+    dropOldest();
+    if (m_used == 0) {
+      m_head = 0;
+      m_tail = 0;
+      skipped = 0;
+    }
+  }
+  if (skipped > 0) {
+    if (skipped >= sizeof(Header)) {
+      Header wrap{0, FLAG_WRAP, 0, 0};
+      memcpy(m_buffer + m_head, &wrap, sizeof(wrap));
+    }
+    m_used += skipped;
+    m_head = 0;
+  }
+
+  Header header;
+  header.timestamp = timestamp;
+  header.flags = (level & FLAG_LEVEL_MASK) | (epochTime ? FLAG_EPOCH : 0) |
+                 (moduleId < 0 ? FLAG_INLINE_MODULE : 0);
+  header.module = moduleId < 0 ? inlineLength : moduleId;
+  header.length = messageLength;
+  uint8_t* out = m_buffer + m_head;
+  memcpy(out, &header, sizeof(header));
+  memcpy(out + sizeof(header), module, inlineLength);
+  memcpy(out + sizeof(header) + inlineLength, message, messageLength);
+  m_head = (m_head + size) % LOG_RING_SIZE;
+  m_used += size;
+}
+
+void LogRing::skipWrap() {
+  size_t rest = LOG_RING_SIZE - m_tail;
+  if (rest < sizeof(Header) || m_buffer[m_tail + offsetof(Header, flags)] == FLAG_WRAP) {
+    m_used -= rest;
+    m_tail = 0;
+  }
+}
+
+bool LogRing::pop(Record& record) {
+  if (m_used == 0) {
+    return false;
+  }
+  skipWrap();
+
+  Header header;
+  memcpy(&header, m_buffer + m_tail, sizeof(header));
+  const char* payload = reinterpret_cast<const char*>(m_buffer + m_tail + sizeof(header));
+  record.timestamp = header.timestamp;
+  record.epochTime = header.flags & FLAG_EPOCH;
+  record.level = header.flags & FLAG_LEVEL_MASK;
+  size_t inlineLength = 0;
+  if (header.flags & FLAG_INLINE_MODULE) {
+    inlineLength = header.module;
+    record.module = payload;
+    record.moduleLength = inlineLength;
+  } else {
+    record.module = m_modules[header.module];
+    record.moduleLength = strlen(record.module);
+  }
+  record.message = payload + inlineLength;
+  record.messageLength = header.length;
+
+  size_t size = sizeof(header) + inlineLength + header.length;
+  m_tail = (m_tail + size) % LOG_RING_SIZE;
+  m_used -= size;
+  return true;
+}
+
+void LogRing::dropOldest() {
+  Record record;
+  if (pop(record)) {
+    m_dropped++;
+  }
+}
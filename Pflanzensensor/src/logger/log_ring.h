@@ -0,0 +1,130 @@
+/**
+ * @file log_ring.h
+ * @brief RAM ring buffer of binary log records
+ * @details A record is stored as [timestamp (4 bytes)][flags][module]
+ *          [message length (2 bytes)][inline module name][message]. Module
+ *          names are interned in a small table, so a record usually carries a
+ *          one-byte module id instead of the name. Records are never split at
+ *          the end of the buffer; the rest of the buffer is skipped instead.
+ *          When the buffer is full, the oldest records are dropped. The text
+ *          of a log line is only formatted when the record is consumed.
+ *          The message itself is the String the caller passed to the logger,
+ *          so building it stays on the caller's path.
+ */
+#ifndef LOG_RING_H
+#define LOG_RING_H
+
+#include <Arduino.h>
+
+#include "configs/config.h"
+
+// Check if LOG_RING_SIZE is defined
+#ifndef LOG_RING_SIZE
+#define LOG_RING_SIZE 2048
+#warning "LOG_RING_SIZE not defined in config file, defaulting to 2048 bytes"
+#endif
+
+/**
+ * @class LogRing
+ * @brief Fixed-size byte ring of log records
+ */
+class LogRing {
+public:
+  /// Interned module names
+  static constexpr size_t MODULE_COUNT = 32;
+  /// Longest interned module name including the terminator
+  static constexpr size_t MODULE_NAME_SIZE = 20;
+  /// Longest module name stored inline, once the table is full
+  static constexpr size_t MODULE_INLINE_MAX = 63;
+  /// Longest stored message; longer messages are cut like the formatted line
+  static constexpr size_t MESSAGE_MAX = 127;
+
+  /**
+   * @brief Record as read from the ring
+   * @details The pointers refer to the ring and are only valid until the
+   *          next push().
+   */
+  struct Record {
+    uint32_t timestamp; ///< Epoch seconds if epochTime is set, otherwise seconds since boot
+    bool epochTime;
+    uint8_t level; ///< LogLevel as integer
+    const char* module;
+    size_t moduleLength;
+    const char* message;
+    size_t messageLength;
+  };
+
+  LogRing() = default;
+
+  /**
+   * @brief Store a record, dropping the oldest records if necessary
+   * @param timestamp Epoch seconds or seconds since boot
+   * @param epochTime Whether timestamp holds epoch seconds
+   * @param level LogLevel as integer
+   * @param module Module name
+   * @param message Message text
+   * @param messageLength Length of the message text
+   */
+  void push(uint32_t timestamp, bool epochTime, uint8_t level, const char* module,
+            const char* message, size_t messageLength);
+
+  /**
+   * @brief Take the oldest record out of the ring
+   * @param record Oldest record (output)
+   * @return false if the ring is empty
+   */
+  bool pop(Record& record);
+
+  /// Bytes in use, including skipped space at the end of the buffer
+  size_t used() const { return m_used; }
+
+  /// Total size of the ring in bytes
+  static constexpr size_t capacity() { return LOG_RING_SIZE; }
+
+  /// Records dropped because the ring was full
+  uint32_t dropped() const { return m_dropped; }
+
+private:
+  /**
+   * @brief Record header in front of the module name and the message
+   */
+  struct Header {
+    uint32_t timestamp;
+    uint8_t flags;   ///< Level in the low bits, FLAG_* above
+    uint8_t module;  ///< Module id, or length of the inline module name
+    uint16_t length; ///< Message bytes
+  };
+
+  static constexpr uint8_t FLAG_LEVEL_MASK = 0x03;
+  static constexpr uint8_t FLAG_EPOCH = 0x40;
+  static constexpr uint8_t FLAG_INLINE_MODULE = 0x80;
+  /// Flags of the header that marks the rest of the buffer as skipped
+  static constexpr uint8_t FLAG_WRAP = 0xFF;
+
+  static_assert(LOG_RING_SIZE >= 4 * (sizeof(Header) + MODULE_INLINE_MAX + MESSAGE_MAX),
+                "LOG_RING_SIZE too small");
+
+  /**
+   * @brief Look up or intern a module name
+   * @return Module id, or -1 if the name is stored inline
+   */
+  int findModule(const char* module, size_t length);
+
+  /**
+   * @brief Move the read position past skipped space at the end of the buffer
+   */
+  void skipWrap();
+
+  /// Drop the oldest record
+  void dropOldest();
+
+  char m_modules[MODULE_COUNT][MODULE_NAME_SIZE] = {};
+  uint8_t m_moduleCount{0};
+  uint8_t m_buffer[LOG_RING_SIZE];
+  size_t m_head{0}; ///< Write position
+  size_t m_tail{0}; ///< Read position
+  size_t m_used{0};
+  uint32_t m_dropped{0};
+};
+
+#endif // LOG_RING_H
@@ -0,0 +1,169 @@
+/**
+ * @file log_segments.cpp
+ * @brief Implementation of the log segment files
+ */
+
+#include "logger/log_segments.h"
+
+#include <LittleFS.h>
+
+#include <algorithm>
+
+#include "utils/file_io_queue.h"
+
+namespace {
+const char LEGACY_LOG_FILE[] PROGMEM = "/log.txt";
+
+/**
+ * @brief Parse the sequence number of a segment file name
+ * @param name File name without directory, e.g. "log.12"
+ * @param sequence Sequence number (output)
+ * @return false if the name is not a segment
+ */
+bool parseSequence(const String& name, uint32_t& sequence) {
+  if (!name.startsWith(F("log.")) || name.length() <= 4) {
+    return false;
+  }
+  for (size_t i = 4; i < name.length(); i++) {
+    if (!isDigit(name[i])) {
+      return false;
+    }
+  }
+  sequence = strtoul(name.c_str() + 4, nullptr, 10);
+  return true;
+}
+} // namespace
+
+void LogSegments::Index::add(uint32_t time, uint8_t level) {
+  if (time != 0) {
+    firstTime = firstTime == 0 ? time : std::min(firstTime, time);
+    lastTime = std::max(lastTime, time);
+  }
+  uint16_t& count = levelCounts[level & 3];
+  if (count < UINT16_MAX) {
+    count++;
+  }
+}
+
+void LogSegments::Index::merge(const Index& other) {
+  if (other.firstTime != 0) {
+    firstTime = firstTime == 0 ? other.firstTime : std::min(firstTime, other.firstTime);
+    lastTime = std::max(lastTime, other.lastTime);
+  }
+  for (size_t level = 0; level < 4; level++) {
+    levelCounts[level] = std::min<uint32_t>(levelCounts[level] + other.levelCounts[level],
+                                            UINT16_MAX);
+  }
+}
+
+void LogSegments::formatPath(uint32_t sequence, char* buffer) {
+  snprintf(buffer, PATH_SIZE, "/log.%lu", static_cast<unsigned long>(sequence));
+}
+
+void LogSegments::begin() {
+  bool found = false;
+  uint32_t first = 0;
+  uint32_t last = 0;
+  size_t lastSize = 0;
+  Dir dir = LittleFS.openDir("/");
+  while (dir.next()) {
+    uint32_t sequence;
+    if (!parseSequence(dir.fileName(), sequence)) {
+      continue;
+    }
+    if (!found || sequence < first) {
+      first = sequence;
+    }
+    if (!found || sequence > last) {
+      last = sequence;
+      lastSize = dir.fileSize();
+    }
+    found = true;
+  }
+
+  String legacy = FPSTR(LEGACY_LOG_FILE);
+  if (LittleFS.exists(legacy)) {
+    if (found) {
+      LittleFS.remove(legacy);
+    } else {
+      // The log of older versions becomes the first segment
+      char path[PATH_SIZE];
+      formatPath(0, path);
+      File file = LittleFS.open(legacy, "r");
+      lastSize = file ? file.size() : 0;
+      file.close();
+      if (!LittleFS.rename(legacy, path)) {
+        LittleFS.remove(legacy);
+        lastSize = 0;
+      }
+    }
+  }
+
+  // Segments left over from a higher LOG_SEGMENT_COUNT
+  char path[PATH_SIZE];
+  while (last - first >= LOG_SEGMENT_COUNT) {
+    formatPath(first++, path);
+    LittleFS.remove(path);
+  }
+
+  m_first = first;
+  m_current = last;
+  m_currentBytes = lastSize;
+  formatPath(m_current, m_currentPath);
+
+  // Existing segments are indexed when they are first queried
+  for (uint32_t sequence = m_first; sequence <= m_current; sequence++) {
+    Index& entry = m_index[sequence % LOG_SEGMENT_COUNT];
+    entry = Index();
+    entry.sequence = sequence;
+  }
+}
+
+void LogSegments::prepareAppend(size_t bytes, const Index& lines) {
+  if (m_currentBytes > 0 && m_currentBytes + bytes > SEGMENT_SIZE) {
+    rotate();
+  }
+  m_currentBytes += bytes;
+  m_index[m_current % LOG_SEGMENT_COUNT].merge(lines);
+}
+
+LogSegments::Index* LogSegments::index(uint32_t sequence) {
+  if (sequence < m_first || sequence > m_current) {
+    return nullptr;
+  }
+  Index& entry = m_index[sequence % LOG_SEGMENT_COUNT];
+  return entry.sequence == sequence ? &entry : nullptr;
+}
+
+void LogSegments::rotate() {
+  // The closed segment is complete on flash before readers switch over
+  FileIoQueue::getInstance().flush(m_currentPath);
+
+  m_current++;
+  m_currentBytes = 0;
+  formatPath(m_current, m_currentPath);
+  Index& entry = m_index[m_current % LOG_SEGMENT_COUNT];
+  entry = Index();
+  entry.sequence = m_current;
+  entry.complete = true;
+
+  char path[PATH_SIZE];
+  while (m_current - m_first >= LOG_SEGMENT_COUNT) {
+    formatPath(m_first++, path);
+    LittleFS.remove(path);
+  }
+}
+
+size_t LogSegments::totalSize() const {
+  size_t total = 0;
+  char path[PATH_SIZE];
+  for (uint32_t sequence = m_first; sequence <= m_current; sequence++) {
+    formatPath(sequence, path);
+    File file = LittleFS.open(path, "r");
+    if (file) {
+      total += file.size();
+      file.close();
+    }
+  }
+  return total;
+}
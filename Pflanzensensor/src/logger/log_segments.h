@@ -0,0 +1,119 @@
+/**
+ * @file log_segments.h
+ * @brief Log file split into numbered segment files
+ * @details The log is written to /log.0, /log.1, ... with the sequence number
+ *          counting upward. Once the newest segment reaches its share of
+ *          MAX_LOG_FILE_SIZE, the next segment is started and the oldest one
+ *          beyond LOG_SEGMENT_COUNT is deleted, so rotation neither copies
+ *          nor rewrites log data. Readers go through the segments from
+ *          first() to current(); segments may be missing in between.
+ *          A small index per segment (time range and lines per level) lets
+ *          log queries skip segments without reading them.
+ */
+#ifndef LOG_SEGMENTS_H
+#define LOG_SEGMENTS_H
+
+#include <Arduino.h>
+
+#include "configs/config.h"
+
+// Check if LOG_SEGMENT_COUNT is defined
+#ifndef LOG_SEGMENT_COUNT
+#define LOG_SEGMENT_COUNT 4
+#warning "LOG_SEGMENT_COUNT not defined in config file, defaulting to 4 segments"
+#endif
+
+static_assert(LOG_SEGMENT_COUNT >= 2, "LOG_SEGMENT_COUNT must be at least 2");
+
+/**
+ * @class LogSegments
+ * @brief Sequence numbers and rotation of the log segment files
+ */
+class LogSegments {
+public:
+  /// Size at which a segment is closed
+  static constexpr size_t SEGMENT_SIZE = MAX_LOG_FILE_SIZE / LOG_SEGMENT_COUNT;
+  /// Buffer size for a segment path
+  static constexpr size_t PATH_SIZE = 16;
+
+  /**
+   * @brief Summary of the lines in one segment
+   */
+  struct Index {
+    uint32_t sequence{0};
+    uint32_t firstTime{0};     ///< Earliest epoch time of a line, 0 if no line has one
+    uint32_t lastTime{0};      ///< Latest epoch time of a line
+    uint16_t levelCounts[4]{}; ///< Lines per LogLevel, saturating
+    bool complete{false};      ///< false for segments found at boot until they are scanned
+
+    /**
+     * @brief Account one line
+     * @param time Epoch time of the line, 0 if the line has none
+     * @param level LogLevel as integer
+     */
+    void add(uint32_t time, uint8_t level);
+
+    /**
+     * @brief Account the lines of another index
+     * @param other Lines to add
+     */
+    void merge(const Index& other);
+  };
+
+  /**
+   * @brief Find the existing segments
+   * @details Takes over the single /log.txt of older versions as the first
+   *          segment and deletes segments beyond LOG_SEGMENT_COUNT.
+   */
+  void begin();
+
+  /// Path of the segment written to
+  const char* currentPath() const { return m_currentPath; }
+
+  /// Sequence number of the oldest segment
+  uint32_t first() const { return m_first; }
+
+  /// Sequence number of the segment written to
+  uint32_t current() const { return m_current; }
+
+  /**
+   * @brief Account bytes about to be appended to the current segment
+   * @details Starts a new segment first if the bytes do not fit into the
+   *          current one. Lines are never split across segments.
+   * @param bytes Bytes to append
+   * @param lines Index of the appended lines
+   */
+  void prepareAppend(size_t bytes, const Index& lines);
+
+  /**
+   * @brief Index of a segment
+   * @param sequence Sequence number of the segment
+   * @return nullptr if the segment no longer exists
+   */
+  Index* index(uint32_t sequence);
+
+  /**
+   * @brief Sum of the sizes of all segment files
+   * @return Size in bytes
+   */
+  size_t totalSize() const;
+
+  /**
+   * @brief Format the path of a segment
+   * @param sequence Sequence number of the segment
+   * @param buffer Output buffer of at least PATH_SIZE bytes
+   */
+  static void formatPath(uint32_t sequence, char* buffer);
+
+private:
+  /// Start the next segment and delete the oldest one beyond the limit
+  void rotate();
+
+  uint32_t m_first{0};
+  uint32_t m_current{0};
+  size_t m_currentBytes{0}; ///< Size of the current segment, including queued data
+  char m_currentPath[PATH_SIZE] = "/log.0";
+  Index m_index[LOG_SEGMENT_COUNT]; ///< Indexed by sequence % LOG_SEGMENT_COUNT
+};
+
+#endif // LOG_SEGMENTS_H
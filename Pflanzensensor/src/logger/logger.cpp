@@ -8,18 +8,21 @@
 
 #include <ArduinoJson.h>
 #include <LittleFS.h>
+#include <algorithm>
 #include <time.h> // For timezone support
 #include <umm_malloc/umm_malloc.h>
 
 #include "configs/config.h"
 #include "managers/manager_config.h"
+#include "sensors/sensor_history.h"
 #include "utils/critical_section.h"
+#include "utils/file_io_queue.h"
 #if USE_WEBSOCKET
 #include "web/handler/log_handler.h"
 #endif
 
 const char Logger::MSG_MEMORY_STATS[] PROGMEM =
-    "Speicher [%s] Heap:%u/%u Block:%u Stack:%u/%u Frag:%u%%";
+    "Speicher [%s] Heap:%u/%u Block:%u Stack:%u/%u Frag:%u%% Verlauf:%u";
 const char Logger::MSG_FREE_HEAP[] PROGMEM = "- Freier Heap: %u Bytes";
 const char Logger::MSG_MAX_FREE_BLOCK[] PROGMEM = "- Größter freier Block: %u Bytes";
 const char Logger::MSG_FRAGMENTATION[] PROGMEM = "- Fragmentierung: %u%%";
@@ -82,8 +85,9 @@ Logger::Logger(LogLevel logLevel, bool useSerial, bool fileLoggingEnabled)
       }
 
       // Create log file if it doesn't exist
-      if (!LittleFS.exists(m_logFileName)) {
-        File file = LittleFS.open(m_logFileName, "w");
+      m_segments.begin();
+      if (!LittleFS.exists(m_segments.currentPath())) {
+        File file = LittleFS.open(m_segments.currentPath(), "w");
         if (file) {
           file.println(F("Logdatei erstellt"));
           file.close();
@@ -118,70 +122,78 @@ void Logger::error(const String& module, const String& message) {
 }
 
 void Logger::log(LogLevel level, const String& module, const String& message) {
-  if (level < m_logLevel) {
+  if (!isLevelEnabled(level)) {
     return;
   }
+  uint32_t start = micros();
 
   // Safety check: replace empty or undefined messages
-  String safeMessage = message;
-  if (!safeMessage.length()) {
-    safeMessage = F("LEERE LOG-NACHRICHT");
+  String emptyMessage;
+  if (!message.length()) {
+    emptyMessage = F("LEERE LOG-NACHRICHT");
   }
-
-  String timestamp = getFormattedTimestamp();
-  String prefix;
-  switch (level) {
-  case LogLevel::DEBUG:
-    prefix = readProgmemString(MSG_DEBUG);
-    break;
-  case LogLevel::INFO:
-    prefix = readProgmemString(MSG_INFO);
-    break;
-  case LogLevel::WARNING:
-    prefix = readProgmemString(MSG_WARNING);
-    break;
-  case LogLevel::ERROR:
-    prefix = readProgmemString(MSG_ERROR);
-    break;
+  const String& safeMessage = message.length() ? message : emptyMessage;
+
+  bool epochTime = isNTPInitialized();
+  uint32_t timestamp = epochTime ? m_timeClient->getEpochTime() : millis() / 1000;
+
+  // The file sink formats its lines in flushRing(); the text is only built
+  // here for the serial output and the callback
+  char formattedMessage[MESSAGE_SIZE];
+  if (m_useSerial || s_logCallback) {
+    char prefix[4];
+    strcpy_P(prefix, levelPrefix(level));
+    snprintf(formattedMessage, sizeof(formattedMessage), "%s [%s] %s", prefix, module.c_str(),
+             safeMessage.c_str());
   }
 
-  char formattedMessage[128];
-  snprintf(formattedMessage, sizeof(formattedMessage), "%s [%s] %s", prefix.c_str(), module.c_str(),
-           safeMessage.c_str());
-
   if (m_useSerial) {
-    String serialMessage;
     if (m_useColors) {
       // Add simple color codes for better compatibility
       switch (level) {
       case LogLevel::DEBUG:
-        serialMessage = "\x1b[90m" + timestamp + " " + formattedMessage + "\x1b[0m"; // Grey
+        Serial.print(F("\x1b[90m")); // Grey
         break;
       case LogLevel::INFO:
-        serialMessage = "\x1b[32m" + timestamp + " " + formattedMessage + "\x1b[0m"; // Green
+        Serial.print(F("\x1b[32m")); // Green
         break;
       case LogLevel::WARNING:
-        serialMessage = "\x1b[33m" + timestamp + " " + formattedMessage + "\x1b[0m"; // Orange
+        Serial.print(F("\x1b[33m")); // Orange
         break;
       case LogLevel::ERROR:
-        serialMessage = "\x1b[31m" + timestamp + " " + formattedMessage + "\x1b[0m"; // Red
+        Serial.print(F("\x1b[31m")); // Red
         break;
       }
-    } else {
-      serialMessage = timestamp + " " + formattedMessage;
     }
-    Serial.println(serialMessage);
+    char timeText[24];
+    formatTimestamp(timeText, sizeof(timeText), timestamp, epochTime);
+    Serial.print(timeText);
+    Serial.print(' ');
+    Serial.print(formattedMessage);
+    if (m_useColors) {
+      Serial.print(F("\x1b[0m"));
+    }
+    Serial.println();
   }
 
   if (m_fileLoggingEnabled) {
-    String plainMessage = timestamp + " " + formattedMessage;
-    writeToFile(plainMessage);
+    // Only the binary record is kept; the line is formatted when it is written
+    m_ring.push(timestamp, epochTime, static_cast<uint8_t>(level), module.c_str(),
+                safeMessage.c_str(), safeMessage.length());
+    if (level == LogLevel::ERROR) {
+      flushFileLog();
+    } else if (m_ring.used() >= LogRing::capacity() / 2) {
+      flushRing();
+    }
   }
 
   // Call the log callback if set
   if (s_logCallback) {
     s_logCallback(level, String(formattedMessage));
   }
+
+  m_fileLogStats.lines++;
+  m_fileLogStats.logTimeUs += micros() - start;
 }
 
 void Logger::setLogLevel(LogLevel level) {
@@ -207,6 +219,7 @@ MemoryStats Logger::getMemoryStats() {
 #endif
 
   stats.totalStack = ESP.getFreeContStack() + (ESP.getFreeHeap() - ESP.getMaxFreeBlockSize());
+  stats.historyBytes = MeasurementHistory::getMemoryUsage();
 
   // Update peak values
   updatePeakStats(stats);
@@ -228,7 +241,7 @@ void Logger::logMemoryStats(const String& location) {
   char buffer[128];
   snprintf_P(buffer, sizeof(buffer), MSG_MEMORY_STATS, location.c_str(), stats.freeHeap,
              stats.totalHeap, stats.maxFreeBlock, stats.freeStack, stats.totalStack,
-             stats.fragmentation);
+             stats.fragmentation, stats.historyBytes);
 
   debug("Memory", buffer);
 }
@@ -300,8 +313,9 @@ void Logger::enableFileLogging(bool enable) {
     }
 
     // Create log file if it doesn't exist
-    if (!LittleFS.exists(m_logFileName)) {
-      File file = LittleFS.open(m_logFileName, "w");
+    m_segments.begin();
+    if (!LittleFS.exists(m_segments.currentPath())) {
+      File file = LittleFS.open(m_segments.currentPath(), "w");
       if (!file || !file.println(F("Logdatei erstellt"))) {
         if (m_useSerial) {
           Serial.println(F("Logdatei konnte nicht erstellt werden"));
@@ -314,6 +328,7 @@ void Logger::enableFileLogging(bool enable) {
     m_fileLoggingEnabled = true;
     info(F("Logger"), F("Dateilogs aktiviert"));
   } else if (!enable && m_fileLoggingEnabled) {
+    flushFileLog();
     m_fileLoggingEnabled = false;
     info(F("Logger"), F("Dateilogs deaktiviert"));
   }
@@ -321,136 +336,100 @@ void Logger::enableFileLogging(bool enable) {
 
 bool Logger::isFileLoggingEnabled() const { return m_fileLoggingEnabled; }
 
-void Logger::writeToFile(const String& logMessage) {
-  static bool inWriteToFile = false; // Prevent recursive calls
-
-  if (!m_fileLoggingEnabled || inWriteToFile) {
+void Logger::processFileLog() {
+  if (!m_fileLoggingEnabled) {
     return;
   }
 
-  inWriteToFile = true;
-
-  // Check if filesystem is mounted with critical section
-  {
-    CriticalSection cs;
-    if (!LittleFS.exists("/")) {
-      if (!LittleFS.begin()) {
-        m_fileLoggingEnabled = false;
-        if (m_useSerial) {
-          Serial.println(F("Dateisystem für Logging konnte nicht eingehängt werden"));
-        }
-        inWriteToFile = false;
-        return;
-      }
-    }
-
-    File file = LittleFS.open(m_logFileName, "a");
-    if (!file) {
-      m_fileLoggingEnabled = false;
-      if (m_useSerial) {
-        Serial.println(F("Logdatei konnte nicht zum Schreiben geöffnet werden"));
-      }
-      inWriteToFile = false;
-      return;
-    }
-
-    file.println(logMessage);
-    file.close();
+  if (m_ring.used() > 0 && millis() - m_lastRingFlush >= LOG_FLUSH_INTERVAL_MS) {
+    flushRing();
   }
-
-  // Only check size occasionally to reduce filesystem operations
-  static uint32_t lastCheck = 0;
-  if (millis() - lastCheck > 30000) { // Check every 30 seconds
-    lastCheck = millis();
-    truncateLogFileIfNeeded();
-  }
-
-  inWriteToFile = false;
 }
 
-void Logger::truncateLogFileIfNeeded() {
-  if (!m_fileLoggingEnabled)
-    return;
+void Logger::flushFileLog() {
+  flushRing();
+  FileIoQueue::getInstance().flush(m_segments.currentPath());
+}
 
-  CriticalSection cs;
+LogQuery::Result Logger::queryFileLog(const LogQuery::Filter& filter, LogQuery::Cursor cursor,
+                                      size_t limit, const LogQuery::LineCallback& callback) {
+  flushFileLog();
+  return LogQuery::run(m_segments, filter, cursor, limit, callback);
+}
 
-  File file = LittleFS.open(m_logFileName, "r");
-  if (!file)
-    return;
+Logger::FileLogStats Logger::getFileLogStats() const {
+  FileLogStats stats = m_fileLogStats;
+  stats.dropped = m_ring.dropped();
+  stats.ringUsed = m_ring.used();
+  return stats;
+}
 
-  if (file.size() <= m_maxFileSize) {
-    file.close();
+void Logger::flushRing() {
+  // A line logged while the ring is formatted stays in the ring
+  if (m_flushingRing || m_ring.used() == 0) {
     return;
   }
-
-  // Keep the most recent portion of the file instead of deleting everything.
-  // Strategy: copy the last `keepSize` bytes to a temporary file in small
-  // chunks, prepend a header that indicates truncation, then replace the
-  // original file with the temp file. This avoids allocating a large buffer
-  // on the heap (important on ESP8266) and keeps newer log entries.
-  size_t fileSize = file.size();
-  info(F("Logger"), String(F("Logdatei prüfen: Größe=")) + fileSize + F(" Bytes, Limit=") +
-                        m_maxFileSize + F(" Bytes"));
-  // Try to keep the newer half, but don't exceed the configured maximum
-  size_t keepSize = min(fileSize / 2, static_cast<size_t>(m_maxFileSize));
-  size_t startPos = (fileSize > keepSize) ? (fileSize - keepSize) : 0;
-
-  String tmpName = String(m_logFileName) + ".tmp";
-  File tmp = LittleFS.open(tmpName.c_str(), "w");
-  if (!tmp) {
-    // If temp file can't be created, fallback to simple truncation
-    warning(F("Logger"), F("Temporäre Logdatei konnte nicht erstellt werden, falle auf "
-                           "vollständige Kürzung zurück"));
-    file.close();
-    LittleFS.remove(m_logFileName);
-    File nf = LittleFS.open(m_logFileName, "w");
-    if (nf) {
-      nf.println(F("Logdatei aufgrund Größenlimit gekürzt"));
-      nf.close();
-    }
-    return;
+  m_flushingRing = true;
+
+  // Timestamps and level prefixes make the text longer than the records
+  String text;
+  text.reserve(m_ring.used() * 3 / 2);
+  LogRing::Record record;
+  LogSegments::Index lines;
+  char line[24 + MESSAGE_SIZE];
+  while (m_ring.pop(record)) {
+    formatRecord(record, line, sizeof(line));
+    text += line;
+    text += F("\r\n");
+    lines.add(record.epochTime ? record.timestamp : 0, record.level);
   }
+  m_lastRingFlush = millis();
+  m_fileLogStats.flushes++;
+
+  // Lines are collected by the I/O queue and appended together from loop().
+  // A full segment is closed first; the lines go into the next one.
+  m_segments.prepareAppend(text.length(), lines);
+  FileIoQueue::getInstance().append(m_segments.currentPath(), text);
+  m_flushingRing = false;
+}
 
-  // Write header indicating truncation
-  tmp.println(F("--- Vorherige Einträge wurden aufgrund des Größenlimits entfernt ---"));
-
-  // Copy the tail of the original file in small chunks
-  const size_t BUF_SIZE = 512;
-  uint8_t buffer[BUF_SIZE];
-  size_t remaining = keepSize;
-  file.seek(startPos);
-  debug(F("Logger"), String(F("Beginne Kopieren ab Position ")) + startPos +
-                         F(" (Bytes zu kopieren: ") + keepSize + F(")"));
-  while (remaining > 0) {
-    size_t toRead = (remaining > BUF_SIZE) ? BUF_SIZE : remaining;
-    size_t r = file.readBytes(reinterpret_cast<char*>(buffer), toRead);
-    if (r == 0)
-      break; // read error or EOF
-    tmp.write(buffer, r);
-    remaining -= r;
+void Logger::formatTimestamp(char* buffer, size_t size, uint32_t timestamp, bool epochTime) {
+  if (epochTime) {
+    time_t epoch = timestamp;
+    struct tm* ptm = localtime(&epoch);
+    strftime(buffer, size, "%Y-%m-%d %H:%M:%S", ptm);
+  } else {
+    snprintf(buffer, size, "%lus", static_cast<unsigned long>(timestamp));
   }
+}
 
-  size_t copied = keepSize - remaining;
-  info(F("Logger"), String(F("Kopiert ")) + copied + F(" Bytes in temporäre Datei"));
-
-  file.close();
-  tmp.close();
+void Logger::formatRecord(const LogRing::Record& record, char* buffer, size_t size) {
+  formatTimestamp(buffer, size, record.timestamp, record.epochTime);
+  size_t length = strlen(buffer);
+  if (length + 1 >= size) {
+    return;
+  }
+  buffer[length++] = ' ';
+
+  // Cut like the formatted message in log()
+  char prefix[4];
+  strcpy_P(prefix, levelPrefix(static_cast<LogLevel>(record.level)));
+  snprintf(buffer + length, std::min(size - length, MESSAGE_SIZE), "%s [%.*s] %.*s", prefix,
+           static_cast<int>(record.moduleLength), record.module,
+           static_cast<int>(record.messageLength), record.message);
+}
 
-  // Replace original file with temp file. Try to be atomic when possible.
-  // Remove original first to ensure rename succeeds on platforms that don't
-  // support overwrite-rename.
-  LittleFS.remove(m_logFileName);
-  if (LittleFS.rename(tmpName.c_str(), m_logFileName)) {
-    info(F("Logger"), F("Logdatei erfolgreich gekürzt; ältere Einträge entfernt"));
-  } else {
-    // Rename failed — try fallback: create a fresh file with header only
-    warning(F("Logger"), F("Umbenennen der temporären Logdatei fehlgeschlagen, fallback aktiv"));
-    LittleFS.remove(tmpName.c_str());
-    File nf = LittleFS.open(m_logFileName, "w");
-    if (nf) {
-      nf.println(F("Logdatei aufgrund Größenlimit gekürzt"));
-      nf.close();
-    }
+PGM_P Logger::levelPrefix(LogLevel level) {
+  switch (level) {
+  case LogLevel::DEBUG:
+    return MSG_DEBUG;
+  case LogLevel::INFO:
+    return MSG_INFO;
+  case LogLevel::WARNING:
+    return MSG_WARNING;
+  case LogLevel::ERROR:
+  default:
+    return MSG_ERROR;
   }
 }
 
@@ -489,18 +468,6 @@ String Logger::logLevelToColor(LogLevel level) const {
   }
 }
 
-String Logger::getFormattedTimestamp() const {
-  if (m_ntpInitialized) {
-    time_t epochTime = m_timeClient->getEpochTime();
-    struct tm* ptm = localtime((time_t*)&epochTime);
-    char buffer[32];
-    strftime(buffer, 32, "%Y-%m-%d %H:%M:%S", ptm);
-    return String(buffer);
-  } else {
-    return String(millis() / 1000) + "s";
-  }
-}
-
 void Logger::initNTP() {
   m_timeClient = new NTPClient(m_ntpUDP, "pool.ntp.org", 0, 60000);
   m_timeClient->begin();
@@ -17,11 +17,79 @@
 #include <vector>
 
 #include "configs/config.h"
+#include "logger/log_query.h"
+#include "logger/log_ring.h"
+#include "logger/log_segments.h"
+
+// Check if LOG_MIN_LEVEL is defined
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL 0
+#warning "LOG_MIN_LEVEL not defined in config file, defaulting to 0 (Debug)"
+#endif
+
+// Check if LOG_FLUSH_INTERVAL_MS is defined
+#ifndef LOG_FLUSH_INTERVAL_MS
+#define LOG_FLUSH_INTERVAL_MS 10000
+#warning "LOG_FLUSH_INTERVAL_MS not defined in config file, defaulting to 10000 ms"
+#endif
+
 /**
  * @brief Enumeration for different log levels
+ * @details The values match LOG_MIN_LEVEL (0 = DEBUG ... 3 = ERROR).
  */
 enum class LogLevel { DEBUG, INFO, WARNING, ERROR };
 
+/**
+ * @brief Logging macros that check the level before the message is built
+ * @details The message argument is only evaluated if the level is enabled at
+ *          runtime, so a discarded message costs no String allocation. Calls
+ *          below LOG_MIN_LEVEL are removed at compile time. LOG_DEBUG_IF()
+ *          additionally checks a module debug flag, e.g.
+ *          LOG_DEBUG_IF(ConfigMgr.isDebugSensor(), getName(), F("...") + ...).
+ *          LOG_DEBUG_ENABLED() guards blocks that prepare a debug message.
+ */
+#if LOG_MIN_LEVEL <= 0
+#define LOG_DEBUG_ENABLED(enabled) (logger.isLevelEnabled(LogLevel::DEBUG) && (enabled))
+#else
+#define LOG_DEBUG_ENABLED(enabled) false
+#endif
+#define LOG_DEBUG_IF(enabled, module, message)                                                     \
+  do {                                                                                             \
+    if (LOG_DEBUG_ENABLED(enabled)) {                                                              \
+      logger.debug(module, message);                                                               \
+    }                                                                                              \
+  } while (0)
+#define LOG_DEBUG(module, message) LOG_DEBUG_IF(true, module, message)
+
+#if LOG_MIN_LEVEL <= 1
+#define LOG_INFO(module, message)                                                                  \
+  do {                                                                                             \
+    if (logger.isLevelEnabled(LogLevel::INFO)) {                                                   \
+      logger.info(module, message);                                                                \
+    }                                                                                              \
+  } while (0)
+#else
+#define LOG_INFO(module, message)                                                                  \
+  do {                                                                                             \
+  } while (0)
+#endif
+
+#if LOG_MIN_LEVEL <= 2
+#define LOG_WARNING(module, message)                                                               \
+  do {                                                                                             \
+    if (logger.isLevelEnabled(LogLevel::WARNING)) {                                                \
+      logger.warning(module, message);                                                             \
+    }                                                                                              \
+  } while (0)
+#else
+#define LOG_WARNING(module, message)                                                               \
+  do {                                                                                             \
+  } while (0)
+#endif
+
+// Errors are always compiled in
+#define LOG_ERROR(module, message) logger.error(module, message)
+
 /**
  * @brief Structure to hold a log entry
  */
@@ -42,6 +110,7 @@ struct MemoryStats {
   uint32_t freeStack;
   uint32_t totalHeap;  // Total heap size
   uint32_t totalStack; // Total stack size
+  uint32_t historyBytes; // Allocated measurement history channels
 };
 
 /**
@@ -68,6 +137,17 @@ struct MemoryTrackingState {
  */
 class Logger {
 public:
+  /**
+   * @brief Logging statistics since boot
+   */
+  struct FileLogStats {
+    uint32_t lines{0};     ///< Lines logged
+    uint32_t dropped{0};   ///< Buffered lines dropped because the ring was full
+    uint32_t flushes{0};   ///< Transfers of the ring into the log file
+    uint32_t ringUsed{0};  ///< Bytes in the ring
+    uint64_t logTimeUs{0}; ///< Time spent in log(), for the throughput
+  };
+
   /**
    * @brief Constructor for Logger class
    * @param logLevel Minimum log level to display
@@ -89,6 +169,15 @@ public:
    */
   LogLevel getLogLevel() const;
 
+  /**
+   * @brief Check whether messages of a level are logged
+   * @param level Log level to check
+   * @return true if the level is compiled in and not below the runtime level
+   */
+  bool isLevelEnabled(LogLevel level) const {
+    return static_cast<int>(level) >= LOG_MIN_LEVEL && level >= m_logLevel;
+  }
+
   /**
    * @brief Log a debug message with module name
    * @param module Module name that will be shown in brackets
@@ -173,6 +262,44 @@ public:
    */
   bool isFileLoggingEnabled() const;
 
+  /**
+   * @brief Write buffered lines and check the log file size when due
+   * @details Called from loop(). Lines are buffered as binary records and
+   *          formatted when they are written: when the ring is half full,
+   *          on an error and every LOG_FLUSH_INTERVAL_MS.
+   */
+  void processFileLog();
+
+  /**
+   * @brief Write all buffered lines into the log file now
+   * @details Readers of the log file call this first.
+   */
+  void flushFileLog();
+
+  /**
+   * @brief Get the logging statistics
+   * @return Statistics since boot
+   */
+  FileLogStats getFileLogStats() const;
+
+  /**
+   * @brief Get the segment files of the log
+   * @return Segments, valid once file logging is enabled
+   */
+  const LogSegments& getSegments() const { return m_segments; }
+
+  /**
+   * @brief Read filtered lines from the log file
+   * @details Writes buffered lines first, then runs the query.
+   * @param filter Selection of lines
+   * @param cursor Position to start at
+   * @param limit Maximum number of lines
+   * @param callback Receives the matching lines
+   * @return Counters and the cursor for the next query
+   */
+  LogQuery::Result queryFileLog(const LogQuery::Filter& filter, LogQuery::Cursor cursor,
+                                size_t limit, const LogQuery::LineCallback& callback);
+
   bool isNTPInitialized() const { return m_ntpInitialized && m_timeClient != nullptr; }
 
   time_t getSynchronizedTime() const {
@@ -227,8 +354,11 @@ private:
   NTPClient* m_timeClient;
   bool m_ntpInitialized;
   bool m_fileLoggingEnabled;
-  const char* m_logFileName = "/log.txt";
-  const size_t m_maxFileSize = MAX_LOG_FILE_SIZE; // in bytes
+  LogSegments m_segments;
+  LogRing m_ring;
+  FileLogStats m_fileLogStats;
+  unsigned long m_lastRingFlush = 0;
+  bool m_flushingRing = false;
   unsigned long lastErrorLogTime = 0;
   const unsigned long errorLogInterval = 5000; // 5 seconds
   int errorCount = 0;
@@ -259,22 +389,37 @@ private:
    */
   String logLevelToColor(LogLevel level) const;
 
+  /// Size of a formatted message without timestamp
+  static constexpr size_t MESSAGE_SIZE = 128;
+
+  /**
+   * @brief Format a timestamp
+   * @param buffer Output buffer
+   * @param size Size of the buffer
+   * @param timestamp Epoch seconds or seconds since boot
+   * @param epochTime Whether timestamp holds epoch seconds
+   */
+  static void formatTimestamp(char* buffer, size_t size, uint32_t timestamp, bool epochTime);
+
   /**
-   * @brief Get current timestamp as a formatted string
-   * @return Formatted timestamp string
+   * @brief Format a buffered record as a log file line without line break
+   * @param record Record taken from the ring
+   * @param buffer Output buffer
+   * @param size Size of the buffer
    */
-  String getFormattedTimestamp() const;
+  static void formatRecord(const LogRing::Record& record, char* buffer, size_t size);
 
   /**
-   * @brief Write a log message to the log file
-   * @param logMessage Message to write
+   * @brief Get the prefix of a log level
+   * @param level Log level
+   * @return Prefix in PROGMEM
    */
-  void writeToFile(const String& logMessage);
+  static PGM_P levelPrefix(LogLevel level);
 
   /**
-   * @brief Truncate the log file if it exceeds the maximum size
+   * @brief Format the buffered records and hand them to the write queue
    */
-  void truncateLogFileIfNeeded();
+  void flushRing();
 
   static inline String readProgmemString(const char* progmem_str) {
     char buffer[128]; // Adjust size as needed
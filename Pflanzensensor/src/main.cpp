@@ -14,12 +14,14 @@
 #include "configs/config.h"
 #include "utils/config_backup_utils.h"
 #include "utils/critical_section.h"
+#include "utils/file_io_queue.h"
 #include "utils/flash_persistence.h"
 #include "utils/result_types.h"
 
 // Manager Classes
 #include "managers/manager_config.h"
 #include "managers/manager_config_persistence.h"
+#include "managers/manager_config_preferences.h"
 #include "managers/manager_display.h"
 #include "managers/manager_led_traffic_light.h"
 #include "managers/manager_resource.h"
@@ -48,6 +50,7 @@
 
 // helper methods
 #include "managers/manager_sensor_persistence.h"
+#include "sensors/sensor_timeseries.h"
 #include "utils/helper.h"
 
 // Global objects
@@ -103,6 +106,7 @@ void setup() {
         }
 
         Serial.println(F("Wiederherstellung abgeschlossen - starte neu..."));
+        FileIoQueue::getInstance().flushAll();
         delay(1000);
         ESP.restart(); // Reboot with restored config
       } else {
@@ -120,6 +124,11 @@ void setup() {
   // Filesystem already mounted above
   logger.info(F("main"), F("Initialisiere Dateisystem"));
 
+  // Without room for the backup slots a filesystem update would lose the config
+  if (!FlashPersistence::checkFlashSpace().isSuccess()) {
+    logger.error(F("main"), F("Flash-Sicherung nicht möglich, Dateisystem-Updates gesperrt"));
+  }
+
 #if USE_LED_TRAFFIC_LIGHT
   if (!Helper::initializeComponent(F("LED traffic light manager"), []() -> ResourceResult {
         ledTrafficLightManager = std::make_unique<LedTrafficLightManager>();
@@ -167,6 +176,12 @@ void setup() {
     displayManager->updateLogStatus(F("Config..."), true);
 #endif
 
+  // Modules that buffer data themselves are written by FileIoQueue::flushAll()
+  // before every reboot
+  FileIoQueue::getInstance().addFlushHook(SensorPersistence::flushAllPendingUpdates);
+  FileIoQueue::getInstance().addFlushHook([]() { TimeSeriesStore::getInstance().flush(); });
+  FileIoQueue::getInstance().addFlushHook([]() { logger.flushFileLog(); });
+
   // increase reboot count
   Helper::incrementRebootCount();
 
@@ -326,7 +341,7 @@ void setup() {
         delay(1000);
         logger.updateNTP();
         timeSync++;
-        logger.debug(F("main"), F("Warte auf Zeitsynchronisation..."));
+        LOG_DEBUG(F("main"), F("Warte auf Zeitsynchronisation..."));
       }
 #if USE_DISPLAY
       if (displayManager)
@@ -342,6 +357,11 @@ void setup() {
   }
 #endif
 
+  // Initialize time-series archive (index of existing segments)
+  Helper::initializeComponent(F("Zeitreihenspeicher"), []() -> ResourceResult {
+    return TimeSeriesStore::getInstance().begin();
+  });
+
   // Initialize sensor manager
   Helper::initializeComponent(F("sensor manager"), []() -> ResourceResult {
     sensorManager = std::make_unique<SensorManager>();
@@ -369,7 +389,7 @@ void setup() {
     auto& webManager = WebManager::getInstance();
     if (sensorManager) {
       webManager.setSensorManager(*sensorManager);
-      logger.debug(F("main"), F("Sensor-Manager im WebManager gesetzt"));
+      LOG_DEBUG(F("main"), F("Sensor-Manager im WebManager gesetzt"));
     } else {
       logger.error(F("main"), F("Sensor-Manager ist null beim Setzen im WebManager"));
 #if USE_DISPLAY
@@ -423,6 +443,7 @@ void setup() {
 
   logger.endMemoryTracking(F("managers_init"));
   logger.logMemoryStats(F("setup_complete"));
+  PreferencesManager::markBootComplete();
   logger.info(F("main"), F("Setup abgeschlossen"));
 
   // Sensor settings are now applied directly during JSON parsing
@@ -437,36 +458,41 @@ void setup() {
 void loop() {
   static unsigned long lastMemoryCheck = 0;
   static unsigned long lastWiFiCheck = 0;
-  static unsigned long lastMeasurementUpdate = 0;
+  static unsigned long lastHousekeeping = 0;
   static unsigned long lastUpdateModeLog = 0;
   const unsigned long currentMillis = millis();
 
+  Helper::countLoopIteration();
+
   // Handle update mode if active (now checked in setup(), but keep timeout
   // logic)
   if (ConfigMgr.getDoFirmwareUpgrade()) {
     // Debug: Log update mode recovery state (every 30 seconds)
     if (currentMillis - lastUpdateModeLog >= 30000) {
-      logger.debug(F("main"), F("[UpdateMode] loop: getDoFirmwareUpgrade()=true"));
+      LOG_DEBUG(F("main"), F("[UpdateMode] loop: getDoFirmwareUpgrade()=true"));
       auto& webManager = WebManager::getInstance();
       unsigned long updateStart = webManager.getUpdateModeStartTime();
       unsigned long timeout = webManager.getUpdateModeTimeout();
-      logger.debug(F("main"), F("[UpdateMode] loop: currentMillis=") + String(currentMillis) +
-                                  F(", updateStart=") + String(updateStart) + F(", timeout=") +
-                                  String(timeout));
+      LOG_DEBUG(F("main"), F("[UpdateMode] loop: currentMillis=") + String(currentMillis) +
+                               F(", updateStart=") + String(updateStart) + F(", timeout=") +
+                               String(timeout));
       if (updateStart > 0 && currentMillis - updateStart > timeout) {
         logger.warning(F("main"), F("Update-Mode Timeout erreicht. Beende "
                                     "Update-Modus automatisch."));
         ConfigMgr.setUpdateFlags(false, false);
         webManager.resetUpdateModeStartTime();
         logger.warning(F("main"), F("ESP startet neu."));
+        FileIoQueue::getInstance().flushAll();
         ESP.restart(); // Force reboot to reload config and exit update mode
         return;
       } else {
-        logger.debug(F("main"), F("[UpdateMode] loop: Kein Timeout, Update-Modus läuft weiter."));
+        LOG_DEBUG(F("main"), F("[UpdateMode] loop: Kein Timeout, Update-Modus läuft weiter."));
       }
       lastUpdateModeLog = currentMillis;
     }
     WebManager::getInstance().handleClient();
+    logger.processFileLog();
+    FileIoQueue::getInstance().process(WebManager::getInstance().isClientPending());
     yield(); // Allow background tasks without blocking upload
     return;
   }
@@ -483,6 +509,12 @@ void loop() {
   if (currentMillis - lastMemoryCheck >= 30000) { // Every 30 seconds
     logger.logMemoryStats(F("loop_monitor"));
     lastMemoryCheck = currentMillis;
+#ifdef UMM_STATS_FULL
+    if (ConfigMgr.isDebugRAM()) {
+      logger.info(F("main"), F("Heap-Allokationen pro Loop: ") +
+                                 String(Helper::getAllocationsPerLoop(), 2));
+    }
+#endif
 
     // Emergency cleanup if memory is critically low
     if (ESP.getFreeHeap() < 3000) {
@@ -497,10 +529,13 @@ void loop() {
   if (currentMillis - lastWiFiCheck >= 30000) { // Every 30 seconds
 #if USE_WIFI
     if (!isCaptivePortalAPActive()) {
-      logger.debug(F("main"), F("Prüfe WiFi-Verbindung"));
+      LOG_DEBUG(F("main"), F("Prüfe WiFi-Verbindung"));
       checkWiFiConnection();
+    } else if (takeWiFiCredentialsChanged()) {
+      logger.info(F("main"), F("WiFi-Zugangsdaten geändert, verlasse AP-Modus"));
+      setupWiFi();
     } else {
-      logger.debug(F("main"), F("AP-Modus aktiv, überspringe erneute WiFi-Verbindungsversuche"));
+      LOG_DEBUG(F("main"), F("AP-Modus aktiv, überspringe erneute WiFi-Verbindungsversuche"));
       yield();
     }
 #endif
@@ -508,10 +543,17 @@ void loop() {
   }
 
 // Handle web server requests
+  bool clientPending = false;
 #if USE_WEBSERVER
   WebManager::getInstance().handleClient();
+  clientPending = WebManager::getInstance().isClientPending();
 #endif
 
+  // Buffered log lines go to the queue; queued file writes run in a time
+  // slice while no request is served
+  logger.processFileLog();
+  FileIoQueue::getInstance().process(clientPending);
+
 // Update display if enabled
 #if USE_DISPLAY
   if (displayManager) {
@@ -519,19 +561,24 @@ void loop() {
   }
 #endif
 
-  // Handle sensor measurements with a minimum delay between updates.
+  // Handle sensor measurements when the earliest cycle manager wants to run.
+  // Each cycle reports its next wake-up (due time, warmup end, minimum delay),
+  // so state transitions no longer wait for a fixed polling interval.
   // NOTE: Measurements should run regardless of station WiFi connectivity so
   // the device still collects data while in AP-mode. Network-dependent
   // operations (NTP, Mail, Influx) are handled elsewhere and check for
   // connectivity as needed.
-  static constexpr unsigned long MEASUREMENT_UPDATE_INTERVAL =
-      1000; // 1s between measurement updates
   if (sensorManager && sensorManager->getState() == ManagerState::INITIALIZED &&
-      currentMillis - lastMeasurementUpdate >= MEASUREMENT_UPDATE_INTERVAL) {
+      static_cast<long>(currentMillis - sensorManager->getNextWakeTime()) >= 0) {
     sensorManager->updateMeasurements();
+  }
 
-    // Note: Sensor persistence is now handled per-sensor in handleDeinitializing()
-    // No need for periodic processPendingUpdates() anymore
+  // Housekeeping that does not need to follow the measurement schedule
+  static constexpr unsigned long HOUSEKEEPING_INTERVAL = 1000; // 1s
+  if (sensorManager && sensorManager->getState() == ManagerState::INITIALIZED &&
+      currentMillis - lastHousekeeping >= HOUSEKEEPING_INTERVAL) {
+    // Write cached runtime values (lastValue, min/max) on interval or low heap
+    SensorPersistence::processPendingUpdates();
 
     // Update LED traffic light status for mode 2
 #if USE_LED_TRAFFIC_LIGHT
@@ -540,7 +587,7 @@ void loop() {
     }
 #endif
 
-    lastMeasurementUpdate = currentMillis;
+    lastHousekeeping = currentMillis;
   }
 
   // Basic system maintenance
@@ -87,7 +87,7 @@ protected:
    */
   void setState(ManagerState state) {
     m_status.setState(state);
-    logger.debug(F("BaseM"), m_name + ": Status gewechselt zu " + stateToString(state));
+    LOG_DEBUG(F("BaseM"), m_name + ": Status gewechselt zu " + stateToString(state));
   }
 
   /**
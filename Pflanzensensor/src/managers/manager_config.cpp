@@ -5,6 +5,8 @@
 
 #include "manager_config.h"
 
+#include <algorithm>
+
 #include "../logger/logger.h"
 #include "../managers/manager_config_persistence.h"
 #include "../managers/manager_resource.h"
@@ -16,11 +18,116 @@
 #include "../web/handler/web_ota_handler.h"
 #include "managers/manager_config_preferences.h"
 
-#if USE_DISPLAY
-#include "managers/manager_display.h"
-// Forward declaration
-extern std::unique_ptr<DisplayManager> displayManager;
-#endif
+namespace {
+
+/**
+ * @brief Value of a sensor namespace entry before a batch wrote it
+ */
+struct SensorUndo {
+  const ConfigManager::ConfigUpdate* update;
+  bool existed;    ///< false: the key is removed again
+  uint32_t number; ///< Bool, integer or float bits
+  String text;     ///< String value
+};
+
+/**
+ * @brief Remember the stored values of the entries of one sensor namespace
+ * @param namespaceName Sensor namespace
+ * @param updates Entries of that namespace
+ * @param undo Receives one entry per update
+ */
+void readSensorUndo(const String& namespaceName,
+                    const std::vector<const ConfigManager::ConfigUpdate*>& updates,
+                    std::vector<SensorUndo>& undo) {
+  Preferences prefs;
+  // A namespace that cannot be opened does not exist yet
+  bool open = prefs.begin(namespaceName.c_str(), true);
+  for (const auto* update : updates) {
+    SensorUndo entry{update, open && prefs.isKey(update->key.c_str()), 0, String()};
+    const char* key = update->key.c_str();
+    if (entry.existed) {
+      switch (update->type) {
+      case ConfigValueType::BOOL:
+        entry.number = PreferencesManager::getBool(prefs, key) ? 1 : 0;
+        break;
+      case ConfigValueType::INT:
+        entry.number = static_cast<uint32_t>(PreferencesManager::getInt(prefs, key));
+        break;
+      case ConfigValueType::UINT:
+        entry.number = PreferencesManager::getUInt(prefs, key);
+        break;
+      case ConfigValueType::FLOAT: {
+        float value = PreferencesManager::getFloat(prefs, key);
+        memcpy(&entry.number, &value, sizeof(value));
+        break;
+      }
+      case ConfigValueType::STRING:
+        entry.text = PreferencesManager::getString(prefs, key);
+        break;
+      }
+    }
+    undo.push_back(entry);
+  }
+  if (open) {
+    prefs.end();
+  }
+}
+
+/**
+ * @brief Write back the values remembered by readSensorUndo()
+ * @param undo Entries grouped by namespace
+ * @return false if a value could not be restored
+ */
+bool undoSensorValues(const std::vector<SensorUndo>& undo) {
+  bool ok = true;
+  for (size_t first = 0; first < undo.size();) {
+    const String& namespaceName = undo[first].update->namespaceName;
+    size_t last = first;
+    Preferences prefs;
+    bool open = prefs.begin(namespaceName.c_str(), false);
+    for (; last < undo.size() && undo[last].update->namespaceName == namespaceName; last++) {
+      const SensorUndo& entry = undo[last];
+      const char* key = entry.update->key.c_str();
+      if (!open) {
+        ok = false;
+        continue;
+      }
+      if (!entry.existed) {
+        if (prefs.isKey(key)) {
+          ok = prefs.remove(key) && ok;
+        }
+        continue;
+      }
+      switch (entry.update->type) {
+      case ConfigValueType::BOOL:
+        ok = PreferencesManager::putBool(prefs, key, entry.number != 0) && ok;
+        break;
+      case ConfigValueType::INT:
+        ok = PreferencesManager::putInt(prefs, key, static_cast<int>(entry.number)) && ok;
+        break;
+      case ConfigValueType::UINT:
+        ok = PreferencesManager::putUInt(prefs, key, entry.number) && ok;
+        break;
+      case ConfigValueType::FLOAT: {
+        float value;
+        memcpy(&value, &entry.number, sizeof(value));
+        ok = PreferencesManager::putFloat(prefs, key, value) && ok;
+        break;
+      }
+      case ConfigValueType::STRING:
+        ok = PreferencesManager::putString(prefs, key, entry.text) && ok;
+        break;
+      }
+    }
+    if (open) {
+      prefs.end();
+    }
+    first = last;
+  }
+  return ok;
+}
+
+} // namespace
 
 ConfigManager::ConfigManager()
     : m_webHandler(*this), m_debugConfig(m_notifier), m_sensorErrorTracker(m_notifier) {}
@@ -38,7 +145,7 @@ ConfigManager::ConfigResult ConfigManager::loadConfig() {
   String logLevel =
       PreferencesManager::getString(PreferencesNamespaces::LOG, "level", String(LOG_LEVEL));
   logger.setLogLevel(Logger::stringToLogLevel(logLevel));
-  logger.debug(F("ConfigM"), String(F("Log-Level geladen: ")) + logLevel);
+  LOG_DEBUG(F("ConfigM"), String(F("Log-Level geladen: ")) + logLevel);
 
   // Load main configuration
   auto result = ConfigPersistence::load(m_configData);
@@ -141,7 +248,7 @@ ConfigManager::ConfigResult ConfigManager::setAdminPassword(const String& passwo
       return ConfigResult::fail(saveResult.error().value_or(ConfigError::SAVE_FAILED),
                                 saveResult.getMessage());
     }
-    notifyConfigChange("admin_password", "updated", true);
+    notifyConfigChange(ConfigKey::ADMIN_PASSWORD, ConfigValue::fromString(password), true);
   }
   return ConfigResult::success();
 }
@@ -154,7 +261,7 @@ ConfigManager::ConfigResult ConfigManager::setMD5Verification(bool enabled) {
         return PreferencesManager::updateBoolValue(PreferencesNamespaces::GENERAL, "md5_verify",
                                                    val);
       },
-      "md5_verification", true);
+      ConfigKey::MD5_VERIFICATION, true);
 }
 
 ConfigManager::ConfigResult ConfigManager::setCollectdEnabled(bool enabled) {
@@ -165,7 +272,7 @@ ConfigManager::ConfigResult ConfigManager::setCollectdEnabled(bool enabled) {
         return PreferencesManager::updateBoolValue(PreferencesNamespaces::GENERAL, "collectd_en",
                                                    val);
       },
-      "collectd_enabled", true);
+      ConfigKey::COLLECTD_ENABLED, true);
 }
 
 ConfigManager::ConfigResult ConfigManager::setFileLoggingEnabled(bool enabled) {
@@ -175,7 +282,7 @@ ConfigManager::ConfigResult ConfigManager::setFileLoggingEnabled(bool enabled) {
       [](bool val) {
         return PreferencesManager::updateBoolValue(PreferencesNamespaces::GENERAL, "file_log", val);
       },
-      "file_logging_enabled", true);
+      ConfigKey::FILE_LOGGING, true);
 }
 
 ConfigManager::ConfigResult ConfigManager::setUpdateFlags(bool fileSystem, bool firmware) {
@@ -197,6 +304,13 @@ ConfigManager::ConfigResult ConfigManager::setUpdateFlags(bool fileSystem, bool
     logger.info(F("ConfigM"),
                 F("Sichere Preferences + JSON-Configs in Flash vor Dateisystem-Update..."));
     auto result = FlashPersistence::saveAllToFlash();
+    if (result.error() == ResourceError::INSUFFICIENT_SPACE) {
+      // The update would wipe the configuration without a way back
+      logger.error(F("ConfigM"),
+                   F("Dateisystem-Update abgelehnt: kein Platz für Flash-Sicherung"));
+      return ConfigResult::fail(ConfigError::SAVE_FAILED,
+                                F("Kein Flash-Speicher für die Sicherung vor dem Update"));
+    }
     if (!result.isSuccess()) {
       logger.warning(F("ConfigM"), F("Flash-Sicherung fehlgeschlagen: ") + result.getMessage() +
                                        F(" - Fortsetzen trotzdem"));
@@ -205,44 +319,54 @@ ConfigManager::ConfigResult ConfigManager::setUpdateFlags(bool fileSystem, bool
     }
   }
 
-  ConfigPersistence::writeUpdateFlagsToFile(fileSystem, firmware);
+  storeUpdateFlags(fileSystem, firmware);
 
   notifyConfigChange("update_flags", "fs:" + String(fileSystem) + ",fw:" + String(firmware), true);
 
   return ConfigResult::success();
 }
 
+void ConfigManager::loadUpdateFlags() const {
+  if (m_updateFlagsLoaded) {
+    return;
+  }
+  ConfigPersistence::readUpdateFlagsFromFile(m_fileSystemUpdatePending, m_firmwareUpdatePending);
+  m_updateFlagsLoaded = true;
+}
+
+void ConfigManager::storeUpdateFlags(bool fileSystem, bool firmware) {
+  ConfigPersistence::writeUpdateFlagsToFile(fileSystem, firmware);
+  m_fileSystemUpdatePending = fileSystem;
+  m_firmwareUpdatePending = firmware;
+  m_updateFlagsLoaded = true;
+}
+
 bool ConfigManager::isFileSystemUpdatePending() const {
-  bool fs, fw;
-  ConfigPersistence::readUpdateFlagsFromFile(fs, fw);
-  return fs;
+  loadUpdateFlags();
+  return m_fileSystemUpdatePending;
 }
 
 bool ConfigManager::isFirmwareUpdatePending() const {
-  bool fs, fw;
-  ConfigPersistence::readUpdateFlagsFromFile(fs, fw);
-  return fw;
+  loadUpdateFlags();
+  return m_firmwareUpdatePending;
 }
 
 bool ConfigManager::getDoFirmwareUpgrade() {
-  bool fs, fw;
-  ConfigPersistence::readUpdateFlagsFromFile(fs, fw);
+  loadUpdateFlags();
   // Update mode is active if either filesystem or firmware update is pending
-  return fs || fw;
+  return m_fileSystemUpdatePending || m_firmwareUpdatePending;
 }
 
 ConfigManager::ConfigResult ConfigManager::setDoFirmwareUpgrade(bool enable) {
   ScopedLock lock;
-  bool fs, fw;
-  ConfigPersistence::readUpdateFlagsFromFile(fs, fw);
 
   if (enable) {
     // If enabling update mode, set firmware update pending (default choice)
-    ConfigPersistence::writeUpdateFlagsToFile(false, true);
+    storeUpdateFlags(false, true);
     notifyConfigChange("do_firmware_upgrade", "true", true);
   } else {
     // If disabling update mode, clear all update flags
-    ConfigPersistence::writeUpdateFlagsToFile(false, false);
+    storeUpdateFlags(false, false);
     notifyConfigChange("do_firmware_upgrade", "false", true);
   }
 
@@ -274,7 +398,7 @@ ConfigManager::ConfigResult ConfigManager::setLogLevel(const String& level) {
     return ConfigResult::fail(ConfigError::SAVE_FAILED, result.getMessage());
   }
 
-  notifyConfigChange("log_level", level, true);
+  notifyConfigChange(ConfigKey::LOG_LEVEL, ConfigValue::fromString(level), true);
 
   return ConfigResult::success();
 }
@@ -285,79 +409,12 @@ String ConfigManager::getLogLevel() const { return logger.logLevelToString(logge
 
 ConfigManager::ConfigResult ConfigManager::setConfigValue(const char* key, const char* value) {
   ScopedLock lock;
-  String keyStr(key);
-  String valueStr(value);
-
-  // Handle different configuration keys
-  if (keyStr == "admin_password") {
-    if (m_configData.adminPassword != valueStr) {
-      auto result = setAdminPassword(valueStr);
-      if (!result.isSuccess()) {
-        return result;
-      }
-    }
-  } else if (keyStr == "md5_verification") {
-    bool newValue = (valueStr == "true" || valueStr == "1");
-    if (m_configData.md5Verification != newValue) {
-      auto result = setMD5Verification(newValue);
-      if (!result.isSuccess()) {
-        return result;
-      }
-    }
-  } else if (keyStr == "collectd_enabled") {
-    bool newValue = (valueStr == "true" || valueStr == "1");
-    if (m_configData.collectdEnabled != newValue) {
-      auto result = setCollectdEnabled(newValue);
-      if (!result.isSuccess()) {
-        return result;
-      }
-    }
-  } else if (keyStr == "file_logging_enabled") {
-    bool newValue = (valueStr == "true" || valueStr == "1");
-    if (m_configData.fileLoggingEnabled != newValue) {
-      auto result = setFileLoggingEnabled(newValue);
-      if (!result.isSuccess()) {
-        return result;
-      }
-    }
-  } else if (keyStr.startsWith("debug_")) {
-    // Handle debug flags
-    bool newValue = (valueStr == "true" || valueStr == "1");
-    if (keyStr == "debug_ram") {
-      auto result = setDebugRAM(newValue);
-      if (!result.isSuccess())
-        return result;
-    } else if (keyStr == "debug_measurement_cycle") {
-      auto result = setDebugMeasurementCycle(newValue);
-      if (!result.isSuccess())
-        return result;
-    } else if (keyStr == "debug_sensor") {
-      auto result = setDebugSensor(newValue);
-      if (!result.isSuccess())
-        return result;
-    } else if (keyStr == "debug_display") {
-      auto result = setDebugDisplay(newValue);
-      if (!result.isSuccess())
-        return result;
-    } else if (keyStr == "debug_websocket") {
-      auto result = setDebugWebSocket(newValue);
-      if (!result.isSuccess())
-        return result;
-    }
-  } else if (keyStr == "log_level") {
-    String currentLevel = getLogLevel();
-    if (currentLevel != valueStr) {
-      auto result = setLogLevel(valueStr);
-      if (!result.isSuccess()) {
-        return result;
-      }
-    }
-  } else {
+  ConfigKey configKey = ConfigKeys::findLegacy(key);
+  if (configKey == ConfigKey::INVALID) {
     return ConfigResult::fail(ConfigError::VALIDATION_ERROR,
-                              F("Unknown configuration key: ") + keyStr);
+                              F("Unknown configuration key: ") + String(key));
   }
-
-  return ConfigResult::success();
+  return setConfigText(configKey, value);
 }
 
 ConfigManager::ConfigResult ConfigManager::setConfigValue(const String& namespaceName,
@@ -365,249 +422,247 @@ ConfigManager::ConfigResult ConfigManager::setConfigValue(const String& namespac
                                                           ConfigValueType type) {
   ScopedLock lock;
 
-  logger.debug(F("ConfigM"), String(F("setConfigValue: namespace=")) + namespaceName + F(", key=") +
-                                 key + F(", value=") + value);
+  LOG_DEBUG(F("ConfigM"), String(F("setConfigValue: namespace=")) + namespaceName + F(", key=") +
+                              key + F(", value=") + value);
 
-  // Handle general namespace - route through existing setters for validation
-  if (namespaceName == "general") {
-    if (key == "device_name") {
-      auto result = setDeviceName(value);
-      if (result.isSuccess()) {
-        logger.info(F("ConfigM"), String(F("Einstellung geändert: device_name = ")) + value);
-      }
-      return result;
-    } else if (key == "admin_pwd") {
-      auto result = setAdminPassword(value);
-      if (result.isSuccess()) {
-        logger.info(F("ConfigM"), F("Einstellung geändert: admin_pwd = ***"));
-      }
-      return result;
-    } else if (key == "md5_verify") {
-      bool enabled = (value == "true" || value == "1");
-      auto result = setMD5Verification(enabled);
-      if (result.isSuccess()) {
-        logger.info(F("ConfigM"), String(F("Einstellung geändert: md5_verify = ")) +
-                                      (enabled ? F("true") : F("false")));
-      }
-      return result;
-    } else if (key == "file_log") {
-      bool enabled = (value == "true" || value == "1");
-      auto result = setFileLoggingEnabled(enabled);
-      if (result.isSuccess()) {
-        logger.info(F("ConfigM"), String(F("Einstellung geändert: file_log = ")) +
-                                      (enabled ? F("true") : F("false")));
-      }
-      return result;
-    } else if (key == "collectd_enabled") {
-      bool enabled = (value == "true" || value == "1");
-      auto result = setCollectdEnabled(enabled);
-      if (result.isSuccess()) {
-        logger.info(F("ConfigM"), String(F("Einstellung geändert: collectd_enabled = ")) +
-                                      (enabled ? F("true") : F("false")));
+  // Fixed namespaces: resolve the typed key, then parse, validate and dispatch
+  ConfigKey configKey = ConfigKeys::find(namespaceName, key);
+  if (configKey != ConfigKey::INVALID) {
+    return setConfigText(configKey, value);
+  }
+
+  // Handle sensor namespaces (format: s_SENSORID)
+  if (namespaceName.startsWith("s_")) {
+    ConfigUpdate update{namespaceName, key, value, type};
+    auto validation = validateSensorUpdate(update);
+    if (!validation.isSuccess()) {
+      return validation;
+    }
+    return setSensorValues(namespaceName, {&update});
+  }
+
+  return ConfigResult::fail(ConfigError::VALIDATION_ERROR,
+                            F("Unknown namespace or key: ") + namespaceName + F(".") + key);
+}
+
+ConfigManager::ConfigResult
+ConfigManager::setConfigValues(const std::vector<ConfigUpdate>& updates) {
+  if (updates.size() > CONFIG_BATCH_MAX_ENTRIES) {
+    return ConfigResult::fail(ConfigError::VALIDATION_ERROR,
+                              F("Zu viele Einträge: ") + String(updates.size()) + F(" (max. ") +
+                                  String(CONFIG_BATCH_MAX_ENTRIES) + F(")"));
+  }
+
+  // Resolve and validate everything before the first value is applied
+  std::vector<std::pair<ConfigKey, ConfigValue>> typed;
+  std::vector<const ConfigUpdate*> sensor;
+  typed.reserve(updates.size());
+  for (const auto& update : updates) {
+    ConfigKey key = ConfigKeys::find(update.namespaceName, update.key);
+    if (key == ConfigKey::INVALID) {
+      if (!update.namespaceName.startsWith("s_") || update.key.isEmpty()) {
+        return ConfigResult::fail(ConfigError::VALIDATION_ERROR,
+                                  F("Unknown namespace or key: ") + update.namespaceName + F(".") +
+                                      update.key);
       }
-      return result;
-    } else if (key == "flower_sens") {
-      auto result = setFlowerStatusSensor(value);
-      if (result.isSuccess()) {
-        logger.info(F("ConfigM"), String(F("Einstellung geändert: flower_sens = ")) + value);
+      auto validation = validateSensorUpdate(update);
+      if (!validation.isSuccess()) {
+        return validation;
       }
-      return result;
+      sensor.push_back(&update);
+      continue;
     }
-  }
 
-  // Handle WiFi namespace - use separate namespaces for each WiFi set
-  else if (namespaceName == "wifi") {
-    // Determine which WiFi namespace to use based on key
-    const char* wifiNamespace = nullptr;
-    String prefKey;
-
-    if (key == "ssid1" || key == "pwd1") {
-      wifiNamespace = PreferencesNamespaces::WIFI1;
-      prefKey = (key == "ssid1") ? "ssid" : "pwd";
-    } else if (key == "ssid2" || key == "pwd2") {
-      wifiNamespace = PreferencesNamespaces::WIFI2;
-      prefKey = (key == "ssid2") ? "ssid" : "pwd";
-    } else if (key == "ssid3" || key == "pwd3") {
-      wifiNamespace = PreferencesNamespaces::WIFI3;
-      prefKey = (key == "ssid3") ? "ssid" : "pwd";
-    } else {
-      return ConfigResult::fail(ConfigError::VALIDATION_ERROR, F("Unknown WiFi key: ") + key);
+    ConfigValue value;
+    if (!ConfigKeys::parse(key, update.value, value)) {
+      return ConfigResult::fail(ConfigError::VALIDATION_ERROR,
+                                F("Ungültiger Wert für ") + ConfigKeys::getName(key) + F(": ") +
+                                    update.value);
+    }
+    auto validation = validateConfigValue(key, value);
+    if (!validation.isSuccess()) {
+      return validation;
     }
 
-    Preferences prefs;
-    if (!prefs.begin(wifiNamespace, false)) {
-      return ConfigResult::fail(ConfigError::FILE_ERROR,
-                                F("Failed to open WiFi namespace: ") + String(wifiNamespace));
+    // A later entry for the same key replaces the earlier one
+    auto it = std::find_if(typed.begin(), typed.end(),
+                           [key](const std::pair<ConfigKey, ConfigValue>& entry) {
+                             return entry.first == key;
+                           });
+    if (it != typed.end()) {
+      it->second = value;
+    } else {
+      typed.emplace_back(key, value);
     }
+  }
 
-    bool success = PreferencesManager::putString(prefs, prefKey.c_str(), value);
-    prefs.end();
+  // Group the sensor entries so every sensor namespace is opened once
+  std::stable_sort(sensor.begin(), sensor.end(), [](const ConfigUpdate* a, const ConfigUpdate* b) {
+    return a->namespaceName < b->namespaceName;
+  });
 
-    if (!success) {
-      return ConfigResult::fail(ConfigError::SAVE_FAILED, F("Failed to save WiFi setting"));
-    }
+  ScopedLock lock;
+  unsigned long start = millis();
 
-    // Update RAM config
-    if (key == "ssid1")
-      setWiFiSSID1(value);
-    else if (key == "pwd1")
-      setWiFiPassword1(value);
-    else if (key == "ssid2")
-      setWiFiSSID2(value);
-    else if (key == "pwd2")
-      setWiFiPassword2(value);
-    else if (key == "ssid3")
-      setWiFiSSID3(value);
-    else if (key == "pwd3")
-      setWiFiPassword3(value);
-
-    String displayValue = key.indexOf("pwd") >= 0 ? "***" : value;
-    logger.info(F("ConfigM"), String(F("WiFi ")) + key + F(" gespeichert in ") +
-                                  String(wifiNamespace) + F(": ") + displayValue);
-    return ConfigResult::success();
-  }
+  // RAM state to restore if applying fails
+  ConfigData snapshot = m_configData;
+  m_debugConfig.saveToConfigData(snapshot);
+  LogLevel logLevel = logger.getLogLevel();
 
-  // Handle display namespace
-  else if (namespaceName == "display") {
-    Preferences prefs;
-    if (!prefs.begin(PreferencesNamespaces::DISP, false)) {
-      return ConfigResult::fail(ConfigError::FILE_ERROR, F("Failed to open display namespace"));
-    }
+  m_notifier.beginBatch();
+  PreferencesManager::beginBatch();
 
-    bool success = false;
-    String displayValue = value;
-    if (key == "show_ip") {
-      bool enabled = (value == "true" || value == "1");
-      auto result =
-          PreferencesManager::updateBoolValue(PreferencesNamespaces::DISP, "show_ip", enabled);
-      success = result.isSuccess();
-      displayValue = enabled ? F("true") : F("false");
-    } else if (key == "show_clock") {
-      bool enabled = (value == "true" || value == "1");
-      auto result =
-          PreferencesManager::updateBoolValue(PreferencesNamespaces::DISP, "show_clock", enabled);
-      success = result.isSuccess();
-      displayValue = enabled ? F("true") : F("false");
-    } else if (key == "show_flower") {
-      bool enabled = (value == "true" || value == "1");
-      auto result =
-          PreferencesManager::updateBoolValue(PreferencesNamespaces::DISP, "show_flower", enabled);
-      success = result.isSuccess();
-      displayValue = enabled ? F("true") : F("false");
-    } else if (key == "show_fabmobil") {
-      bool enabled = (value == "true" || value == "1");
-      auto result = PreferencesManager::updateBoolValue(PreferencesNamespaces::DISP,
-                                                        "show_fabmobil", enabled);
-      success = result.isSuccess();
-      displayValue = enabled ? F("true") : F("false");
-    } else if (key == "show_qr") {
-      bool enabled = (value == "true" || value == "1");
-      auto result =
-          PreferencesManager::updateBoolValue(PreferencesNamespaces::DISP, "show_qr", enabled);
-      success = result.isSuccess();
-      displayValue = enabled ? F("true") : F("false");
-    } else if (key == "screen_dur") {
-      unsigned int duration = value.toInt();
-      auto result =
-          PreferencesManager::updateUIntValue(PreferencesNamespaces::DISP, "screen_dur", duration);
-      success = result.isSuccess();
-    } else if (key == "clock_fmt") {
-      auto result =
-          PreferencesManager::updateStringValue(PreferencesNamespaces::DISP, "clock_fmt", value);
-      success = result.isSuccess();
+  // Typed values are only staged in the Preferences cache here
+  ConfigResult result = ConfigResult::success();
+  for (const auto& entry : typed) {
+    result = applyConfigValue(entry.first, entry.second);
+    if (!result.isSuccess()) {
+      break;
     }
-
-    prefs.end();
-    if (!success) {
-      return ConfigResult::fail(ConfigError::SAVE_FAILED, F("Failed to save display setting"));
+  }
+  // Sensor namespaces bypass the Preferences cache and are written directly;
+  // their previous values are kept to undo them if a later step fails
+  std::vector<SensorUndo> undo;
+  undo.reserve(sensor.size());
+  for (size_t first = 0; result.isSuccess() && first < sensor.size();) {
+    size_t last = first + 1;
+    while (last < sensor.size() && sensor[last]->namespaceName == sensor[first]->namespaceName) {
+      last++;
     }
+    std::vector<const ConfigUpdate*> group(sensor.begin() + first, sensor.begin() + last);
+    readSensorUndo(sensor[first]->namespaceName, group, undo);
+    result = setSensorValues(sensor[first]->namespaceName, group);
+    first = last;
+  }
 
-    // Reload display manager config so it picks up the new values
-#if USE_DISPLAY
-    if (displayManager) {
-      displayManager->reloadConfig();
+  // The typed values are committed last, so a failure here can still undo
+  // the sensor namespaces
+  bool commitFailed = false;
+  if (result.isSuccess()) {
+    auto commitResult = PreferencesManager::commitBatch();
+    if (!commitResult.isSuccess()) {
+      commitFailed = true;
+      result = ConfigResult::fail(ConfigError::SAVE_FAILED, commitResult.getMessage());
     }
-#endif
-
-    logger.info(F("ConfigM"), String(F("Einstellung geändert: ")) + key + F(" = ") + displayValue);
-    notifyConfigChange(key, value, false);
-    return ConfigResult::success();
+  } else {
+    PreferencesManager::discardBatch();
   }
 
-  // Handle debug namespace
-  else if (namespaceName == "debug") {
-    bool enabled = (value == "true" || value == "1");
-    ConfigResult result = ConfigResult::success();
-    if (key == "ram") {
-      result = setDebugRAM(enabled);
-    } else if (key == "meas_cycle") {
-      result = setDebugMeasurementCycle(enabled);
-    } else if (key == "sensor") {
-      result = setDebugSensor(enabled);
-    } else if (key == "display") {
-      result = setDebugDisplay(enabled);
-    } else if (key == "websocket") {
-      result = setDebugWebSocket(enabled);
+  if (!result.isSuccess()) {
+    m_notifier.discardBatch();
+    if (!undoSensorValues(undo)) {
+      logger.error(F("ConfigM"), F("Sensor-Einstellungen nicht vollständig zurückgesetzt"));
     }
-    if (result.isSuccess()) {
-      logger.info(F("ConfigM"), String(F("Einstellung geändert: ")) + key + F(" = ") +
-                                    (enabled ? F("true") : F("false")));
+    m_configData = snapshot;
+    m_debugConfig.loadFromConfigData(snapshot);
+    logger.setLogLevel(logLevel);
+    // Fixed namespaces committed before the failed one get their old values back
+    if (commitFailed) {
+      PreferencesManager::invalidateCache();
+      if (!ConfigPersistence::save(snapshot).isSuccess()) {
+        logger.error(F("ConfigM"), F("Einstellungen nicht vollständig zurückgesetzt"));
+      }
     }
+    logger.warning(F("ConfigM"), F("Einstellungen verworfen: ") + result.getMessage());
     return result;
   }
 
-  // Handle log namespace
-  else if (namespaceName == "log") {
-    ConfigResult result = ConfigResult::success();
-    if (key == "level") {
-      result = setLogLevel(value);
-      if (result.isSuccess()) {
-        logger.info(F("ConfigM"), String(F("Einstellung geändert: log_level = ")) + value);
-      }
-      return result;
-    } else if (key == "file_enabled") {
-      bool enabled = (value == "true" || value == "1");
-      result = setFileLoggingEnabled(enabled);
-      if (result.isSuccess()) {
-        logger.info(F("ConfigM"), String(F("Einstellung geändert: file_enabled = ")) +
-                                      (enabled ? F("true") : F("false")));
-      }
-      return result;
-    }
+  m_notifier.endBatch();
+
+  logger.info(F("ConfigM"), String(updates.size()) + F(" Einstellungen gespeichert in ") +
+                                String(millis() - start) + F(" ms"));
+  return ConfigResult::success();
+}
+
+ConfigManager::ConfigResult ConfigManager::validateConfigValue(ConfigKey key,
+                                                               const ConfigValue& value) const {
+  auto validation = ConfigKeys::validate(key, value);
+  if (!validation.isSuccess()) {
+    return ConfigResult::fail(validation.error().value_or(ConfigError::VALIDATION_ERROR),
+                              validation.getMessage());
+  }
+  if (key != ConfigKey::FLOWER_STATUS_SENSOR && key != ConfigKey::LED_SELECTED_MEASUREMENT) {
+    return ConfigResult::success();
   }
 
-  // Handle LED traffic light namespace
-  else if (namespaceName == "led_traf") {
-    ConfigResult result = ConfigResult::success();
-    if (key == "mode") {
-      uint8_t mode = value.toInt();
-      result = setLedTrafficLightMode(mode);
-      if (result.isSuccess()) {
-        logger.info(F("ConfigM"), String(F("Einstellung geändert: led_mode = ")) + String(mode));
-      }
-      return result;
-    } else if (key == "sel_meas") {
-      result = setLedTrafficLightSelectedMeasurement(value);
-      if (result.isSuccess()) {
-        logger.info(F("ConfigM"), String(F("Einstellung geändert: led_sel_meas = ")) + value);
-      }
-      return result;
-    }
+  // "<sensor ID>_<measurement index>", empty selects nothing
+  const String& reference = value.stringValue;
+  if (reference.isEmpty()) {
+    return ConfigResult::success();
+  }
+  int separator = reference.indexOf('_');
+  bool valid = separator > 0 && static_cast<size_t>(separator) + 1 < reference.length();
+  for (size_t i = separator + 1; valid && i < reference.length(); i++) {
+    valid = isdigit(static_cast<unsigned char>(reference.charAt(i)));
   }
+  valid = valid &&
+          static_cast<size_t>(reference.substring(separator + 1).toInt()) <
+              SensorConfig::MAX_MEASUREMENTS &&
+          SensorRegistry::find(reference.substring(0, separator)) != INVALID_SENSOR_HANDLE;
+  if (!valid) {
+    return ConfigResult::fail(ConfigError::VALIDATION_ERROR,
+                              F("Unbekannte Messung für ") + ConfigKeys::getName(key) + F(": ") +
+                                  reference);
+  }
+  return ConfigResult::success();
+}
 
-  // Handle sensor namespaces (format: s_SENSORID)
-  else if (namespaceName.startsWith("s_")) {
-    Preferences prefs;
-    if (!prefs.begin(namespaceName.c_str(), false)) {
-      return ConfigResult::fail(ConfigError::FILE_ERROR,
-                                F("Failed to open sensor namespace: ") + namespaceName);
-    }
+ConfigManager::ConfigResult ConfigManager::validateSensorUpdate(const ConfigUpdate& update) {
+  // Namespace and key names are limited like ESP32 NVS names
+  static constexpr size_t MAX_PREFERENCES_NAME = 15;
+  if (update.namespaceName.length() > MAX_PREFERENCES_NAME ||
+      update.key.length() > MAX_PREFERENCES_NAME) {
+    return ConfigResult::fail(ConfigError::VALIDATION_ERROR,
+                              F("Name zu lang: ") + update.namespaceName + F(".") + update.key);
+  }
+
+  const String& value = update.value;
+  const char* text = value.c_str();
+  char* end = nullptr;
+  bool valid = true;
+  switch (update.type) {
+  case ConfigValueType::BOOL:
+    valid = value == "true" || value == "false" || value == "1" || value == "0";
+    break;
+  case ConfigValueType::INT:
+    strtol(text, &end, 10);
+    valid = !value.isEmpty() && *end == '\0';
+    break;
+  case ConfigValueType::UINT:
+    strtoul(text, &end, 10);
+    valid = !value.isEmpty() && value.charAt(0) != '-' && *end == '\0';
+    break;
+  case ConfigValueType::FLOAT:
+    valid = !value.isEmpty() && isfinite(strtof(text, &end)) && *end == '\0';
+    break;
+  case ConfigValueType::STRING:
+    break;
+  }
+  if (!valid) {
+    return ConfigResult::fail(ConfigError::VALIDATION_ERROR, F("Ungültiger Wert für ") +
+                                                                 update.namespaceName + F(".") +
+                                                                 update.key + F(": ") + value);
+  }
+  return ConfigResult::success();
+}
 
+ConfigManager::ConfigResult
+ConfigManager::setSensorValues(const String& namespaceName,
+                               const std::vector<const ConfigUpdate*>& updates) {
+  Preferences prefs;
+  if (!prefs.begin(namespaceName.c_str(), false)) {
+    return ConfigResult::fail(ConfigError::FILE_ERROR,
+                              F("Failed to open sensor namespace: ") + namespaceName);
+  }
+
+  for (const ConfigUpdate* update : updates) {
+    const String& key = update->key;
+    const String& value = update->value;
     bool success = false;
     String displayValue = value;
 
     // Write the value based on type
-    switch (type) {
+    switch (update->type) {
     case ConfigValueType::BOOL: {
       bool boolValue = (value == "true" || value == "1");
       success = PreferencesManager::putBool(prefs, key.c_str(), boolValue);
@@ -635,9 +690,8 @@ ConfigManager::ConfigResult ConfigManager::setConfigValue(const String& namespac
     }
     }
 
-    prefs.end();
-
     if (!success) {
+      prefs.end();
       return ConfigResult::fail(ConfigError::SAVE_FAILED,
                                 F("Failed to save sensor setting: ") + key);
     }
@@ -645,23 +699,164 @@ ConfigManager::ConfigResult ConfigManager::setConfigValue(const String& namespac
     logger.info(F("ConfigM"), String(F("Einstellung geändert: ")) + namespaceName + F(".") + key +
                                   F(" = ") + displayValue);
     notifyConfigChange(key, value, true);
-    return ConfigResult::success();
   }
 
-  return ConfigResult::fail(ConfigError::VALIDATION_ERROR,
-                            F("Unknown namespace or key: ") + namespaceName + F(".") + key);
+  prefs.end();
+  return ConfigResult::success();
+}
+
+ConfigManager::ConfigResult ConfigManager::setConfigText(ConfigKey key, const String& text) {
+  ConfigValue value;
+  if (!ConfigKeys::parse(key, text, value)) {
+    return ConfigResult::fail(ConfigError::VALIDATION_ERROR, F("Ungültiger Wert für ") +
+                                                                 ConfigKeys::getName(key) +
+                                                                 F(": ") + text);
+  }
+  auto validation = validateConfigValue(key, value);
+  if (!validation.isSuccess()) {
+    return validation;
+  }
+
+  auto result = applyConfigValue(key, value);
+  if (result.isSuccess()) {
+    String shown = ConfigKeys::isSecret(key) ? String(F("***")) : value.toString();
+    logger.info(F("ConfigM"),
+                String(F("Einstellung geändert: ")) + ConfigKeys::getName(key) + F(" = ") + shown);
+  }
+  return result;
+}
+
+ConfigManager::ConfigResult ConfigManager::applyConfigValue(ConfigKey key,
+                                                            const ConfigValue& value) {
+  switch (key) {
+  case ConfigKey::DEVICE_NAME:
+    return setDeviceName(value.stringValue);
+  case ConfigKey::ADMIN_PASSWORD:
+    return setAdminPassword(value.stringValue);
+  case ConfigKey::MD5_VERIFICATION:
+    return setMD5Verification(value.boolValue);
+  case ConfigKey::COLLECTD_ENABLED:
+    return setCollectdEnabled(value.boolValue);
+  case ConfigKey::FILE_LOGGING:
+  case ConfigKey::LOG_FILE_ENABLED:
+    return setFileLoggingEnabled(value.boolValue);
+  case ConfigKey::FLOWER_STATUS_SENSOR:
+    return setFlowerStatusSensor(value.stringValue);
+  case ConfigKey::LOG_LEVEL:
+    return setLogLevel(value.stringValue);
+  case ConfigKey::LED_MODE:
+    return setLedTrafficLightMode(static_cast<uint8_t>(value.uintValue));
+  case ConfigKey::LED_SELECTED_MEASUREMENT:
+    return setLedTrafficLightSelectedMeasurement(value.stringValue);
+  case ConfigKey::DEBUG_RAM:
+    return setDebugRAM(value.boolValue);
+  case ConfigKey::DEBUG_MEASUREMENT_CYCLE:
+    return setDebugMeasurementCycle(value.boolValue);
+  case ConfigKey::DEBUG_SENSOR:
+    return setDebugSensor(value.boolValue);
+  case ConfigKey::DEBUG_DISPLAY:
+    return setDebugDisplay(value.boolValue);
+  case ConfigKey::DEBUG_WEBSOCKET:
+    return setDebugWebSocket(value.boolValue);
+  case ConfigKey::WIFI_SSID_1:
+  case ConfigKey::WIFI_SSID_2:
+  case ConfigKey::WIFI_SSID_3:
+  case ConfigKey::WIFI_PASSWORD_1:
+  case ConfigKey::WIFI_PASSWORD_2:
+  case ConfigKey::WIFI_PASSWORD_3:
+    return setWiFiValue(key, value.stringValue);
+  case ConfigKey::DISPLAY_CLOCK_FORMAT:
+  case ConfigKey::DISPLAY_SCREEN_DURATION:
+  case ConfigKey::DISPLAY_SHOW_CLOCK:
+  case ConfigKey::DISPLAY_SHOW_FABMOBIL:
+  case ConfigKey::DISPLAY_SHOW_FLOWER:
+  case ConfigKey::DISPLAY_SHOW_IP:
+  case ConfigKey::DISPLAY_SHOW_QR:
+    return setDisplayValue(key, value);
+  default:
+    return ConfigResult::fail(ConfigError::VALIDATION_ERROR, F("Unbekannter Schlüssel"));
+  }
+}
+
+ConfigManager::ConfigResult ConfigManager::setWiFiValue(ConfigKey key, const String& value) {
+  switch (key) {
+  case ConfigKey::WIFI_SSID_1:
+    return setWiFiSSID1(value);
+  case ConfigKey::WIFI_PASSWORD_1:
+    return setWiFiPassword1(value);
+  case ConfigKey::WIFI_SSID_2:
+    return setWiFiSSID2(value);
+  case ConfigKey::WIFI_PASSWORD_2:
+    return setWiFiPassword2(value);
+  case ConfigKey::WIFI_SSID_3:
+    return setWiFiSSID3(value);
+  default:
+    return setWiFiPassword3(value);
+  }
+}
+
+ConfigManager::ConfigResult ConfigManager::setDisplayValue(ConfigKey key,
+                                                           const ConfigValue& value) {
+  const char* ns = PreferencesNamespaces::DISP;
+  PreferencesManager::PrefResult result = PreferencesManager::PrefResult::success();
+  switch (key) {
+  case ConfigKey::DISPLAY_SHOW_IP:
+    result = PreferencesManager::updateBoolValue(ns, "show_ip", value.boolValue);
+    break;
+  case ConfigKey::DISPLAY_SHOW_CLOCK:
+    result = PreferencesManager::updateBoolValue(ns, "show_clock", value.boolValue);
+    break;
+  case ConfigKey::DISPLAY_SHOW_FLOWER:
+    result = PreferencesManager::updateBoolValue(ns, "show_flower", value.boolValue);
+    break;
+  case ConfigKey::DISPLAY_SHOW_FABMOBIL:
+    result = PreferencesManager::updateBoolValue(ns, "show_fabmobil", value.boolValue);
+    break;
+  case ConfigKey::DISPLAY_SHOW_QR:
+    result = PreferencesManager::updateBoolValue(ns, "show_qr", value.boolValue);
+    break;
+  case ConfigKey::DISPLAY_SCREEN_DURATION:
+    result = PreferencesManager::updateUIntValue(ns, "screen_dur", value.uintValue);
+    break;
+  case ConfigKey::DISPLAY_CLOCK_FORMAT:
+    result = PreferencesManager::updateStringValue(ns, "clock_fmt", value.stringValue);
+    break;
+  default:
+    return ConfigResult::fail(ConfigError::VALIDATION_ERROR, F("Unbekannter Display-Schlüssel"));
+  }
+
+  if (!result.isSuccess()) {
+    return ConfigResult::fail(ConfigError::SAVE_FAILED, F("Failed to save display setting"));
+  }
+
+  // DisplayManager subscribes to the display keys and reloads its config
+  notifyConfigChange(key, value, false);
+  return ConfigResult::success();
 }
 
 void ConfigManager::addChangeCallback(ConfigNotifier::ChangeCallback callback) {
   m_notifier.addChangeCallback(callback);
 }
 
+void ConfigManager::subscribeConfigKey(ConfigKey key, ConfigNotifier::KeyCallback callback) {
+  m_notifier.subscribe(key, std::move(callback));
+}
+
 void ConfigManager::notifyConfigChange(const String& key, const String& value, bool updateSensors) {
 
   // Delegate to notifier
-  logger.debug(F("ConfigM"), String(F("Konfigurationsänderung für Schlüssel: ")) + key +
-                                 F(" (updateSensors=") + String(updateSensors) +
-                                 F(") wird gemeldet"));
+  LOG_DEBUG(F("ConfigM"), String(F("Konfigurationsänderung für Schlüssel: ")) + key +
+                              F(" (updateSensors=") + String(updateSensors) +
+                              F(") wird gemeldet"));
+  m_notifier.notifyChange(key, value, updateSensors);
+}
+
+void ConfigManager::notifyConfigChange(ConfigKey key, const ConfigValue& value,
+                                       bool updateSensors) {
+  if (isDebugSensor()) {
+    LOG_DEBUG(F("ConfigM"), String(F("Konfigurationsänderung für Schlüssel: ")) +
+                                ConfigKeys::getName(key) + F(" wird gemeldet"));
+  }
   m_notifier.notifyChange(key, value, updateSensors);
 }
 
@@ -669,7 +864,7 @@ void ConfigManager::notifyConfigChange(const String& key, const String& value, b
 
 ConfigManager::ConfigResult ConfigManager::updateBoolConfig(bool& currentValue, bool newValue,
                                                             BoolUpdateFunc updateFunc,
-                                                            const String& notifyKey,
+                                                            ConfigKey notifyKey,
                                                             bool updateSensors) {
 
   if (currentValue != newValue) {
@@ -678,12 +873,13 @@ ConfigManager::ConfigResult ConfigManager::updateBoolConfig(bool& currentValue,
     // Persist atomically to Preferences
     auto saveResult = updateFunc(newValue);
     if (!saveResult.isSuccess()) {
-      logger.error(F("ConfigM"), String(F("Fehler beim persistenten Speichern von ")) + notifyKey +
-                                     F(": ") + saveResult.getMessage());
+      logger.error(F("ConfigM"), String(F("Fehler beim persistenten Speichern von ")) +
+                                     ConfigKeys::getName(notifyKey) + F(": ") +
+                                     saveResult.getMessage());
       return ConfigResult::fail(ConfigError::SAVE_FAILED, saveResult.getMessage());
     }
 
-    notifyConfigChange(notifyKey, newValue ? "true" : "false", updateSensors);
+    notifyConfigChange(notifyKey, ConfigValue::fromBool(newValue), updateSensors);
   }
   return ConfigResult::success();
 }
@@ -691,7 +887,7 @@ ConfigManager::ConfigResult ConfigManager::updateBoolConfig(bool& currentValue,
 ConfigManager::ConfigResult ConfigManager::updateStringConfig(String& currentValue,
                                                               const String& newValue,
                                                               StringUpdateFunc updateFunc,
-                                                              const String& notifyKey,
+                                                              ConfigKey notifyKey,
                                                               bool updateSensors) {
 
   if (currentValue != newValue) {
@@ -700,12 +896,13 @@ ConfigManager::ConfigResult ConfigManager::updateStringConfig(String& currentVal
     // Persist atomically to Preferences
     auto saveResult = updateFunc(newValue);
     if (!saveResult.isSuccess()) {
-      logger.error(F("ConfigM"), String(F("Fehler beim persistenten Speichern von ")) + notifyKey +
-                                     F(": ") + saveResult.getMessage());
+      logger.error(F("ConfigM"), String(F("Fehler beim persistenten Speichern von ")) +
+                                     ConfigKeys::getName(notifyKey) + F(": ") +
+                                     saveResult.getMessage());
       return ConfigResult::fail(ConfigError::SAVE_FAILED, saveResult.getMessage());
     }
 
-    notifyConfigChange(notifyKey, newValue, updateSensors);
+    notifyConfigChange(notifyKey, ConfigValue::fromString(newValue), updateSensors);
   }
   return ConfigResult::success();
 }
@@ -713,7 +910,7 @@ ConfigManager::ConfigResult ConfigManager::updateStringConfig(String& currentVal
 ConfigManager::ConfigResult ConfigManager::updateUInt8Config(uint8_t& currentValue,
                                                              uint8_t newValue,
                                                              UInt8UpdateFunc updateFunc,
-                                                             const String& notifyKey,
+                                                             ConfigKey notifyKey,
                                                              bool updateSensors) {
 
   if (currentValue != newValue) {
@@ -722,12 +919,13 @@ ConfigManager::ConfigResult ConfigManager::updateUInt8Config(uint8_t& currentVal
     // Persist atomically to Preferences
     auto saveResult = updateFunc(newValue);
     if (!saveResult.isSuccess()) {
-      logger.error(F("ConfigM"), String(F("Fehler beim persistenten Speichern von ")) + notifyKey +
-                                     F(": ") + saveResult.getMessage());
+      logger.error(F("ConfigM"), String(F("Fehler beim persistenten Speichern von ")) +
+                                     ConfigKeys::getName(notifyKey) + F(": ") +
+                                     saveResult.getMessage());
       return ConfigResult::fail(ConfigError::SAVE_FAILED, saveResult.getMessage());
     }
 
-    notifyConfigChange(notifyKey, String(newValue), updateSensors);
+    notifyConfigChange(notifyKey, ConfigValue::fromUInt(newValue), updateSensors);
   }
   return ConfigResult::success();
 }
@@ -796,7 +994,7 @@ ConfigManager::ConfigResult ConfigManager::setDeviceName(const String& name) {
         return PreferencesManager::updateStringValue(PreferencesNamespaces::GENERAL, "device_name",
                                                      val);
       },
-      "device_name", false);
+      ConfigKey::DEVICE_NAME, false);
 }
 
 ConfigManager::ConfigResult ConfigManager::setFlowerStatusSensor(const String& sensorId) {
@@ -806,7 +1004,7 @@ ConfigManager::ConfigResult ConfigManager::setFlowerStatusSensor(const String& s
         return PreferencesManager::updateStringValue(PreferencesNamespaces::GENERAL, "flower_sens",
                                                      val);
       },
-      "flower_status_sensor", false);
+      ConfigKey::FLOWER_STATUS_SENSOR, false);
 }
 
 ConfigManager::ConfigResult ConfigManager::setLedTrafficLightMode(uint8_t mode) {
@@ -816,7 +1014,7 @@ ConfigManager::ConfigResult ConfigManager::setLedTrafficLightMode(uint8_t mode)
         return PreferencesManager::updateUInt8Value(PreferencesNamespaces::LED_TRAFFIC, "mode",
                                                     val);
       },
-      "led_traffic_light_mode", false);
+      ConfigKey::LED_MODE, false);
 }
 
 ConfigManager::ConfigResult
@@ -827,7 +1025,7 @@ ConfigManager::setLedTrafficLightSelectedMeasurement(const String& measurementId
         return PreferencesManager::updateStringValue(PreferencesNamespaces::LED_TRAFFIC, "sel_meas",
                                                      val);
       },
-      "led_traffic_light_selected_measurement", false);
+      ConfigKey::LED_SELECTED_MEASUREMENT, false);
 }
 
 // ====== Simplified Setters Using DRY Helpers (defined at end of file) ======
@@ -11,11 +11,14 @@
 #include <Arduino.h>
 #include <ESP8266WebServer.h>
 
+#include <vector>
+
 #include "../configs/config_pflanzensensor.h"
 #include "../utils/critical_section.h"
 #include "../utils/result_types.h"
 #include "../web/handler/web_ota_handler.h"
 #include "manager_config_debug.h"
+#include "manager_config_keys.h"
 #include "manager_config_notifier.h"
 #include "manager_config_persistence.h"
 #include "manager_config_preferences.h"
@@ -24,6 +27,12 @@
 #include "manager_config_validator.h"
 #include "manager_config_web_handler.h"
 
+// Check if CONFIG_BATCH_MAX_ENTRIES is defined
+#ifndef CONFIG_BATCH_MAX_ENTRIES
+#define CONFIG_BATCH_MAX_ENTRIES 32
+#warning "CONFIG_BATCH_MAX_ENTRIES not defined in config file, defaulting to 32 entries"
+#endif
+
 // Forward declarations
 class ResourceManager;
 class SensorManager;
@@ -129,6 +138,33 @@ public:
   ConfigResult setConfigValue(const String& namespaceName, const String& key, const String& value,
                               ConfigValueType type);
 
+  /**
+   * @brief One entry of a batched configuration update
+   */
+  struct ConfigUpdate {
+    String namespaceName;                          ///< e.g. "general" or "s_ANALOG_1"
+    String key;                                    ///< Key within the namespace
+    String value;                                  ///< Value as sent by the web interface
+    ConfigValueType type{ConfigValueType::STRING}; ///< Type for sensor namespaces
+  };
+
+  /**
+   * @brief Set several configuration values as one update
+   * @details All entries are resolved and validated before the first one is
+   *          applied; an invalid entry rejects the whole batch. The entries
+   *          are applied under one lock, every touched Preferences namespace
+   *          is written once and listeners are notified once per changed key
+   *          after the last entry. Sensor namespaces are written first, with
+   *          their previous values kept; the fixed namespaces are committed
+   *          last. If any step fails, the sensor values are written back, the
+   *          fixed namespaces and the RAM configuration get their previous
+   *          values and no listener is notified. Only a filesystem error while
+   *          undoing can leave part of the batch stored; it is logged.
+   * @param updates Entries to apply; a later entry for the same key wins
+   * @return Result of the set operation
+   */
+  ConfigResult setConfigValues(const std::vector<ConfigUpdate>& updates);
+
   // Main configuration getters
   /**
    * @brief Get the current admin password
@@ -157,6 +193,7 @@ public:
   /**
    * @brief Check if a firmware upgrade is scheduled
    * @return True if a firmware upgrade is pending
+   * @details Served from RAM; /update_flags.txt is only read once per boot.
    */
   bool getDoFirmwareUpgrade();
 
@@ -319,6 +356,15 @@ public:
    */
   void addChangeCallback(ConfigNotifier::ChangeCallback callback);
 
+  /**
+   * @brief Subscribe to changes of a single configuration key
+   * @details Setters notify while their ScopedLock holds interrupts off, so a
+   *          callback should only record the change and act on it later.
+   * @param key Typed key to watch
+   * @param callback Invoked with the typed new value
+   */
+  void subscribeConfigKey(ConfigKey key, ConfigNotifier::KeyCallback callback);
+
   // Dependencies
   /**
    * @brief Set the SensorManager instance
@@ -340,7 +386,7 @@ public:
         [](const String& val) {
           return PreferencesManager::updateStringValue(PreferencesNamespaces::WIFI1, "ssid", val);
         },
-        "wifi_ssid_1", false);
+        ConfigKey::WIFI_SSID_1, false);
   }
   /**
    * @brief Get WiFi Password 1
@@ -356,7 +402,7 @@ public:
         [](const String& val) {
           return PreferencesManager::updateStringValue(PreferencesNamespaces::WIFI1, "pwd", val);
         },
-        "wifi_pwd_1", false);
+        ConfigKey::WIFI_PASSWORD_1, false);
   }
   /**
    * @brief Get WiFi SSID 2
@@ -372,7 +418,7 @@ public:
         [](const String& val) {
           return PreferencesManager::updateStringValue(PreferencesNamespaces::WIFI2, "ssid", val);
         },
-        "wifi_ssid_2", false);
+        ConfigKey::WIFI_SSID_2, false);
   }
   /**
    * @brief Get WiFi Password 2
@@ -388,7 +434,7 @@ public:
         [](const String& val) {
           return PreferencesManager::updateStringValue(PreferencesNamespaces::WIFI2, "pwd", val);
         },
-        "wifi_pwd_2", false);
+        ConfigKey::WIFI_PASSWORD_2, false);
   }
   /**
    * @brief Get WiFi SSID 3
@@ -404,7 +450,7 @@ public:
         [](const String& val) {
           return PreferencesManager::updateStringValue(PreferencesNamespaces::WIFI3, "ssid", val);
         },
-        "wifi_ssid_3", false);
+        ConfigKey::WIFI_SSID_3, false);
   }
   /**
    * @brief Get WiFi Password 3
@@ -420,7 +466,7 @@ public:
         [](const String& val) {
           return PreferencesManager::updateStringValue(PreferencesNamespaces::WIFI3, "pwd", val);
         },
-        "wifi_pwd_3", false);
+        ConfigKey::WIFI_PASSWORD_3, false);
   }
 
   // LED Traffic Light configuration
@@ -486,6 +532,23 @@ private:
   SensorManager* m_sensorManager = nullptr;
   bool m_configLoaded = false;
 
+  // RAM copy of /update_flags.txt; read once, then kept in sync by the setters
+  mutable bool m_updateFlagsLoaded = false;
+  mutable bool m_fileSystemUpdatePending = false;
+  mutable bool m_firmwareUpdatePending = false;
+
+  /**
+   * @brief Read the update flags from the filesystem on first use
+   */
+  void loadUpdateFlags() const;
+
+  /**
+   * @brief Persist the update flags and update the RAM copy
+   * @param fileSystem Filesystem update pending
+   * @param firmware Firmware update pending
+   */
+  void storeUpdateFlags(bool fileSystem, bool firmware);
+
   /**
    * @brief Generic helper to update a boolean config value atomically
    * @param currentValue Reference to the current value in RAM
@@ -497,7 +560,7 @@ private:
    */
   using BoolUpdateFunc = PreferencesManager::PrefResult (*)(bool);
   ConfigResult updateBoolConfig(bool& currentValue, bool newValue, BoolUpdateFunc updateFunc,
-                                const String& notifyKey, bool updateSensors = false);
+                                ConfigKey notifyKey, bool updateSensors = false);
 
   /**
    * @brief Generic helper to update a string config value atomically
@@ -510,7 +573,7 @@ private:
    */
   using StringUpdateFunc = PreferencesManager::PrefResult (*)(const String&);
   ConfigResult updateStringConfig(String& currentValue, const String& newValue,
-                                  StringUpdateFunc updateFunc, const String& notifyKey,
+                                  StringUpdateFunc updateFunc, ConfigKey notifyKey,
                                   bool updateSensors = false);
 
   /**
@@ -524,7 +587,7 @@ private:
    */
   using UInt8UpdateFunc = PreferencesManager::PrefResult (*)(uint8_t);
   ConfigResult updateUInt8Config(uint8_t& currentValue, uint8_t newValue,
-                                 UInt8UpdateFunc updateFunc, const String& notifyKey,
+                                 UInt8UpdateFunc updateFunc, ConfigKey notifyKey,
                                  bool updateSensors = false);
 
   /**
@@ -545,6 +608,72 @@ private:
    */
   void notifyConfigChange(const String& key, const String& value, bool updateSensors = true);
 
+  /**
+   * @brief Notify listeners of a change of a typed configuration key
+   * @param key The typed key of the changed configuration
+   * @param value The new typed value
+   * @param updateSensors Whether to update sensor settings
+   */
+  void notifyConfigChange(ConfigKey key, const ConfigValue& value, bool updateSensors = true);
+
+  /**
+   * @brief Parse, validate and apply a value sent as text
+   * @param key Typed key
+   * @param text Value text
+   * @return Result of the operation
+   */
+  ConfigResult setConfigText(ConfigKey key, const String& text);
+
+  /**
+   * @brief Check a parsed value against its key's rules and references
+   * @details Besides ConfigKeys::validate(), measurement selections must name
+   *          a registered sensor and a valid measurement index.
+   * @param key Typed key
+   * @param value Parsed value
+   * @return Result of the validation
+   */
+  ConfigResult validateConfigValue(ConfigKey key, const ConfigValue& value) const;
+
+  /**
+   * @brief Check an entry for a sensor namespace before it is written
+   * @param update Entry with an s_* namespace
+   * @return Result of the validation
+   */
+  static ConfigResult validateSensorUpdate(const ConfigUpdate& update);
+
+  /**
+   * @brief Dispatch a validated value to the setter of its key
+   * @param key Typed key
+   * @param value Validated value
+   * @return Result of the operation
+   */
+  ConfigResult applyConfigValue(ConfigKey key, const ConfigValue& value);
+
+  /**
+   * @brief Store a WiFi SSID or password
+   * @param key One of the WIFI_* keys
+   * @param value New SSID or password
+   * @return Result of the operation
+   */
+  ConfigResult setWiFiValue(ConfigKey key, const String& value);
+
+  /**
+   * @brief Store a display setting and reload the display configuration
+   * @param key One of the DISPLAY_* keys
+   * @param value Validated value
+   * @return Result of the operation
+   */
+  ConfigResult setDisplayValue(ConfigKey key, const ConfigValue& value);
+
+  /**
+   * @brief Write values into a sensor namespace (s_SENSORID)
+   * @param namespaceName Sensor namespace
+   * @param updates Entries of that namespace, written in one Preferences session
+   * @return Result of the operation
+   */
+  ConfigResult setSensorValues(const String& namespaceName,
+                               const std::vector<const ConfigUpdate*>& updates);
+
   /**
    * @brief Validate and save configuration
    * @return Result of the validate and save operation
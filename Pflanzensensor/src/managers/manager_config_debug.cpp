@@ -13,7 +13,7 @@ DebugConfig::DebugConfig(ConfigNotifier& notifier) : m_notifier(notifier) {}
 DebugConfig::DebugResult DebugConfig::setRAMDebug(bool enabled) {
   if (m_debugRAM != enabled) {
     m_debugRAM = enabled;
-    m_notifier.notifyChange("debug_ram", enabled ? "true" : "false", false);
+    m_notifier.notifyChange(ConfigKey::DEBUG_RAM, ConfigValue::fromBool(enabled), false);
     logger.info(F("DebugCfg"),
                 String(F("RAM-Debug gesetzt: ")) + (enabled ? F("true") : F("false")));
   }
@@ -23,7 +23,8 @@ DebugConfig::DebugResult DebugConfig::setRAMDebug(bool enabled) {
 DebugConfig::DebugResult DebugConfig::setMeasurementCycleDebug(bool enabled) {
   if (m_debugMeasurementCycle != enabled) {
     m_debugMeasurementCycle = enabled;
-    m_notifier.notifyChange("debug_measurement_cycle", enabled ? "true" : "false", false);
+    m_notifier.notifyChange(ConfigKey::DEBUG_MEASUREMENT_CYCLE, ConfigValue::fromBool(enabled),
+                            false);
     logger.info(F("DebugCfg"),
                 String(F("Messzyklus-Debug gesetzt: ")) + (enabled ? F("true") : F("false")));
   }
@@ -36,7 +37,7 @@ DebugConfig::DebugResult DebugConfig::setSensorDebug(bool enabled) {
     // When sensor debug flag changes we want to propagate changes to sensors
     logger.info(F("DebugCfg"),
                 String(F("Sensor-Debug gesetzt: ")) + (enabled ? F("true") : F("false")));
-    m_notifier.notifyChange("debug_sensor", enabled ? "true" : "false", true);
+    m_notifier.notifyChange(ConfigKey::DEBUG_SENSOR, ConfigValue::fromBool(enabled), true);
   }
   return DebugResult::success();
 }
@@ -44,7 +45,7 @@ DebugConfig::DebugResult DebugConfig::setSensorDebug(bool enabled) {
 DebugConfig::DebugResult DebugConfig::setDisplayDebug(bool enabled) {
   if (m_debugDisplay != enabled) {
     m_debugDisplay = enabled;
-    m_notifier.notifyChange("debug_display", enabled ? "true" : "false", false);
+    m_notifier.notifyChange(ConfigKey::DEBUG_DISPLAY, ConfigValue::fromBool(enabled), false);
     logger.info(F("DebugCfg"),
                 String(F("Display-Debug gesetzt: ")) + (enabled ? F("true") : F("false")));
   }
@@ -54,7 +55,7 @@ DebugConfig::DebugResult DebugConfig::setDisplayDebug(bool enabled) {
 DebugConfig::DebugResult DebugConfig::setWebSocketDebug(bool enabled) {
   if (m_debugWebSocket != enabled) {
     m_debugWebSocket = enabled;
-    m_notifier.notifyChange("debug_websocket", enabled ? "true" : "false", false);
+    m_notifier.notifyChange(ConfigKey::DEBUG_WEBSOCKET, ConfigValue::fromBool(enabled), false);
     logger.info(F("DebugCfg"),
                 String(F("WebSocket-Debug gesetzt: ")) + (enabled ? F("true") : F("false")));
   }
@@ -0,0 +1,305 @@
+/**
+ * @file manager_config_keys.cpp
+ * @brief Implementation of the typed configuration key table
+ */
+
+#include "manager_config_keys.h"
+
+#include "configs/config_validation_rules.h"
+#include "manager_config_validator.h"
+
+namespace {
+
+using Validator = ConfigKeys::ValidationResult (*)(const String&);
+
+/**
+ * @brief Static description of one configuration key
+ */
+struct KeyInfo {
+  PGM_P name;           ///< Qualified name "namespace.key"
+  ConfigValueType type; ///< Value type
+  uint32_t minValue;    ///< Smallest number, or shortest string
+  uint32_t maxValue;    ///< Largest number, or longest string
+  Validator validator;  ///< Additional check for strings, may be nullptr
+};
+
+const char NAME_DEBUG_DISPLAY[] PROGMEM = "debug.display";
+const char NAME_DEBUG_MEAS_CYCLE[] PROGMEM = "debug.meas_cycle";
+const char NAME_DEBUG_RAM[] PROGMEM = "debug.ram";
+const char NAME_DEBUG_SENSOR[] PROGMEM = "debug.sensor";
+const char NAME_DEBUG_WEBSOCKET[] PROGMEM = "debug.websocket";
+const char NAME_DISPLAY_CLOCK_FMT[] PROGMEM = "display.clock_fmt";
+const char NAME_DISPLAY_SCREEN_DUR[] PROGMEM = "display.screen_dur";
+const char NAME_DISPLAY_SHOW_CLOCK[] PROGMEM = "display.show_clock";
+const char NAME_DISPLAY_SHOW_FABMOBIL[] PROGMEM = "display.show_fabmobil";
+const char NAME_DISPLAY_SHOW_FLOWER[] PROGMEM = "display.show_flower";
+const char NAME_DISPLAY_SHOW_IP[] PROGMEM = "display.show_ip";
+const char NAME_DISPLAY_SHOW_QR[] PROGMEM = "display.show_qr";
+const char NAME_GENERAL_ADMIN_PWD[] PROGMEM = "general.admin_pwd";
+const char NAME_GENERAL_COLLECTD[] PROGMEM = "general.collectd_enabled";
+const char NAME_GENERAL_DEVICE_NAME[] PROGMEM = "general.device_name";
+const char NAME_GENERAL_FILE_LOG[] PROGMEM = "general.file_log";
+const char NAME_GENERAL_FLOWER_SENS[] PROGMEM = "general.flower_sens";
+const char NAME_GENERAL_MD5_VERIFY[] PROGMEM = "general.md5_verify";
+const char NAME_LED_MODE[] PROGMEM = "led_traf.mode";
+const char NAME_LED_SEL_MEAS[] PROGMEM = "led_traf.sel_meas";
+const char NAME_LOG_FILE_ENABLED[] PROGMEM = "log.file_enabled";
+const char NAME_LOG_LEVEL[] PROGMEM = "log.level";
+const char NAME_WIFI_PWD1[] PROGMEM = "wifi.pwd1";
+const char NAME_WIFI_PWD2[] PROGMEM = "wifi.pwd2";
+const char NAME_WIFI_PWD3[] PROGMEM = "wifi.pwd3";
+const char NAME_WIFI_SSID1[] PROGMEM = "wifi.ssid1";
+const char NAME_WIFI_SSID2[] PROGMEM = "wifi.ssid2";
+const char NAME_WIFI_SSID3[] PROGMEM = "wifi.ssid3";
+
+constexpr uint32_t MAX_NAME_LENGTH = 63; // Device and measurement names
+constexpr uint32_t MAX_SSID_LENGTH = 32; // IEEE 802.11
+constexpr uint32_t MAX_WIFI_PWD_LENGTH = 64;
+
+// Sorted by name; the position is the ConfigKey value
+const KeyInfo KEY_TABLE[] PROGMEM = {
+    {NAME_DEBUG_DISPLAY, ConfigValueType::BOOL, 0, 1, nullptr},
+    {NAME_DEBUG_MEAS_CYCLE, ConfigValueType::BOOL, 0, 1, nullptr},
+    {NAME_DEBUG_RAM, ConfigValueType::BOOL, 0, 1, nullptr},
+    {NAME_DEBUG_SENSOR, ConfigValueType::BOOL, 0, 1, nullptr},
+    {NAME_DEBUG_WEBSOCKET, ConfigValueType::BOOL, 0, 1, nullptr},
+    {NAME_DISPLAY_CLOCK_FMT, ConfigValueType::STRING, 3, 3, &ConfigValidator::validateClockFormat},
+    {NAME_DISPLAY_SCREEN_DUR, ConfigValueType::UINT, 1000, 60000, nullptr},
+    {NAME_DISPLAY_SHOW_CLOCK, ConfigValueType::BOOL, 0, 1, nullptr},
+    {NAME_DISPLAY_SHOW_FABMOBIL, ConfigValueType::BOOL, 0, 1, nullptr},
+    {NAME_DISPLAY_SHOW_FLOWER, ConfigValueType::BOOL, 0, 1, nullptr},
+    {NAME_DISPLAY_SHOW_IP, ConfigValueType::BOOL, 0, 1, nullptr},
+    {NAME_DISPLAY_SHOW_QR, ConfigValueType::BOOL, 0, 1, nullptr},
+    {NAME_GENERAL_ADMIN_PWD, ConfigValueType::STRING, ConfigValidationRules::MIN_PASSWORD_LENGTH,
+     ConfigValidationRules::MAX_PASSWORD_LENGTH, &ConfigValidator::validatePassword},
+    {NAME_GENERAL_COLLECTD, ConfigValueType::BOOL, 0, 1, nullptr},
+    {NAME_GENERAL_DEVICE_NAME, ConfigValueType::STRING, 1, MAX_NAME_LENGTH, nullptr},
+    {NAME_GENERAL_FILE_LOG, ConfigValueType::BOOL, 0, 1, nullptr},
+    {NAME_GENERAL_FLOWER_SENS, ConfigValueType::STRING, 0, MAX_NAME_LENGTH, nullptr},
+    {NAME_GENERAL_MD5_VERIFY, ConfigValueType::BOOL, 0, 1, nullptr},
+    {NAME_LED_MODE, ConfigValueType::UINT, 0, 2, nullptr},
+    {NAME_LED_SEL_MEAS, ConfigValueType::STRING, 0, MAX_NAME_LENGTH, nullptr},
+    {NAME_LOG_FILE_ENABLED, ConfigValueType::BOOL, 0, 1, nullptr},
+    {NAME_LOG_LEVEL, ConfigValueType::STRING, 4, 7, &ConfigValidator::validateLogLevel},
+    {NAME_WIFI_PWD1, ConfigValueType::STRING, 0, MAX_WIFI_PWD_LENGTH, nullptr},
+    {NAME_WIFI_PWD2, ConfigValueType::STRING, 0, MAX_WIFI_PWD_LENGTH, nullptr},
+    {NAME_WIFI_PWD3, ConfigValueType::STRING, 0, MAX_WIFI_PWD_LENGTH, nullptr},
+    {NAME_WIFI_SSID1, ConfigValueType::STRING, 0, MAX_SSID_LENGTH, nullptr},
+    {NAME_WIFI_SSID2, ConfigValueType::STRING, 0, MAX_SSID_LENGTH, nullptr},
+    {NAME_WIFI_SSID3, ConfigValueType::STRING, 0, MAX_SSID_LENGTH, nullptr},
+};
+static_assert(sizeof(KEY_TABLE) / sizeof(KEY_TABLE[0]) == static_cast<size_t>(ConfigKey::COUNT),
+              "KEY_TABLE and ConfigKey are out of sync");
+
+/**
+ * @brief Key name of the legacy flat API
+ */
+struct LegacyName {
+  PGM_P name;
+  ConfigKey key;
+};
+
+const char LEGACY_ADMIN_PASSWORD[] PROGMEM = "admin_password";
+const char LEGACY_COLLECTD_ENABLED[] PROGMEM = "collectd_enabled";
+const char LEGACY_DEBUG_DISPLAY[] PROGMEM = "debug_display";
+const char LEGACY_DEBUG_MEAS_CYCLE[] PROGMEM = "debug_measurement_cycle";
+const char LEGACY_DEBUG_RAM[] PROGMEM = "debug_ram";
+const char LEGACY_DEBUG_SENSOR[] PROGMEM = "debug_sensor";
+const char LEGACY_DEBUG_WEBSOCKET[] PROGMEM = "debug_websocket";
+const char LEGACY_FILE_LOGGING[] PROGMEM = "file_logging_enabled";
+const char LEGACY_LOG_LEVEL[] PROGMEM = "log_level";
+const char LEGACY_MD5_VERIFICATION[] PROGMEM = "md5_verification";
+
+// Sorted by name
+const LegacyName LEGACY_TABLE[] PROGMEM = {
+    {LEGACY_ADMIN_PASSWORD, ConfigKey::ADMIN_PASSWORD},
+    {LEGACY_COLLECTD_ENABLED, ConfigKey::COLLECTD_ENABLED},
+    {LEGACY_DEBUG_DISPLAY, ConfigKey::DEBUG_DISPLAY},
+    {LEGACY_DEBUG_MEAS_CYCLE, ConfigKey::DEBUG_MEASUREMENT_CYCLE},
+    {LEGACY_DEBUG_RAM, ConfigKey::DEBUG_RAM},
+    {LEGACY_DEBUG_SENSOR, ConfigKey::DEBUG_SENSOR},
+    {LEGACY_DEBUG_WEBSOCKET, ConfigKey::DEBUG_WEBSOCKET},
+    {LEGACY_FILE_LOGGING, ConfigKey::FILE_LOGGING},
+    {LEGACY_LOG_LEVEL, ConfigKey::LOG_LEVEL},
+    {LEGACY_MD5_VERIFICATION, ConfigKey::MD5_VERIFICATION},
+};
+
+KeyInfo readKeyInfo(ConfigKey key) {
+  KeyInfo info;
+  memcpy_P(&info, &KEY_TABLE[static_cast<size_t>(key)], sizeof(info));
+  return info;
+}
+
+// Compare a PROGMEM name with the concatenation of parts, without building a String
+int compareName(PGM_P name, const char* const* parts, size_t partCount) {
+  for (size_t i = 0; i < partCount; i++) {
+    for (const char* part = parts[i]; *part; part++, name++) {
+      uint8_t c = pgm_read_byte(name);
+      if (c != static_cast<uint8_t>(*part)) {
+        return static_cast<int>(c) - static_cast<uint8_t>(*part);
+      }
+    }
+  }
+  return pgm_read_byte(name);
+}
+
+bool isValidKey(ConfigKey key) { return key < ConfigKey::COUNT; }
+
+} // namespace
+
+ConfigValue ConfigValue::fromBool(bool value) {
+  ConfigValue result;
+  result.type = ConfigValueType::BOOL;
+  result.boolValue = value;
+  return result;
+}
+
+ConfigValue ConfigValue::fromUInt(uint32_t value) {
+  ConfigValue result;
+  result.type = ConfigValueType::UINT;
+  result.uintValue = value;
+  return result;
+}
+
+ConfigValue ConfigValue::fromString(const String& value) {
+  ConfigValue result;
+  result.type = ConfigValueType::STRING;
+  result.stringValue = value;
+  return result;
+}
+
+String ConfigValue::toString() const {
+  switch (type) {
+  case ConfigValueType::BOOL:
+    return boolValue ? F("true") : F("false");
+  case ConfigValueType::UINT:
+    return String(uintValue);
+  default:
+    return stringValue;
+  }
+}
+
+ConfigKey ConfigKeys::find(const String& namespaceName, const String& key) {
+  const char* parts[] = {namespaceName.c_str(), ".", key.c_str()};
+  size_t low = 0;
+  size_t high = static_cast<size_t>(ConfigKey::COUNT);
+  while (low < high) {
+    size_t mid = (low + high) / 2;
+    int cmp = compareName(readKeyInfo(static_cast<ConfigKey>(mid)).name, parts, 3);
+    if (cmp == 0) {
+      return static_cast<ConfigKey>(mid);
+    }
+    if (cmp < 0) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return ConfigKey::INVALID;
+}
+
+ConfigKey ConfigKeys::findLegacy(const String& key) {
+  const char* parts[] = {key.c_str()};
+  size_t low = 0;
+  size_t high = sizeof(LEGACY_TABLE) / sizeof(LEGACY_TABLE[0]);
+  while (low < high) {
+    size_t mid = (low + high) / 2;
+    LegacyName entry;
+    memcpy_P(&entry, &LEGACY_TABLE[mid], sizeof(entry));
+    int cmp = compareName(entry.name, parts, 1);
+    if (cmp == 0) {
+      return entry.key;
+    }
+    if (cmp < 0) {
+      low = mid + 1;
+    } else {
+      high = mid;
+    }
+  }
+  return ConfigKey::INVALID;
+}
+
+String ConfigKeys::getName(ConfigKey key) {
+  if (!isValidKey(key)) {
+    return String();
+  }
+  return String(FPSTR(readKeyInfo(key).name));
+}
+
+ConfigValueType ConfigKeys::getType(ConfigKey key) {
+  if (!isValidKey(key)) {
+    return ConfigValueType::STRING;
+  }
+  return readKeyInfo(key).type;
+}
+
+bool ConfigKeys::parse(ConfigKey key, const String& text, ConfigValue& value) {
+  if (!isValidKey(key)) {
+    return false;
+  }
+  switch (getType(key)) {
+  case ConfigValueType::BOOL:
+    if (text == "true" || text == "1") {
+      value = ConfigValue::fromBool(true);
+    } else if (text == "false" || text == "0") {
+      value = ConfigValue::fromBool(false);
+    } else {
+      return false;
+    }
+    return true;
+  case ConfigValueType::UINT: {
+    // Up to 9 digits so the value cannot overflow uint32_t
+    if (text.length() == 0 || text.length() > 9) {
+      return false;
+    }
+    uint32_t number = 0;
+    for (size_t i = 0; i < text.length(); i++) {
+      if (!isdigit(static_cast<unsigned char>(text[i]))) {
+        return false;
+      }
+      number = number * 10 + (text[i] - '0');
+    }
+    value = ConfigValue::fromUInt(number);
+    return true;
+  }
+  default:
+    value = ConfigValue::fromString(text);
+    return true;
+  }
+}
+
+ConfigKeys::ValidationResult ConfigKeys::validate(ConfigKey key, const ConfigValue& value) {
+  if (!isValidKey(key)) {
+    return ValidationResult::fail(ConfigError::VALIDATION_ERROR, F("Unbekannter Schlüssel"));
+  }
+  KeyInfo info = readKeyInfo(key);
+  if (value.type != info.type) {
+    return ValidationResult::fail(ConfigError::VALIDATION_ERROR,
+                                  F("Falscher Werttyp für ") + getName(key));
+  }
+
+  if (info.type == ConfigValueType::UINT &&
+      (value.uintValue < info.minValue || value.uintValue > info.maxValue)) {
+    return ValidationResult::fail(ConfigError::VALIDATION_ERROR,
+                                  getName(key) + F(" muss zwischen ") + String(info.minValue) +
+                                      F(" und ") + String(info.maxValue) + F(" liegen"));
+  }
+  if (info.type == ConfigValueType::STRING) {
+    if (info.validator) {
+      return info.validator(value.stringValue);
+    }
+    if (value.stringValue.length() < info.minValue ||
+        value.stringValue.length() > info.maxValue) {
+      return ValidationResult::fail(ConfigError::VALIDATION_ERROR,
+                                    getName(key) + F(" muss zwischen ") + String(info.minValue) +
+                                        F(" und ") + String(info.maxValue) +
+                                        F(" Zeichen lang sein"));
+    }
+  }
+  return ValidationResult::success();
+}
+
+bool ConfigKeys::isSecret(ConfigKey key) {
+  return key == ConfigKey::ADMIN_PASSWORD || key == ConfigKey::WIFI_PASSWORD_1 ||
+         key == ConfigKey::WIFI_PASSWORD_2 || key == ConfigKey::WIFI_PASSWORD_3;
+}
@@ -0,0 +1,144 @@
+/**
+ * @file manager_config_keys.h
+ * @brief Compile-time table of typed configuration keys
+ * @details Every setting of the fixed Preferences namespaces is listed once
+ *          with its qualified name ("namespace.key"), value type and bounds.
+ *          The names live in PROGMEM and the table is sorted by name, so a
+ *          name is resolved by a binary search and the setting is then
+ *          dispatched by a switch over ConfigKey instead of a chain of String
+ *          compares.
+ */
+
+#ifndef MANAGER_CONFIG_KEYS_H
+#define MANAGER_CONFIG_KEYS_H
+
+#include <Arduino.h>
+
+#include "../utils/result_types.h"
+#include "manager_config_types.h"
+
+/**
+ * @enum ConfigKey
+ * @brief Typed configuration keys
+ * @note The order must match the name order of the key table in
+ *       manager_config_keys.cpp (sorted by qualified name).
+ */
+enum class ConfigKey : uint8_t {
+  DEBUG_DISPLAY,
+  DEBUG_MEASUREMENT_CYCLE,
+  DEBUG_RAM,
+  DEBUG_SENSOR,
+  DEBUG_WEBSOCKET,
+  DISPLAY_CLOCK_FORMAT,
+  DISPLAY_SCREEN_DURATION,
+  DISPLAY_SHOW_CLOCK,
+  DISPLAY_SHOW_FABMOBIL,
+  DISPLAY_SHOW_FLOWER,
+  DISPLAY_SHOW_IP,
+  DISPLAY_SHOW_QR,
+  ADMIN_PASSWORD,
+  COLLECTD_ENABLED,
+  DEVICE_NAME,
+  FILE_LOGGING,
+  FLOWER_STATUS_SENSOR,
+  MD5_VERIFICATION,
+  LED_MODE,
+  LED_SELECTED_MEASUREMENT,
+  LOG_FILE_ENABLED,
+  LOG_LEVEL,
+  WIFI_PASSWORD_1,
+  WIFI_PASSWORD_2,
+  WIFI_PASSWORD_3,
+  WIFI_SSID_1,
+  WIFI_SSID_2,
+  WIFI_SSID_3,
+  COUNT,         ///< Number of keys
+  INVALID = 0xFF ///< Unknown name
+};
+
+/**
+ * @brief Typed value of a configuration key
+ */
+struct ConfigValue {
+  ConfigValueType type{ConfigValueType::STRING};
+  bool boolValue{false};
+  uint32_t uintValue{0};
+  String stringValue;
+
+  static ConfigValue fromBool(bool value);
+  static ConfigValue fromUInt(uint32_t value);
+  static ConfigValue fromString(const String& value);
+
+  /**
+   * @brief Format the value the way the web interface sends it
+   * @return "true"/"false", the decimal number or the string
+   */
+  String toString() const;
+};
+
+/**
+ * @class ConfigKeys
+ * @brief Lookup, parsing and validation of typed configuration keys
+ */
+class ConfigKeys {
+public:
+  using ValidationResult = TypedResult<ConfigError, void>;
+
+  /**
+   * @brief Resolve a namespace and key as sent by the web interface
+   * @param namespaceName Namespace, e.g. "general" or "display"
+   * @param key Key within the namespace, e.g. "device_name"
+   * @return The typed key or ConfigKey::INVALID
+   */
+  static ConfigKey find(const String& namespaceName, const String& key);
+
+  /**
+   * @brief Resolve a key name of the legacy flat API ("debug_ram", "log_level", ...)
+   * @param key Legacy key name
+   * @return The typed key or ConfigKey::INVALID
+   */
+  static ConfigKey findLegacy(const String& key);
+
+  /**
+   * @brief Get the qualified name of a key
+   * @param key Typed key
+   * @return "namespace.key"
+   */
+  static String getName(ConfigKey key);
+
+  /**
+   * @brief Get the value type of a key
+   * @param key Typed key
+   * @return Value type
+   */
+  static ConfigValueType getType(ConfigKey key);
+
+  /**
+   * @brief Parse a value sent as text
+   * @param key Typed key that decides the value type
+   * @param text Value text ("true"/"1"/"false"/"0" for booleans)
+   * @param value Parsed value (output)
+   * @return true if the text is a valid value of the key's type
+   */
+  static bool parse(ConfigKey key, const String& text, ConfigValue& value);
+
+  /**
+   * @brief Check a value against the bounds and validator of its key
+   * @param key Typed key
+   * @param value Value to check
+   * @return ValidationResult indicating success or failure
+   */
+  static ValidationResult validate(ConfigKey key, const ConfigValue& value);
+
+  /**
+   * @brief Check whether a key holds a secret that must not be logged
+   * @param key Typed key
+   * @return true for passwords
+   */
+  static bool isSecret(ConfigKey key);
+
+private:
+  ConfigKeys() = default;
+};
+
+#endif // MANAGER_CONFIG_KEYS_H
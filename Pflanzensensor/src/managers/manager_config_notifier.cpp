@@ -5,20 +5,104 @@
 
 #include "manager_config_notifier.h"
 
+#include <algorithm>
+
 #include "../logger/logger.h"
 
 void ConfigNotifier::addChangeCallback(ChangeCallback callback) { m_callbacks.push_back(callback); }
 
+void ConfigNotifier::subscribe(ConfigKey key, KeyCallback callback) {
+  // Insert behind the existing subscribers of the key to keep registration order
+  auto it = std::upper_bound(
+      m_subscriptions.begin(), m_subscriptions.end(), key,
+      [](ConfigKey k, const Subscription& subscription) { return k < subscription.key; });
+  m_subscriptions.insert(it, Subscription{key, std::move(callback)});
+}
+
+void ConfigNotifier::notifyChange(ConfigKey key, const ConfigValue& value, bool updateSensors) {
+  if (m_batching) {
+    for (auto& pending : m_pendingKeys) {
+      if (pending.first == key) {
+        pending.second = value;
+        return;
+      }
+    }
+    m_pendingKeys.emplace_back(key, value);
+    return;
+  }
+  deliver(key, value);
+}
+
+void ConfigNotifier::deliver(ConfigKey key, const ConfigValue& value) {
+  auto it = std::lower_bound(
+      m_subscriptions.begin(), m_subscriptions.end(), key,
+      [](const Subscription& subscription, ConfigKey k) { return subscription.key < k; });
+  for (; it != m_subscriptions.end() && it->key == key; ++it) {
+    it->callback(key, value);
+  }
+
+  // Name and value strings are only built for untyped listeners
+  if (!m_callbacks.empty()) {
+    String name = ConfigKeys::getName(key);
+    String text = value.toString();
+    for (const auto& callback : m_callbacks) {
+      callback(name, text);
+    }
+  }
+}
+
 void ConfigNotifier::notifyChange(const String& key, const String& value, bool updateSensors) {
   // Note: Logging moved to ConfigManager::setConfigValue for consistency
   // All config changes are logged there with user-friendly German messages
-  
+
+  if (m_batching) {
+    for (auto& pending : m_pendingChanges) {
+      if (pending.key == key) {
+        pending.value = value;
+        return;
+      }
+    }
+    m_pendingChanges.push_back(PendingChange{key, value});
+    return;
+  }
+
   // Notify all registered callbacks
   for (const auto& callback : m_callbacks) {
     callback(key, value);
   }
 }
 
-void ConfigNotifier::clearCallbacks() { m_callbacks.clear(); }
+void ConfigNotifier::beginBatch() { m_batching = true; }
+
+void ConfigNotifier::endBatch() {
+  m_batching = false;
+  // Swap out first so a callback that changes the config again is not lost
+  std::vector<std::pair<ConfigKey, ConfigValue>> keys;
+  std::vector<PendingChange> changes;
+  keys.swap(m_pendingKeys);
+  changes.swap(m_pendingChanges);
+
+  for (const auto& pending : keys) {
+    deliver(pending.first, pending.second);
+  }
+  for (const auto& pending : changes) {
+    for (const auto& callback : m_callbacks) {
+      callback(pending.key, pending.value);
+    }
+  }
+}
+
+void ConfigNotifier::discardBatch() {
+  m_batching = false;
+  m_pendingKeys.clear();
+  m_pendingChanges.clear();
+}
+
+void ConfigNotifier::clearCallbacks() {
+  m_callbacks.clear();
+  m_subscriptions.clear();
+}
 
-size_t ConfigNotifier::getCallbackCount() const { return m_callbacks.size(); }
+size_t ConfigNotifier::getCallbackCount() const {
+  return m_callbacks.size() + m_subscriptions.size();
+}
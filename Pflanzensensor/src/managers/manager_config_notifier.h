@@ -9,11 +9,26 @@
 #include <Arduino.h>
 
 #include <functional>
+#include <utility>
 #include <vector>
 
+#include "manager_config_keys.h"
+
+/**
+ * @class ConfigNotifier
+ * @brief Dispatches configuration changes to subscribers
+ * @details Typed subscribers register for single ConfigKeys and receive the
+ *          typed value; only the subscribers of the changed key are called.
+ *          Callbacks added with addChangeCallback() receive every change as a
+ *          name/value string pair, including events without a ConfigKey
+ *          ("config loaded", update flags). Between beginBatch() and
+ *          endBatch() changes are collected, one entry per key, and delivered
+ *          together when the batch ends.
+ */
 class ConfigNotifier {
 public:
   using ChangeCallback = std::function<void(const String&, const String&)>;
+  using KeyCallback = std::function<void(ConfigKey, const ConfigValue&)>;
 
   /**
    * @brief Add a callback to be invoked on configuration changes
@@ -21,6 +36,21 @@ public:
    */
   void addChangeCallback(ChangeCallback callback);
 
+  /**
+   * @brief Subscribe to changes of a single key
+   * @param key The key to watch
+   * @param callback Called with the key and its new typed value
+   */
+  void subscribe(ConfigKey key, KeyCallback callback);
+
+  /**
+   * @brief Notify the subscribers of a typed key
+   * @param key The changed key
+   * @param value The new value
+   * @param updateSensors Whether to update sensor settings
+   */
+  void notifyChange(ConfigKey key, const ConfigValue& value, bool updateSensors = true);
+
   /**
    * @brief Notify all registered callbacks of a configuration change
    * @param key The key of the changed configuration
@@ -30,18 +60,57 @@ public:
   void notifyChange(const String& key, const String& value, bool updateSensors = true);
 
   /**
-   * @brief Clear all registered callbacks
+   * @brief Collect changes instead of delivering them right away
+   */
+  void beginBatch();
+
+  /**
+   * @brief Deliver the changes collected since beginBatch()
+   * @details A key changed several times in the batch is delivered once, with
+   *          its last value.
+   */
+  void endBatch();
+
+  /**
+   * @brief End a batch without delivering the collected changes
+   */
+  void discardBatch();
+
+  /**
+   * @brief Clear all registered callbacks and subscriptions
    */
   void clearCallbacks();
 
   /**
-   * @brief Get the number of registered callbacks
+   * @brief Get the number of registered callbacks and subscriptions
    * @return Number of registered callbacks
    */
   size_t getCallbackCount() const;
 
 private:
+  /**
+   * @brief Subscription of one callback to one key
+   */
+  struct Subscription {
+    ConfigKey key;
+    KeyCallback callback;
+  };
+
+  /**
+   * @brief Untyped change held back by a batch
+   */
+  struct PendingChange {
+    String key;
+    String value;
+  };
+
+  void deliver(ConfigKey key, const ConfigValue& value);
+
   std::vector<ChangeCallback> m_callbacks;
+  std::vector<Subscription> m_subscriptions; ///< Sorted by key
+  bool m_batching{false};
+  std::vector<std::pair<ConfigKey, ConfigValue>> m_pendingKeys;
+  std::vector<PendingChange> m_pendingChanges;
 };
 
 #endif
@@ -12,6 +12,7 @@ using namespace ArduinoJson;
 
 #include "../logger/logger.h"
 #include "../utils/critical_section.h"
+#include "../utils/file_io_queue.h"
 #include "managers/manager_config_preferences.h"
 #include "managers/manager_resource.h"
 #include "managers/manager_sensor.h"
@@ -57,66 +58,42 @@ ConfigPersistence::PersistenceResult ConfigPersistence::load(ConfigData& config)
   // Load from Preferences
   logger.info(F("ConfigP"), F("Lade Konfiguration aus Preferences..."));
 
-  // Load general settings directly using generic getters
-  Preferences generalPrefs;
-  if (generalPrefs.begin(PreferencesNamespaces::GENERAL, true)) {
-    config.deviceName = PreferencesManager::getString(generalPrefs, "device_name", DEVICE_NAME);
-    config.adminPassword = PreferencesManager::getString(generalPrefs, "admin_pwd", ADMIN_PASSWORD);
-    config.md5Verification = PreferencesManager::getBool(generalPrefs, "md5_verify", false);
-    config.fileLoggingEnabled =
-        PreferencesManager::getBool(generalPrefs, "file_log", FILE_LOGGING_ENABLED);
-    generalPrefs.end();
-  }
+  // Each namespace is read once into the Preferences cache, the getters below
+  // are then served from RAM
+  // Load general settings
+  config.deviceName =
+      PreferencesManager::getString(PreferencesNamespaces::GENERAL, "device_name", DEVICE_NAME);
+  config.adminPassword =
+      PreferencesManager::getString(PreferencesNamespaces::GENERAL, "admin_pwd", ADMIN_PASSWORD);
+  config.md5Verification =
+      PreferencesManager::getBool(PreferencesNamespaces::GENERAL, "md5_verify", false);
+  config.fileLoggingEnabled =
+      PreferencesManager::getBool(PreferencesNamespaces::GENERAL, "file_log", FILE_LOGGING_ENABLED);
+  config.flowerStatusSensor =
+      PreferencesManager::getString(PreferencesNamespaces::GENERAL, "flower_sens", "ANALOG_1");
 
   // Load WiFi settings from separate namespaces
-  Preferences wifi1Prefs;
-  if (wifi1Prefs.begin(PreferencesNamespaces::WIFI1, true)) {
-    config.wifiSSID1 = PreferencesManager::getString(wifi1Prefs, "ssid", "");
-    config.wifiPassword1 = PreferencesManager::getString(wifi1Prefs, "pwd", "");
-    wifi1Prefs.end();
-  }
-
-  Preferences wifi2Prefs;
-  if (wifi2Prefs.begin(PreferencesNamespaces::WIFI2, true)) {
-    config.wifiSSID2 = PreferencesManager::getString(wifi2Prefs, "ssid", "");
-    config.wifiPassword2 = PreferencesManager::getString(wifi2Prefs, "pwd", "");
-    wifi2Prefs.end();
-  }
-
-  Preferences wifi3Prefs;
-  if (wifi3Prefs.begin(PreferencesNamespaces::WIFI3, true)) {
-    config.wifiSSID3 = PreferencesManager::getString(wifi3Prefs, "ssid", "");
-    config.wifiPassword3 = PreferencesManager::getString(wifi3Prefs, "pwd", "");
-    wifi3Prefs.end();
-  }
-
-  // Load debug settings directly
-  Preferences debugPrefs;
-  if (debugPrefs.begin(PreferencesNamespaces::DEBUG, true)) {
-    config.debugRAM = PreferencesManager::getBool(debugPrefs, "ram", false);
-    config.debugMeasurementCycle = PreferencesManager::getBool(debugPrefs, "meas_cycle", false);
-    config.debugSensor = PreferencesManager::getBool(debugPrefs, "sensor", false);
-    config.debugDisplay = PreferencesManager::getBool(debugPrefs, "display", false);
-    config.debugWebSocket = PreferencesManager::getBool(debugPrefs, "websocket", false);
-    debugPrefs.end();
-  }
-
-  // Load LED traffic light settings directly
-  Preferences ledPrefs;
-  if (ledPrefs.begin(PreferencesNamespaces::LED_TRAFFIC, true)) {
-    config.ledTrafficLightMode = PreferencesManager::getUChar(ledPrefs, "mode", 0);
-    config.ledTrafficLightSelectedMeasurement =
-        PreferencesManager::getString(ledPrefs, "sel_meas", "");
-    ledPrefs.end();
-  }
-
-  // Load flower status sensor directly
-  Preferences flowerPrefs;
-  if (flowerPrefs.begin(PreferencesNamespaces::GENERAL, true)) {
-    config.flowerStatusSensor =
-        PreferencesManager::getString(flowerPrefs, "flower_sens", "ANALOG_1");
-    flowerPrefs.end();
-  }
+  config.wifiSSID1 = PreferencesManager::getString(PreferencesNamespaces::WIFI1, "ssid", "");
+  config.wifiPassword1 = PreferencesManager::getString(PreferencesNamespaces::WIFI1, "pwd", "");
+  config.wifiSSID2 = PreferencesManager::getString(PreferencesNamespaces::WIFI2, "ssid", "");
+  config.wifiPassword2 = PreferencesManager::getString(PreferencesNamespaces::WIFI2, "pwd", "");
+  config.wifiSSID3 = PreferencesManager::getString(PreferencesNamespaces::WIFI3, "ssid", "");
+  config.wifiPassword3 = PreferencesManager::getString(PreferencesNamespaces::WIFI3, "pwd", "");
+
+  // Load debug settings
+  config.debugRAM = PreferencesManager::getBool(PreferencesNamespaces::DEBUG, "ram", false);
+  config.debugMeasurementCycle =
+      PreferencesManager::getBool(PreferencesNamespaces::DEBUG, "meas_cycle", false);
+  config.debugSensor = PreferencesManager::getBool(PreferencesNamespaces::DEBUG, "sensor", false);
+  config.debugDisplay = PreferencesManager::getBool(PreferencesNamespaces::DEBUG, "display", false);
+  config.debugWebSocket =
+      PreferencesManager::getBool(PreferencesNamespaces::DEBUG, "websocket", false);
+
+  // Load LED traffic light settings
+  config.ledTrafficLightMode =
+      PreferencesManager::getUChar(PreferencesNamespaces::LED_TRAFFIC, "mode", 0);
+  config.ledTrafficLightSelectedMeasurement =
+      PreferencesManager::getString(PreferencesNamespaces::LED_TRAFFIC, "sel_meas", "");
 
   logger.info(F("ConfigP"), F("Konfiguration erfolgreich aus Preferences geladen"));
 
@@ -153,6 +130,11 @@ ConfigPersistence::PersistenceResult ConfigPersistence::resetToDefaults(ConfigDa
     }
   }
 
+  // Remove the measurement store that replaced those files
+  if (!SensorPersistence::clearMeasurementStore()) {
+    logger.warning(F("ConfigP"), F("Konnte Messungsspeicher nicht löschen"));
+  }
+
   logger.info(F("ConfigP"), F("Factory Reset abgeschlossen"));
   // Return success; caller (UI) will handle reboot
   return PersistenceResult::success();
@@ -162,6 +144,20 @@ ConfigPersistence::PersistenceResult ConfigPersistence::save(const ConfigData& c
   // Save to Preferences using atomic update functions
   logger.info(F("ConfigP"), F("Speichere Konfiguration in Preferences..."));
 
+  // Unchanged keys are skipped; the rest is committed once per namespace
+  PreferencesManager::beginBatch();
+  auto result = saveToBatch(config);
+  auto commitResult = PreferencesManager::commitBatch();
+  if (!result.isSuccess())
+    return result;
+  if (!commitResult.isSuccess())
+    return commitResult;
+
+  logger.info(F("ConfigP"), F("Konfiguration erfolgreich in Preferences gespeichert"));
+  return PersistenceResult::success();
+}
+
+ConfigPersistence::PersistenceResult ConfigPersistence::saveToBatch(const ConfigData& config) {
   // Save general settings using atomic updates
   auto result = PreferencesManager::updateStringValue(PreferencesNamespaces::GENERAL, "device_name",
                                                       config.deviceName);
@@ -239,19 +235,19 @@ ConfigPersistence::PersistenceResult ConfigPersistence::save(const ConfigData& c
   if (!result.isSuccess())
     return result;
 
-  logger.info(F("ConfigP"), F("Konfiguration erfolgreich in Preferences gespeichert"));
   return PersistenceResult::success();
 }
 
 void ConfigPersistence::writeUpdateFlagsToFile(bool fs, bool fw) {
-  File f = LittleFS.open("/update_flags.txt", "w");
-  if (f) {
-    f.printf("fs:%d,fw:%d\n", fs ? 1 : 0, fw ? 1 : 0);
-    f.close();
-  }
+  // Every reboot path runs FileIoQueue::flushAll(), so the flags are on disk
+  // before the update mode starts
+  char line[16];
+  snprintf(line, sizeof(line), "fs:%d,fw:%d\n", fs ? 1 : 0, fw ? 1 : 0);
+  FileIoQueue::getInstance().write("/update_flags.txt", line);
 }
 
 void ConfigPersistence::readUpdateFlagsFromFile(bool& fs, bool& fw) {
+  FileIoQueue::getInstance().flush("/update_flags.txt");
   File f = LittleFS.open("/update_flags.txt", "r");
   if (f) {
     String line = f.readStringUntil('\n');
@@ -269,80 +265,69 @@ bool ConfigPersistence::backupPreferencesToFile() {
 
   // Create JSON document for backup (allocate enough space)
   DynamicJsonDocument doc(8192);
-  Preferences prefs;
-
-  // Backup general namespace
-  if (prefs.begin(PreferencesNamespaces::GENERAL, true)) {
-    JsonObject general = doc.createNestedObject("general");
-    general["device_name"] = prefs.getString("device_name", "Pflanzensensor");
-    general["admin_pwd"] = prefs.getString("admin_pwd", "admin");
-    general["md5_verify"] = prefs.getBool("md5_verify", true);
-    general["collectd_en"] = prefs.getBool("collectd_en", false);
-    general["file_log"] = prefs.getBool("file_log", false);
-    general["flower_sens"] = prefs.getString("flower_sens", "");
-    prefs.end();
-  }
+
+  // Backup general namespace (all fixed namespaces are served from the Preferences cache)
+  JsonObject general = doc.createNestedObject("general");
+  general["device_name"] =
+      PreferencesManager::getString(PreferencesNamespaces::GENERAL, "device_name",
+                                    "Pflanzensensor");
+  general["admin_pwd"] =
+      PreferencesManager::getString(PreferencesNamespaces::GENERAL, "admin_pwd", "admin");
+  general["md5_verify"] =
+      PreferencesManager::getBool(PreferencesNamespaces::GENERAL, "md5_verify", true);
+  general["collectd_en"] =
+      PreferencesManager::getBool(PreferencesNamespaces::GENERAL, "collectd_en", false);
+  general["file_log"] =
+      PreferencesManager::getBool(PreferencesNamespaces::GENERAL, "file_log", false);
+  general["flower_sens"] =
+      PreferencesManager::getString(PreferencesNamespaces::GENERAL, "flower_sens", "");
 
   // Backup WiFi namespaces (3 separate namespaces)
   JsonObject wifi = doc.createNestedObject("wifi");
-  if (prefs.begin(PreferencesNamespaces::WIFI1, true)) {
-    wifi["ssid1"] = prefs.getString("ssid", "");
-    wifi["pwd1"] = prefs.getString("pwd", "");
-    prefs.end();
-  }
-  if (prefs.begin(PreferencesNamespaces::WIFI2, true)) {
-    wifi["ssid2"] = prefs.getString("ssid", "");
-    wifi["pwd2"] = prefs.getString("pwd", "");
-    prefs.end();
-  }
-  if (prefs.begin(PreferencesNamespaces::WIFI3, true)) {
-    wifi["ssid3"] = prefs.getString("ssid", "");
-    wifi["pwd3"] = prefs.getString("pwd", "");
-    prefs.end();
-  }
+  wifi["ssid1"] = PreferencesManager::getString(PreferencesNamespaces::WIFI1, "ssid", "");
+  wifi["pwd1"] = PreferencesManager::getString(PreferencesNamespaces::WIFI1, "pwd", "");
+  wifi["ssid2"] = PreferencesManager::getString(PreferencesNamespaces::WIFI2, "ssid", "");
+  wifi["pwd2"] = PreferencesManager::getString(PreferencesNamespaces::WIFI2, "pwd", "");
+  wifi["ssid3"] = PreferencesManager::getString(PreferencesNamespaces::WIFI3, "ssid", "");
+  wifi["pwd3"] = PreferencesManager::getString(PreferencesNamespaces::WIFI3, "pwd", "");
 
   // Backup display namespace
-  if (prefs.begin(PreferencesNamespaces::DISP, true)) {
-    JsonObject disp = doc.createNestedObject("display");
-    disp["show_ip"] = prefs.getBool("show_ip", true);
-    disp["show_clock"] = prefs.getBool("show_clock", true);
-    disp["show_flower"] = prefs.getBool("show_flower", true);
-    disp["show_fabmobil"] = prefs.getBool("show_fabmobil", true);
-    disp["show_qr"] = prefs.getBool("show_qr", false);
-    disp["screen_dur"] = prefs.getUInt("screen_dur", 5);
-    disp["clock_fmt"] = prefs.getString("clock_fmt", "24h");
-    disp["sensor_disp"] = prefs.getString("sensor_disp", "");
-    prefs.end();
-  }
+  JsonObject disp = doc.createNestedObject("display");
+  disp["show_ip"] = PreferencesManager::getBool(PreferencesNamespaces::DISP, "show_ip", true);
+  disp["show_clock"] = PreferencesManager::getBool(PreferencesNamespaces::DISP, "show_clock", true);
+  disp["show_flower"] =
+      PreferencesManager::getBool(PreferencesNamespaces::DISP, "show_flower", true);
+  disp["show_fabmobil"] =
+      PreferencesManager::getBool(PreferencesNamespaces::DISP, "show_fabmobil", true);
+  disp["show_qr"] = PreferencesManager::getBool(PreferencesNamespaces::DISP, "show_qr", false);
+  disp["screen_dur"] = PreferencesManager::getUInt(PreferencesNamespaces::DISP, "screen_dur", 5);
+  disp["clock_fmt"] =
+      PreferencesManager::getString(PreferencesNamespaces::DISP, "clock_fmt", "24h");
+  disp["sensor_disp"] =
+      PreferencesManager::getString(PreferencesNamespaces::DISP, "sensor_disp", "");
 
   // Backup debug namespace
-  if (prefs.begin(PreferencesNamespaces::DEBUG, true)) {
-    JsonObject debug = doc.createNestedObject("debug");
-    debug["ram"] = prefs.getBool("ram", false);
-    debug["meas_cycle"] = prefs.getBool("meas_cycle", false);
-    debug["sensor"] = prefs.getBool("sensor", false);
-    debug["display"] = prefs.getBool("display", false);
-    debug["websocket"] = prefs.getBool("websocket", false);
-    prefs.end();
-  }
+  JsonObject debug = doc.createNestedObject("debug");
+  debug["ram"] = PreferencesManager::getBool(PreferencesNamespaces::DEBUG, "ram", false);
+  debug["meas_cycle"] =
+      PreferencesManager::getBool(PreferencesNamespaces::DEBUG, "meas_cycle", false);
+  debug["sensor"] = PreferencesManager::getBool(PreferencesNamespaces::DEBUG, "sensor", false);
+  debug["display"] = PreferencesManager::getBool(PreferencesNamespaces::DEBUG, "display", false);
+  debug["websocket"] =
+      PreferencesManager::getBool(PreferencesNamespaces::DEBUG, "websocket", false);
 
   // Backup log namespace
-  if (prefs.begin(PreferencesNamespaces::LOG, true)) {
-    JsonObject log = doc.createNestedObject("log");
-    // Log level is stored as string (e.g., "DEBUG", "INFO", "WARNING", "ERROR")
-    String logLevelStr = prefs.getString("level", "INFO");
-    log["level"] = logLevelStr;
-    log["file_enabled"] = prefs.getBool("file_enabled", false);
-    prefs.end();
-  }
+  JsonObject log = doc.createNestedObject("log");
+  // Log level is stored as string (e.g., "DEBUG", "INFO", "WARNING", "ERROR")
+  log["level"] = PreferencesManager::getString(PreferencesNamespaces::LOG, "level", "INFO");
+  log["file_enabled"] =
+      PreferencesManager::getBool(PreferencesNamespaces::LOG, "file_enabled", false);
 
   // Backup LED traffic namespace
-  if (prefs.begin(PreferencesNamespaces::LED_TRAFFIC, true)) {
-    JsonObject led = doc.createNestedObject("led_traffic");
-    led["mode"] = prefs.getUChar("mode", 0);
-    led["sel_meas"] = prefs.getString("sel_meas", "");
-    prefs.end();
-  }
+  JsonObject led = doc.createNestedObject("led_traffic");
+  led["mode"] = PreferencesManager::getUChar(PreferencesNamespaces::LED_TRAFFIC, "mode", 0);
+  led["sel_meas"] =
+      PreferencesManager::getString(PreferencesNamespaces::LED_TRAFFIC, "sel_meas", "");
 
   // Backup sensor measurements from JSON files (new JSON-based persistence)
   const char* sensorIds[] = {"ANALOG", "DHT"};
@@ -379,7 +364,7 @@ bool ConfigPersistence::backupPreferencesToFile() {
       yield(); // Watchdog reset for each measurement
 
       MeasurementConfig config;
-      auto result = SensorPersistence::loadMeasurementFromJson(sensorId, i, config);
+      auto result = SensorPersistence::loadMeasurement(sensorId, i, config);
 
       if (result.isSuccess()) {
         JsonObject meas = measurements.createNestedObject();
@@ -390,6 +375,9 @@ bool ConfigPersistence::backupPreferencesToFile() {
         meas["un"] = config.unit;
         meas["min"] = config.minValue;
         meas["max"] = config.maxValue;
+        meas["agg"] = aggregationModeToString(config.aggregation);
+        meas["trim"] = config.trimFraction;
+        meas["hmp"] = config.hampelThreshold;
 
         JsonObject thresh = meas.createNestedObject("thresh");
         thresh["yl"] = config.limits.yellowLow;
@@ -397,6 +385,20 @@ bool ConfigPersistence::backupPreferencesToFile() {
         thresh["gh"] = config.limits.greenHigh;
         thresh["yh"] = config.limits.yellowHigh;
 
+        // Absolute Min/Max werden für alle Sensoren geführt;
+        // Unendlich als null für JSON-Kompatibilität
+        if (isinf(config.absoluteMin)) {
+          meas["amin"] = serialized("null");
+        } else {
+          meas["amin"] = config.absoluteMin;
+        }
+
+        if (isinf(config.absoluteMax)) {
+          meas["amax"] = serialized("null");
+        } else {
+          meas["amax"] = config.absoluteMax;
+        }
+
         // Analog-spezifische Felder
         if (isAnalog) {
           meas["inv"] = config.inverted;
@@ -404,19 +406,6 @@ bool ConfigPersistence::backupPreferencesToFile() {
           meas["ahl"] = config.autocalHalfLifeSeconds;
           meas["rmin"] = config.absoluteRawMin;
           meas["rmax"] = config.absoluteRawMax;
-
-          // Handle infinity values - use null for JSON compatibility
-          if (isinf(config.absoluteMin)) {
-            meas["amin"] = serialized("null");
-          } else {
-            meas["amin"] = config.absoluteMin;
-          }
-
-          if (isinf(config.absoluteMax)) {
-            meas["amax"] = serialized("null");
-          } else {
-            meas["amax"] = config.absoluteMax;
-          }
           // include stored last raw value (may be -1 if unknown)
           meas["lastRawValue"] = config.lastRawValue;
         }
@@ -454,7 +443,7 @@ bool ConfigPersistence::backupPreferencesToFile() {
 
 bool ConfigPersistence::restorePreferencesFromJson(const DynamicJsonDocument& doc) {
   unsigned long startTime = millis();
-  logger.debug(F("ConfigP"), F("Starte Wiederherstellung der Preferences..."));
+  LOG_DEBUG(F("ConfigP"), F("Starte Wiederherstellung der Preferences..."));
 
   // Restore general namespace
   unsigned long stepStart = millis();
@@ -479,8 +468,8 @@ bool ConfigPersistence::restorePreferencesFromJson(const DynamicJsonDocument& do
       prefs.end();
     }
     yield(); // Watchdog reset
-    logger.debug(F("ConfigP"), String(F("General-Namespace wiederhergestellt (")) +
-                                   String(millis() - stepStart) + F(" ms)"));
+    LOG_DEBUG(F("ConfigP"), String(F("General-Namespace wiederhergestellt (")) +
+                                String(millis() - stepStart) + F(" ms)"));
   }
 
   // Restore WiFi namespaces (3 separate namespaces)
@@ -532,8 +521,8 @@ bool ConfigPersistence::restorePreferencesFromJson(const DynamicJsonDocument& do
       }
       yield(); // Watchdog reset
     }
-    logger.debug(F("ConfigP"), String(F("WiFi-Namespaces wiederhergestellt (")) +
-                                   String(millis() - stepStart) + F(" ms)"));
+    LOG_DEBUG(F("ConfigP"), String(F("WiFi-Namespaces wiederhergestellt (")) +
+                                String(millis() - stepStart) + F(" ms)"));
   }
 
   // Restore display namespace
@@ -563,8 +552,8 @@ bool ConfigPersistence::restorePreferencesFromJson(const DynamicJsonDocument& do
       prefs.end();
     }
     yield(); // Watchdog reset
-    logger.debug(F("ConfigP"), String(F("Display-Namespace wiederhergestellt (")) +
-                                   String(millis() - stepStart) + F(" ms)"));
+    LOG_DEBUG(F("ConfigP"), String(F("Display-Namespace wiederhergestellt (")) +
+                                String(millis() - stepStart) + F(" ms)"));
   }
 
   // Restore debug namespace
@@ -588,8 +577,8 @@ bool ConfigPersistence::restorePreferencesFromJson(const DynamicJsonDocument& do
       prefs.end();
     }
     yield(); // Watchdog reset
-    logger.debug(F("ConfigP"), String(F("Debug-Namespace wiederhergestellt (")) +
-                                   String(millis() - stepStart) + F(" ms)"));
+    LOG_DEBUG(F("ConfigP"), String(F("Debug-Namespace wiederhergestellt (")) +
+                                String(millis() - stepStart) + F(" ms)"));
   }
 
   // Restore log namespace
@@ -610,8 +599,8 @@ bool ConfigPersistence::restorePreferencesFromJson(const DynamicJsonDocument& do
       prefs.end();
     }
     yield(); // Watchdog reset
-    logger.debug(F("ConfigP"), String(F("Log-Namespace wiederhergestellt (")) +
-                                   String(millis() - stepStart) + F(" ms)"));
+    LOG_DEBUG(F("ConfigP"), String(F("Log-Namespace wiederhergestellt (")) +
+                                String(millis() - stepStart) + F(" ms)"));
   }
 
   // Restore LED traffic namespace
@@ -629,16 +618,19 @@ bool ConfigPersistence::restorePreferencesFromJson(const DynamicJsonDocument& do
       prefs.end();
     }
     yield(); // Watchdog reset
-    logger.debug(F("ConfigP"), String(F("LED-Traffic-Namespace wiederhergestellt (")) +
-                                   String(millis() - stepStart) + F(" ms)"));
+    LOG_DEBUG(F("ConfigP"), String(F("LED-Traffic-Namespace wiederhergestellt (")) +
+                                String(millis() - stepStart) + F(" ms)"));
   }
 
+  // The namespaces above were rewritten without the Preferences cache
+  PreferencesManager::invalidateCache();
+
   // Restore sensor measurements to JSON files (new JSON-based persistence)
   stepStart = millis();
   if (doc.containsKey("sensors")) {
     JsonArrayConst sensors = doc["sensors"].as<JsonArrayConst>();
-    logger.debug(F("ConfigP"), String(F("Beginne Wiederherstellung von ")) +
-                                   String(sensors.size()) + F(" Sensor-Gruppen..."));
+    LOG_DEBUG(F("ConfigP"), String(F("Beginne Wiederherstellung von ")) +
+                                String(sensors.size()) + F(" Sensor-Gruppen..."));
 
     // Track measurement intervals per sensor
     std::map<String, unsigned long> sensorIntervals;
@@ -670,6 +662,9 @@ bool ConfigPersistence::restorePreferencesFromJson(const DynamicJsonDocument& do
           config.unit = meas["un"] | String("");
           config.minValue = meas["min"] | 0.0f;
           config.maxValue = meas["max"] | 100.0f;
+          aggregationModeFromString(meas["agg"] | "mean", config.aggregation);
+          config.trimFraction = meas["trim"] | DEFAULT_TRIM_FRACTION;
+          config.hampelThreshold = meas["hmp"] | DEFAULT_HAMPEL_THRESHOLD;
 
           JsonObjectConst thresh = meas["thresh"];
           config.limits.yellowLow = thresh["yl"] | 0.0f;
@@ -677,6 +672,19 @@ bool ConfigPersistence::restorePreferencesFromJson(const DynamicJsonDocument& do
           config.limits.greenHigh = thresh["gh"] | 100.0f;
           config.limits.yellowHigh = thresh["yh"] | 100.0f;
 
+          // Handle null values for infinity
+          if (meas["amin"].isNull()) {
+            config.absoluteMin = INFINITY;
+          } else {
+            config.absoluteMin = meas["amin"] | INFINITY;
+          }
+
+          if (meas["amax"].isNull()) {
+            config.absoluteMax = -INFINITY;
+          } else {
+            config.absoluteMax = meas["amax"] | -INFINITY;
+          }
+
           // Analog-spezifische Felder
           if (sensorId == "ANALOG") {
             config.inverted = meas["inv"] | false;
@@ -686,23 +694,10 @@ bool ConfigPersistence::restorePreferencesFromJson(const DynamicJsonDocument& do
             config.lastRawValue = meas.containsKey("lastRawValue") ? (int)meas["lastRawValue"] : -1;
             config.absoluteRawMin = meas["rmin"] | 0;
             config.absoluteRawMax = meas["rmax"] | 1023;
-
-            // Handle null values for infinity
-            if (meas["amin"].isNull()) {
-              config.absoluteMin = INFINITY;
-            } else {
-              config.absoluteMin = meas["amin"] | INFINITY;
-            }
-
-            if (meas["amax"].isNull()) {
-              config.absoluteMax = -INFINITY;
-            } else {
-              config.absoluteMax = meas["amax"] | -INFINITY;
-            }
           }
 
-          // Schreibe Messung in JSON-Datei
-          auto result = SensorPersistence::saveMeasurementToJson(sensorId, idx, config);
+          // Schreibe Messung in den Messungsspeicher
+          auto result = SensorPersistence::saveMeasurement(sensorId, idx, config);
           if (!result.isSuccess()) {
             logger.warning(F("ConfigP"), F("Fehler beim Wiederherstellen von ") + sensorId +
                                              F("[") + String(idx) + F("]: ") + result.getMessage());
@@ -756,8 +751,8 @@ bool ConfigPersistence::restorePreferencesFromJson(const DynamicJsonDocument& do
           }
         }
 
-        // Schreibe Messung in JSON-Datei
-        auto result = SensorPersistence::saveMeasurementToJson(sensorId, idx, config);
+        // Schreibe Messung in den Messungsspeicher
+        auto result = SensorPersistence::saveMeasurement(sensorId, idx, config);
         if (!result.isSuccess()) {
           logger.warning(F("ConfigP"), F("Fehler beim Wiederherstellen von ") + sensorId + F("[") +
                                            String(idx) + F("]: ") + result.getMessage());
@@ -770,27 +765,6 @@ bool ConfigPersistence::restorePreferencesFromJson(const DynamicJsonDocument& do
     // Apply measurement intervals to sensors
     extern std::unique_ptr<SensorManager> sensorManager;
     if (sensorManager && !sensorIntervals.empty()) {
-      // Load settings.json to update intervals persistently
-      const char* settingsPath = "/config/settings.json";
-      DynamicJsonDocument settingsDoc(4096);
-
-      {
-        File settingsFile = LittleFS.open(settingsPath, "r");
-        if (settingsFile) {
-          DeserializationError error = deserializeJson(settingsDoc, settingsFile);
-          settingsFile.close();
-          if (error != DeserializationError::Ok) {
-            logger.warning(F("ConfigP"), F("Konnte settings.json nicht parsen, erstelle neue"));
-          }
-        }
-      }
-
-      // Ensure sensors object exists in settings.json
-      if (!settingsDoc.containsKey("sensors")) {
-        settingsDoc.createNestedObject("sensors");
-      }
-      JsonObject settingsSensors = settingsDoc["sensors"];
-
       for (const auto& pair : sensorIntervals) {
         const String& sensorId = pair.first;
         unsigned long interval = pair.second;
@@ -800,34 +774,23 @@ bool ConfigPersistence::restorePreferencesFromJson(const DynamicJsonDocument& do
         for (const auto& sensorPtr : sensors_list) {
           if (sensorPtr && sensorPtr->config().id == sensorId) {
             sensorPtr->mutableConfig().measurementInterval = interval;
-            logger.debug(F("ConfigP"), String(F("Messintervall für ")) + sensorId + F(" auf ") +
-                                           String(interval) + F("ms gesetzt"));
+            LOG_DEBUG(F("ConfigP"), String(F("Messintervall für ")) + sensorId + F(" auf ") +
+                                        String(interval) + F("ms gesetzt"));
             break;
           }
         }
 
-        // Also save to settings.json for persistence across reboots
-        if (!settingsSensors.containsKey(sensorId)) {
-          settingsSensors.createNestedObject(sensorId);
-        }
-        settingsSensors[sensorId]["interval"] = interval;
-      }
-
-      // Save updated settings.json
-      {
-        File settingsFile = LittleFS.open(settingsPath, "w");
-        if (settingsFile) {
-          serializeJson(settingsDoc, settingsFile);
-          settingsFile.close();
-          logger.debug(F("ConfigP"), F("Messintervalle in settings.json gespeichert"));
-        } else {
-          logger.warning(F("ConfigP"), F("Konnte settings.json nicht für Schreibzugriff öffnen"));
+        // Also store it for persistence across reboots
+        auto result = SensorPersistence::updateMeasurementInterval(sensorId, interval);
+        if (!result.isSuccess()) {
+          logger.warning(F("ConfigP"), F("Konnte Messintervall für ") + sensorId +
+                                           F(" nicht speichern"));
         }
       }
     }
 
-    logger.debug(F("ConfigP"), String(F("Sensor-Messungen wiederhergestellt (")) +
-                                   String(millis() - stepStart) + F(" ms)"));
+    LOG_DEBUG(F("ConfigP"), String(F("Sensor-Messungen wiederhergestellt (")) +
+                                String(millis() - stepStart) + F(" ms)"));
   }
 
   // Backup file cleaned up by caller (flash restore or config upload handler)
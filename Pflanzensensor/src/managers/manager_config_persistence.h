@@ -68,7 +68,7 @@ public:
    * @return True if backup successful, false otherwise
    * @details Creates /prefs_backup.json containing:
    *          - Global settings (WiFi, Display, Debug, NTP, InfluxDB) from Preferences
-   *          - Sensor measurements from /config/sensor_*.json files
+   *          - Sensor measurements from the measurement store (/config/measurements.log)
    *          Used for Config Download in WebUI
    */
   static bool backupPreferencesToFile();
@@ -84,6 +84,13 @@ public:
 
 private:
   ConfigPersistence() = default;
+
+  /**
+   * @brief Stage all configuration keys inside an open Preferences batch
+   * @param config Configuration data to save
+   * @return PersistenceResult of the first failed update
+   */
+  static PersistenceResult saveToBatch(const ConfigData& config);
 };
 
 #endif
@@ -7,6 +7,250 @@
 #include "../configs/config_pflanzensensor.h"
 #include "../logger/logger.h"
 
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+/// Value type of a cached key; decides which Preferences getter/putter is used
+enum class PrefType : uint8_t { BOOL, UCHAR, UINT, STRING };
+
+struct PrefKey {
+  const char* key;
+  PrefType type;
+};
+
+// Known keys of the fixed namespaces; a namespace is loaded with one session
+const PrefKey GENERAL_KEYS[] = {
+    {"initialized", PrefType::BOOL}, {"device_name", PrefType::STRING},
+    {"admin_pwd", PrefType::STRING}, {"md5_verify", PrefType::BOOL},
+    {"collectd_en", PrefType::BOOL}, {"file_log", PrefType::BOOL},
+    {"flower_sens", PrefType::STRING}};
+const PrefKey WIFI_KEYS[] = {
+    {"initialized", PrefType::BOOL}, {"ssid", PrefType::STRING}, {"pwd", PrefType::STRING}};
+const PrefKey DISPLAY_KEYS[] = {
+    {"initialized", PrefType::BOOL},   {"show_ip", PrefType::BOOL},
+    {"show_clock", PrefType::BOOL},    {"show_flower", PrefType::BOOL},
+    {"show_fabmobil", PrefType::BOOL}, {"show_qr", PrefType::BOOL},
+    {"screen_dur", PrefType::UINT},    {"clock_fmt", PrefType::STRING},
+    {"sensor_disp", PrefType::STRING}};
+const PrefKey LOG_KEYS[] = {
+    {"initialized", PrefType::BOOL}, {"level", PrefType::STRING}, {"file_enabled", PrefType::BOOL}};
+const PrefKey LED_TRAFFIC_KEYS[] = {
+    {"initialized", PrefType::BOOL}, {"mode", PrefType::UCHAR}, {"sel_meas", PrefType::STRING}};
+const PrefKey DEBUG_KEYS[] = {{"initialized", PrefType::BOOL}, {"ram", PrefType::BOOL},
+                              {"meas_cycle", PrefType::BOOL},  {"sensor", PrefType::BOOL},
+                              {"display", PrefType::BOOL},     {"websocket", PrefType::BOOL}};
+
+struct NamespaceSchema {
+  const char* name;
+  const PrefKey* keys;
+  uint8_t keyCount;
+};
+
+#define PREF_SCHEMA(ns, keys) {ns, keys, sizeof(keys) / sizeof(keys[0])}
+const NamespaceSchema SCHEMAS[] = {
+    PREF_SCHEMA(PreferencesNamespaces::GENERAL, GENERAL_KEYS),
+    PREF_SCHEMA(PreferencesNamespaces::WIFI1, WIFI_KEYS),
+    PREF_SCHEMA(PreferencesNamespaces::WIFI2, WIFI_KEYS),
+    PREF_SCHEMA(PreferencesNamespaces::WIFI3, WIFI_KEYS),
+    PREF_SCHEMA(PreferencesNamespaces::DISP, DISPLAY_KEYS),
+    PREF_SCHEMA(PreferencesNamespaces::LOG, LOG_KEYS),
+    PREF_SCHEMA(PreferencesNamespaces::LED_TRAFFIC, LED_TRAFFIC_KEYS),
+    PREF_SCHEMA(PreferencesNamespaces::DEBUG, DEBUG_KEYS)};
+#undef PREF_SCHEMA
+constexpr size_t NAMESPACE_COUNT = sizeof(SCHEMAS) / sizeof(SCHEMAS[0]);
+
+/**
+ * @brief Cached value of one key; numbers and bools share the integer slot
+ */
+struct CachedValue {
+  String text;
+  uint32_t number{0};
+  bool present{false}; ///< Key exists in the namespace
+  bool dirty{false};   ///< Changed in RAM, not yet committed
+};
+
+/**
+ * @brief Cached namespace; values are parallel to the schema keys
+ */
+struct NamespaceCache {
+  bool loaded{false};
+  std::vector<CachedValue> values;
+};
+
+NamespaceCache g_cache[NAMESPACE_COUNT];
+PreferencesManager::CacheStats g_cacheStats;
+uint8_t g_batchDepth = 0;
+bool g_bootComplete = false;
+
+bool openSession(Preferences& prefs, const char* namespaceKey, bool readOnly) {
+  g_cacheStats.sessions++;
+  if (!g_bootComplete) {
+    g_cacheStats.bootSessions++;
+  }
+  return prefs.begin(namespaceKey, readOnly);
+}
+
+int findNamespace(const char* namespaceKey) {
+  for (size_t i = 0; i < NAMESPACE_COUNT; i++) {
+    if (strcmp(SCHEMAS[i].name, namespaceKey) == 0) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+int findKey(const NamespaceSchema& schema, const char* key) {
+  for (uint8_t i = 0; i < schema.keyCount; i++) {
+    if (strcmp(schema.keys[i].key, key) == 0) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+// Read every known key of a namespace in a single session
+bool loadNamespace(size_t index) {
+  NamespaceCache& cache = g_cache[index];
+  if (cache.loaded) {
+    return true;
+  }
+  const NamespaceSchema& schema = SCHEMAS[index];
+  Preferences prefs;
+  if (!openSession(prefs, schema.name, true)) {
+    return false;
+  }
+  cache.values.assign(schema.keyCount, CachedValue());
+  for (uint8_t i = 0; i < schema.keyCount; i++) {
+    const PrefKey& key = schema.keys[i];
+    CachedValue& value = cache.values[i];
+    value.present = prefs.isKey(key.key);
+    if (!value.present) {
+      continue;
+    }
+    g_cacheStats.keyReads++;
+    switch (key.type) {
+    case PrefType::BOOL:
+      value.number = prefs.getBool(key.key, false) ? 1 : 0;
+      break;
+    case PrefType::UCHAR:
+      value.number = prefs.getUChar(key.key, 0);
+      break;
+    case PrefType::UINT:
+      value.number = prefs.getUInt(key.key, 0);
+      break;
+    case PrefType::STRING:
+      value.text = prefs.getString(key.key, "");
+      break;
+    }
+  }
+  prefs.end();
+  cache.loaded = true;
+  return true;
+}
+
+/**
+ * @brief Find the cached value of a key, loading its namespace if needed
+ * @return nullptr if the key is not cached (unknown namespace or key, or
+ *         the namespace could not be opened)
+ */
+CachedValue* findCached(const char* namespaceKey, const char* key, int* namespaceIndex = nullptr) {
+  int index = findNamespace(namespaceKey);
+  if (index < 0) {
+    return nullptr;
+  }
+  int keyIndex = findKey(SCHEMAS[index], key);
+  if (keyIndex < 0 || !loadNamespace(index)) {
+    return nullptr;
+  }
+  if (namespaceIndex) {
+    *namespaceIndex = index;
+  }
+  return &g_cache[index].values[keyIndex];
+}
+
+// Write all dirty keys of a namespace in a single session
+PreferencesManager::PrefResult commitNamespace(size_t index) {
+  NamespaceCache& cache = g_cache[index];
+  bool dirty = false;
+  for (const auto& value : cache.values) {
+    dirty = dirty || value.dirty;
+  }
+  if (!dirty) {
+    return PreferencesManager::PrefResult::success();
+  }
+
+  const NamespaceSchema& schema = SCHEMAS[index];
+  Preferences prefs;
+  bool saved = openSession(prefs, schema.name, false);
+  if (saved) {
+    for (uint8_t i = 0; i < schema.keyCount; i++) {
+      CachedValue& value = cache.values[i];
+      if (!value.dirty) {
+        continue;
+      }
+      const char* key = schema.keys[i].key;
+      bool written = false;
+      switch (schema.keys[i].type) {
+      case PrefType::BOOL:
+        written = PreferencesManager::putBool(prefs, key, value.number != 0);
+        break;
+      case PrefType::UCHAR:
+        written = PreferencesManager::putUChar(prefs, key, static_cast<uint8_t>(value.number));
+        break;
+      case PrefType::UINT:
+        written = PreferencesManager::putUInt(prefs, key, value.number);
+        break;
+      case PrefType::STRING:
+        written = PreferencesManager::putString(prefs, key, value.text);
+        break;
+      }
+      if (!written) {
+        saved = false;
+        break;
+      }
+      value.dirty = false;
+      g_cacheStats.keyWrites++;
+    }
+    prefs.end();
+  } else {
+    logger.error(F("PrefMgr"), String(F("Fehler beim Öffnen des Namespace: ")) + schema.name);
+  }
+
+  if (!saved) {
+    // Reload from the filesystem so the cache never shows unsaved values
+    cache.loaded = false;
+    cache.values.clear();
+    return PreferencesManager::PrefResult::fail(ConfigError::SAVE_FAILED,
+                                                String("Failed to save namespace: ") + schema.name);
+  }
+  return PreferencesManager::PrefResult::success();
+}
+
+// Update a cached key; unchanged values cost no filesystem access
+PreferencesManager::PrefResult stageValue(size_t index, CachedValue& cached, uint32_t number,
+                                          const String* text) {
+  bool unchanged = cached.present && (text ? cached.text == *text : cached.number == number);
+  if (unchanged) {
+    g_cacheStats.skippedWrites++;
+    return PreferencesManager::PrefResult::success();
+  }
+  if (text) {
+    cached.text = *text;
+  } else {
+    cached.number = number;
+  }
+  cached.present = true;
+  cached.dirty = true;
+  if (g_batchDepth > 0) {
+    return PreferencesManager::PrefResult::success();
+  }
+  return commitNamespace(index);
+}
+
+} // namespace
+
 // Helper functions for type-safe access
 String PreferencesManager::getString(Preferences& prefs, const char* key,
                                      const String& defaultValue) {
@@ -36,21 +280,31 @@ float PreferencesManager::getFloat(Preferences& prefs, const char* key, float de
 // Convenience getters that accept a namespace key
 String PreferencesManager::getString(const char* namespaceKey, const char* key,
                                      const String& defaultValue) {
+  if (const CachedValue* cached = findCached(namespaceKey, key)) {
+    g_cacheStats.cacheHits++;
+    return cached->present ? cached->text : defaultValue;
+  }
   Preferences prefs;
-  if (!prefs.begin(namespaceKey, true)) {
+  if (!openSession(prefs, namespaceKey, true)) {
     // If cannot open, return default
     return defaultValue;
   }
+  g_cacheStats.keyReads++;
   String val = getString(prefs, key, defaultValue);
   prefs.end();
   return val;
 }
 
 bool PreferencesManager::getBool(const char* namespaceKey, const char* key, bool defaultValue) {
+  if (const CachedValue* cached = findCached(namespaceKey, key)) {
+    g_cacheStats.cacheHits++;
+    return cached->present ? cached->number != 0 : defaultValue;
+  }
   Preferences prefs;
-  if (!prefs.begin(namespaceKey, true)) {
+  if (!openSession(prefs, namespaceKey, true)) {
     return defaultValue;
   }
+  g_cacheStats.keyReads++;
   bool val = getBool(prefs, key, defaultValue);
   prefs.end();
   return val;
@@ -58,15 +312,36 @@ bool PreferencesManager::getBool(const char* namespaceKey, const char* key, bool
 
 uint32_t PreferencesManager::getUInt(const char* namespaceKey, const char* key,
                                      uint32_t defaultValue) {
+  if (const CachedValue* cached = findCached(namespaceKey, key)) {
+    g_cacheStats.cacheHits++;
+    return cached->present ? cached->number : defaultValue;
+  }
   Preferences prefs;
-  if (!prefs.begin(namespaceKey, true)) {
+  if (!openSession(prefs, namespaceKey, true)) {
     return defaultValue;
   }
+  g_cacheStats.keyReads++;
   uint32_t val = getUInt(prefs, key, defaultValue);
   prefs.end();
   return val;
 }
 
+uint8_t PreferencesManager::getUChar(const char* namespaceKey, const char* key,
+                                     uint8_t defaultValue) {
+  if (const CachedValue* cached = findCached(namespaceKey, key)) {
+    g_cacheStats.cacheHits++;
+    return cached->present ? static_cast<uint8_t>(cached->number) : defaultValue;
+  }
+  Preferences prefs;
+  if (!openSession(prefs, namespaceKey, true)) {
+    return defaultValue;
+  }
+  g_cacheStats.keyReads++;
+  uint8_t val = getUChar(prefs, key, defaultValue);
+  prefs.end();
+  return val;
+}
+
 bool PreferencesManager::putString(Preferences& prefs, const char* key, const String& value) {
   return prefs.putString(key, value) > 0;
 }
@@ -93,8 +368,12 @@ bool PreferencesManager::putFloat(Preferences& prefs, const char* key, float val
 
 // Check if namespace exists
 bool PreferencesManager::namespaceExists(const char* namespaceName) {
+  if (const CachedValue* cached = findCached(namespaceName, "initialized")) {
+    g_cacheStats.cacheHits++;
+    return cached->present;
+  }
   Preferences prefs;
-  bool opened = prefs.begin(namespaceName, true); // Read-only
+  bool opened = openSession(prefs, namespaceName, true); // Read-only
   if (opened) {
     // Check if there's at least one key
     bool exists = prefs.isKey("initialized");
@@ -107,7 +386,7 @@ bool PreferencesManager::namespaceExists(const char* namespaceName) {
 // Initialize general namespace with defaults
 PreferencesManager::PrefResult PreferencesManager::initGeneralNamespace() {
   Preferences prefs;
-  if (!prefs.begin(PreferencesNamespaces::GENERAL, false)) {
+  if (!openSession(prefs, PreferencesNamespaces::GENERAL, false)) {
     logger.error(F("PrefMgr"), F("Fehler beim Öffnen des General-Namespace"));
     return PrefResult::fail(ConfigError::FILE_ERROR, "Cannot open general namespace");
   }
@@ -123,6 +402,7 @@ PreferencesManager::PrefResult PreferencesManager::initGeneralNamespace() {
 
   prefs.end();
   logger.info(F("PrefMgr"), F("General-Namespace mit Standardwerten initialisiert"));
+  invalidateCache();
   return PrefResult::success();
 }
 
@@ -131,7 +411,7 @@ PreferencesManager::PrefResult PreferencesManager::initWiFiNamespace() {
   Preferences prefs;
 
   // Initialize WiFi 1 namespace
-  if (!prefs.begin(PreferencesNamespaces::WIFI1, false)) {
+  if (!openSession(prefs, PreferencesNamespaces::WIFI1, false)) {
     logger.error(F("PrefMgr"), F("Fehler beim Öffnen des WiFi1-Namespace"));
     return PrefResult::fail(ConfigError::FILE_ERROR, "Cannot open WiFi1 namespace");
   }
@@ -142,7 +422,7 @@ PreferencesManager::PrefResult PreferencesManager::initWiFiNamespace() {
   logger.info(F("PrefMgr"), F("WiFi1-Namespace initialisiert"));
 
   // Initialize WiFi 2 namespace
-  if (!prefs.begin(PreferencesNamespaces::WIFI2, false)) {
+  if (!openSession(prefs, PreferencesNamespaces::WIFI2, false)) {
     logger.error(F("PrefMgr"), F("Fehler beim Öffnen des WiFi2-Namespace"));
     return PrefResult::fail(ConfigError::FILE_ERROR, "Cannot open WiFi2 namespace");
   }
@@ -153,7 +433,7 @@ PreferencesManager::PrefResult PreferencesManager::initWiFiNamespace() {
   logger.info(F("PrefMgr"), F("WiFi2-Namespace initialisiert"));
 
   // Initialize WiFi 3 namespace
-  if (!prefs.begin(PreferencesNamespaces::WIFI3, false)) {
+  if (!openSession(prefs, PreferencesNamespaces::WIFI3, false)) {
     logger.error(F("PrefMgr"), F("Fehler beim Öffnen des WiFi3-Namespace"));
     return PrefResult::fail(ConfigError::FILE_ERROR, "Cannot open WiFi3 namespace");
   }
@@ -163,13 +443,14 @@ PreferencesManager::PrefResult PreferencesManager::initWiFiNamespace() {
   prefs.end();
   logger.info(F("PrefMgr"), F("WiFi3-Namespace initialisiert"));
 
+  invalidateCache();
   return PrefResult::success();
 }
 
 // Initialize Display namespace with defaults
 PreferencesManager::PrefResult PreferencesManager::initDisplayNamespace() {
   Preferences prefs;
-  if (!prefs.begin(PreferencesNamespaces::DISP, false)) {
+  if (!openSession(prefs, PreferencesNamespaces::DISP, false)) {
     logger.error(F("PrefMgr"), F("Fehler beim Öffnen des Display-Namespace"));
     return PrefResult::fail(ConfigError::FILE_ERROR, "Cannot open display namespace");
   }
@@ -186,13 +467,14 @@ PreferencesManager::PrefResult PreferencesManager::initDisplayNamespace() {
 
   prefs.end();
   logger.info(F("PrefMgr"), F("Display-Namespace mit Standardwerten initialisiert"));
+  invalidateCache();
   return PrefResult::success();
 }
 
 // Initialize Log namespace with defaults
 PreferencesManager::PrefResult PreferencesManager::initLogNamespace() {
   Preferences prefs;
-  if (!prefs.begin(PreferencesNamespaces::LOG, false)) {
+  if (!openSession(prefs, PreferencesNamespaces::LOG, false)) {
     logger.error(F("PrefMgr"), F("Fehler beim Öffnen des Log-Namespace"));
     return PrefResult::fail(ConfigError::FILE_ERROR, "Cannot open log namespace");
   }
@@ -203,13 +485,14 @@ PreferencesManager::PrefResult PreferencesManager::initLogNamespace() {
 
   prefs.end();
   logger.info(F("PrefMgr"), F("Log-Namespace mit Standardwerten initialisiert"));
+  invalidateCache();
   return PrefResult::success();
 }
 
 // Initialize LED Traffic Light namespace with defaults
 PreferencesManager::PrefResult PreferencesManager::initLedTrafficNamespace() {
   Preferences prefs;
-  if (!prefs.begin(PreferencesNamespaces::LED_TRAFFIC, false)) {
+  if (!openSession(prefs, PreferencesNamespaces::LED_TRAFFIC, false)) {
     logger.error(F("PrefMgr"), F("Fehler beim Öffnen des LED-Traffic-Namespace"));
     return PrefResult::fail(ConfigError::FILE_ERROR, "Cannot open LED traffic namespace");
   }
@@ -220,13 +503,14 @@ PreferencesManager::PrefResult PreferencesManager::initLedTrafficNamespace() {
 
   prefs.end();
   logger.info(F("PrefMgr"), F("LED-Traffic-Namespace mit Standardwerten initialisiert"));
+  invalidateCache();
   return PrefResult::success();
 }
 
 // Initialize Debug namespace with defaults
 PreferencesManager::PrefResult PreferencesManager::initDebugNamespace() {
   Preferences prefs;
-  if (!prefs.begin(PreferencesNamespaces::DEBUG, false)) {
+  if (!openSession(prefs, PreferencesNamespaces::DEBUG, false)) {
     logger.error(F("PrefMgr"), F("Fehler beim Öffnen des Debug-Namespace"));
     return PrefResult::fail(ConfigError::FILE_ERROR, "Cannot open debug namespace");
   }
@@ -240,6 +524,7 @@ PreferencesManager::PrefResult PreferencesManager::initDebugNamespace() {
 
   prefs.end();
   logger.info(F("PrefMgr"), F("Debug-Namespace mit Standardwerten initialisiert"));
+  invalidateCache();
   return PrefResult::success();
 }
 
@@ -314,12 +599,13 @@ PreferencesManager::PrefResult PreferencesManager::clearAll() {
 
   for (const char* ns : namespaces) {
     Preferences prefs;
-    if (prefs.begin(ns, false)) {
+    if (openSession(prefs, ns, false)) {
       prefs.clear();
       prefs.end();
       logger.info(F("PrefMgr"), String(F("Namespace gelöscht: ")) + String(ns));
     }
   }
+  invalidateCache();
 
   logger.info(F("PrefMgr"), F("Factory Reset abgeschlossen"));
   return PrefResult::success();
@@ -345,19 +631,14 @@ PreferencesManager::PrefResult PreferencesManager::updateWiFiCredentials(uint8_t
     wifiNamespace = PreferencesNamespaces::WIFI3;
   }
 
-  Preferences prefs;
-  if (!prefs.begin(wifiNamespace, false)) {
-    logger.error(F("PrefMgr"),
-                 F("Fehler beim Öffnen des WiFi-Namespace: ") + String(wifiNamespace));
-    return PrefResult::fail(ConfigError::SAVE_FAILED, "Cannot open WiFi namespace");
-  }
-
-  if (!putString(prefs, "ssid", ssid) || !putString(prefs, "pwd", password)) {
-    prefs.end();
+  // Both keys are committed in one session
+  beginBatch();
+  updateStringValue(wifiNamespace, "ssid", ssid);
+  updateStringValue(wifiNamespace, "pwd", password);
+  auto result = commitBatch();
+  if (!result.isSuccess()) {
     return PrefResult::fail(ConfigError::SAVE_FAILED, "Failed to save WiFi credentials");
   }
-
-  prefs.end();
   return PrefResult::success();
 }
 
@@ -365,13 +646,19 @@ PreferencesManager::PrefResult PreferencesManager::updateWiFiCredentials(uint8_t
 
 PreferencesManager::PrefResult PreferencesManager::updateBoolValue(const char* namespaceKey,
                                                                    const char* key, bool value) {
+  int index;
+  if (CachedValue* cached = findCached(namespaceKey, key, &index)) {
+    return stageValue(index, *cached, value ? 1 : 0, nullptr);
+  }
+
   Preferences prefs;
-  if (!prefs.begin(namespaceKey, false)) {
+  if (!openSession(prefs, namespaceKey, false)) {
     logger.error(F("PrefMgr"), String(F("Fehler beim Öffnen des Namespace: ")) + namespaceKey);
     return PrefResult::fail(ConfigError::SAVE_FAILED,
                             String("Cannot open namespace: ") + namespaceKey);
   }
 
+  g_cacheStats.keyWrites++;
   if (!putBool(prefs, key, value)) {
     prefs.end();
     return PrefResult::fail(ConfigError::SAVE_FAILED, String("Failed to save ") + key);
@@ -384,13 +671,19 @@ PreferencesManager::PrefResult PreferencesManager::updateBoolValue(const char* n
 PreferencesManager::PrefResult PreferencesManager::updateStringValue(const char* namespaceKey,
                                                                      const char* key,
                                                                      const String& value) {
+  int index;
+  if (CachedValue* cached = findCached(namespaceKey, key, &index)) {
+    return stageValue(index, *cached, 0, &value);
+  }
+
   Preferences prefs;
-  if (!prefs.begin(namespaceKey, false)) {
+  if (!openSession(prefs, namespaceKey, false)) {
     logger.error(F("PrefMgr"), String(F("Fehler beim Öffnen des Namespace: ")) + namespaceKey);
     return PrefResult::fail(ConfigError::SAVE_FAILED,
                             String("Cannot open namespace: ") + namespaceKey);
   }
 
+  g_cacheStats.keyWrites++;
   if (!putString(prefs, key, value)) {
     prefs.end();
     return PrefResult::fail(ConfigError::SAVE_FAILED, String("Failed to save ") + key);
@@ -402,13 +695,19 @@ PreferencesManager::PrefResult PreferencesManager::updateStringValue(const char*
 
 PreferencesManager::PrefResult
 PreferencesManager::updateUInt8Value(const char* namespaceKey, const char* key, uint8_t value) {
+  int index;
+  if (CachedValue* cached = findCached(namespaceKey, key, &index)) {
+    return stageValue(index, *cached, value, nullptr);
+  }
+
   Preferences prefs;
-  if (!prefs.begin(namespaceKey, false)) {
+  if (!openSession(prefs, namespaceKey, false)) {
     logger.error(F("PrefMgr"), String(F("Fehler beim Öffnen des Namespace: ")) + namespaceKey);
     return PrefResult::fail(ConfigError::SAVE_FAILED,
                             String("Cannot open namespace: ") + namespaceKey);
   }
 
+  g_cacheStats.keyWrites++;
   if (!putUChar(prefs, key, value)) {
     prefs.end();
     return PrefResult::fail(ConfigError::SAVE_FAILED, String("Failed to save ") + key);
@@ -420,13 +719,19 @@ PreferencesManager::updateUInt8Value(const char* namespaceKey, const char* key,
 
 PreferencesManager::PrefResult
 PreferencesManager::updateUIntValue(const char* namespaceKey, const char* key, unsigned int value) {
+  int index;
+  if (CachedValue* cached = findCached(namespaceKey, key, &index)) {
+    return stageValue(index, *cached, value, nullptr);
+  }
+
   Preferences prefs;
-  if (!prefs.begin(namespaceKey, false)) {
+  if (!openSession(prefs, namespaceKey, false)) {
     logger.error(F("PrefMgr"), String(F("Fehler beim Öffnen des Namespace: ")) + namespaceKey);
     return PrefResult::fail(ConfigError::SAVE_FAILED,
                             String("Cannot open namespace: ") + namespaceKey);
   }
 
+  g_cacheStats.keyWrites++;
   if (!putUInt(prefs, key, value)) {
     prefs.end();
     return PrefResult::fail(ConfigError::SAVE_FAILED, String("Failed to save ") + key);
@@ -435,3 +740,53 @@ PreferencesManager::updateUIntValue(const char* namespaceKey, const char* key, u
   prefs.end();
   return PrefResult::success();
 }
+
+// ========== Namespace Cache ==========
+
+void PreferencesManager::beginBatch() { g_batchDepth++; }
+
+PreferencesManager::PrefResult PreferencesManager::commitBatch() {
+  if (g_batchDepth > 0 && --g_batchDepth > 0) {
+    return PrefResult::success();
+  }
+  PrefResult result = PrefResult::success();
+  for (size_t i = 0; i < NAMESPACE_COUNT; i++) {
+    auto namespaceResult = commitNamespace(i);
+    if (!namespaceResult.isSuccess() && result.isSuccess()) {
+      result = namespaceResult;
+    }
+  }
+  return result;
+}
+
+void PreferencesManager::discardBatch() {
+  if (g_batchDepth > 0) {
+    g_batchDepth--;
+  }
+  for (auto& cache : g_cache) {
+    bool dirty = std::any_of(cache.values.begin(), cache.values.end(),
+                             [](const CachedValue& value) { return value.dirty; });
+    if (dirty) {
+      cache.loaded = false;
+      cache.values.clear();
+    }
+  }
+}
+
+void PreferencesManager::invalidateCache() {
+  for (auto& cache : g_cache) {
+    cache.loaded = false;
+    cache.values.clear();
+  }
+}
+
+void PreferencesManager::markBootComplete() {
+  if (!g_bootComplete) {
+    g_bootComplete = true;
+    logger.info(F("PrefMgr"), String(F("Boot: ")) + String(g_cacheStats.bootSessions) +
+                                  F(" Preferences-Zugriffe, ") + String(g_cacheStats.keyReads) +
+                                  F(" Schlüssel gelesen"));
+  }
+}
+
+const PreferencesManager::CacheStats& PreferencesManager::getCacheStats() { return g_cacheStats; }
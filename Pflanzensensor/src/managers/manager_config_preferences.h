@@ -36,11 +36,30 @@ constexpr const char* DEBUG = "debug";          // Debug flags
  * - Key-value loading and saving
  * - Type-safe getters and setters
  * - Migration from JSON to Preferences
+ *
+ * The fixed namespaces (PreferencesNamespaces) are cached in RAM. The first
+ * access to such a namespace reads all of its known keys in a single
+ * Preferences session; later reads are served from the cache. Writes update
+ * the cache and are committed in one session per namespace, either right away
+ * or, between beginBatch() and commitBatch(), once for the whole batch.
+ * Sensor namespaces (s_*) and unknown keys bypass the cache.
  */
 class PreferencesManager {
 public:
   using PrefResult = TypedResult<ConfigError, void>;
 
+  /**
+   * @brief Preferences access statistics since boot
+   */
+  struct CacheStats {
+    uint32_t sessions{0};      ///< Preferences sessions (begin/end) opened by the manager
+    uint32_t keyReads{0};      ///< Keys read from the filesystem
+    uint32_t keyWrites{0};     ///< Keys written to the filesystem
+    uint32_t cacheHits{0};     ///< Reads served from the cache
+    uint32_t skippedWrites{0}; ///< Updates dropped because the value was unchanged
+    uint32_t bootSessions{0};  ///< Sessions opened until markBootComplete()
+  };
+
   /**
    * @brief Initialize all namespaces with default values if they don't exist
    * @return PrefResult indicating success or failure
@@ -77,6 +96,7 @@ public:
                           const String& defaultValue = "");
   static bool getBool(const char* namespaceKey, const char* key, bool defaultValue = false);
   static uint32_t getUInt(const char* namespaceKey, const char* key, uint32_t defaultValue = 0);
+  static uint8_t getUChar(const char* namespaceKey, const char* key, uint8_t defaultValue = 0);
 
   static bool putString(Preferences& prefs, const char* key, const String& value);
   static bool putBool(Preferences& prefs, const char* key, bool value);
@@ -92,6 +112,44 @@ public:
   static PrefResult updateUInt8Value(const char* namespaceKey, const char* key, uint8_t value);
   static PrefResult updateUIntValue(const char* namespaceKey, const char* key, unsigned int value);
 
+  /**
+   * @brief Start collecting cached writes instead of committing each one
+   * @details Batches nest; the outermost commitBatch() writes the changes.
+   */
+  static void beginBatch();
+
+  /**
+   * @brief End a batch and commit every changed namespace in one session each
+   * @return PrefResult indicating success or failure
+   */
+  static PrefResult commitBatch();
+
+  /**
+   * @brief End a batch and drop its changes
+   * @details Every value staged since the outermost beginBatch() is dropped,
+   *          even in a nested batch; the changed namespaces are read from the
+   *          filesystem again on their next access.
+   */
+  static void discardBatch();
+
+  /**
+   * @brief Drop all cached values so the next access reads the filesystem
+   * @details Needed after namespaces were written without the manager, e.g.
+   *          by a restore from backup.
+   */
+  static void invalidateCache();
+
+  /**
+   * @brief Freeze the boot session count reported in CacheStats::bootSessions
+   */
+  static void markBootComplete();
+
+  /**
+   * @brief Get Preferences access statistics
+   * @return Statistics since boot
+   */
+  static const CacheStats& getCacheStats();
+
   // Public initialization functions for individual namespaces
   static PrefResult initGeneralNamespace();
   static PrefResult initWiFiNamespace();
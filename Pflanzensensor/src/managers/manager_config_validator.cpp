@@ -36,6 +36,14 @@ ConfigValidator::ValidationResult ConfigValidator::validateLogLevel(const String
   return ValidationResult::success();
 }
 
+ConfigValidator::ValidationResult ConfigValidator::validateClockFormat(const String& format) {
+  if (format != "12h" && format != "24h") {
+    return ValidationResult::fail(ConfigError::VALIDATION_ERROR,
+                                  F("Ungültiges Uhrzeitformat: ") + format);
+  }
+  return ValidationResult::success();
+}
+
 ConfigValidator::ValidationResult ConfigValidator::validateConfigData(const ConfigData& config) {
   // Validate password
   auto passwordResult = validatePassword(config.adminPassword);
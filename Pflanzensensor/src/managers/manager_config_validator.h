@@ -28,6 +28,13 @@ public:
    */
   static ValidationResult validateLogLevel(const String& level);
 
+  /**
+   * @brief Validates a clock format string
+   * @param format The clock format ("12h" or "24h")
+   * @return ValidationResult indicating success or failure
+   */
+  static ValidationResult validateClockFormat(const String& format);
+
   /**
    * @brief Validate entire configuration data structure
    * @param config Configuration data to validate
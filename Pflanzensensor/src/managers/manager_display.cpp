@@ -27,7 +27,7 @@ extern Logger logger;
 
 TypedResult<ResourceError, void> DisplayManager::initialize() {
 #if USE_DISPLAY
-  logger.debug(F("DisplayM"), F("Initialisiere DisplayManager"));
+  LOG_DEBUG(F("DisplayM"), F("Initialisiere DisplayManager"));
 
   m_display = std::make_unique<SSD1306Display>();
   if (!m_display) {
@@ -52,6 +52,17 @@ TypedResult<ResourceError, void> DisplayManager::initialize() {
     // Do not access sensorManager here!
   }
 
+  // Changes arrive with interrupts disabled; update() reloads the config
+  static constexpr ConfigKey DISPLAY_KEYS[] = {
+      ConfigKey::DISPLAY_CLOCK_FORMAT, ConfigKey::DISPLAY_SCREEN_DURATION,
+      ConfigKey::DISPLAY_SHOW_CLOCK,   ConfigKey::DISPLAY_SHOW_FABMOBIL,
+      ConfigKey::DISPLAY_SHOW_FLOWER,  ConfigKey::DISPLAY_SHOW_IP,
+      ConfigKey::DISPLAY_SHOW_QR};
+  for (ConfigKey key : DISPLAY_KEYS) {
+    ConfigMgr.subscribeConfigKey(
+        key, [this](ConfigKey, const ConfigValue&) { m_configReloadPending = true; });
+  }
+
   logger.info(F("DisplayM"), F("DisplayManager erfolgreich initialisiert"));
   // Do not access sensorManager here!
   return TypedResult<ResourceError, void>::success();
@@ -67,15 +78,14 @@ void DisplayManager::logEnabledSensors() {
 #if USE_DISPLAY
   if (!sensorManager)
     return;
-  String sensorCount =
-      String(F("Anzahl aktivierter Sensoren: ")) + String(sensorManager->getSensors().size());
-  logger.debug(F("DisplayM"), sensorCount);
+  if (!LOG_DEBUG_ENABLED(true))
+    return;
+  LOG_DEBUG(F("DisplayM"), String(F("Anzahl aktivierter Sensoren: ")) +
+                               String(sensorManager->getSensors().size()));
   for (const auto& sensorPtr : sensorManager->getSensors()) {
     if (!sensorPtr || !sensorPtr->isEnabled())
       continue;
-    String sensorId = sensorPtr->getId();
-    String sensorMsg = String(F("Aktiver Sensor: ")) + sensorId;
-    logger.debug(F("DisplayM"), sensorMsg);
+    LOG_DEBUG(F("DisplayM"), String(F("Aktiver Sensor: ")) + sensorPtr->getId());
   }
 #endif
 }
@@ -97,7 +107,7 @@ DisplayResult DisplayManager::loadConfig() {
   }
 
   // Load from Preferences
-  logger.debug(F("DisplayM"), F("Lade Display-Konfiguration aus Preferences..."));
+  LOG_DEBUG(F("DisplayM"), F("Lade Display-Konfiguration aus Preferences..."));
 
   // Load each setting using generic getters
   m_config.showIpScreen = PreferencesManager::getBool(PreferencesNamespaces::DISP, "show_ip", true);
@@ -143,13 +153,12 @@ DisplayResult DisplayManager::loadConfig() {
       }
       sensorStart = semicolonPos + 1;
     }
-    logger.debug(F("DisplayM"), String(F("Sensor-Anzeigeeinstellungen geladen: ")) +
-                                    String(m_config.sensorDisplays.size()) + F(" Sensoren"));
+    LOG_DEBUG(F("DisplayM"), String(F("Sensor-Anzeigeeinstellungen geladen: ")) +
+                                 String(m_config.sensorDisplays.size()) + F(" Sensoren"));
   }
 
   logger.info(F("DisplayM"), F("Display-Konfiguration aus Preferences geladen"));
-  {
-
+  if (LOG_DEBUG_ENABLED(true)) {
     String configMsg =
         String(F("Geladene Konfiguration - IP-Anzeige: ")) + String(m_config.showIpScreen) +
         String(F(", Uhr: ")) + String(m_config.showClock) + String(F(", Blume: ")) +
@@ -157,7 +166,7 @@ DisplayResult DisplayManager::loadConfig() {
         String(m_config.showFabmobilImage) + String(F(", QR-Screen: ")) +
         String(m_config.showQrCode) + String(F(", Dauer: ")) + String(m_config.screenDuration) +
         String(F(", Format: ")) + m_config.clockFormat;
-    logger.debug(F("DisplayM"), configMsg);
+    LOG_DEBUG(F("DisplayM"), configMsg);
   }
 
 #endif
@@ -192,7 +201,7 @@ DisplayResult DisplayManager::saveConfig() {
   CriticalSection cs;
 
   // Save to Preferences using atomic update helpers
-  logger.debug(F("DisplayM"), F("Speichere Display-Konfiguration in Preferences..."));
+  LOG_DEBUG(F("DisplayM"), F("Speichere Display-Konfiguration in Preferences..."));
 
   auto r1 = PreferencesManager::updateBoolValue(PreferencesNamespaces::DISP, "show_ip",
                                                 m_config.showIpScreen);
@@ -235,8 +244,8 @@ DisplayResult DisplayManager::saveConfig() {
   }
 
   logger.info(F("DisplayM"), F("Display-Konfiguration erfolgreich in Preferences gespeichert"));
-  logger.debug(F("DisplayM"),
-               String(F("Sensor-Anzeigeeinstellungen gespeichert: ")) + sensorDisplayStr);
+  LOG_DEBUG(F("DisplayM"),
+            String(F("Sensor-Anzeigeeinstellungen gespeichert: ")) + sensorDisplayStr);
 
   // Note: Sensor-specific display settings (sensorDisplays) are now persisted above
   // through the admin interface and saved atomically when changed
@@ -247,6 +256,11 @@ DisplayResult DisplayManager::saveConfig() {
 
 void DisplayManager::update() {
 #if USE_DISPLAY
+  if (m_configReloadPending) {
+    m_configReloadPending = false;
+    reloadConfig();
+  }
+
   unsigned long currentMillis = millis();
 
   if (currentMillis - m_lastScreenChange >= m_config.screenDuration) {
@@ -306,7 +320,7 @@ void DisplayManager::rotateScreen() {
   // Show static screens
   if (m_config.showIpScreen && currentIndex == 0) {
     if (ConfigMgr.isDebugDisplay()) {
-      logger.debug(F("DisplayM"), F("IP-Anzeige wird angezeigt"));
+      LOG_DEBUG(F("DisplayM"), F("IP-Anzeige wird angezeigt"));
     }
     IPAddress ip;
     // Show softAP IP if we're in AP mode (manual AP started on failure)
@@ -333,7 +347,7 @@ void DisplayManager::rotateScreen() {
   if (m_config.showClock && currentIndex == idx) {
     if (logger.isNTPInitialized()) {
       if (ConfigMgr.isDebugDisplay()) {
-        logger.debug(F("DisplayM"), F("Uhr-Anzeige wird gezeigt"));
+        LOG_DEBUG(F("DisplayM"), F("Uhr-Anzeige wird gezeigt"));
       }
       showClock();
     }
@@ -349,7 +363,7 @@ void DisplayManager::rotateScreen() {
     idx++;
   if (m_config.showQrCode && currentIndex == idx) {
     if (ConfigMgr.isDebugDisplay()) {
-      logger.debug(F("DisplayM"), F("QR-Code-Seite wird gezeigt"));
+      LOG_DEBUG(F("DisplayM"), F("QR-Code-Seite wird gezeigt"));
     }
     m_display->showQrCodeScreen();
     if (ledTrafficLightManager) {
@@ -364,7 +378,7 @@ void DisplayManager::rotateScreen() {
     idx++;
   if (m_config.showFlowerImage && currentIndex == idx) {
     if (ConfigMgr.isDebugDisplay()) {
-      logger.debug(F("DisplayM"), F("Blumenbild wird gezeigt"));
+      LOG_DEBUG(F("DisplayM"), F("Blumenbild wird gezeigt"));
     }
     showImage(displayImageFlower);
     if (ledTrafficLightManager) {
@@ -379,7 +393,7 @@ void DisplayManager::rotateScreen() {
     idx++;
   if (m_config.showFabmobilImage && currentIndex == idx) {
     if (ConfigMgr.isDebugDisplay()) {
-      logger.debug(F("DisplayM"), F("Fabmobil-Bild wird gezeigt"));
+      LOG_DEBUG(F("DisplayM"), F("Fabmobil-Bild wird gezeigt"));
     }
     showImage(displayImageFabmobil);
     if (ledTrafficLightManager) {
@@ -405,8 +419,8 @@ void DisplayManager::rotateScreen() {
         if (config.measurements[i].enabled && isSensorMeasurementShown(sensorPtr->getId(), i)) {
           if (currentMeasurementIdx == measurementIdx) {
             if (ConfigMgr.isDebugDisplay()) {
-              logger.debug(F("DisplayM"), String(F("Zeige Messung ")) + sensorPtr->getId() +
-                                              String(F(":")) + String(i));
+              LOG_DEBUG(F("DisplayM"), String(F("Zeige Messung ")) + sensorPtr->getId() +
+                                           String(F(":")) + String(i));
             }
             showSensorData(sensorPtr->getId(), i);
             m_currentScreenIndex++;
@@ -466,12 +480,13 @@ void DisplayManager::showSensorData(const String& sensorId, size_t measurementIn
           measurementName = measurementData.fieldNames[measurementIndex];
         }
 
-        String sensorMsg = String(F("Zeige Sensor ")) + sensorId + String(F(" Messung ")) +
-                           String(measurementIndex) + String(F(": name=")) + measurementName +
-                           String(F(", Wert=")) + String(measurementData.values[measurementIndex]) +
-                           String(F(", Einheit=")) + measurementData.units[measurementIndex];
-        if (ConfigMgr.isDebugDisplay()) {
-          logger.debug(F("DisplayM"), sensorMsg);
+        if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugDisplay())) {
+          String sensorMsg =
+              String(F("Zeige Sensor ")) + sensorId + String(F(" Messung ")) +
+              String(measurementIndex) + String(F(": name=")) + measurementName +
+              String(F(", Wert=")) + String(measurementData.values[measurementIndex]) +
+              String(F(", Einheit=")) + measurementData.units[measurementIndex];
+          LOG_DEBUG(F("DisplayM"), sensorMsg);
         }
 
         m_display->showMeasurementValue(measurementName, measurementData.values[measurementIndex],
@@ -498,9 +513,9 @@ void DisplayManager::showSensorData(const String& sensorId, size_t measurementIn
         }
 
         if (ConfigMgr.isDebugDisplay()) {
-          logger.debug(F("DisplayM"),
-                       "Sensor status: " + sensor->getStatus(measurementIndex) +
-                           " für Wert: " + String(measurementData.values[measurementIndex]));
+          LOG_DEBUG(F("DisplayM"),
+                    "Sensor status: " + sensor->getStatus(measurementIndex) +
+                        " für Wert: " + String(measurementData.values[measurementIndex]));
         }
       } else {
         String warningMsg = String(F("Ungültiger Messindex ")) + String(measurementIndex) +
@@ -723,7 +738,7 @@ void DisplayManager::showClock() {
   m_display->showClock(dateStr, timeStr);
 
   if (ConfigMgr.isDebugDisplay()) {
-    logger.debug(F("DisplayM"), F("Zeige Uhr: ") + dateStr + " " + timeStr);
+    LOG_DEBUG(F("DisplayM"), F("Zeige Uhr: ") + dateStr + " " + timeStr);
   }
 #endif
 }
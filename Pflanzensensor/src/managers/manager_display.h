@@ -200,6 +200,8 @@ private:
   // Update mode state
   bool m_updateMode = false;
 
+  bool m_configReloadPending = false; ///< A display key changed, reload in update()
+
   // Helper methods
   DisplayResult loadConfig();
   DisplayResult validateConfig();
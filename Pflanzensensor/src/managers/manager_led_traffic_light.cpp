@@ -17,7 +17,7 @@ extern Logger logger;
 
 TypedResult<ResourceError, void> LedTrafficLightManager::initialize() {
 #if USE_LED_TRAFFIC_LIGHT
-  logger.debug(F("LedTrafficLight"), F("Initialisiere LedTrafficLightManager"));
+  LOG_DEBUG(F("LedTrafficLight"), F("Initialisiere LedTrafficLightManager"));
 
   m_ledLights = std::make_unique<LedLights>();
   if (!m_ledLights) {
@@ -35,10 +35,16 @@ TypedResult<ResourceError, void> LedTrafficLightManager::initialize() {
         F("Initialisierung der LED-Ampel fehlgeschlagen: ") + initResult.getMessage());
   }
 
+  // Changes arrive with interrupts disabled; the LEDs follow in
+  // updateSelectedMeasurementStatus()
+  auto onChange = [this](ConfigKey, const ConfigValue&) { m_configChanged = true; };
+  ConfigMgr.subscribeConfigKey(ConfigKey::LED_MODE, onChange);
+  ConfigMgr.subscribeConfigKey(ConfigKey::LED_SELECTED_MEASUREMENT, onChange);
+
   logger.info(F("LedTrafficLight"), F("LedTrafficLightManager erfolgreich initialisiert"));
   return TypedResult<ResourceError, void>::success();
 #else
-  logger.debug(F("LedTrafficLight"), F("LED traffic light disabled, skipping initialization"));
+  LOG_DEBUG(F("LedTrafficLight"), F("LED traffic light disabled, skipping initialization"));
   return TypedResult<ResourceError, void>::success();
 #endif
 }
@@ -110,6 +116,14 @@ void LedTrafficLightManager::turnOffAllLeds() {
 
 void LedTrafficLightManager::updateSelectedMeasurementStatus() {
 #if USE_LED_TRAFFIC_LIGHT
+  // A new mode or measurement starts dark, so no status of the old one stays
+  // lit; mode 0 keeps the LEDs off
+  if (m_configChanged) {
+    m_configChanged = false;
+    turnOffAllLeds();
+    m_lastStatus = "";
+  }
+
   // Only update if we're in mode 2 and have a selected measurement
   if (ConfigMgr.getLedTrafficLightMode() == 2 &&
       !ConfigMgr.getLedTrafficLightSelectedMeasurement().isEmpty()) {
@@ -77,7 +77,8 @@ public:
   /**
    * @brief Update LED status for the selected measurement in mode 2
    * @details This method should be called periodically to ensure the LED shows
-   *          the current status of the selected measurement
+   *          the current status of the selected measurement. After the mode or
+   *          the selected measurement changed, the LEDs are switched off first.
    */
   void updateSelectedMeasurementStatus();
 
@@ -106,7 +107,8 @@ private:
 #if USE_LED_TRAFFIC_LIGHT
   std::unique_ptr<LedLights> m_ledLights;
 #endif
-  String m_lastStatus; ///< Last set status for tracking
+  String m_lastStatus;        ///< Last set status for tracking
+  bool m_configChanged{false}; ///< LED mode or selected measurement changed
 };
 
 /**
@@ -85,7 +85,7 @@ void ResourceManager::exitCriticalOperation() {
   if (!ConfigMgr.getDoFirmwareUpgrade()) {
     // Recreate and initialize sensor manager if it was reset
     if (!m_sensorManager) {
-      logger.debug(F("ResourceM"), F("Sensor-Manager neu erstellen"));
+      LOG_DEBUG(F("ResourceM"), F("Sensor-Manager neu erstellen"));
       try {
         m_sensorManager = std::make_unique<SensorManager>();
         if (m_sensorManager) {
@@ -124,7 +124,7 @@ ResourceResult ResourceManager::initMinimalSystem() {
 
   // Stop all sensors first
   if (m_sensorManager) {
-    logger.debug(F("ResourceM"), F("Stopping all sensors"));
+    LOG_DEBUG(F("ResourceM"), F("Stopping all sensors"));
     m_sensorManager->stopAll();
     m_sensorManager.reset();
   }
@@ -228,15 +228,15 @@ void ResourceManager::logMemoryStatus(const String& phase) {
   uint32_t maxFreeBlock = ESP.getMaxFreeBlockSize();
   float fragmentation = 100.0f - ((float)maxFreeBlock / (float)freeHeap) * 100.0f;
 
-  logger.debug(F("ResourceM"), F("Speicherstatistiken [") + phase + F("]:"));
-  logger.debug(F("ResourceM"), F("- Freier Heap: ") + String(freeHeap) + F(" Bytes"));
-  logger.debug(F("ResourceM"), F("- Größter freier Block: ") + String(maxFreeBlock) + F(" Bytes"));
-  logger.debug(F("ResourceM"), F("- Fragmentierung: ") + String(fragmentation, 0) + F("%"));
-  logger.debug(F("ResourceM"),
-               F("- Freier Cont-Stack: ") + String(ESP.getFreeContStack()) + F(" Bytes"));
-  logger.debug(F("ResourceM"), F("- Freier Stack: ") +
-                                   String(ESP.getFreeHeap() - ESP.getHeapFragmentation()) +
-                                   F(" Bytes"));
+  LOG_DEBUG(F("ResourceM"), F("Speicherstatistiken [") + phase + F("]:"));
+  LOG_DEBUG(F("ResourceM"), F("- Freier Heap: ") + String(freeHeap) + F(" Bytes"));
+  LOG_DEBUG(F("ResourceM"), F("- Größter freier Block: ") + String(maxFreeBlock) + F(" Bytes"));
+  LOG_DEBUG(F("ResourceM"), F("- Fragmentierung: ") + String(fragmentation, 0) + F("%"));
+  LOG_DEBUG(F("ResourceM"),
+            F("- Freier Cont-Stack: ") + String(ESP.getFreeContStack()) + F(" Bytes"));
+  LOG_DEBUG(F("ResourceM"), F("- Freier Stack: ") +
+                                String(ESP.getFreeHeap() - ESP.getHeapFragmentation()) +
+                                F(" Bytes"));
 }
 
 void ResourceManager::cleanup() {
@@ -247,7 +247,7 @@ void ResourceManager::cleanup() {
 
   // Reset all services
   if (m_sensorManager) {
-    logger.debug(F("ResourceM"), F("Beende Sensor-Manager"));
+    LOG_DEBUG(F("ResourceM"), F("Beende Sensor-Manager"));
     m_sensorManager->stopAll();
     m_sensorManager.reset();
   }
@@ -12,8 +12,8 @@ std::unique_ptr<SensorManager> sensorManager;
 // implementations that might be needed in the future.
 
 void SensorManager::applySensorSettingsFromConfig() {
-  if (ConfigMgr.isDebugSensor()) {
-    logger.debug(F("SensorM"), F("Wende Sensoreinstellungen aus der Konfiguration an"));
+  if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugSensor())) {
+    LOG_DEBUG(F("SensorM"), F("Wende Sensoreinstellungen aus der Konfiguration an"));
   }
 
   logger.info(F("SensorM"), F("Sensoreinstellungen aus der Konfiguration werden angewendet"));
@@ -26,9 +26,136 @@ void SensorManager::applySensorSettingsFromConfig() {
     return;
   }
 
-  if (ConfigMgr.isDebugSensor()) {
-    logger.debug(F("SensorM"), F("Sensor-Konfiguration erfolgreich aus Datei geladen"));
+  if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugSensor())) {
+    LOG_DEBUG(F("SensorM"), F("Sensor-Konfiguration erfolgreich aus Datei geladen"));
   }
 
   logger.info(F("SensorM"), F("Sensoreinstellungen erfolgreich angewendet"));
 }
+
+void SensorManager::updateMeasurements() {
+  if (getState() != ManagerState::INITIALIZED) {
+    return;
+  }
+
+  unsigned long now = millis();
+
+  // Idle tick: nothing at the top of the heap is due (O(1))
+  if (m_wakeHeap.empty()) {
+    m_nextWakeTime = now + MAX_WAKE_INTERVAL;
+    return;
+  }
+  if (isLater(m_schedule[m_wakeHeap.front()].wakeTime, now)) {
+    m_nextWakeTime = m_schedule[m_wakeHeap.front()].wakeTime;
+    return;
+  }
+
+  auto laterFirst = [this](uint8_t a, uint8_t b) {
+    return isLater(m_schedule[a].wakeTime, m_schedule[b].wakeTime);
+  };
+
+  // Pop every due entry first so each sensor is serviced at most once per
+  // call, even if its new wake-up time is "now" again
+  m_dueScratch.clear();
+  while (!m_wakeHeap.empty() && !isLater(m_schedule[m_wakeHeap.front()].wakeTime, now)) {
+    std::pop_heap(m_wakeHeap.begin(), m_wakeHeap.end(), laterFirst);
+    m_dueScratch.push_back(m_wakeHeap.back());
+    m_wakeHeap.pop_back();
+  }
+
+  for (uint8_t index : m_dueScratch) {
+    serviceEntry(m_schedule[index]);
+    m_wakeHeap.push_back(index);
+    std::push_heap(m_wakeHeap.begin(), m_wakeHeap.end(), laterFirst);
+
+    // Allow other processes to run
+    yield();
+  }
+
+  m_nextWakeTime = m_schedule[m_wakeHeap.front()].wakeTime;
+}
+
+void SensorManager::serviceEntry(ScheduleEntry& entry) {
+  Sensor* sensor = entry.sensor;
+  SensorMeasurementCycleManager* cycleManager = entry.cycleManager.get();
+  unsigned long now = millis();
+
+  // Disabled sensors are re-checked once per MAX_WAKE_INTERVAL
+  if (!sensor || !cycleManager || !sensor->isEnabled()) {
+    entry.wakeTime = now + MAX_WAKE_INTERVAL;
+    return;
+  }
+
+  MeasurementState currentState = cycleManager->getCurrentState();
+  auto& stateLog = entry.stateLog;
+
+  // Prüfe auf Zustandsänderungen und aktualisiere Tracking
+  bool stateChanged = (currentState != stateLog.lastState);
+  stateLog.lastState = currentState; // Zustand sofort aktualisieren
+
+  // Nur tatsächliche Zustandsänderungen loggen
+  if (stateChanged && LOG_DEBUG_ENABLED(ConfigMgr.isDebugMeasurementCycle())) {
+    LOG_DEBUG(F("SensorManager"), F("Sensor: ") + sensor->getId() + F(" Zustand: ") +
+                                      String(static_cast<int>(currentState)) +
+                                      F(" (geändert)"));
+    stateLog.lastStateLogTime = now;
+  }
+
+  // Messzyklus verarbeiten wenn:
+  // 1. Sensor ist im Zustand WAITING_FOR_DUE und ist fällig, oder
+  // 2. Sensor ist in einem anderen aktiven Zustand
+  bool shouldProcess =
+      (currentState == MeasurementState::WAITING_FOR_DUE && cycleManager->isDue()) ||
+      (currentState != MeasurementState::WAITING_FOR_DUE);
+
+  if (shouldProcess) {
+    bool cycleResult = cycleManager->updateMeasurementCycle();
+    bool resultChanged = (cycleResult != stateLog.lastUpdateResult);
+    stateLog.lastUpdateResult = cycleResult; // Ergebnis sofort aktualisieren
+
+    // Nur bei Ergebnisänderungen loggen
+    if (resultChanged && LOG_DEBUG_ENABLED(ConfigMgr.isDebugMeasurementCycle())) {
+      LOG_DEBUG(F("SensorManager"), F("Sensor: ") + sensor->getId() + F(" Zyklus: ") +
+                                        (cycleResult ? F("Abgeschlossen") : F("In Bearbeitung")) +
+                                        F(" (geändert)"));
+    }
+  }
+
+  entry.wakeTime = cycleManager->getNextWakeTime(millis());
+}
+
+void SensorManager::rebuildWakeHeap() {
+  m_wakeHeap.clear();
+  m_wakeHeap.reserve(m_schedule.size());
+  for (size_t i = 0; i < m_schedule.size(); i++) {
+    m_wakeHeap.push_back(static_cast<uint8_t>(i));
+  }
+  std::make_heap(m_wakeHeap.begin(), m_wakeHeap.end(), [this](uint8_t a, uint8_t b) {
+    return isLater(m_schedule[a].wakeTime, m_schedule[b].wakeTime);
+  });
+}
+
+SensorManager::ScheduleEntry* SensorManager::findScheduleEntry(SensorHandle handle) {
+  if (handle == INVALID_SENSOR_HANDLE) {
+    return nullptr;
+  }
+  for (auto& entry : m_schedule) {
+    if (entry.sensor && entry.sensor->getHandle() == handle) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+const SensorManager::ScheduleEntry*
+SensorManager::findScheduleEntry(SensorHandle handle) const {
+  if (handle == INVALID_SENSOR_HANDLE) {
+    return nullptr;
+  }
+  for (const auto& entry : m_schedule) {
+    if (entry.sensor && entry.sensor->getHandle() == handle) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
@@ -10,8 +10,10 @@
 #ifndef MANAGER_SENSOR_H
 #define MANAGER_SENSOR_H
 
+#include <algorithm>
 #include <map>
 #include <memory>
+#include <vector>
 
 #include "configs/config_validation_rules.h"
 #include "managers/manager_base.h"
@@ -45,73 +47,45 @@ public:
   ~SensorManager() { cleanup(); }
 
   /**
-   * @brief Updates measurements for all enabled sensors
-   * @details Processes each sensor's measurement cycle and handles state
-   * transitions. This method:
-   *          - Checks each sensor's enabled status
+   * @brief Updates measurements for all sensors whose wake-up time has come
+   * @details Sensors are kept in a min-heap ordered by the wake-up time their
+   * cycle manager reports. Only entries at the top of the heap that are due
+   * are serviced; an idle tick costs a single comparison. This method:
+   *          - Pops all due entries from the heap
    *          - Manages measurement state transitions
    *          - Processes measurement cycles when appropriate
    *          - Handles debug logging of state changes
-   * @note Only processes sensors if the manager is in INITIALIZED state
+   *          - Re-inserts each entry with its new wake-up time
+   * @note Only processes sensors if the manager is in INITIALIZED state.
+   * Afterwards getNextWakeTime() returns the earliest wake-up reported by the
+   * cycle managers, so the caller only needs to call again at that time.
    */
-  void updateMeasurements() {
-    if (getState() != ManagerState::INITIALIZED) { // Using getState() from
-                                                   // Manager base class
-      return;
-    }
-
-    for (const auto& sensor : m_sensors) {
-      if (!sensor || !sensor->isEnabled()) {
-        continue;
-      }
-
-      auto& stateLog = m_sensorStates[sensor->getId()];
-      auto cycleManager = m_cycleManagers[sensor->getId()].get();
-
-      if (!cycleManager) {
-        logger.error(F("SensorManager"), F("Kein Zyklusmanager für Sensor: ") + sensor->getId());
-        continue;
-      }
-
-      MeasurementState currentState = cycleManager->getCurrentState();
-      unsigned long now = millis();
-
-      // Prüfe auf Zustandsänderungen und aktualisiere Tracking
-      bool stateChanged = (currentState != stateLog.lastState);
-      stateLog.lastState = currentState; // Zustand sofort aktualisieren
+  void updateMeasurements();
 
-      // Nur tatsächliche Zustandsänderungen loggen
-      if (stateChanged && ConfigMgr.isDebugMeasurementCycle()) {
-        logger.debug(F("SensorManager"), F("Sensor: ") + sensor->getId() + F(" Zustand: ") +
-                                             String(static_cast<int>(currentState)) +
-                                             F(" (geändert)"));
-        stateLog.lastStateLogTime = now;
-      }
+  /**
+   * @brief Gets the millis() time at which updateMeasurements() is needed next
+   * @return Earliest wake-up time of all cycle managers (rollover-safe compare
+   *         with static_cast<long>(now - getNextWakeTime()) >= 0)
+   */
+  unsigned long getNextWakeTime() const { return m_nextWakeTime; }
 
-      // Messzyklus verarbeiten wenn:
-      // 1. Sensor ist im Zustand WAITING_FOR_DUE und ist fällig, oder
-      // 2. Sensor ist in einem anderen aktiven Zustand
-      bool shouldProcess =
-          (currentState == MeasurementState::WAITING_FOR_DUE && cycleManager->isDue()) ||
-          (currentState != MeasurementState::WAITING_FOR_DUE);
-
-      if (shouldProcess) {
-        bool cycleResult = cycleManager->updateMeasurementCycle();
-        bool resultChanged = (cycleResult != stateLog.lastUpdateResult);
-        stateLog.lastUpdateResult = cycleResult; // Ergebnis sofort aktualisieren
-
-        // Nur bei Ergebnisänderungen loggen
-        if (resultChanged && ConfigMgr.isDebugMeasurementCycle()) {
-          logger.debug(F("SensorManager"),
-                       F("Sensor: ") + sensor->getId() + F(" Zyklus: ") +
-                           (cycleResult ? F("Abgeschlossen") : F("In Bearbeitung")) +
-                           F(" (geändert)"));
-        }
-      }
+  /**
+   * @brief Gets the cycle manager of a sensor
+   * @param id The unique identifier of the sensor
+   * @return Pointer to the cycle manager, nullptr if none exists
+   */
+  const SensorMeasurementCycleManager* getCycleManager(const String& id) const {
+    return getCycleManager(SensorRegistry::find(id));
+  }
 
-      // Allow other processes to run
-      yield();
-    }
+  /**
+   * @brief Gets the cycle manager of a sensor
+   * @param handle Handle of the sensor
+   * @return Pointer to the cycle manager, nullptr if none exists
+   */
+  const SensorMeasurementCycleManager* getCycleManager(SensorHandle handle) const {
+    const ScheduleEntry* entry = findScheduleEntry(handle);
+    return entry ? entry->cycleManager.get() : nullptr;
   }
 
   /**
@@ -138,7 +112,7 @@ public:
    * @return SensorResult indicating success or failure
    */
   SensorResult stopAll() {
-    logger.debug(F("SensorManager"), F("stopAll aufgerufen"));
+    LOG_DEBUG(F("SensorManager"), F("stopAll aufgerufen"));
     for (auto& sensor : m_sensors) {
       if (sensor) {
         sensor->stop();
@@ -156,7 +130,9 @@ public:
    */
   void cleanup() {
     stopAll();
-    m_cycleManagers.clear();
+    m_wakeHeap.clear();
+    m_dueScratch.clear();
+    m_schedule.clear();
     m_sensors.clear();
   }
 
@@ -166,11 +142,13 @@ public:
    * @return true if successful, false otherwise
    */
   bool forceImmediateMeasurement(const String& id) {
-    auto it = m_cycleManagers.find(id);
-    if (it == m_cycleManagers.end() || !it->second)
+    ScheduleEntry* entry = findScheduleEntry(SensorRegistry::find(id));
+    if (!entry || !entry->cycleManager)
       return false;
-    auto* cycleManager = it->second.get();
-    cycleManager->forceImmediateMeasurement();
+    entry->cycleManager->forceImmediateMeasurement();
+    entry->wakeTime = millis();
+    rebuildWakeHeap();
+    m_nextWakeTime = entry->wakeTime;
     return true;
   }
 
@@ -210,7 +188,7 @@ protected:
         // Überspringe Re-Initialisierung für Sensoren, die während der Fabrikprüfung deinitialisiert wurden
         // Verhindert Zugriff auf freigegebene Messdaten
         if (!sensor->isInitialized()) {
-          logger.debug(
+          LOG_DEBUG(
               F("SensorM"),
               F("Zuvor fehlgeschlagener Sensor ") + sensor->getName() +
                   F(" wurde während der Fabrikprüfung deinitialisiert, Fehlerflag wird entfernt"));
@@ -235,37 +213,43 @@ protected:
     }
 
     // Logge Details zu aktivierten Sensoren
-    logger.debug(F("SensorM"), F("Überprüfe aktivierte Sensoren:"));
+    LOG_DEBUG(F("SensorM"), F("Überprüfe aktivierte Sensoren:"));
     for (const auto& sensor : m_sensors) {
-      if (sensor) {
+      if (sensor && LOG_DEBUG_ENABLED(true)) {
         String msg = F("Sensor-ID: ");
         msg += sensor->getId();
         msg += F(", Name: ");
         msg += sensor->getName();
         msg += F(", Aktiviert: ");
         msg += sensor->isEnabled() ? F("ja") : F("nein");
-        logger.debug(F("SensorM"), msg);
+        LOG_DEBUG(F("SensorM"), msg);
       }
     }
 
     // Zyklusmanager für jeden Sensor erstellen
     size_t enabledCount = 0;
+    m_schedule.clear();
+    m_schedule.reserve(m_sensors.size());
     for (auto& sensor : m_sensors) {
       if (sensor && sensor->isEnabled()) {
-        auto cycleManager = std::make_unique<SensorMeasurementCycleManager>(sensor.get());
-        String sensorId = sensor->getId();
-        m_cycleManagers[sensorId] = std::move(cycleManager);
+        ScheduleEntry entry;
+        entry.sensor = sensor.get();
+        entry.cycleManager = std::make_unique<SensorMeasurementCycleManager>(sensor.get());
+        entry.wakeTime = millis();
+        m_schedule.push_back(std::move(entry));
         enabledCount++;
-        logger.debug(F("SensorM"), F("Zyklusmanager für Sensor erstellt: ") + sensorId);
+        LOG_DEBUG(F("SensorM"), F("Zyklusmanager für Sensor erstellt: ") + sensor->getId());
       }
     }
 
-    String msg = F("Es wurden ");
-    msg += String(enabledCount);
-    msg += F(" Zyklusmanager von insgesamt ");
-    msg += String(m_sensors.size());
-    msg += F(" Sensoren erstellt");
-    logger.debug(F("SensorM"), msg);
+    // Heap und Scratch-Puffer einmalig anlegen (keine Allokation pro Tick)
+    m_dueScratch.reserve(m_schedule.size());
+    rebuildWakeHeap();
+    m_nextWakeTime = millis();
+
+    LOG_DEBUG(F("SensorM"), F("Es wurden ") + String(enabledCount) +
+                                F(" Zyklusmanager von insgesamt ") + String(m_sensors.size()) +
+                                F(" Sensoren erstellt"));
 
     logger.info(F("SensorM"), F("Initialisierung des Sensormanagers abgeschlossen mit ") +
                                   String(m_sensors.size()) + F(" Sensoren (") +
@@ -288,10 +272,7 @@ protected:
 
 private:
   static constexpr unsigned long MEMORY_LOG_INTERVAL = 60000; // 1 minute
-
-  std::vector<std::unique_ptr<Sensor>> m_sensors;
-  std::map<String, std::unique_ptr<SensorMeasurementCycleManager>> m_cycleManagers;
-  unsigned long m_lastMemoryLog{0};
+  static constexpr unsigned long MAX_WAKE_INTERVAL = 1000;    // Re-check of disabled sensors
 
   /**
    * @struct SensorStateLog
@@ -304,7 +285,49 @@ private:
     static constexpr unsigned long LOG_THROTTLE_INTERVAL =
         5000; // Only log same state every 5 seconds
   };
-  std::map<String, SensorStateLog> m_sensorStates;
+
+  /**
+   * @struct ScheduleEntry
+   * @brief Cycle manager, state log and wake-up time of one enabled sensor
+   */
+  struct ScheduleEntry {
+    Sensor* sensor{nullptr};                                     ///< Scheduled sensor
+    std::unique_ptr<SensorMeasurementCycleManager> cycleManager; ///< Its cycle manager
+    unsigned long wakeTime{0};                                   ///< Next service time
+    SensorStateLog stateLog;                                     ///< Debug state tracking
+  };
+
+  /**
+   * @brief Rollover-safe ordering of millis() timestamps
+   * @return true if @p a is later than @p b (valid while both lie within 2^31 ms)
+   */
+  static bool isLater(unsigned long a, unsigned long b) { return static_cast<long>(a - b) > 0; }
+
+  /**
+   * @brief Service one due schedule entry and compute its next wake-up time
+   * @param entry Entry to service
+   */
+  void serviceEntry(ScheduleEntry& entry);
+
+  /**
+   * @brief Restore the heap property after wake times changed outside the heap
+   */
+  void rebuildWakeHeap();
+
+  /**
+   * @brief Find the schedule entry of a sensor
+   * @param handle Sensor handle
+   * @return Pointer to the entry, nullptr if the sensor is not scheduled
+   */
+  ScheduleEntry* findScheduleEntry(SensorHandle handle);
+  const ScheduleEntry* findScheduleEntry(SensorHandle handle) const;
+
+  std::vector<std::unique_ptr<Sensor>> m_sensors;
+  std::vector<ScheduleEntry> m_schedule; ///< One entry per enabled sensor
+  std::vector<uint8_t> m_wakeHeap;       ///< Min-heap of indices into m_schedule by wakeTime
+  std::vector<uint8_t> m_dueScratch;     ///< Entries popped in the current tick
+  unsigned long m_lastMemoryLog{0};
+  unsigned long m_nextWakeTime{0}; ///< Earliest wake-up of all cycle managers
 };
 
 #endif // MANAGER_SENSOR_H
@@ -6,14 +6,17 @@
 #include "manager_sensor_persistence.h"
 
 #include <LittleFS.h>
-#include <map>
+
+#include <vector>
 
 #include "../logger/logger.h"
 #include "../utils/json_file_utils.h"
+#include "../utils/log_store.h"
 #include "managers/manager_config.h"
 #include "managers/manager_config_preferences.h"
 #include "managers/manager_resource.h"
 #include "managers/manager_sensor.h"
+#include "sensors/sensor_count.h"
 #include "sensors/sensors.h"
 #if USE_ANALOG
 #include "sensors/sensor_analog.h"
@@ -21,43 +24,565 @@
 #include "sensors/sensor_autocalibration.h"
 
 // Write-behind cache: Instead of writing immediately, we collect all changes
-// in RAM and flush them periodically (e.g., every 60 seconds). This drastically
-// reduces flash wear and eliminates blocking writes during measurements.
-enum class PendingUpdateType {
-  RAW_MIN_MAX,       // int absoluteRawMin, absoluteRawMax
-  ABSOLUTE_MIN_MAX,  // float absoluteMin, absoluteMax
-  CALIBRATED_MIN_MAX // int minValue, maxValue, bool inverted
+// in RAM and flush them periodically (SENSOR_PERSISTENCE_FLUSH_INTERVAL), on
+// reboot requests and on low heap. This drastically reduces flash wear and
+// eliminates blocking writes during measurements.
+//
+// The cache is a fixed table with one entry per (sensor, measurement). Every
+// field group has a dirty bit, so the key is (sensor, measurement, field) and
+// a newer update overwrites the superseded value in place. A flush applies all
+// dirty fields of an entry to its store record, so each measurement is written
+// once.
+enum PendingField : uint8_t {
+  FIELD_RAW_MIN_MAX = 1 << 0,        // int absoluteRawMin, absoluteRawMax
+  FIELD_ABSOLUTE_MIN_MAX = 1 << 1,   // float absoluteMin, absoluteMax
+  FIELD_CALIBRATED_MIN_MAX = 1 << 2, // int minValue, maxValue, bool inverted
+  FIELD_LAST_VALUE = 1 << 3          // float lastValue, int lastRawValue
 };
 
-struct PendingUpdate {
-  PendingUpdateType type;
-  String sensorId;
-  size_t measurementIndex;
-  unsigned long timestamp; // When this update was queued
-
-  // Union to save memory - only one set of values is active at a time
-  union {
-    struct {
-      int absoluteRawMin;
-      int absoluteRawMax;
-    } raw;
-    struct {
-      float absoluteMin;
-      float absoluteMax;
-    } absolute;
-    struct {
-      int minValue;
-      int maxValue;
-      bool inverted;
-    } calibrated;
-  } data;
+struct PendingEntry {
+  SensorHandle sensor;
+  uint8_t measurementIndex;
+  uint8_t dirty;          // PendingField bits, 0 = slot free
+  unsigned long queuedAt; // millis() when the entry became dirty
+  int absoluteRawMin;
+  int absoluteRawMax;
+  float absoluteMin;
+  float absoluteMax;
+  int minValue;
+  int maxValue;
+  bool inverted;
+  float lastValue;
+  int lastRawValue;
 };
 
-static std::vector<PendingUpdate> g_pendingUpdates;
+// One entry per measurement of all configured sensors
+static constexpr size_t MAX_PENDING_ENTRIES =
+    SensorCounter::getTotalMeasurementCount() > 0 ? SensorCounter::getTotalMeasurementCount() : 1;
+
+static PendingEntry g_pendingEntries[MAX_PENDING_ENTRIES];
+static size_t g_pendingFields = 0; // Dirty fields over all entries
+static SensorPersistence::FlushStats g_flushStats;
+
+/**
+ * @brief Number of dirty fields of an entry
+ */
+static size_t countFields(uint8_t dirty) {
+  size_t count = 0;
+  for (; dirty; dirty &= dirty - 1) {
+    count++;
+  }
+  return count;
+}
+
+/**
+ * @brief Find the entry of a sensor/measurement or claim a free one
+ * @details If the table is full, the sensor of the oldest entry is flushed
+ *          first to make room.
+ * @return Entry to update, nullptr if no slot could be freed
+ */
+static PendingEntry* acquirePendingEntry(SensorHandle sensor, size_t measurementIndex) {
+  for (int attempt = 0; attempt < 2; attempt++) {
+    PendingEntry* freeEntry = nullptr;
+    PendingEntry* oldest = nullptr;
+    for (auto& e : g_pendingEntries) {
+      if (e.dirty == 0) {
+        if (!freeEntry) {
+          freeEntry = &e;
+        }
+        continue;
+      }
+      if (e.sensor == sensor && e.measurementIndex == measurementIndex) {
+        return &e;
+      }
+      if (!oldest || static_cast<long>(e.queuedAt - oldest->queuedAt) < 0) {
+        oldest = &e;
+      }
+    }
+
+    if (freeEntry) {
+      freeEntry->sensor = sensor;
+      freeEntry->measurementIndex = static_cast<uint8_t>(measurementIndex);
+      freeEntry->queuedAt = millis();
+      return freeEntry;
+    }
+
+    logger.warning(F("SensorP"), F("Sensor-Cache voll, schreibe ältesten Sensor vorzeitig"));
+    SensorPersistence::flushPendingUpdatesForSensor(oldest->sensor);
+  }
+  return nullptr;
+}
+
+/**
+ * @brief Mark a field dirty and update the queue metrics
+ */
+static void markPendingField(PendingEntry& e, uint8_t field) {
+  if (e.dirty & field) {
+    g_flushStats.updatesCoalesced++;
+    return;
+  }
+  e.dirty |= field;
+  g_pendingFields++;
+  g_flushStats.updatesQueued++;
+  if (g_pendingFields > g_flushStats.pendingHighWater) {
+    g_flushStats.pendingHighWater = g_pendingFields;
+  }
+}
+
+// ============================================================================
+// Measurement store: log-structured records instead of one JSON file per
+// measurement. Every measurement is one packed, versioned binary record plus
+// one string-table record; the sensor-wide interval is a record of its own.
+// ============================================================================
+
+/**
+ * @brief Zentrale Feld-Definition für alle MeasurementConfig-Felder
+ * Diese Macro-Liste ist die EINZIGE Stelle, die bei neuen Feldern geändert werden muss!
+ */
+#define MEASUREMENT_FIELDS                                                                         \
+  FIELD(enabled, bool)                                                                             \
+  FIELD(name, String)                                                                              \
+  FIELD(fieldName, String)                                                                         \
+  FIELD(unit, String)                                                                              \
+  FIELD(minValue, float)                                                                           \
+  FIELD(maxValue, float)                                                                           \
+  FIELD(trimFraction, float)                                                                       \
+  FIELD(hampelThreshold, float)                                                                    \
+  FIELD(inverted, bool)                                                                            \
+  FIELD(calibrationMode, bool)                                                                     \
+  FIELD(autocalHalfLifeSeconds, uint32_t)                                                          \
+  FIELD(absoluteRawMin, int)                                                                       \
+  FIELD(absoluteRawMax, int)                                                                       \
+  FIELD(absoluteMin, float)                                                                        \
+  FIELD(absoluteMax, float)                                                                        \
+  FIELD(lastRawValue, int)                                                                         \
+  FIELD(lastValue, float)
+
+/// Record types of a measurement key
+enum MeasurementRecord : uint8_t {
+  RECORD_VALUES = 0,      // PackedMeasurement
+  RECORD_STRINGS = 1,     // name, fieldName, unit as NUL-terminated string table
+  RECORD_INTERVAL = 2,    // Sensor-wide measurement interval (SENSOR_RECORD_INDEX only)
+  RECORD_SENSOR_TABLE = 3 // Sensor IDs in tag order (SENSOR_TABLE_KEY only)
+};
+
+/// Measurement index of sensor-wide records
+static constexpr size_t SENSOR_RECORD_INDEX = 0xFF;
+
+/// Key of the sensor ID table; tag 0 is never assigned to a sensor
+static constexpr uint32_t SENSOR_TABLE_KEY = RECORD_SENSOR_TABLE;
+
+/// Key of a sensor without tag; never stored
+static constexpr uint32_t NO_MEASUREMENT_KEY = UINT32_MAX;
+
+/// Sensor IDs that fit into the table record
+static constexpr size_t MAX_SENSOR_TAGS = LogStore::MAX_VALUE_SIZE / SensorRegistry::ID_LEN;
+
+/// Current PackedMeasurement schema. Fields are only appended; a shorter
+/// record of an older schema keeps the defaults for the missing fields.
+static constexpr uint8_t MEASUREMENT_RECORD_VERSION = 1;
+
+/**
+ * @brief On-flash layout of the numeric fields of a measurement
+ */
+struct __attribute__((packed)) PackedMeasurement {
+  uint8_t version;
+  uint8_t flags; // PACKED_* bits
+  uint8_t aggregation;
+  float minValue;
+  float maxValue;
+  float trimFraction;
+  float hampelThreshold;
+  float yellowLow;
+  float greenLow;
+  float greenHigh;
+  float yellowHigh;
+  uint32_t autocalHalfLifeSeconds;
+  int32_t absoluteRawMin;
+  int32_t absoluteRawMax;
+  float absoluteMin;
+  float absoluteMax;
+  int32_t lastRawValue;
+  float lastValue;
+};
+
+enum PackedFlag : uint8_t {
+  PACKED_ENABLED = 1 << 0,
+  PACKED_INVERTED = 1 << 1,
+  PACKED_CALIBRATION_MODE = 1 << 2
+};
+
+static_assert(sizeof(PackedMeasurement) <= LogStore::MAX_VALUE_SIZE,
+              "PackedMeasurement does not fit into one record");
+
+static const char MEASUREMENT_STORE_PATH[] = "/config/measurements.log";
+
+// Two records per measurement, one interval record per sensor and the sensor table
+static LogStore g_measurementStore(MEASUREMENT_STORE_PATH, MEASUREMENT_STORE_SEGMENT_SIZE,
+                                   MAX_PENDING_ENTRIES * 3 + 1);
+
+static SensorPersistence::LoadStats g_loadStats;
+
+/// Sensor IDs by tag - 1, as stored under SENSOR_TABLE_KEY
+static char g_sensorTags[MAX_SENSOR_TAGS][SensorRegistry::ID_LEN];
+static size_t g_sensorTagCount = 0;
+
+/**
+ * @brief Load the sensor ID table of the mounted store
+ */
+static void loadSensorTags() {
+  char table[LogStore::MAX_VALUE_SIZE];
+  size_t length;
+  g_sensorTagCount = 0;
+  if (!g_measurementStore.read(SENSOR_TABLE_KEY, table, sizeof(table), length)) {
+    return;
+  }
+  size_t pos = 0;
+  while (pos < length && g_sensorTagCount < MAX_SENSOR_TAGS) {
+    size_t n = strnlen(table + pos, length - pos);
+    if (n == 0 || n >= SensorRegistry::ID_LEN) {
+      break;
+    }
+    memcpy(g_sensorTags[g_sensorTagCount], table + pos, n);
+    g_sensorTags[g_sensorTagCount][n] = '\0';
+    g_sensorTagCount++;
+    pos += n + 1;
+  }
+}
+
+/**
+ * @brief Append a sensor ID to the table without committing
+ * @details The table record is appended before the records that use the new
+ *          tag, so a committed measurement always finds its tag at mount.
+ * @return true if the ID got a tag
+ */
+static bool assignSensorTag(const String& sensorId) {
+  if (g_sensorTagCount >= MAX_SENSOR_TAGS || sensorId.length() == 0 ||
+      sensorId.length() >= SensorRegistry::ID_LEN) {
+    logger.error(F("SensorP"), F("Keine Speicherkennung für Sensor ") + sensorId);
+    return false;
+  }
+  memcpy(g_sensorTags[g_sensorTagCount], sensorId.c_str(), sensorId.length() + 1);
+
+  char table[LogStore::MAX_VALUE_SIZE];
+  size_t length = 0;
+  for (size_t i = 0; i <= g_sensorTagCount; i++) {
+    size_t n = strlen(g_sensorTags[i]) + 1;
+    memcpy(table + length, g_sensorTags[i], n);
+    length += n;
+  }
+  if (!g_measurementStore.append(SENSOR_TABLE_KEY, table, length)) {
+    return false;
+  }
+  g_sensorTagCount++;
+  return true;
+}
+
+/**
+ * @brief Record key of a measurement
+ * @details The sensor part is the sensor's position in the stored ID table,
+ *          so keys of different sensors never collide and do not depend on
+ *          the handle order of a firmware build.
+ * @param assign Give an unknown sensor a tag (write paths only)
+ * @return Key, NO_MEASUREMENT_KEY if the sensor has no tag
+ */
+static uint32_t measurementKey(const String& sensorId, size_t measurementIndex,
+                               MeasurementRecord record, bool assign = false) {
+  size_t tag = 0;
+  while (tag < g_sensorTagCount && !sensorId.equals(g_sensorTags[tag])) {
+    tag++;
+  }
+  if (tag == g_sensorTagCount && (!assign || !assignSensorTag(sensorId))) {
+    return NO_MEASUREMENT_KEY;
+  }
+  return static_cast<uint32_t>(tag + 1) << 16 | (measurementIndex & 0xFF) << 8 | record;
+}
+
+static void packMeasurement(const MeasurementConfig& config, PackedMeasurement& packed) {
+  packed.version = MEASUREMENT_RECORD_VERSION;
+  packed.flags = (config.enabled ? PACKED_ENABLED : 0) | (config.inverted ? PACKED_INVERTED : 0) |
+                 (config.calibrationMode ? PACKED_CALIBRATION_MODE : 0);
+  packed.aggregation = static_cast<uint8_t>(config.aggregation);
+  packed.minValue = config.minValue;
+  packed.maxValue = config.maxValue;
+  packed.trimFraction = config.trimFraction;
+  packed.hampelThreshold = config.hampelThreshold;
+  packed.yellowLow = config.limits.yellowLow;
+  packed.greenLow = config.limits.greenLow;
+  packed.greenHigh = config.limits.greenHigh;
+  packed.yellowHigh = config.limits.yellowHigh;
+  packed.autocalHalfLifeSeconds = config.autocalHalfLifeSeconds;
+  packed.absoluteRawMin = config.absoluteRawMin;
+  packed.absoluteRawMax = config.absoluteRawMax;
+  packed.absoluteMin = config.absoluteMin;
+  packed.absoluteMax = config.absoluteMax;
+  packed.lastRawValue = config.lastRawValue;
+  packed.lastValue = config.lastValue;
+}
+
+// Analog-only fields are applied for the ANALOG sensor only, as in the JSON files.
+// The absolute min/max are tracked for every sensor.
+static void unpackMeasurement(const PackedMeasurement& packed, const String& sensorId,
+                              MeasurementConfig& config) {
+  config.enabled = packed.flags & PACKED_ENABLED;
+  if (packed.aggregation <= static_cast<uint8_t>(AggregationMode::HAMPEL)) {
+    config.aggregation = static_cast<AggregationMode>(packed.aggregation);
+  }
+  config.minValue = packed.minValue;
+  config.maxValue = packed.maxValue;
+  config.trimFraction = packed.trimFraction;
+  config.hampelThreshold = packed.hampelThreshold;
+  config.limits.yellowLow = packed.yellowLow;
+  config.limits.greenLow = packed.greenLow;
+  config.limits.greenHigh = packed.greenHigh;
+  config.limits.yellowHigh = packed.yellowHigh;
+  config.lastValue = packed.lastValue;
+  config.absoluteMin = packed.absoluteMin;
+  config.absoluteMax = packed.absoluteMax;
+
+  if (sensorId == "ANALOG") {
+    config.inverted = packed.flags & PACKED_INVERTED;
+    config.calibrationMode = packed.flags & PACKED_CALIBRATION_MODE;
+    config.autocalHalfLifeSeconds = packed.autocalHalfLifeSeconds;
+    config.absoluteRawMin = packed.absoluteRawMin;
+    config.absoluteRawMax = packed.absoluteRawMax;
+    config.lastRawValue = packed.lastRawValue;
+  }
+}
+
+/**
+ * @brief Build the string table "name\0fieldName\0unit\0"
+ * @return Table length, truncated to one record
+ */
+static size_t packStrings(const MeasurementConfig& config, char* table) {
+  size_t length = 0;
+  for (const String* text : {&config.name, &config.fieldName, &config.unit}) {
+    size_t n = std::min(static_cast<size_t>(text->length()),
+                        LogStore::MAX_VALUE_SIZE - length - 1);
+    memcpy(table + length, text->c_str(), n);
+    length += n;
+    table[length++] = '\0';
+    if (length >= LogStore::MAX_VALUE_SIZE - 1) {
+      break;
+    }
+  }
+  return length;
+}
+
+static void unpackStrings(const char* table, size_t length, MeasurementConfig& config) {
+  String* texts[] = {&config.name, &config.fieldName, &config.unit};
+  size_t pos = 0;
+  for (String* text : texts) {
+    if (pos >= length) {
+      break;
+    }
+    const char* start = table + pos;
+    size_t n = strnlen(start, length - pos);
+    text->reserve(n);
+    *text = "";
+    text->concat(start, n);
+    pos += n + 1;
+  }
+}
+
+/**
+ * @brief Append the records of a measurement without committing
+ * @details The string table is only appended if it changed, so runtime
+ *          updates cost a single PackedMeasurement record.
+ */
+static bool appendMeasurement(const String& sensorId, size_t measurementIndex,
+                              const MeasurementConfig& config) {
+  uint32_t valuesKey = measurementKey(sensorId, measurementIndex, RECORD_VALUES, true);
+  if (valuesKey == NO_MEASUREMENT_KEY) {
+    return false;
+  }
+  PackedMeasurement packed;
+  packMeasurement(config, packed);
+  bool ok = g_measurementStore.append(valuesKey, &packed, sizeof(packed));
+
+  char table[LogStore::MAX_VALUE_SIZE];
+  char stored[LogStore::MAX_VALUE_SIZE];
+  size_t length = packStrings(config, table);
+  size_t storedLength;
+  uint32_t stringsKey = measurementKey(sensorId, measurementIndex, RECORD_STRINGS);
+  if (!g_measurementStore.read(stringsKey, stored, sizeof(stored), storedLength) ||
+      storedLength != length || memcmp(stored, table, length) != 0) {
+    ok &= g_measurementStore.append(stringsKey, table, length);
+  }
+  return ok;
+}
+
+/**
+ * @brief Sample the free heap while loading the configuration
+ */
+static void sampleLoadHeap() {
+  uint32_t freeHeap = ESP.getFreeHeap();
+  if (freeHeap < g_loadStats.heapMin) {
+    g_loadStats.heapMin = freeHeap;
+  }
+}
+
+/**
+ * @brief Commit appended records and account them in the flush statistics
+ */
+static bool commitMeasurementStore(uint32_t bytesBefore) {
+  bool ok = g_measurementStore.commit();
+  g_flushStats.commits++;
+  g_flushStats.bytesWritten += g_measurementStore.getStats().bytesAppended - bytesBefore;
+  return ok;
+}
+
+/**
+ * @brief Load a measurement from a legacy JSON file (/config/sensor_<ID>_<i>.json)
+ * @details Only used to migrate existing installations into the store.
+ */
+static bool loadLegacyMeasurementFile(const String& path, const String& sensorId,
+                                      MeasurementConfig& config) {
+  DynamicJsonDocument doc(640);
+  if (!loadJsonFile(path, doc)) {
+    return false;
+  }
+
+  config.enabled = doc["enabled"] | true;
+  config.name = doc["name"] | String("");
+  config.fieldName = doc["fieldName"] | String("");
+  config.lastValue = doc["lastValue"] | NAN;
+  config.unit = doc["unit"] | String("");
+  config.minValue = doc["minValue"] | 0.0f;
+  config.maxValue = doc["maxValue"] | 100.0f;
+  config.aggregation = AggregationMode::MEAN;
+  aggregationModeFromString(doc["aggregation"] | "mean", config.aggregation);
+  config.trimFraction = doc["trimFraction"] | DEFAULT_TRIM_FRACTION;
+  config.hampelThreshold = doc["hampelThreshold"] | DEFAULT_HAMPEL_THRESHOLD;
+
+  JsonObjectConst thresholds = doc["thresholds"];
+  config.limits.yellowLow = thresholds["yellowLow"] | 0.0f;
+  config.limits.greenLow = thresholds["greenLow"] | 0.0f;
+  config.limits.greenHigh = thresholds["greenHigh"] | 100.0f;
+  config.limits.yellowHigh = thresholds["yellowHigh"] | 100.0f;
+  config.absoluteMin = doc["absoluteMin"].isNull() ? INFINITY : (doc["absoluteMin"] | INFINITY);
+  config.absoluteMax = doc["absoluteMax"].isNull() ? -INFINITY : (doc["absoluteMax"] | -INFINITY);
+
+  if (sensorId == "ANALOG") {
+    config.inverted = doc["inverted"] | false;
+    config.calibrationMode = doc["calibrationMode"] | false;
+    config.autocalHalfLifeSeconds = doc["autocalHalfLifeSeconds"] | 0;
+    config.lastRawValue = doc["lastRawValue"] | -1;
+    config.absoluteRawMin = doc["absoluteRawMin"] | 0;
+    config.absoluteRawMax = doc["absoluteRawMax"] | 1023;
+  }
+  return true;
+}
+
+/**
+ * @brief Move legacy per-measurement JSON files into the store
+ */
+static void migrateLegacyMeasurementFiles() {
+  Dir dir = LittleFS.openDir("/config");
+  std::vector<String> migrated;
+  while (dir.next()) {
+    String filename = dir.fileName();
+    if (!filename.startsWith("sensor_") || !filename.endsWith(".json")) {
+      continue;
+    }
+    // sensor_<ID>_<index>.json
+    int sep = filename.lastIndexOf('_');
+    if (sep <= 7) {
+      continue;
+    }
+    String sensorId = filename.substring(7, sep);
+    size_t index = filename.substring(sep + 1, filename.length() - 5).toInt();
+    String path = String("/config/") + filename;
+
+    MeasurementConfig config;
+    if (!loadLegacyMeasurementFile(path, sensorId, config)) {
+      logger.warning(F("SensorP"), F("Konnte Altdatei nicht lesen: ") + path);
+      continue;
+    }
+    if (SensorPersistence::saveMeasurement(sensorId, index, config).isSuccess()) {
+      migrated.push_back(path);
+    }
+    yield();
+  }
+
+  // Remove the JSON files only after their records are committed
+  g_measurementStore.commit();
+  for (const auto& path : migrated) {
+    LittleFS.remove(path);
+  }
+  if (!migrated.empty()) {
+    logger.info(F("SensorP"),
+                String(migrated.size()) + F(" Messungs-JSON-Dateien in den Messungsspeicher übernommen"));
+  }
+}
+
+/**
+ * @brief Mount the measurement store on first use
+ * @return true if the store is usable
+ */
+static bool ensureMeasurementStore() {
+  if (g_measurementStore.isMounted()) {
+    return true;
+  }
+  auto result = g_measurementStore.mount();
+  if (!result.isSuccess()) {
+    logger.error(F("SensorP"), F("Messungsspeicher nicht verfügbar: ") + result.getMessage());
+    return false;
+  }
+  loadSensorTags();
+  auto stats = g_measurementStore.getStats();
+  logger.info(F("SensorP"), F("Messungsspeicher: ") + String(stats.liveRecords) +
+                                F(" Einträge, ") + String(stats.logBytes) + F(" Bytes, ") +
+                                String(stats.mountMs) + F(" ms"));
+  if (stats.liveRecords > 0 && g_sensorTagCount == 0) {
+    // Records keyed by the former 16-bit ID hash cannot be told apart
+    logger.warning(F("SensorP"), F("Messungsspeicher ohne Sensortabelle verworfen"));
+    g_measurementStore.clear();
+    stats = g_measurementStore.getStats();
+  }
+  if (stats.liveRecords == 0) {
+    migrateLegacyMeasurementFiles();
+  }
+  return true;
+}
+
+/**
+ * @brief Move the sensor intervals of a legacy /config/settings.json into the store
+ */
+static void migrateLegacyIntervals() {
+  const char* settingsPath = "/config/settings.json";
+  if (!LittleFS.exists(settingsPath)) {
+    return;
+  }
+
+  {
+    DynamicJsonDocument settingsDoc(4096);
+    if (loadJsonFile(settingsPath, settingsDoc)) {
+      JsonObjectConst sensors = settingsDoc["sensors"];
+      for (JsonPairConst kv : sensors) {
+        if (!kv.value().containsKey("interval")) {
+          continue;
+        }
+        uint32_t interval = kv.value()["interval"].as<uint32_t>();
+        uint32_t key =
+            measurementKey(kv.key().c_str(), SENSOR_RECORD_INDEX, RECORD_INTERVAL, true);
+        if (key != NO_MEASUREMENT_KEY) {
+          g_measurementStore.append(key, &interval, sizeof(interval));
+        }
+      }
+    }
+    sampleLoadHeap();
+  }
+
+  if (g_measurementStore.commit()) {
+    LittleFS.remove(settingsPath);
+    logger.info(F("SensorP"), F("Messintervalle aus settings.json übernommen"));
+  }
+}
 
 SensorPersistence::PersistenceResult SensorPersistence::load() {
   if (ConfigMgr.isDebugSensor()) {
-    logger.debug(F("SensorP"), F("Beginne Laden der Sensorkonfiguration aus JSON"));
+    LOG_DEBUG(F("SensorP"), F("Beginne Laden der Sensorkonfiguration"));
   }
 
   extern std::unique_ptr<SensorManager> sensorManager;
@@ -68,16 +593,23 @@ SensorPersistence::PersistenceResult SensorPersistence::load() {
     return PersistenceResult::success();
   }
 
-  // Load measurement intervals from settings.json
-  const char* settingsPath = "/config/settings.json";
-  DynamicJsonDocument settingsDoc(4096);
-  bool hasSettings = loadJsonFile(settingsPath, settingsDoc);
+  g_loadStats = LoadStats();
+  g_loadStats.heapBefore = ESP.getFreeHeap();
+  g_loadStats.heapMin = g_loadStats.heapBefore;
+  unsigned long loadStart = millis();
+
+  if (!ensureMeasurementStore()) {
+    return PersistenceResult::fail(ConfigError::FILE_ERROR, "Measurement store not available");
+  }
+
+  // Intervals of installations that still have settings.json
+  migrateLegacyIntervals();
 
   const auto& allSensors = sensorManager->getSensors();
   bool anyLoaded = false;
-  size_t filesCreated = 0;
+  size_t measurementsCreated = 0;
 
-  // Load each sensor's measurements from individual JSON files
+  // Load each sensor's measurements from the store
   for (const auto& sensorPtr : allSensors) {
     if (!sensorPtr)
       continue;
@@ -85,73 +617,72 @@ SensorPersistence::PersistenceResult SensorPersistence::load() {
     String sensorId = sensorPtr->config().id;
     SensorConfig& config = sensorPtr->mutableConfig();
 
-    // Load measurement interval from settings.json if available
-    if (hasSettings && settingsDoc.containsKey("sensors")) {
-      JsonObjectConst sensors = settingsDoc["sensors"];
-      if (sensors.containsKey(sensorId) && sensors[sensorId].containsKey("interval")) {
-        unsigned long interval = sensors[sensorId]["interval"] | (MEASUREMENT_INTERVAL * 1000);
-        config.measurementInterval = interval;
-        sensorPtr->setMeasurementInterval(interval);
-
-        if (ConfigMgr.isDebugSensor()) {
-          logger.debug(F("SensorP"), F("Messintervall für ") + sensorId +
-                                         F(" aus settings.json geladen: ") + String(interval) +
-                                         F("ms"));
-        }
+    uint32_t interval;
+    size_t length;
+    if (g_measurementStore.read(measurementKey(sensorId, SENSOR_RECORD_INDEX, RECORD_INTERVAL),
+                                &interval, sizeof(interval), length) &&
+        length == sizeof(interval)) {
+      config.measurementInterval = interval;
+      sensorPtr->setMeasurementInterval(interval);
+
+      if (ConfigMgr.isDebugSensor()) {
+        LOG_DEBUG(F("SensorP"), F("Messintervall für ") + sensorId + F(" geladen: ") +
+                                    String(interval) + F("ms"));
       }
     }
 
     if (ConfigMgr.isDebugSensor()) {
-      logger.debug(F("SensorP"), String(F("Lade Messungen für Sensor: ")) + sensorId);
+      LOG_DEBUG(F("SensorP"), String(F("Lade Messungen für Sensor: ")) + sensorId);
     }
 
-    // Try to load each measurement from its JSON file
+    // Try to load each measurement from the store
     for (size_t i = 0; i < config.activeMeasurements; ++i) {
-      String path = getMeasurementFilePath(sensorId, i);
-
-      // Check if file exists
-      if (!LittleFS.exists(path)) {
-        // File doesn't exist - create it with current defaults
+      if (!hasMeasurement(sensorId, i)) {
+        // Not stored yet - store the current defaults
         if (ConfigMgr.isDebugSensor()) {
-          logger.debug(F("SensorP"), String(F("Erstelle Default-Datei: ")) + path);
+          LOG_DEBUG(F("SensorP"), F("Speichere Default-Messung ") + sensorId + F("[") +
+                                      String(i) + F("]"));
         }
 
-        auto saveResult = saveMeasurementToJson(sensorId, i, config.measurements[i]);
+        auto saveResult = saveMeasurement(sensorId, i, config.measurements[i]);
         if (saveResult.isSuccess()) {
-          filesCreated++;
+          measurementsCreated++;
         } else {
-          logger.warning(F("SensorP"), F("Konnte Default-Datei nicht erstellen: ") + path);
+          logger.warning(F("SensorP"), F("Konnte Default-Messung nicht speichern: ") + sensorId +
+                                           F("[") + String(i) + F("]"));
         }
         continue;
       }
 
-      // Load from JSON
       MeasurementConfig loadedConfig;
-      auto result = loadMeasurementFromJson(sensorId, i, loadedConfig);
+      auto result = loadMeasurement(sensorId, i, loadedConfig);
 
       if (result.isSuccess()) {
         // Apply loaded settings
         config.measurements[i] = loadedConfig;
         anyLoaded = true;
-
-        if (ConfigMgr.isDebugSensor()) {
-          logger.debug(F("SensorP"), String(F("Messung geladen: ")) + path);
-        }
       } else {
-        logger.warning(F("SensorP"), F("Konnte Messung nicht laden: ") + path);
+        logger.warning(F("SensorP"), F("Konnte Messung nicht laden: ") + sensorId + F("[") +
+                                         String(i) + F("]"));
       }
 
+      sampleLoadHeap();
       yield(); // Feed watchdog
     }
   }
 
-  if (filesCreated > 0) {
-    logger.info(F("SensorP"), String(filesCreated) + F(" Default-Messungs-Dateien erstellt"));
+  g_loadStats.loadMs = millis() - loadStart;
+  logger.info(F("SensorP"), F("Sensor-Konfiguration in ") + String(g_loadStats.loadMs) +
+                                F(" ms geladen, Heap-Spitze ") + String(g_loadStats.heapPeak()) +
+                                F(" Bytes"));
+
+  if (measurementsCreated > 0) {
+    logger.info(F("SensorP"), String(measurementsCreated) + F(" Default-Messungen gespeichert"));
   }
 
   if (anyLoaded) {
-    logger.info(F("SensorP"), F("Sensor-Konfiguration erfolgreich aus JSON geladen"));
-  } else if (filesCreated == 0) {
+    logger.info(F("SensorP"), F("Sensor-Konfiguration erfolgreich geladen"));
+  } else if (measurementsCreated == 0) {
     logger.warning(F("SensorP"), F("Keine Sensor-Konfiguration gefunden oder geladen"));
   }
 
@@ -171,7 +702,7 @@ SensorPersistence::PersistenceResult SensorPersistence::save() {
   const auto& allSensors = sensorManager->getSensors();
   size_t totalSaved = 0;
 
-  // Save each measurement to its own JSON file
+  // Save every measurement into the store
   for (const auto& sensorPtr : allSensors) {
     if (!sensorPtr)
       continue;
@@ -180,12 +711,11 @@ SensorPersistence::PersistenceResult SensorPersistence::save() {
     String sensorId = sensorConfig.id;
 
     if (ConfigMgr.isDebugSensor()) {
-      logger.debug(F("SensorP"), String(F("Speichere Messungen für Sensor: ")) + sensorId);
+      LOG_DEBUG(F("SensorP"), String(F("Speichere Messungen für Sensor: ")) + sensorId);
     }
 
-    // Save each measurement to individual JSON file
     for (size_t i = 0; i < sensorConfig.activeMeasurements; ++i) {
-      auto result = saveMeasurementToJson(sensorId, i, sensorConfig.measurements[i]);
+      auto result = saveMeasurement(sensorId, i, sensorConfig.measurements[i]);
       if (result.isSuccess()) {
         totalSaved++;
       } else {
@@ -199,7 +729,7 @@ SensorPersistence::PersistenceResult SensorPersistence::save() {
                                   String(sensorConfig.activeMeasurements) + F(" Messungen)"));
   }
 
-  logger.info(F("SensorP"), String(totalSaved) + F(" Messungs-Dateien gespeichert"));
+  logger.info(F("SensorP"), String(totalSaved) + F(" Messungen gespeichert"));
   return PersistenceResult::success();
 }
 
@@ -207,7 +737,6 @@ SensorPersistence::PersistenceResult
 SensorPersistence::updateSensorThresholds(const String& sensorId, size_t measurementIndex,
                                           float yellowLow, float greenLow, float greenHigh,
                                           float yellowHigh) {
-  // Now update JSON file directly
   extern std::unique_ptr<SensorManager> sensorManager;
   if (!sensorManager) {
     return PersistenceResult::fail(ConfigError::SAVE_FAILED, "SensorManager not available");
@@ -221,15 +750,14 @@ SensorPersistence::updateSensorThresholds(const String& sensorId, size_t measure
         return PersistenceResult::fail(ConfigError::SAVE_FAILED, "Invalid measurement index");
       }
 
-      // Create updated config
-      MeasurementConfig updatedConfig = config.measurements[measurementIndex];
-      updatedConfig.limits.yellowLow = yellowLow;
-      updatedConfig.limits.greenLow = greenLow;
-      updatedConfig.limits.greenHigh = greenHigh;
-      updatedConfig.limits.yellowHigh = yellowHigh;
+      MeasurementConfig stored = config.measurements[measurementIndex];
+      loadMeasurement(sensorId, measurementIndex, stored);
+      stored.limits.yellowLow = yellowLow;
+      stored.limits.greenLow = greenLow;
+      stored.limits.greenHigh = greenHigh;
+      stored.limits.yellowHigh = yellowHigh;
 
-      // Save to JSON
-      auto result = saveMeasurementToJson(sensorId, measurementIndex, updatedConfig);
+      auto result = saveMeasurement(sensorId, measurementIndex, stored);
       if (result.isSuccess()) {
         logger.info(F("SensorP"), String(F("Schwellenwerte aktualisiert für ")) + sensorId +
                                       F(" Messung ") + String(measurementIndex));
@@ -242,7 +770,7 @@ SensorPersistence::updateSensorThresholds(const String& sensorId, size_t measure
 }
 
 // ============================================================================
-// JSON-based Update Functions (replaces old Preferences-based code)
+// Update Functions (replace old Preferences-based code)
 // ============================================================================
 
 SensorPersistence::PersistenceResult
@@ -279,41 +807,22 @@ SensorPersistence::PersistenceResult SensorPersistence::updateAnalogMinMaxIntege
 SensorPersistence::PersistenceResult
 SensorPersistence::updateMeasurementInterval(const String& sensorId, unsigned long interval) {
   // Measurement interval ist NICHT pro Messung, sondern sensor-weit
-  // Speichere in settings.json
-
-  const char* settingsPath = "/config/settings.json";
-
-  // Load existing settings.json
-  DynamicJsonDocument doc(4096);
-  if (!loadJsonFile(settingsPath, doc)) {
-    logger.error(F("SensorP"), F("Konnte settings.json nicht laden"));
-    return PersistenceResult::fail(ConfigError::FILE_ERROR, "Cannot load settings.json");
+  if (!ensureMeasurementStore()) {
+    return PersistenceResult::fail(ConfigError::FILE_ERROR, "Measurement store not available");
   }
 
-  // Ensure sensors object exists
-  if (!doc.containsKey("sensors")) {
-    doc.createNestedObject("sensors");
-  }
-
-  JsonObject sensors = doc["sensors"];
-
-  // Ensure sensor object exists
-  if (!sensors.containsKey(sensorId)) {
-    sensors.createNestedObject(sensorId);
-  }
-
-  // Update interval
-  sensors[sensorId]["interval"] = interval;
-
-  // Save back to file
-  if (!saveJsonFile(settingsPath, doc)) {
-    logger.error(F("SensorP"), F("Konnte settings.json nicht speichern"));
-    return PersistenceResult::fail(ConfigError::SAVE_FAILED, "Cannot save settings.json");
+  uint32_t bytesBefore = g_measurementStore.getStats().bytesAppended;
+  uint32_t value = interval;
+  uint32_t key = measurementKey(sensorId, SENSOR_RECORD_INDEX, RECORD_INTERVAL, true);
+  bool ok = key != NO_MEASUREMENT_KEY && g_measurementStore.append(key, &value, sizeof(value));
+  if (!commitMeasurementStore(bytesBefore) || !ok) {
+    logger.error(F("SensorP"), F("Konnte Messintervall nicht speichern"));
+    return PersistenceResult::fail(ConfigError::SAVE_FAILED, "Cannot write interval");
   }
 
   if (ConfigMgr.isDebugSensor()) {
-    logger.debug(F("SensorP"), F("Messintervall für ") + sensorId + F(" auf ") + String(interval) +
-                                   F("ms gesetzt"));
+    LOG_DEBUG(F("SensorP"), F("Messintervall für ") + sensorId + F(" auf ") + String(interval) +
+                                F("ms gesetzt"));
   }
 
   return PersistenceResult::success();
@@ -359,170 +868,61 @@ SensorPersistence::updateAnalogRawMinMax(const String& sensorId, size_t measurem
   return updateMeasurementSettings(sensorId, measurementIndex, settings);
 }
 
-void SensorPersistence::enqueueAnalogRawMinMax(const String& sensorId, size_t measurementIndex,
+void SensorPersistence::enqueueAnalogRawMinMax(SensorHandle sensor, size_t measurementIndex,
                                                int absoluteRawMin, int absoluteRawMax) {
-  // Check if we already have a RAW_MIN_MAX pending update for this sensor/measurement
-  for (auto& u : g_pendingUpdates) {
-    if (u.type == PendingUpdateType::RAW_MIN_MAX && u.sensorId == sensorId &&
-        u.measurementIndex == measurementIndex) {
-      // Update existing entry with new values
-      u.data.raw.absoluteRawMin = absoluteRawMin;
-      u.data.raw.absoluteRawMax = absoluteRawMax;
-      u.timestamp = millis();
-      return;
-    }
-  }
-
-  // Add new entry
-  PendingUpdate u;
-  u.type = PendingUpdateType::RAW_MIN_MAX;
-  u.sensorId = sensorId;
-  u.measurementIndex = measurementIndex;
-  u.timestamp = millis();
-  u.data.raw.absoluteRawMin = absoluteRawMin;
-  u.data.raw.absoluteRawMax = absoluteRawMax;
-
-  // Keep queue size reasonable — if it grows too large, flush oldest entries
-  const size_t MAX_PENDING = 32;
-  if (g_pendingUpdates.size() >= MAX_PENDING) {
-    logger.warning(F("SensorP"), F("Pending updates queue full, forcing partial flush"));
-    // Flush oldest entry
-    if (!g_pendingUpdates.empty()) {
-      PendingUpdate oldest = g_pendingUpdates.front();
-      g_pendingUpdates.erase(g_pendingUpdates.begin());
-
-      switch (oldest.type) {
-      case PendingUpdateType::RAW_MIN_MAX:
-        updateAnalogRawMinMax(oldest.sensorId, oldest.measurementIndex,
-                              oldest.data.raw.absoluteRawMin, oldest.data.raw.absoluteRawMax);
-        break;
-      case PendingUpdateType::ABSOLUTE_MIN_MAX:
-        updateAbsoluteMinMax(oldest.sensorId, oldest.measurementIndex,
-                             oldest.data.absolute.absoluteMin, oldest.data.absolute.absoluteMax);
-        break;
-      case PendingUpdateType::CALIBRATED_MIN_MAX:
-        updateAnalogMinMaxIntegerNoReload(
-            oldest.sensorId, oldest.measurementIndex, oldest.data.calibrated.minValue,
-            oldest.data.calibrated.maxValue, oldest.data.calibrated.inverted);
-        break;
-      }
-    }
+  PendingEntry* e = acquirePendingEntry(sensor, measurementIndex);
+  if (!e) {
+    return;
   }
-  g_pendingUpdates.push_back(std::move(u));
+  e->absoluteRawMin = absoluteRawMin;
+  e->absoluteRawMax = absoluteRawMax;
+  markPendingField(*e, FIELD_RAW_MIN_MAX);
 }
 
-void SensorPersistence::enqueueAbsoluteMinMax(const String& sensorId, size_t measurementIndex,
+void SensorPersistence::enqueueAbsoluteMinMax(SensorHandle sensor, size_t measurementIndex,
                                               float absoluteMin, float absoluteMax) {
-  // Check if we already have an ABSOLUTE_MIN_MAX pending update for this sensor/measurement
-  for (auto& u : g_pendingUpdates) {
-    if (u.type == PendingUpdateType::ABSOLUTE_MIN_MAX && u.sensorId == sensorId &&
-        u.measurementIndex == measurementIndex) {
-      // Update existing entry with new values
-      u.data.absolute.absoluteMin = absoluteMin;
-      u.data.absolute.absoluteMax = absoluteMax;
-      u.timestamp = millis();
-      return;
-    }
-  }
-
-  // Add new entry
-  PendingUpdate u;
-  u.type = PendingUpdateType::ABSOLUTE_MIN_MAX;
-  u.sensorId = sensorId;
-  u.measurementIndex = measurementIndex;
-  u.timestamp = millis();
-  u.data.absolute.absoluteMin = absoluteMin;
-  u.data.absolute.absoluteMax = absoluteMax;
-
-  const size_t MAX_PENDING = 32;
-  if (g_pendingUpdates.size() >= MAX_PENDING) {
-    logger.warning(F("SensorP"), F("Pending updates queue full, forcing partial flush"));
-    if (!g_pendingUpdates.empty()) {
-      PendingUpdate oldest = g_pendingUpdates.front();
-      g_pendingUpdates.erase(g_pendingUpdates.begin());
-
-      switch (oldest.type) {
-      case PendingUpdateType::RAW_MIN_MAX:
-        updateAnalogRawMinMax(oldest.sensorId, oldest.measurementIndex,
-                              oldest.data.raw.absoluteRawMin, oldest.data.raw.absoluteRawMax);
-        break;
-      case PendingUpdateType::ABSOLUTE_MIN_MAX:
-        updateAbsoluteMinMax(oldest.sensorId, oldest.measurementIndex,
-                             oldest.data.absolute.absoluteMin, oldest.data.absolute.absoluteMax);
-        break;
-      case PendingUpdateType::CALIBRATED_MIN_MAX:
-        updateAnalogMinMaxIntegerNoReload(
-            oldest.sensorId, oldest.measurementIndex, oldest.data.calibrated.minValue,
-            oldest.data.calibrated.maxValue, oldest.data.calibrated.inverted);
-        break;
-      }
-    }
+  PendingEntry* e = acquirePendingEntry(sensor, measurementIndex);
+  if (!e) {
+    return;
   }
-  g_pendingUpdates.push_back(std::move(u));
+  e->absoluteMin = absoluteMin;
+  e->absoluteMax = absoluteMax;
+  markPendingField(*e, FIELD_ABSOLUTE_MIN_MAX);
 }
 
-void SensorPersistence::enqueueAnalogMinMaxInteger(const String& sensorId, size_t measurementIndex,
+void SensorPersistence::enqueueAnalogMinMaxInteger(SensorHandle sensor, size_t measurementIndex,
                                                    int minValue, int maxValue, bool inverted) {
-  // Check if we already have a CALIBRATED_MIN_MAX pending update for this sensor/measurement
-  for (auto& u : g_pendingUpdates) {
-    if (u.type == PendingUpdateType::CALIBRATED_MIN_MAX && u.sensorId == sensorId &&
-        u.measurementIndex == measurementIndex) {
-      // Update existing entry with new values
-      u.data.calibrated.minValue = minValue;
-      u.data.calibrated.maxValue = maxValue;
-      u.data.calibrated.inverted = inverted;
-      u.timestamp = millis();
-      return;
-    }
+  PendingEntry* e = acquirePendingEntry(sensor, measurementIndex);
+  if (!e) {
+    return;
   }
+  e->minValue = minValue;
+  e->maxValue = maxValue;
+  e->inverted = inverted;
+  markPendingField(*e, FIELD_CALIBRATED_MIN_MAX);
+}
 
-  // Add new entry
-  PendingUpdate u;
-  u.type = PendingUpdateType::CALIBRATED_MIN_MAX;
-  u.sensorId = sensorId;
-  u.measurementIndex = measurementIndex;
-  u.timestamp = millis();
-  u.data.calibrated.minValue = minValue;
-  u.data.calibrated.maxValue = maxValue;
-  u.data.calibrated.inverted = inverted;
-
-  const size_t MAX_PENDING = 32;
-  if (g_pendingUpdates.size() >= MAX_PENDING) {
-    logger.warning(F("SensorP"), F("Pending updates queue full, forcing partial flush"));
-    if (!g_pendingUpdates.empty()) {
-      PendingUpdate oldest = g_pendingUpdates.front();
-      g_pendingUpdates.erase(g_pendingUpdates.begin());
-
-      switch (oldest.type) {
-      case PendingUpdateType::RAW_MIN_MAX:
-        updateAnalogRawMinMax(oldest.sensorId, oldest.measurementIndex,
-                              oldest.data.raw.absoluteRawMin, oldest.data.raw.absoluteRawMax);
-        break;
-      case PendingUpdateType::ABSOLUTE_MIN_MAX:
-        updateAbsoluteMinMax(oldest.sensorId, oldest.measurementIndex,
-                             oldest.data.absolute.absoluteMin, oldest.data.absolute.absoluteMax);
-        break;
-      case PendingUpdateType::CALIBRATED_MIN_MAX:
-        updateAnalogMinMaxIntegerNoReload(
-            oldest.sensorId, oldest.measurementIndex, oldest.data.calibrated.minValue,
-            oldest.data.calibrated.maxValue, oldest.data.calibrated.inverted);
-        break;
-      }
-    }
+void SensorPersistence::enqueueLastValue(SensorHandle sensor, size_t measurementIndex,
+                                         float lastValue, int lastRawValue) {
+  PendingEntry* e = acquirePendingEntry(sensor, measurementIndex);
+  if (!e) {
+    return;
   }
-  g_pendingUpdates.push_back(std::move(u));
+  e->lastValue = lastValue;
+  e->lastRawValue = lastRawValue;
+  markPendingField(*e, FIELD_LAST_VALUE);
 }
 
-void SensorPersistence::flushPendingUpdatesForSensor(const String& sensorId) {
-  if (g_pendingUpdates.empty()) {
+void SensorPersistence::flushPendingUpdatesForSensor(SensorHandle sensor) {
+  if (g_pendingFields == 0) {
     return;
   }
 
   // Count updates for this sensor
   size_t totalForSensor = 0;
-  for (const auto& u : g_pendingUpdates) {
-    if (u.sensorId == sensorId) {
-      totalForSensor++;
+  for (const auto& e : g_pendingEntries) {
+    if (e.dirty != 0 && e.sensor == sensor) {
+      totalForSensor += countFields(e.dirty);
     }
   }
 
@@ -530,95 +930,114 @@ void SensorPersistence::flushPendingUpdatesForSensor(const String& sensorId) {
     return; // No updates for this sensor
   }
 
+  // The store keys need the String ID; resolve it once per flush
+  const String sensorId = SensorRegistry::getId(sensor);
   unsigned long flushStartTime = millis();
 
   if (ConfigMgr.isDebugSensor()) {
-    logger.debug(F("SensorP"),
-                 F("Flushe ") + String(totalForSensor) + F(" Updates für ") + sensorId);
+    LOG_DEBUG(F("SensorP"),
+              F("Flushe ") + String(totalForSensor) + F(" Updates für ") + sensorId);
   }
 
-  // JSON-based: Group updates by measurementIndex, then apply all changes to each file
-  // This is much faster than writing individual fields multiple times
-  std::map<size_t, MeasurementConfig> configsToUpdate;
+  if (!ensureMeasurementStore()) {
+    return; // Keep the entries for the next flush
+  }
 
-  // First pass: Load all affected measurement configs
-  auto it = g_pendingUpdates.begin();
-  while (it != g_pendingUpdates.end()) {
-    if (it->sensorId != sensorId) {
-      ++it;
+  // Each entry holds the final values of one measurement: apply all dirty
+  // fields to the stored record and append it once; all records of the
+  // sensor share one commit
+  size_t successCount = 0;
+  uint32_t bytesBefore = g_measurementStore.getStats().bytesAppended;
+  for (auto& e : g_pendingEntries) {
+    if (e.dirty == 0 || e.sensor != sensor) {
       continue;
     }
 
-    size_t measurementIndex = it->measurementIndex;
+    size_t measurementIndex = e.measurementIndex;
+    size_t fields = countFields(e.dirty);
+    uint8_t dirty = e.dirty;
+    g_pendingFields -= fields;
+    e.dirty = 0;
+
+    MeasurementConfig config;
+    auto loadResult = loadMeasurement(sensorId, measurementIndex, config);
+    if (!loadResult.isSuccess()) {
+      logger.error(F("SensorP"), F("Fehler beim Laden von Messung ") + String(measurementIndex) +
+                                     F(" für ") + sensorId);
+      continue; // Drop the failed update
+    }
 
-    // Load config if not already loaded
-    if (configsToUpdate.find(measurementIndex) == configsToUpdate.end()) {
-      MeasurementConfig config;
-      auto loadResult = loadMeasurementFromJson(sensorId, measurementIndex, config);
-      if (!loadResult.isSuccess()) {
-        logger.error(F("SensorP"), F("Fehler beim Laden von Messung ") + String(measurementIndex) +
-                                       F(" für ") + sensorId);
-        it = g_pendingUpdates.erase(it); // Remove failed update
-        continue;
-      }
-      configsToUpdate[measurementIndex] = config;
+    if (dirty & FIELD_RAW_MIN_MAX) {
+      config.absoluteRawMin = e.absoluteRawMin;
+      config.absoluteRawMax = e.absoluteRawMax;
+    }
+    if (dirty & FIELD_ABSOLUTE_MIN_MAX) {
+      config.absoluteMin = e.absoluteMin;
+      config.absoluteMax = e.absoluteMax;
+    }
+    if (dirty & FIELD_CALIBRATED_MIN_MAX) {
+      config.minValue = static_cast<float>(e.minValue);
+      config.maxValue = static_cast<float>(e.maxValue);
+      config.inverted = e.inverted;
+    }
+    if (dirty & FIELD_LAST_VALUE) {
+      config.lastValue = e.lastValue;
+      config.lastRawValue = e.lastRawValue;
     }
 
-    ++it;
+    if (appendMeasurement(sensorId, measurementIndex, config)) {
+      successCount += fields;
+    } else {
+      logger.error(F("SensorP"), F("Fehler beim Speichern von Messung ") +
+                                     String(measurementIndex) + F(" für ") + sensorId);
+    }
   }
 
-  // Second pass: Apply all pending updates to loaded configs (in RAM)
-  it = g_pendingUpdates.begin();
-  size_t successCount = 0;
-  while (it != g_pendingUpdates.end()) {
-    if (it->sensorId != sensorId) {
-      ++it;
-      continue;
-    }
+  if (!commitMeasurementStore(bytesBefore)) {
+    logger.error(F("SensorP"), F("Fehler beim Abschließen der Updates für ") + sensorId);
+  }
+  g_flushStats.flushCount++;
 
-    size_t measurementIndex = it->measurementIndex;
-    auto& config = configsToUpdate[measurementIndex];
+  // Log flush performance
+  logger.info(F("SensorP"), String(successCount) + F(" Updates für ") + sensorId + F(" in ") +
+                                String(millis() - flushStartTime) + F(" ms aktualisiert"));
+}
 
-    // Apply update based on type
-    switch (it->type) {
-    case PendingUpdateType::RAW_MIN_MAX:
-      config.absoluteRawMin = it->data.raw.absoluteRawMin;
-      config.absoluteRawMax = it->data.raw.absoluteRawMax;
-      break;
-    case PendingUpdateType::ABSOLUTE_MIN_MAX:
-      config.absoluteMin = it->data.absolute.absoluteMin;
-      config.absoluteMax = it->data.absolute.absoluteMax;
-      break;
-    case PendingUpdateType::CALIBRATED_MIN_MAX:
-      config.minValue = static_cast<float>(it->data.calibrated.minValue);
-      config.maxValue = static_cast<float>(it->data.calibrated.maxValue);
-      config.inverted = it->data.calibrated.inverted;
+void SensorPersistence::flushAllPendingUpdates() {
+  // flushPendingUpdatesForSensor clears every entry of the given sensor,
+  // so this loop terminates after one pass per sensor
+  for (const auto& e : g_pendingEntries) {
+    if (g_pendingFields == 0) {
       break;
     }
+    if (e.dirty != 0) {
+      flushPendingUpdatesForSensor(e.sensor);
+    }
+  }
+  g_flushStats.lastFlushTime = millis();
+}
 
-    successCount++;
-    it = g_pendingUpdates.erase(it); // Remove processed update
+void SensorPersistence::processPendingUpdates() {
+  if (g_pendingFields == 0) {
+    return;
   }
 
-  // Third pass: Save all modified configs back to JSON files
-  for (auto& pair : configsToUpdate) {
-    size_t measurementIndex = pair.first;
-    const MeasurementConfig& config = pair.second;
+  bool intervalElapsed = millis() - g_flushStats.lastFlushTime >=
+                         static_cast<unsigned long>(SENSOR_PERSISTENCE_FLUSH_INTERVAL) * 1000UL;
+  bool lowHeap = ESP.getFreeHeap() < SENSOR_PERSISTENCE_LOW_HEAP;
+  if (!intervalElapsed && !lowHeap) {
+    return;
+  }
 
-    auto saveResult = saveMeasurementToJson(sensorId, measurementIndex, config);
-    if (!saveResult.isSuccess()) {
-      logger.error(F("SensorP"), F("Fehler beim Speichern von Messung ") +
-                                     String(measurementIndex) + F(" für ") + sensorId);
-    }
-    yield(); // Feed watchdog between file writes
+  if (lowHeap) {
+    logger.warning(F("SensorP"), F("Wenig freier Heap, schreibe Laufzeitwerte vorzeitig"));
   }
+  flushAllPendingUpdates();
+}
 
-  unsigned long totalFlushTime = millis() - flushStartTime;
+size_t SensorPersistence::getPendingUpdateCount() { return g_pendingFields; }
 
-  // Log flush performance
-  logger.info(F("SensorP"), String(successCount) + F(" Updates für ") + sensorId + F(" in ") +
-                                String(totalFlushTime) + F(" ms aktualisiert"));
-}
+const SensorPersistence::FlushStats& SensorPersistence::getFlushStats() { return g_flushStats; }
 
 SensorPersistence::PersistenceResult
 SensorPersistence::updateAnalogCalibrationMode(const String& sensorId, size_t measurementIndex,
@@ -641,177 +1060,88 @@ SensorPersistence::updateAutocalDuration(const String& sensorId, size_t measurem
 }
 
 // ============================================================================
-// JSON-based persistence (new approach - replaces Preferences for sensor config)
+// Measurement store access
 // ============================================================================
 
-#include "../utils/json_file_utils.h"
-
-/**
- * @brief Save a single measurement configuration to JSON file
- * @param sensorId Sensor ID (e.g., "ANALOG", "DHT")
- * @param measurementIndex Measurement index (0-based)
- * @param config Measurement configuration to save
- * @return PersistenceResult indicating success or failure
- */
 SensorPersistence::PersistenceResult
-SensorPersistence::saveMeasurementToJson(const String& sensorId, size_t measurementIndex,
-                                         const MeasurementConfig& config) {
-  // Allocate small JSON document (~512 bytes)
-  DynamicJsonDocument doc(512);
-
-  // Serialize measurement config
-  doc["enabled"] = config.enabled;
-  doc["name"] = config.name;
-  doc["fieldName"] = config.fieldName;
-  doc["unit"] = config.unit;
-  doc["minValue"] = config.minValue;
-  doc["maxValue"] = config.maxValue;
-
-  JsonObject thresholds = doc.createNestedObject("thresholds");
-  thresholds["yellowLow"] = config.limits.yellowLow;
-  thresholds["greenLow"] = config.limits.greenLow;
-  thresholds["greenHigh"] = config.limits.greenHigh;
-  thresholds["yellowHigh"] = config.limits.yellowHigh;
-
-  // Analog-specific fields
-  if (sensorId == "ANALOG") {
-    doc["inverted"] = config.inverted;
-    doc["calibrationMode"] = config.calibrationMode;
-    doc["autocalHalfLifeSeconds"] = config.autocalHalfLifeSeconds;
-    doc["absoluteRawMin"] = config.absoluteRawMin;
-    doc["absoluteRawMax"] = config.absoluteRawMax;
-
-    // Store null for INFINITY values
-    if (isinf(config.absoluteMin)) {
-      doc["absoluteMin"] = nullptr;
-    } else {
-      doc["absoluteMin"] = config.absoluteMin;
-    }
-
-    if (isinf(config.absoluteMax)) {
-      doc["absoluteMax"] = nullptr;
-    } else {
-      doc["absoluteMax"] = config.absoluteMax;
-    }
-
-    // Speichere letzten Rohwert
-    doc["lastRawValue"] = config.lastRawValue;
+SensorPersistence::saveMeasurement(const String& sensorId, size_t measurementIndex,
+                                   const MeasurementConfig& config) {
+  if (!ensureMeasurementStore()) {
+    return PersistenceResult::fail(ConfigError::FILE_ERROR, "Measurement store not available");
   }
 
-  // Generisch: Speichere letzten Messwert
-  doc["lastValue"] = config.lastValue;
-
-  String path = getMeasurementFilePath(sensorId, measurementIndex);
-
-  if (!saveJsonFile(path, doc)) {
-    logger.error(F("SensorP"), F("Fehler beim Schreiben von ") + path);
-    return PersistenceResult::fail(ConfigError::SAVE_FAILED, "Cannot write measurement file");
+  uint32_t bytesBefore = g_measurementStore.getStats().bytesAppended;
+  bool ok = appendMeasurement(sensorId, measurementIndex, config);
+  ok &= commitMeasurementStore(bytesBefore);
+  if (!ok) {
+    logger.error(F("SensorP"), F("Fehler beim Speichern von ") + sensorId + F("[") +
+                                   String(measurementIndex) + F("]"));
+    return PersistenceResult::fail(ConfigError::SAVE_FAILED, "Cannot write measurement");
   }
 
   if (ConfigMgr.isDebugSensor()) {
-    logger.debug(F("SensorP"), F("Messung gespeichert: ") + path);
+    LOG_DEBUG(F("SensorP"), F("Messung gespeichert: ") + sensorId + F("[") +
+                                String(measurementIndex) + F("]"));
   }
 
   return PersistenceResult::success();
 }
 
-/**
- * @brief Load a single measurement configuration from JSON file
- * @param sensorId Sensor ID (e.g., "ANALOG", "DHT")
- * @param measurementIndex Measurement index (0-based)
- * @param config Output parameter - loaded configuration
- * @return PersistenceResult indicating success or failure
- */
 SensorPersistence::PersistenceResult
-SensorPersistence::loadMeasurementFromJson(const String& sensorId, size_t measurementIndex,
-                                           MeasurementConfig& config) {
-  String path = getMeasurementFilePath(sensorId, measurementIndex);
+SensorPersistence::loadMeasurement(const String& sensorId, size_t measurementIndex,
+                                   MeasurementConfig& config) {
+  if (!ensureMeasurementStore()) {
+    return PersistenceResult::fail(ConfigError::FILE_ERROR, "Measurement store not available");
+  }
 
-  if (!LittleFS.exists(path)) {
+  // Start from the caller's values so fields of a newer schema keep them
+  PackedMeasurement packed;
+  packMeasurement(config, packed);
+  size_t length;
+  if (!g_measurementStore.read(measurementKey(sensorId, measurementIndex, RECORD_VALUES), &packed,
+                               sizeof(packed), length) ||
+      length < offsetof(PackedMeasurement, minValue) || packed.version == 0) {
     if (ConfigMgr.isDebugSensor()) {
-      logger.debug(F("SensorP"), F("Messung-Datei nicht gefunden: ") + path);
+      LOG_DEBUG(F("SensorP"), F("Messung nicht gefunden: ") + sensorId + F("[") +
+                                  String(measurementIndex) + F("]"));
     }
-    return PersistenceResult::fail(ConfigError::FILE_ERROR, "Measurement file not found");
+    return PersistenceResult::fail(ConfigError::FILE_ERROR, "Measurement not found");
   }
+  unpackMeasurement(packed, sensorId, config);
 
-  // Allocate small JSON document (~512 bytes)
-  DynamicJsonDocument doc(512);
-
-  if (!loadJsonFile(path, doc)) {
-    logger.error(F("SensorP"), F("Fehler beim Lesen von ") + path);
-    return PersistenceResult::fail(ConfigError::FILE_ERROR, "Cannot read measurement file");
+  char table[LogStore::MAX_VALUE_SIZE];
+  if (g_measurementStore.read(measurementKey(sensorId, measurementIndex, RECORD_STRINGS), table,
+                              sizeof(table), length)) {
+    unpackStrings(table, length, config);
   }
 
-  // Deserialize measurement config
-  config.enabled = doc["enabled"] | true;
-  config.name = doc["name"] | String("");
-  config.fieldName = doc["fieldName"] | String("");
-  config.lastValue = doc["lastValue"] | NAN;
-  config.unit = doc["unit"] | String("");
-  config.minValue = doc["minValue"] | 0.0f;
-  config.maxValue = doc["maxValue"] | 100.0f;
-
-  JsonObjectConst thresholds = doc["thresholds"];
-  config.limits.yellowLow = thresholds["yellowLow"] | 0.0f;
-  config.limits.greenLow = thresholds["greenLow"] | 0.0f;
-  config.limits.greenHigh = thresholds["greenHigh"] | 100.0f;
-  config.limits.yellowHigh = thresholds["yellowHigh"] | 100.0f;
-
-  // Analog-specific fields
-  if (sensorId == "ANALOG") {
-    config.inverted = doc["inverted"] | false;
-    config.calibrationMode = doc["calibrationMode"] | false;
-    config.autocalHalfLifeSeconds = doc["autocalHalfLifeSeconds"] | 0;
-    config.lastRawValue = doc["lastRawValue"] | -1;
-    config.absoluteRawMin = doc["absoluteRawMin"] | 0;
-    config.absoluteRawMax = doc["absoluteRawMax"] | 1023;
+  return PersistenceResult::success();
+}
 
-    // Handle null for INFINITY
-    if (doc["absoluteMin"].isNull()) {
-      config.absoluteMin = INFINITY;
-    } else {
-      config.absoluteMin = doc["absoluteMin"] | INFINITY;
-    }
+bool SensorPersistence::hasMeasurement(const String& sensorId, size_t measurementIndex) {
+  return ensureMeasurementStore() &&
+         g_measurementStore.contains(measurementKey(sensorId, measurementIndex, RECORD_VALUES));
+}
 
-    if (doc["absoluteMax"].isNull()) {
-      config.absoluteMax = -INFINITY;
-    } else {
-      config.absoluteMax = doc["absoluteMax"] | -INFINITY;
-    }
+bool SensorPersistence::clearMeasurementStore() {
+  for (auto& e : g_pendingEntries) {
+    e.dirty = 0;
   }
+  g_pendingFields = 0;
+  g_sensorTagCount = 0;
+  return g_measurementStore.clear();
+}
 
-  if (ConfigMgr.isDebugSensor()) {
-    logger.debug(F("SensorP"), F("Messung geladen: ") + path);
-  }
+const char* SensorPersistence::getMeasurementStorePath() { return MEASUREMENT_STORE_PATH; }
 
-  return PersistenceResult::success();
-}
+LogStore::Stats SensorPersistence::getStoreStats() { return g_measurementStore.getStats(); }
+
+const SensorPersistence::LoadStats& SensorPersistence::getLoadStats() { return g_loadStats; }
 
 // ============================================================================
 // Generische Update-Funktionen (Macro-basiert für DRY-Prinzip)
 // ============================================================================
 
-/**
- * @brief Zentrale Feld-Definition für alle MeasurementConfig-Felder
- * Diese Macro-Liste ist die EINZIGE Stelle, die bei neuen Feldern geändert werden muss!
- */
-#define MEASUREMENT_FIELDS                                                                         \
-  FIELD(enabled, bool)                                                                             \
-  FIELD(name, String)                                                                              \
-  FIELD(fieldName, String)                                                                         \
-  FIELD(unit, String)                                                                              \
-  FIELD(minValue, float)                                                                           \
-  FIELD(maxValue, float)                                                                           \
-  FIELD(inverted, bool)                                                                            \
-  FIELD(calibrationMode, bool)                                                                     \
-  FIELD(autocalHalfLifeSeconds, uint32_t)                                                          \
-  FIELD(absoluteRawMin, int)                                                                       \
-  FIELD(absoluteRawMax, int)                                                                       \
-  FIELD(absoluteMin, float)                                                                        \
-  FIELD(absoluteMax, float)                                                                        \
-  FIELD(lastRawValue, int)                                                                         \
-  FIELD(lastValue, float)
-
 /**
  * @brief Helper: Setzt ein einzelnes Feld in MeasurementConfig
  * Nutzt Macro-Expansion um Code-Duplikation zu vermeiden
@@ -843,6 +1173,11 @@ static bool setConfigField(MeasurementConfig& config, const String& fieldName,
     return true;
   }
 
+  // Spezialfall: Aggregationsmodus als Name ("mean", "median", "trimmed", "hampel")
+  if (fieldName == "aggregation") {
+    return aggregationModeFromString(value.as<const char*>(), config.aggregation);
+  }
+
   // Spezialfall: Einzelne Threshold-Felder
   if (fieldName == "yellowLow") {
     config.limits.yellowLow = value.as<float>();
@@ -873,7 +1208,7 @@ SensorPersistence::updateMeasurementSetting(const String& sensorId, size_t measu
                                             const String& fieldName, const JsonVariant& value) {
   // Load
   MeasurementConfig config;
-  auto loadResult = loadMeasurementFromJson(sensorId, measurementIndex, config);
+  auto loadResult = loadMeasurement(sensorId, measurementIndex, config);
   if (!loadResult.isSuccess()) {
     return loadResult;
   }
@@ -884,8 +1219,8 @@ SensorPersistence::updateMeasurementSetting(const String& sensorId, size_t measu
                                    String(F("Unbekanntes Feld: ")) + fieldName);
   }
 
-  // Save
-  return saveMeasurementToJson(sensorId, measurementIndex, config);
+  // Save: ein einzelner Datensatz
+  return saveMeasurement(sensorId, measurementIndex, config);
 }
 
 /**
@@ -896,7 +1231,7 @@ SensorPersistence::PersistenceResult
 SensorPersistence::updateMeasurementSettings(const String& sensorId, size_t measurementIndex,
                                              const JsonObject& settings) {
   MeasurementConfig config;
-  auto loadResult = loadMeasurementFromJson(sensorId, measurementIndex, config);
+  auto loadResult = loadMeasurement(sensorId, measurementIndex, config);
   if (!loadResult.isSuccess()) {
     return loadResult;
   }
@@ -908,7 +1243,7 @@ SensorPersistence::updateMeasurementSettings(const String& sensorId, size_t meas
     }
   }
 
-  return saveMeasurementToJson(sensorId, measurementIndex, config);
+  return saveMeasurement(sensorId, measurementIndex, config);
 }
 
 // Räume Macro-Definition auf
@@ -6,10 +6,31 @@
 #ifndef MANAGER_SENSOR_PERSISTENCE_H
 #define MANAGER_SENSOR_PERSISTENCE_H
 
+#include "../configs/config.h"
+#include "../sensors/sensor_handle.h"
+#include "../utils/log_store.h"
 #include "../utils/result_types.h"
 #include "manager_config_types.h"
 #include <ArduinoJson.h>
 
+// Check if SENSOR_PERSISTENCE_FLUSH_INTERVAL is defined
+#ifndef SENSOR_PERSISTENCE_FLUSH_INTERVAL
+#define SENSOR_PERSISTENCE_FLUSH_INTERVAL 300
+#warning "SENSOR_PERSISTENCE_FLUSH_INTERVAL not defined in config file, defaulting to 300 seconds"
+#endif
+
+// Check if SENSOR_PERSISTENCE_LOW_HEAP is defined
+#ifndef SENSOR_PERSISTENCE_LOW_HEAP
+#define SENSOR_PERSISTENCE_LOW_HEAP 6000
+#warning "SENSOR_PERSISTENCE_LOW_HEAP not defined in config file, defaulting to 6000 bytes"
+#endif
+
+// Check if MEASUREMENT_STORE_SEGMENT_SIZE is defined
+#ifndef MEASUREMENT_STORE_SEGMENT_SIZE
+#define MEASUREMENT_STORE_SEGMENT_SIZE 8192
+#warning "MEASUREMENT_STORE_SEGMENT_SIZE not defined in config file, defaulting to 8192 bytes"
+#endif
+
 // Forward declarations
 #if USE_ANALOG
 class AnalogSensor;
@@ -22,13 +43,44 @@ public:
   using PersistenceResult = TypedResult<ConfigError, void>;
 
   /**
-   * @brief Load sensor configuration from Preferences
+   * @brief Counters of the write-behind cache and measurement store writes
+   */
+  struct FlushStats {
+    uint32_t flushCount{0};         ///< Per-sensor flushes of the write-behind cache
+    uint32_t commits{0};            ///< Measurement store commits (all paths)
+    uint32_t bytesWritten{0};       ///< Bytes appended to the measurement store (all paths)
+    uint32_t updatesQueued{0};      ///< Updates that made a field dirty
+    uint32_t updatesCoalesced{0};   ///< Updates that overwrote an already dirty field
+    uint32_t pendingHighWater{0};   ///< Most dirty fields held at the same time
+    unsigned long lastFlushTime{0}; ///< millis() of the last full flush
+
+    /// @return Share of updates that were absorbed by an already dirty field
+    float coalescingRatio() const {
+      uint32_t total = updatesQueued + updatesCoalesced;
+      return total > 0 ? static_cast<float>(updatesCoalesced) / total : 0.0f;
+    }
+  };
+
+  /**
+   * @brief Duration and heap use of the last load()
+   */
+  struct LoadStats {
+    uint32_t loadMs{0};     ///< Duration of load() including the store mount
+    uint32_t heapBefore{0}; ///< Free heap when load() started
+    uint32_t heapMin{0};    ///< Lowest free heap sampled during load()
+
+    /// @return Heap used at the peak of load()
+    uint32_t heapPeak() const { return heapBefore > heapMin ? heapBefore - heapMin : 0; }
+  };
+
+  /**
+   * @brief Load sensor configuration from the measurement store
    * @return PersistenceResult indicating success or failure
    */
   static PersistenceResult load();
 
   /**
-   * @brief Save sensor configuration to Preferences
+   * @brief Save sensor configuration to the measurement store
    * @return PersistenceResult indicating success or failure
    */
   static PersistenceResult save();
@@ -128,42 +180,76 @@ public:
    * @brief Enqueue an analog raw min/max update to be processed later in the main loop.
    * This avoids performing blocking Preferences writes from a time-critical context.
    * Updates are batched and written every 60 seconds to reduce flash wear.
-   * @param sensorId Sensor ID
+   * @param sensor Sensor handle
    * @param measurementIndex Measurement index
    * @param absoluteRawMin New minimum raw value
    * @param absoluteRawMax New maximum raw value
    */
-  static void enqueueAnalogRawMinMax(const String& sensorId, size_t measurementIndex,
+  static void enqueueAnalogRawMinMax(SensorHandle sensor, size_t measurementIndex,
                                      int absoluteRawMin, int absoluteRawMax);
 
   /**
    * @brief Enqueue an absolute min/max update (float) to be processed later.
    * Used by all sensor types (not just analog) to batch persistence writes.
-   * @param sensorId Sensor ID
+   * @param sensor Sensor handle
    * @param measurementIndex Measurement index
    * @param absoluteMin New minimum value
    * @param absoluteMax New maximum value
    */
-  static void enqueueAbsoluteMinMax(const String& sensorId, size_t measurementIndex,
+  static void enqueueAbsoluteMinMax(SensorHandle sensor, size_t measurementIndex,
                                     float absoluteMin, float absoluteMax);
 
   /**
    * @brief Enqueue an analog min/max/inverted update (integer) to be processed later.
-   * @param sensorId Sensor ID
+   * @param sensor Sensor handle
    * @param measurementIndex Measurement index
    * @param minValue Minimum calibrated value
    * @param maxValue Maximum calibrated value
    * @param inverted Inversion flag
    */
-  static void enqueueAnalogMinMaxInteger(const String& sensorId, size_t measurementIndex,
+  static void enqueueAnalogMinMaxInteger(SensorHandle sensor, size_t measurementIndex,
                                          int minValue, int maxValue, bool inverted);
 
   /**
-   * @brief Flush pending updates for a specific sensor immediately after measurement cycle.
-   * This is the preferred method - each sensor flushes its own data right after measurement.
-   * @param sensorId Sensor ID to flush updates for
+   * @brief Enqueue the last measured value (and raw ADC value) to be persisted later.
+   * Replaces the per-cycle file rewrite; the value is kept in RAM until the next flush.
+   * @param sensor Sensor handle
+   * @param measurementIndex Measurement index
+   * @param lastValue Last processed measurement value
+   * @param lastRawValue Last raw value (-1 if not applicable)
+   */
+  static void enqueueLastValue(SensorHandle sensor, size_t measurementIndex, float lastValue,
+                               int lastRawValue);
+
+  /**
+   * @brief Flush pending updates for a specific sensor.
+   * Every dirty field is appended as one record; the sensor's records share one commit.
+   * @param sensor Handle of the sensor to flush updates for
+   */
+  static void flushPendingUpdatesForSensor(SensorHandle sensor);
+
+  /**
+   * @brief Flush all pending updates of all sensors (e.g. before a reboot)
+   */
+  static void flushAllPendingUpdates();
+
+  /**
+   * @brief Flush the cache if the flush interval elapsed or the heap runs low.
+   * Called from the main loop.
    */
-  static void flushPendingUpdatesForSensor(const String& sensorId);
+  static void processPendingUpdates();
+
+  /**
+   * @brief Get the number of dirty fields currently held in RAM
+   * @return Number of pending (sensor, measurement, field) updates
+   */
+  static size_t getPendingUpdateCount();
+
+  /**
+   * @brief Get write-behind cache statistics
+   * @return Reference to the statistics counters
+   */
+  static const FlushStats& getFlushStats();
 
   /**
    * @brief Update analog sensor calibration mode flag atomically
@@ -186,28 +272,64 @@ public:
                                                  uint32_t halfLifeSeconds);
 
   // ============================================================================
-  // JSON-based persistence (new approach)
+  // Measurement store (/config/measurements.log)
   // ============================================================================
 
   /**
-   * @brief Save a single measurement configuration to JSON file
+   * @brief Save a single measurement configuration to the store
+   * @details A measurement is one versioned, packed binary record plus a
+   *          string table for name, field name and unit. Legacy
+   *          /config/sensor_<ID>_<index>.json files are migrated into the
+   *          store when it is mounted empty.
    * @param sensorId Sensor ID (e.g., "ANALOG", "DHT")
    * @param measurementIndex Measurement index (0-based)
    * @param config Measurement configuration to save
    * @return PersistenceResult indicating success or failure
    */
-  static PersistenceResult saveMeasurementToJson(const String& sensorId, size_t measurementIndex,
-                                                 const MeasurementConfig& config);
+  static PersistenceResult saveMeasurement(const String& sensorId, size_t measurementIndex,
+                                           const MeasurementConfig& config);
 
   /**
-   * @brief Load a single measurement configuration from JSON file
+   * @brief Load a single measurement configuration from the store
    * @param sensorId Sensor ID (e.g., "ANALOG", "DHT")
    * @param measurementIndex Measurement index (0-based)
-   * @param config Output parameter - loaded configuration
+   * @param config Output parameter - fields without a record keep their value
    * @return PersistenceResult indicating success or failure
    */
-  static PersistenceResult loadMeasurementFromJson(const String& sensorId, size_t measurementIndex,
-                                                   MeasurementConfig& config);
+  static PersistenceResult loadMeasurement(const String& sensorId, size_t measurementIndex,
+                                           MeasurementConfig& config);
+
+  /**
+   * @brief Check whether a measurement has been stored
+   * @param sensorId Sensor ID
+   * @param measurementIndex Measurement index (0-based)
+   * @return true if the store holds the measurement
+   */
+  static bool hasMeasurement(const String& sensorId, size_t measurementIndex);
+
+  /**
+   * @brief Remove all stored measurements and pending updates (factory reset)
+   * @return true on success
+   */
+  static bool clearMeasurementStore();
+
+  /**
+   * @brief Get the path of the measurement store file
+   * @return LittleFS path below /config
+   */
+  static const char* getMeasurementStorePath();
+
+  /**
+   * @brief Get measurement store statistics
+   * @return Log size, live records, compactions and mount time
+   */
+  static LogStore::Stats getStoreStats();
+
+  /**
+   * @brief Get duration and heap use of the last load()
+   * @return Reference to the load statistics
+   */
+  static const LoadStats& getLoadStats();
 
   /**
    * @brief Update a single measurement setting via generic field name
@@ -5,7 +5,7 @@
 #include "managers/manager_config.h"
 #include "managers/manager_sensor_persistence.h"
 
-AnalogSensor::~AnalogSensor() { m_state.samples.clear(); }
+AnalogSensor::~AnalogSensor() {}
 
 AnalogSensor::AnalogSensor(const AnalogConfig& config, SensorManager* sensorManager)
     : Sensor(config, sensorManager), m_analogConfig(config) {
@@ -84,17 +84,17 @@ AnalogSensor::AnalogSensor(const AnalogConfig& config, SensorManager* sensorMana
 }
 
 void AnalogSensor::logDebugDetails() const {
-  logDebug(F("Analog-Konfig: pin=") + String(m_analogConfig.pin) + F(", activeMeasurements=") +
-           String(m_analogConfig.activeMeasurements));
+  SENSOR_LOG_DEBUG(F("Analog-Konfig: pin=") + String(m_analogConfig.pin) +
+                   F(", activeMeasurements=") + String(m_analogConfig.activeMeasurements));
 }
 
 SensorResult AnalogSensor::init() {
-  logDebug(F("Initialisiere Analog-Sensor an Pin ") + String(m_analogConfig.pin));
+  SENSOR_LOG_DEBUG(F("Initialisiere Analog-Sensor an Pin ") + String(m_analogConfig.pin));
   auto memoryResult = validateMemoryState();
   if (!memoryResult.isSuccess()) {
     return memoryResult;
   }
-  m_state.samples.clear();
+  resetSampleStatistics(getNumMeasurements());
 #if USE_MULTIPLEXER
   if (m_analogConfig.useMultiplexer) {
     if (!m_multiplexer) {
@@ -109,13 +109,13 @@ SensorResult AnalogSensor::init() {
   }
 #endif
   pinMode(m_analogConfig.pin, INPUT);
-  logger.debug(getName(), F(": Initialisiert an Pin ") + String(m_analogConfig.pin));
+  LOG_DEBUG(getName(), F(": Initialisiert an Pin ") + String(m_analogConfig.pin));
   m_initialized = true;
   return SensorResult::success();
 }
 
 SensorResult AnalogSensor::startMeasurement() {
-  logDebug(F("Starte Analogmessung"));
+  SENSOR_LOG_DEBUG(F("Starte Analogmessung"));
   auto memoryResult = validateMemoryState();
   if (!memoryResult.isSuccess()) {
     return memoryResult;
@@ -136,13 +136,13 @@ SensorResult AnalogSensor::startMeasurement() {
   m_state.operationStartTime = millis();
   // Reset clamping warning flags for new measurement cycle
   std::fill(m_clampWarningShown.begin(), m_clampWarningShown.end(), false);
-  logger.debug(getName(), F(": Starte neuen Messzyklus für ") +
-                              String(m_analogConfig.activeMeasurements) + F(" Sensoren"));
+  LOG_DEBUG(getName(), F(": Starte neuen Messzyklus für ") +
+                        String(m_analogConfig.activeMeasurements) + F(" Sensoren"));
   return SensorResult::success();
 }
 
 SensorResult AnalogSensor::continueMeasurement() {
-  logDebug(F("Setze Analogmessung fort"));
+  SENSOR_LOG_DEBUG(F("Setze Analogmessung fort"));
   // DRY: The base class handles measurement cycling, so just validate state and
   // return success
   auto memoryResult = validateMemoryState();
@@ -168,9 +168,9 @@ SensorResult AnalogSensor::continueMeasurement() {
 }
 
 void AnalogSensor::deinitialize() {
-  logDebug(F("Deinitialisiere Analog-Sensor"));
+  SENSOR_LOG_DEBUG(F("Deinitialisiere Analog-Sensor"));
   Sensor::deinitialize();
-  Sensor::clearAndShrink(m_state.samples);
+  resetSampleStatistics(0);
 #if USE_MULTIPLEXER
   if (m_multiplexer) {
     m_multiplexer.reset();
@@ -180,8 +180,8 @@ void AnalogSensor::deinitialize() {
 
 bool AnalogSensor::validateReading(int reading, size_t measurementIndex) const {
   if (measurementIndex >= m_analogConfig.measurements.size()) {
-    logDebug(F("AnalogSensor: Index außerhalb des Bereichs für Messungen! index=") +
-             String(measurementIndex));
+    SENSOR_LOG_DEBUG(F("AnalogSensor: Index außerhalb des Bereichs für Messungen! index=") +
+                     String(measurementIndex));
     return false;
   }
   // Für analoge Sensoren akzeptieren wir jetzt alle Werte, da wir sie in fetchSample begrenzen.
@@ -191,8 +191,8 @@ bool AnalogSensor::validateReading(int reading, size_t measurementIndex) const {
 
 float AnalogSensor::mapAnalogValue(int rawValue, size_t measurementIndex) const {
   if (measurementIndex >= m_analogConfig.measurements.size()) {
-    logDebug(F("AnalogSensor: Index außerhalb des Bereichs für Messungen! index=") +
-             String(measurementIndex));
+    SENSOR_LOG_DEBUG(F("AnalogSensor: Index außerhalb des Bereichs für Messungen! index=") +
+                     String(measurementIndex));
     return 0.0f;
   }
   // Use accessor helpers so autocal (when active) is taken into account.
@@ -206,19 +206,21 @@ float AnalogSensor::mapAnalogValue(int rawValue, size_t measurementIndex) const
   // Wenn invertiert, wird der Rohwert umgekehrt auf den Prozentwert abgebildet
   if (inverted) {
     float percentage = 100.0f * (maxValue - rawValue) / (maxValue - minValue);
-    logDebug(F("Invertierte Abbildung: roh=") + String(rawValue) + F(", min=") + String(minValue) +
-             F(", max=") + String(maxValue) + F(", Ergebnis=") + String(percentage) + F("%"));
+    SENSOR_LOG_DEBUG(F("Invertierte Abbildung: roh=") + String(rawValue) + F(", min=") +
+                     String(minValue) + F(", max=") + String(maxValue) + F(", Ergebnis=") +
+                     String(percentage) + F("%"));
     return percentage;
   } else {
     float percentage = 100.0f * (rawValue - minValue) / (maxValue - minValue);
-    logDebug(F("Normale Abbildung: roh=") + String(rawValue) + F(", min=") + String(minValue) +
-             F(", max=") + String(maxValue) + F(", Ergebnis=") + String(percentage) + F("%"));
+    SENSOR_LOG_DEBUG(F("Normale Abbildung: roh=") + String(rawValue) + F(", min=") +
+                     String(minValue) + F(", max=") + String(maxValue) + F(", Ergebnis=") +
+                     String(percentage) + F("%"));
     return percentage;
   }
 }
 
 bool AnalogSensor::fetchSample(float& value, size_t index) {
-  logDebug(F("Lese analogen Messwert für Index ") + String(index));
+  SENSOR_LOG_DEBUG(F("Lese analogen Messwert für Index ") + String(index));
 #if USE_MULTIPLEXER
   if (m_analogConfig.useMultiplexer && m_multiplexer) {
     if (!m_multiplexer->switchToSensor(index + 1)) {
@@ -231,7 +233,8 @@ bool AnalogSensor::fetchSample(float& value, size_t index) {
   }
 #endif
   if (index >= m_analogConfig.measurements.size()) {
-    logDebug(F("AnalogSensor: Index außerhalb des Bereichs für Messungen! index=") + String(index));
+    SENSOR_LOG_DEBUG(F("AnalogSensor: Index außerhalb des Bereichs für Messungen! index=") +
+                     String(index));
     value = NAN;
     return false;
   }
@@ -283,21 +286,21 @@ bool AnalogSensor::fetchSample(float& value, size_t index) {
       cfg.measurements[index].absoluteRawMin = newRawMin;
       cfg.measurements[index].absoluteRawMax = newRawMax;
 
-      if (ConfigMgr.isDebugSensor()) {
-        logger.debug(getName(), F("Neue absolute Roh-Extrema erkannt; persistiere: Min=") +
-                                    String(newRawMin) + F(", Max=") + String(newRawMax));
+      if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugSensor())) {
+        LOG_DEBUG(getName(), F("Neue absolute Roh-Extrema erkannt; persistiere: Min=") +
+                                 String(newRawMin) + F(", Max=") + String(newRawMax));
       }
 
       // Defer persistence to avoid blocking in the measurement path
-      SensorPersistence::enqueueAnalogRawMinMax(this->getId(), index, newRawMin, newRawMax);
-      if (ConfigMgr.isDebugSensor())
-        logger.debug(getName(), F("Absolute Roh-Extrema enqueued for persistence"));
+      SensorPersistence::enqueueAnalogRawMinMax(this->getHandle(), index, newRawMin, newRawMax);
+      if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugSensor()))
+        LOG_DEBUG(getName(), F("Absolute Roh-Extrema enqueued for persistence"));
     }
   }
 
   // Debug: print runtime calibration and autocal state so we can see why
   // clamping or autocal updates happen during measurement cycles.
-  if (ConfigMgr.isDebugSensor()) {
+  if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugSensor())) {
     bool cfgCal = false;
     if (index < this->mutableConfig().measurements.size())
       cfgCal = this->mutableConfig().measurements[index].calibrationMode;
@@ -312,7 +315,7 @@ bool AnalogSensor::fetchSample(float& value, size_t index) {
         String(m_analogConfig.measurements[index].autocal.max_value) + F(", autocalMinF=") +
         String(m_analogConfig.measurements[index].autocal.min_value_f) + F(", autocalMaxF=") +
         String(m_analogConfig.measurements[index].autocal.max_value_f);
-    logger.debug(getName(), dbg);
+    LOG_DEBUG(getName(), dbg);
   }
 
   // Derive a unified 'calibration mode' flag from both the runtime copy
@@ -345,12 +348,12 @@ bool AnalogSensor::fetchSample(float& value, size_t index) {
         int persistMax = static_cast<int>(measurement.autocal.max_value);
 
         // Enqueue instead of blocking write
-        SensorPersistence::enqueueAnalogMinMaxInteger(m_analogConfig.id, index, persistMin,
+        SensorPersistence::enqueueAnalogMinMaxInteger(getHandle(), index, persistMin,
                                                       persistMax, measurement.inverted);
         persistedImmediate = true;
-        if (ConfigMgr.isDebugSensor())
-          logger.debug(getName(),
-                       F("Autocal: untere Grenze auf Rohwert gesetzt: ") + String(persistMin));
+        if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugSensor()))
+          LOG_DEBUG(getName(),
+                    F("Autocal: untere Grenze auf Rohwert gesetzt: ") + String(persistMin));
       } else if (raw > curMaxInt) {
         // Expand upper bound immediately
         measurement.autocal.max_value_f = static_cast<float>(raw);
@@ -360,22 +363,22 @@ bool AnalogSensor::fetchSample(float& value, size_t index) {
         int persistMax = static_cast<int>(measurement.autocal.max_value);
 
         // Enqueue instead of blocking write
-        SensorPersistence::enqueueAnalogMinMaxInteger(m_analogConfig.id, index, persistMin,
+        SensorPersistence::enqueueAnalogMinMaxInteger(getHandle(), index, persistMin,
                                                       persistMax, measurement.inverted);
         persistedImmediate = true;
-        if (ConfigMgr.isDebugSensor())
-          logger.debug(getName(),
-                       F("Autocal: obere Grenze auf Rohwert gesetzt: ") + String(persistMax));
+        if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugSensor()))
+          LOG_DEBUG(getName(),
+                    F("Autocal: obere Grenze auf Rohwert gesetzt: ") + String(persistMax));
       }
 
       // If we didn't perform an immediate expansion, run the EMA-based
       // autocal update to slowly forget old extrema. Persist only when
       // the integer-rounded bounds change (reduces flash wear).
       if (!persistedImmediate) {
-        if (ConfigMgr.isDebugSensor()) {
-          logger.debug(getName(), F("AutoCal update aufrufen: roh=") + String(raw) +
-                                      F(", cal_min=") + String(measurement.autocal.min_value) +
-                                      F(", cal_max=") + String(measurement.autocal.max_value));
+        if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugSensor())) {
+          LOG_DEBUG(getName(), F("AutoCal update aufrufen: roh=") + String(raw) +
+                                   F(", cal_min=") + String(measurement.autocal.min_value) +
+                                   F(", cal_max=") + String(measurement.autocal.max_value));
         }
         // Compute alpha from configured autocal half-life and current
         // measurement interval so alpha adapts automatically when interval
@@ -394,20 +397,20 @@ bool AnalogSensor::fetchSample(float& value, size_t index) {
           measurement.autocal.max_value_f = static_cast<float>(raw);
           measurement.autocal.last_update_time = minutes;
           autocalChanged = true;
-          if (ConfigMgr.isDebugSensor()) {
-            logger.debug(getName(),
-                         F("Autocal-Inversion erkannt; min/max auf aktuellen Rohwert gesetzt: ") +
-                             String(raw));
+          if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugSensor())) {
+            LOG_DEBUG(getName(),
+                      F("Autocal-Inversion erkannt; min/max auf aktuellen Rohwert gesetzt: ") +
+                          String(raw));
           }
         }
-        if (ConfigMgr.isDebugSensor() && !autocalChanged) {
-          logger.debug(getName(), F("AutoCal-Aufruf: keine Änderung (roh=") + String(raw) + F(")"));
+        if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugSensor()) && !autocalChanged) {
+          LOG_DEBUG(getName(), F("AutoCal-Aufruf: keine Änderung (roh=") + String(raw) + F(")"));
         }
         if (autocalChanged) {
-          if (ConfigMgr.isDebugSensor()) {
-            logger.debug(getName(), F("Autokalibrierung geändert für Index ") + String(index) +
-                                        F(": min=") + String(measurement.autocal.min_value) +
-                                        F(", max=") + String(measurement.autocal.max_value));
+          if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugSensor())) {
+            LOG_DEBUG(getName(), F("Autokalibrierung geändert für Index ") + String(index) +
+                                     F(": min=") + String(measurement.autocal.min_value) +
+                                     F(", max=") + String(measurement.autocal.max_value));
           }
           // Apply autocal result to the calculation limits
           measurement.minValue = static_cast<float>(measurement.autocal.min_value);
@@ -417,11 +420,11 @@ bool AnalogSensor::fetchSample(float& value, size_t index) {
           int persistMax = static_cast<int>(measurement.autocal.max_value);
 
           // Enqueue instead of blocking write
-          SensorPersistence::enqueueAnalogMinMaxInteger(m_analogConfig.id, index, persistMin,
+          SensorPersistence::enqueueAnalogMinMaxInteger(getHandle(), index, persistMin,
                                                         persistMax, measurement.inverted);
 
-          if (ConfigMgr.isDebugSensor())
-            logger.debug(getName(), F("Autocal int min/max in Queue für Index ") + String(index));
+          if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugSensor()))
+            LOG_DEBUG(getName(), F("Autocal int min/max in Queue für Index ") + String(index));
         }
       }
     }
@@ -469,11 +472,11 @@ bool AnalogSensor::fetchSample(float& value, size_t index) {
 
   // Debug-Log für invertierte Sensoren
   if (index < m_analogConfig.measurements.size() && m_analogConfig.measurements[index].inverted) {
-    logDebug(F("Invertierter Sensor: roh=") + String(clampedRaw) + F(", abgebildet=") +
-             String(value) + F("%"));
+    SENSOR_LOG_DEBUG(F("Invertierter Sensor: roh=") + String(clampedRaw) + F(", abgebildet=") +
+                     String(value) + F("%"));
   }
 
-  logDebug(F("Gelesener Wert: ") + String(value));
+  SENSOR_LOG_DEBUG(F("Gelesener Wert: ") + String(value));
 
   // Persist updated calculation limits immediately if autocal changed
   // (this is done earlier in the autocal update block). No further action
@@ -32,10 +32,10 @@ SensorResult Multiplexer::init() {
     return SensorResult::success();
 
   try {
-    logger.debug(F("Multiplexer"), F("Initialisiere Multiplexer-Pins:"));
-    logger.debug(F("Multiplexer"), F("Pin A (LSB): ") + String(MUX_A));
-    logger.debug(F("Multiplexer"), F("Pin B     : ") + String(MUX_B));
-    logger.debug(F("Multiplexer"), F("Pin C (MSB): ") + String(MUX_C));
+    LOG_DEBUG(F("Multiplexer"), F("Initialisiere Multiplexer-Pins:"));
+    LOG_DEBUG(F("Multiplexer"), F("Pin A (LSB): ") + String(MUX_A));
+    LOG_DEBUG(F("Multiplexer"), F("Pin B     : ") + String(MUX_B));
+    LOG_DEBUG(F("Multiplexer"), F("Pin C (MSB): ") + String(MUX_C));
 
     // Set up the select pins as outputs
     pinMode(MUX_A, OUTPUT);
@@ -57,7 +57,7 @@ SensorResult Multiplexer::init() {
     bool pinCState = digitalRead(MUX_C);
 
     String binaryState = String(pinCState) + String(pinBState) + String(pinAState);
-    logger.debug(F("Multiplexer"), F("Initiale Pin-Zustände (CBA): ") + binaryState);
+    LOG_DEBUG(F("Multiplexer"), F("Initiale Pin-Zustände (CBA): ") + binaryState);
 
     if (pinAState != HIGH || pinBState != HIGH || pinCState != HIGH) {
       logger.error(F("Multiplexer"),
@@ -113,8 +113,8 @@ bool Multiplexer::switchToSensor(int sensorIndex) {
   bool pinCState = (muxAddress >> 2) & 0x01; // MSB
 
   String binaryAddress = String(pinCState) + String(pinBState) + String(pinAState);
-  logger.debug(F("Multiplexer"), F("Wechsle von Kanal ") + String(m_currentChannel) + F(" zu ") +
-                                     String(sensorIndex) + F(" (Binär: ") + binaryAddress + F(")"));
+  LOG_DEBUG(F("Multiplexer"), F("Wechsle von Kanal ") + String(m_currentChannel) + F(" zu ") +
+                                  String(sensorIndex) + F(" (Binär: ") + binaryAddress + F(")"));
 
   // Set all pins at once to minimize transition time
   // record target and start time so we can measure actual settle time
@@ -163,8 +163,8 @@ bool Multiplexer::switchToSensor(int sensorIndex) {
   if (m_switchStartTime != 0) {
     elapsed = millis() - m_switchStartTime;
   }
-  logger.debug(F("Multiplexer"), F("Erfolgreich auf Kanal ") + String(sensorIndex) +
-                                     F(" umgeschaltet nach ") + String(elapsed) + F("ms"));
+  LOG_DEBUG(F("Multiplexer"), F("Erfolgreich auf Kanal ") + String(sensorIndex) +
+                                  F(" umgeschaltet nach ") + String(elapsed) + F("ms"));
 
   // clear start time to avoid future miscalculations
   m_switchStartTime = 0;
@@ -46,16 +46,16 @@ DHTSensor::~DHTSensor() {
 }
 
 void DHTSensor::logDebugDetails() const {
-  logDebug(F("DHT-Konfig: pin=") + String(m_pin) + F(", typ=") + String(m_type));
+  SENSOR_LOG_DEBUG(F("DHT-Konfig: pin=") + String(m_pin) + F(", typ=") + String(m_type));
 }
 
 SensorResult DHTSensor::init() {
-  logDebug(F("Initialisiere DHT-Sensor an Pin ") + String(m_pin));
+  SENSOR_LOG_DEBUG(F("Initialisiere DHT-Sensor an Pin ") + String(m_pin));
   DHTesp::DHT_MODEL_t dhtModel = (m_type == 22) ? DHTesp::DHT22 : DHTesp::DHT11;
   m_dhtesp.setup(m_pin, dhtModel);
   m_initialized = true;
-  logger.debug(getName(), F("DHTesp-Initialisierung abgeschlossen (Typ: ") +
-                              String((m_type == 22) ? "DHT22" : "DHT11") + F(")"));
+  LOG_DEBUG(getName(), F("DHTesp-Initialisierung abgeschlossen (Typ: ") +
+                           String((m_type == 22) ? "DHT22" : "DHT11") + F(")"));
   return SensorResult::success();
 }
 
@@ -66,7 +66,7 @@ SensorResult DHTSensor::init() {
 // [REMOVED: std::vector<float> DHTSensor::readMeasurement()]
 
 void DHTSensor::deinitialize() {
-  logDebug(F("Deinitialisiere DHT-Sensor"));
+  SENSOR_LOG_DEBUG(F("Deinitialisiere DHT-Sensor"));
   Sensor::deinitialize();
   m_initialized = false;
 
@@ -94,7 +94,7 @@ bool DHTSensor::canAccessHardware() const {
  * @return true if successful, false if hardware error
  */
 bool DHTSensor::fetchSample(float& value, size_t index) {
-  logDebug(F("Lese DHT-Probe für Index ") + String(index));
+  SENSOR_LOG_DEBUG(F("Lese DHT-Probe für Index ") + String(index));
   if (!m_initialized) {
     logger.error(getName(), F("DHTSensor nicht in fetchSample initialisiert"));
     return false;
@@ -107,17 +107,17 @@ bool DHTSensor::fetchSample(float& value, size_t index) {
     value = NAN;
     return false;
   }
-  logDebug(F("Gelesener Wert: ") + String(value));
+  SENSOR_LOG_DEBUG(F("Gelesener Wert: ") + String(value));
   return !isnan(value);
 }
 
 SensorResult DHTSensor::startMeasurement() {
-  logDebug(F("Starting DHT measurement"));
+  SENSOR_LOG_DEBUG(F("Starting DHT measurement"));
   return performMeasurementCycle();
 }
 
 SensorResult DHTSensor::continueMeasurement() {
-  logDebug(F("Continuing DHT measurement"));
+  SENSOR_LOG_DEBUG(F("Continuing DHT measurement"));
   return performMeasurementCycle();
 }
 
@@ -36,11 +36,11 @@ void SensorFactory::logSensorStatus(const String& phase, const Sensor* sensor) {
   if (!sensor)
     return;
 
-  logger.debug(F("SensorFactory"), phase + F(": Sensor ") + sensor->getName() + F(" [ID: ") +
-                                       sensor->getId() + F(", Aktiv: ") +
-                                       String(sensor->isEnabled() ? "ja" : "nein") +
-                                       F(", Fehler: ") + String(sensor->getErrorCount()) +
-                                       F(", Status: ") + sensor->getStatus() + F("]"));
+  LOG_DEBUG(F("SensorFactory"), phase + F(": Sensor ") + sensor->getName() + F(" [ID: ") +
+                                    sensor->getId() + F(", Aktiv: ") +
+                                    String(sensor->isEnabled() ? "ja" : "nein") +
+                                    F(", Fehler: ") + String(sensor->getErrorCount()) +
+                                    F(", Status: ") + sensor->getStatus() + F("]"));
 }
 
 SensorResult SensorFactory::initializeSensor(std::unique_ptr<Sensor>& sensor) {
@@ -48,7 +48,17 @@ SensorResult SensorFactory::initializeSensor(std::unique_ptr<Sensor>& sensor) {
     return SensorResult::fail(SensorError::INITIALIZATION_ERROR, "Null sensor pointer");
   }
 
-  logger.debug(F("SensorFactory"), F("Beginne Initialisierung für ") + sensor->getName());
+  LOG_DEBUG(F("SensorFactory"), F("Beginne Initialisierung für ") + sensor->getName());
+
+  // The handle identifies the sensor on the measurement hot path
+  sensor->setHandle(SensorRegistry::registerSensor(sensor->getId()));
+  if (sensor->getHandle() == INVALID_SENSOR_HANDLE) {
+    logger.error(F("SensorFactory"),
+                 F("Kein Sensor-Handle für ") + sensor->getId() +
+                     F(" (Tabelle voll oder ID länger als ") +
+                     String(SensorRegistry::ID_LEN - 1) + F(" Zeichen)"));
+    return SensorResult::fail(SensorError::RESOURCE_ERROR);
+  }
 
   // Basic initialization
   auto initResult = sensor->init();
@@ -67,7 +77,7 @@ SensorResult SensorFactory::initializeSensor(std::unique_ptr<Sensor>& sensor) {
   // No action needed here unless you want to override from another source.
 
   sensor->setEnabled(true);
-  logger.debug(F("SensorFactory"), sensor->getName() + F(" erfolgreich initialisiert"));
+  LOG_DEBUG(F("SensorFactory"), sensor->getName() + F(" erfolgreich initialisiert"));
   return SensorResult::success();
 }
 
@@ -79,6 +89,7 @@ SensorFactory::createAllSensors(std::vector<std::unique_ptr<Sensor>>& sensors,
   try {
     logger.logMemoryStats(F("vor_sensorerstellung"));
     sensors.clear();
+    SensorRegistry::clear();
 
     std::vector<String> errors;
 
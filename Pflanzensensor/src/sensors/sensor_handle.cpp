@@ -0,0 +1,39 @@
+/**
+ * @file sensor_handle.cpp
+ * @brief Implementation of the sensor handle registry
+ */
+
+#include "sensors/sensor_handle.h"
+
+static char g_sensorIds[SensorRegistry::MAX_SENSORS][SensorRegistry::ID_LEN];
+static size_t g_sensorCount = 0;
+
+SensorHandle SensorRegistry::registerSensor(const String& sensorId) {
+  SensorHandle existing = find(sensorId);
+  if (existing != INVALID_SENSOR_HANDLE) {
+    return existing;
+  }
+  // A truncated ID would never be found again
+  if (g_sensorCount >= MAX_SENSORS || sensorId.length() >= ID_LEN) {
+    return INVALID_SENSOR_HANDLE;
+  }
+  memcpy(g_sensorIds[g_sensorCount], sensorId.c_str(), sensorId.length() + 1);
+  return static_cast<SensorHandle>(g_sensorCount++);
+}
+
+SensorHandle SensorRegistry::find(const String& sensorId) {
+  for (size_t i = 0; i < g_sensorCount; i++) {
+    if (sensorId.equals(g_sensorIds[i])) {
+      return static_cast<SensorHandle>(i);
+    }
+  }
+  return INVALID_SENSOR_HANDLE;
+}
+
+const char* SensorRegistry::getId(SensorHandle handle) {
+  return handle < g_sensorCount ? g_sensorIds[handle] : "";
+}
+
+size_t SensorRegistry::count() { return g_sensorCount; }
+
+void SensorRegistry::clear() { g_sensorCount = 0; }
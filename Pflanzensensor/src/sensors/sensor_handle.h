@@ -0,0 +1,67 @@
+/**
+ * @file sensor_handle.h
+ * @brief Compact integer handles for sensors
+ * @details The measurement loop identifies sensors by a small integer handle
+ *          assigned by SensorFactory. String IDs are only resolved at the API
+ *          and persistence boundary (web handlers, file names, log output).
+ */
+#ifndef SENSOR_HANDLE_H
+#define SENSOR_HANDLE_H
+
+#include <Arduino.h>
+
+/// Index of a sensor in the SensorRegistry
+using SensorHandle = uint8_t;
+
+/// Handle of a sensor that was not registered
+static constexpr SensorHandle INVALID_SENSOR_HANDLE = 0xFF;
+
+/**
+ * @class SensorRegistry
+ * @brief Static table mapping sensor handles to their String IDs
+ * @details Filled by SensorFactory when sensors are created. IDs are kept in
+ *          fixed buffers, so resolving a handle never allocates.
+ */
+class SensorRegistry {
+public:
+  /// Maximum number of registered sensors
+  static constexpr size_t MAX_SENSORS = 8;
+  /// Maximum sensor ID length incl. terminator
+  static constexpr size_t ID_LEN = 12;
+
+  /**
+   * @brief Register a sensor ID and assign its handle
+   * @param sensorId Sensor ID
+   * @return Handle of the sensor (the existing one if already registered),
+   *         INVALID_SENSOR_HANDLE if the table is full or the ID has
+   *         ID_LEN or more characters
+   */
+  static SensorHandle registerSensor(const String& sensorId);
+
+  /**
+   * @brief Look up the handle of a sensor ID
+   * @param sensorId Sensor ID
+   * @return Handle or INVALID_SENSOR_HANDLE if unknown
+   */
+  static SensorHandle find(const String& sensorId);
+
+  /**
+   * @brief Resolve a handle to its sensor ID
+   * @param handle Sensor handle
+   * @return Sensor ID, empty string for an unknown handle
+   */
+  static const char* getId(SensorHandle handle);
+
+  /// @return Number of registered sensors
+  static size_t count();
+
+  /**
+   * @brief Remove all registrations (before sensors are recreated)
+   */
+  static void clear();
+
+private:
+  SensorRegistry() = delete;
+};
+
+#endif // SENSOR_HANDLE_H
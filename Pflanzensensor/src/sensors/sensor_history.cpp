@@ -0,0 +1,213 @@
+/**
+ * @file sensor_history.cpp
+ * @brief Implementation of the RAM measurement history
+ */
+
+#include "sensors/sensor_history.h"
+
+#include <new>
+
+// Rollup tiers in the order of Channel::newestBucket
+static constexpr HistoryResolution ROLLUP_TIERS[MeasurementHistory::TIER_COUNT] = {
+    HistoryResolution::MINUTE, HistoryResolution::HOUR, HistoryResolution::DAY};
+
+int16_t MeasurementHistory::encodeValue(float value) {
+  if (isnan(value)) {
+    return INVALID_VALUE;
+  }
+  float scaled = roundf(value * VALUE_SCALE);
+  // INT16_MIN is reserved for invalid samples
+  if (scaled > INT16_MAX) {
+    return INT16_MAX;
+  }
+  if (scaled < INT16_MIN + 1) {
+    return INT16_MIN + 1;
+  }
+  return static_cast<int16_t>(scaled);
+}
+
+int MeasurementHistory::findChannel(const String& sensorId, size_t measurementIndex) const {
+  for (size_t i = 0; i < CHANNEL_COUNT; i++) {
+    if (m_channels[i] == nullptr) {
+      continue;
+    }
+    const Channel& ch = *m_channels[i];
+    if (ch.measurementIndex == measurementIndex && sensorId.equals(ch.sensorId)) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+void MeasurementHistory::record(const String& sensorId, size_t measurementIndex,
+                                uint32_t timestamp, float value) {
+  int index = findChannel(sensorId, measurementIndex);
+  if (index < 0) {
+    // Bind the first free channel to this measurement; it is allocated once
+    // and kept, so only enabled measurements take memory
+    for (size_t i = 0; i < CHANNEL_COUNT; i++) {
+      if (m_channels[i] == nullptr) {
+        Channel* ch = new (std::nothrow) Channel();
+        if (ch == nullptr) {
+          return; // Out of memory, the measurement stays without history
+        }
+        strncpy(ch->sensorId, sensorId.c_str(), SENSOR_ID_LEN - 1);
+        ch->sensorId[SENSOR_ID_LEN - 1] = '\0';
+        ch->measurementIndex = static_cast<uint8_t>(measurementIndex);
+        ch->lastTimestamp = timestamp;
+        m_channels[i] = ch;
+        m_allocatedChannels++;
+        index = static_cast<int>(i);
+        break;
+      }
+    }
+    if (index < 0) {
+      return; // All channels bound, nothing to record into
+    }
+  }
+
+  Channel& ch = *m_channels[index];
+
+  // Delta to previous sample; clock steps backwards are stored as 0
+  uint32_t delta = 0;
+  if (ch.count > 0 && timestamp > ch.lastTimestamp) {
+    delta = timestamp - ch.lastTimestamp;
+    if (delta > UINT16_MAX) {
+      delta = UINT16_MAX;
+    }
+  }
+
+  size_t slot;
+  if (ch.count < CAPACITY) {
+    slot = physicalIndex(ch, ch.count);
+    ch.count++;
+  } else {
+    // Overwrite the oldest sample
+    slot = ch.head;
+    ch.head = (ch.head + 1) % CAPACITY;
+  }
+
+  int16_t stored = encodeValue(value);
+  ch.samples[slot].delta = static_cast<uint16_t>(delta);
+  ch.samples[slot].value = stored;
+  if (timestamp > ch.lastTimestamp) {
+    ch.lastTimestamp = timestamp;
+  }
+
+  if (stored != INVALID_VALUE) {
+    updateRollups(ch, timestamp, stored);
+  }
+}
+
+void MeasurementHistory::updateRollups(Channel& ch, uint32_t timestamp, int16_t value) {
+  for (size_t tier = 0; tier < TIER_COUNT; tier++) {
+    size_t capacity = getTierCapacity(ROLLUP_TIERS[tier]);
+    uint32_t bucketNumber = timestamp / getBucketSeconds(ROLLUP_TIERS[tier]);
+    uint32_t& newest = ch.newestBucket[tier];
+
+    // Sample older than the retained window (clock stepped back)
+    if (bucketNumber + capacity <= newest) {
+      continue;
+    }
+
+    RollupBucket& bucket = tierBuckets(ch, tier)[bucketNumber % capacity];
+    if (bucket.count == 0 || bucket.tag != static_cast<uint16_t>(bucketNumber)) {
+      // Slot holds an expired bucket: start a new one
+      bucket.tag = static_cast<uint16_t>(bucketNumber);
+      bucket.count = 0;
+      bucket.min = value;
+      bucket.max = value;
+      bucket.sum = 0;
+    }
+    if (bucket.count == UINT16_MAX) {
+      continue;
+    }
+
+    if (value < bucket.min) {
+      bucket.min = value;
+    }
+    if (value > bucket.max) {
+      bucket.max = value;
+    }
+    bucket.sum += value;
+    bucket.count++;
+
+    if (bucketNumber > newest) {
+      newest = bucketNumber;
+    }
+  }
+}
+
+uint32_t MeasurementHistory::getOldestTimestamp(const Channel& ch) const {
+  uint32_t ts = ch.lastTimestamp;
+  for (size_t i = ch.count; i > 1; i--) {
+    uint16_t delta = ch.samples[physicalIndex(ch, i - 1)].delta;
+    if (delta > ts) {
+      break;
+    }
+    ts -= delta;
+  }
+  return ts;
+}
+
+HistoryResolution MeasurementHistory::selectResolution(size_t channel, uint32_t since,
+                                                       uint32_t now, size_t maxPoints) const {
+  if (!isChannelUsed(channel)) {
+    return HistoryResolution::RAW;
+  }
+  const Channel& ch = *m_channels[channel];
+
+  // Raw samples cover the range if nothing was evicted yet or the oldest
+  // retained sample is older than the requested start
+  if (ch.count < CAPACITY || getOldestTimestamp(ch) <= since) {
+    size_t points = forEachSince(channel, since, CAPACITY, [](uint32_t, float) {});
+    if (points <= maxPoints) {
+      return HistoryResolution::RAW;
+    }
+  }
+
+  for (size_t tier = 0; tier < TIER_COUNT; tier++) {
+    uint32_t seconds = getBucketSeconds(ROLLUP_TIERS[tier]);
+    uint32_t firstBucket = since / seconds;
+    uint32_t lastBucket = now / seconds;
+    size_t points = lastBucket >= firstBucket ? lastBucket - firstBucket + 1 : 0;
+    if (points <= getTierCapacity(ROLLUP_TIERS[tier]) && points <= maxPoints) {
+      return ROLLUP_TIERS[tier];
+    }
+  }
+  return HistoryResolution::DAY;
+}
+
+size_t MeasurementHistory::getMemoryUsage() {
+  return sizeof(Channel) * getInstance().m_allocatedChannels;
+}
+
+const __FlashStringHelper* MeasurementHistory::resolutionToString(HistoryResolution resolution) {
+  switch (resolution) {
+  case HistoryResolution::MINUTE:
+    return F("minute");
+  case HistoryResolution::HOUR:
+    return F("hour");
+  case HistoryResolution::DAY:
+    return F("day");
+  case HistoryResolution::RAW:
+  default:
+    return F("raw");
+  }
+}
+
+bool MeasurementHistory::resolutionFromString(const String& name,
+                                              HistoryResolution& resolution) {
+  if (name == "raw") {
+    resolution = HistoryResolution::RAW;
+  } else if (name == "minute") {
+    resolution = HistoryResolution::MINUTE;
+  } else if (name == "hour") {
+    resolution = HistoryResolution::HOUR;
+  } else if (name == "day") {
+    resolution = HistoryResolution::DAY;
+  } else {
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,379 @@
+/**
+ * @file sensor_history.h
+ * @brief Fixed-size RAM history of measurement values
+ * @details Keeps the most recent samples of every enabled measurement in a
+ *          ring buffer. Samples are stored packed as a 16-bit timestamp delta
+ *          to the previous sample plus a 16-bit value scaled by VALUE_SCALE,
+ *          i.e. 4 bytes per sample. In addition each measurement keeps
+ *          min/max/mean/count rollups at minute, hour and day resolution.
+ *
+ *          Memory: a channel takes about 24 + 4 * MEASUREMENT_HISTORY_SIZE +
+ *          12 * (MEASUREMENT_ROLLUP_MINUTES + MEASUREMENT_ROLLUP_HOURS +
+ *          MEASUREMENT_ROLLUP_DAYS) bytes, about 2.2 KB with the defaults.
+ *          Channels are allocated from the heap once, when an enabled
+ *          measurement records its first sample, and are never freed.
+ *          Disabled measurements take no channel memory; only a pointer per
+ *          possible measurement is reserved statically.
+ */
+#ifndef SENSOR_HISTORY_H
+#define SENSOR_HISTORY_H
+
+#include <Arduino.h>
+
+#include "configs/config.h"
+#include "sensors/sensor_count.h"
+
+// Check if MEASUREMENT_HISTORY_SIZE is defined
+#ifndef MEASUREMENT_HISTORY_SIZE
+#define MEASUREMENT_HISTORY_SIZE 120
+#warning "MEASUREMENT_HISTORY_SIZE not defined in config file, defaulting to 120 samples"
+#endif
+
+// Check if MEASUREMENT_ROLLUP_MINUTES is defined
+#ifndef MEASUREMENT_ROLLUP_MINUTES
+#define MEASUREMENT_ROLLUP_MINUTES 60
+#warning "MEASUREMENT_ROLLUP_MINUTES not defined in config file, defaulting to 60 buckets"
+#endif
+
+// Check if MEASUREMENT_ROLLUP_HOURS is defined
+#ifndef MEASUREMENT_ROLLUP_HOURS
+#define MEASUREMENT_ROLLUP_HOURS 48
+#warning "MEASUREMENT_ROLLUP_HOURS not defined in config file, defaulting to 48 buckets"
+#endif
+
+// Check if MEASUREMENT_ROLLUP_DAYS is defined
+#ifndef MEASUREMENT_ROLLUP_DAYS
+#define MEASUREMENT_ROLLUP_DAYS 31
+#warning "MEASUREMENT_ROLLUP_DAYS not defined in config file, defaulting to 31 buckets"
+#endif
+
+/**
+ * @enum HistoryResolution
+ * @brief Resolution of stored history data, from finest to coarsest
+ */
+enum class HistoryResolution : uint8_t {
+  RAW,    ///< Individual samples
+  MINUTE, ///< 1-minute aggregates
+  HOUR,   ///< 1-hour aggregates
+  DAY     ///< 1-day aggregates (UTC)
+};
+
+/**
+ * @brief Aggregated values of one rollup bucket
+ */
+struct HistoryAggregate {
+  uint32_t start; ///< Epoch seconds of the bucket start
+  float min;      ///< Minimum value in the bucket
+  float max;      ///< Maximum value in the bucket
+  float mean;     ///< Mean value in the bucket
+  uint16_t count; ///< Number of samples in the bucket
+};
+
+/**
+ * @class MeasurementHistory
+ * @brief Singleton holding one ring buffer per enabled measurement
+ * @details Channels are bound to (sensor ID, measurement index) on the first
+ *          recorded sample. Timestamps are epoch seconds; samples are only
+ *          recorded once NTP time is available.
+ */
+class MeasurementHistory {
+public:
+  /// Maximum number of ring buffers (one per possible measurement)
+  static constexpr size_t CHANNEL_COUNT = SensorCounter::getTotalMeasurementCount();
+  /// Samples kept per measurement
+  static constexpr size_t CAPACITY = MEASUREMENT_HISTORY_SIZE;
+  /// Fixed-point scale of stored values (0.01 resolution, range +-327.67)
+  static constexpr float VALUE_SCALE = 100.0f;
+  /// Stored value marking an invalid (NaN) sample
+  static constexpr int16_t INVALID_VALUE = INT16_MIN;
+  /// Maximum sensor ID length incl. terminator
+  static constexpr size_t SENSOR_ID_LEN = 12;
+  /// Number of rollup tiers (minute, hour, day)
+  static constexpr size_t TIER_COUNT = 3;
+
+  /**
+   * @brief Gets the singleton instance
+   * @return Reference to the singleton instance
+   */
+  static MeasurementHistory& getInstance() {
+    static MeasurementHistory instance;
+    return instance;
+  }
+
+  /**
+   * @brief Record a sample for a measurement
+   * @param sensorId Sensor ID (e.g. "ANALOG", "DHT")
+   * @param measurementIndex Measurement index (0-based)
+   * @param timestamp Epoch seconds of the sample
+   * @param value Measured value
+   * @details Binds a free channel on first use. The oldest sample is
+   *          overwritten when the ring is full. Gaps longer than 65535 s are
+   *          shortened to that value.
+   */
+  void record(const String& sensorId, size_t measurementIndex, uint32_t timestamp, float value);
+
+  /**
+   * @brief Find the channel for a measurement
+   * @param sensorId Sensor ID
+   * @param measurementIndex Measurement index
+   * @return Channel index or -1 if nothing was recorded yet
+   */
+  int findChannel(const String& sensorId, size_t measurementIndex) const;
+
+  /**
+   * @brief Check whether a channel is bound to a measurement
+   * @param channel Channel index
+   * @return true if the channel is in use
+   */
+  bool isChannelUsed(size_t channel) const {
+    return channel < CHANNEL_COUNT && m_channels[channel] != nullptr;
+  }
+
+  /**
+   * @brief Get the sensor ID a channel is bound to
+   * @param channel Channel index (must be in use)
+   * @return Sensor ID
+   */
+  const char* getSensorId(size_t channel) const { return m_channels[channel]->sensorId; }
+
+  /**
+   * @brief Get the measurement index a channel is bound to
+   * @param channel Channel index (must be in use)
+   * @return Measurement index
+   */
+  size_t getMeasurementIndex(size_t channel) const {
+    return m_channels[channel]->measurementIndex;
+  }
+
+  /**
+   * @brief Get the number of stored samples of a channel
+   * @param channel Channel index
+   * @return Number of samples
+   */
+  size_t getSampleCount(size_t channel) const {
+    return isChannelUsed(channel) ? m_channels[channel]->count : 0;
+  }
+
+  /**
+   * @brief Visit samples newer than a timestamp in ascending order
+   * @param channel Channel index
+   * @param since Only samples with timestamp > since are visited
+   * @param limit Maximum number of samples to visit
+   * @param fn Callback invoked as fn(uint32_t timestamp, float value)
+   * @return Number of visited samples
+   */
+  template <typename Fn>
+  size_t forEachSince(size_t channel, uint32_t since, size_t limit, Fn&& fn) const {
+    if (!isChannelUsed(channel) || limit == 0) {
+      return 0;
+    }
+    const Channel& ch = *m_channels[channel];
+
+    // Walk backwards from the newest sample to find the first one > since
+    size_t skip = ch.count;
+    uint32_t ts = ch.lastTimestamp;
+    uint32_t startTs = ts;
+    while (skip > 0 && ts > since) {
+      startTs = ts;
+      skip--;
+      uint16_t delta = ch.samples[physicalIndex(ch, skip)].delta;
+      if (skip == 0 || delta > ts) {
+        break;
+      }
+      ts -= delta;
+    }
+    if (startTs <= since) {
+      return 0;
+    }
+
+    // Stream forward from there, rebuilding timestamps from the deltas
+    size_t visited = 0;
+    ts = startTs;
+    for (size_t i = skip; i < ch.count && visited < limit; i++) {
+      const PackedSample& s = ch.samples[physicalIndex(ch, i)];
+      if (i != skip) {
+        ts += s.delta;
+      }
+      fn(ts, decodeValue(s.value));
+      visited++;
+    }
+    return visited;
+  }
+
+  /**
+   * @brief Visit rollup buckets overlapping (since, now] in ascending order
+   * @param channel Channel index
+   * @param resolution MINUTE, HOUR or DAY
+   * @param since Buckets ending at or before this epoch second are skipped
+   * @param limit Maximum number of buckets to visit
+   * @param fn Callback invoked as fn(const HistoryAggregate&)
+   * @return Number of visited buckets
+   */
+  template <typename Fn>
+  size_t forEachAggregate(size_t channel, HistoryResolution resolution, uint32_t since,
+                          size_t limit, Fn&& fn) const {
+    if (!isChannelUsed(channel) || resolution == HistoryResolution::RAW || limit == 0) {
+      return 0;
+    }
+    const Channel& ch = *m_channels[channel];
+    size_t tier = tierIndex(resolution);
+    const RollupBucket* buckets = tierBuckets(ch, tier);
+    size_t capacity = getTierCapacity(resolution);
+    uint32_t seconds = getBucketSeconds(resolution);
+    uint32_t newest = ch.newestBucket[tier];
+    if (newest == 0) {
+      return 0;
+    }
+
+    uint32_t first = newest >= capacity ? newest - capacity + 1 : 0;
+    if (since / seconds > first) {
+      first = since / seconds;
+    }
+
+    size_t visited = 0;
+    for (uint32_t b = first; b <= newest && visited < limit; b++) {
+      const RollupBucket& bucket = buckets[b % capacity];
+      if (bucket.count == 0 || bucket.tag != static_cast<uint16_t>(b)) {
+        continue; // Empty or stale bucket
+      }
+      HistoryAggregate agg;
+      agg.start = b * seconds;
+      agg.min = static_cast<float>(bucket.min) / VALUE_SCALE;
+      agg.max = static_cast<float>(bucket.max) / VALUE_SCALE;
+      agg.mean = static_cast<float>(bucket.sum) / bucket.count / VALUE_SCALE;
+      agg.count = bucket.count;
+      fn(agg);
+      visited++;
+    }
+    return visited;
+  }
+
+  /**
+   * @brief Pick the resolution for a query
+   * @param channel Channel index
+   * @param since Start of the requested range (epoch seconds)
+   * @param now Current time (epoch seconds)
+   * @param maxPoints Maximum number of points the caller wants
+   * @return Finest resolution that still reaches back to @p since within
+   *         @p maxPoints points; DAY if none does
+   */
+  HistoryResolution selectResolution(size_t channel, uint32_t since, uint32_t now,
+                                     size_t maxPoints) const;
+
+  /**
+   * @brief Get the bucket length of a resolution
+   * @param resolution Resolution
+   * @return Bucket length in seconds (0 for RAW)
+   */
+  static constexpr uint32_t getBucketSeconds(HistoryResolution resolution) {
+    return resolution == HistoryResolution::MINUTE ? 60UL
+           : resolution == HistoryResolution::HOUR ? 3600UL
+           : resolution == HistoryResolution::DAY  ? 86400UL
+                                                   : 0UL;
+  }
+
+  /**
+   * @brief Get the number of buckets kept for a resolution
+   * @param resolution Resolution
+   * @return Bucket count (sample capacity for RAW)
+   */
+  static constexpr size_t getTierCapacity(HistoryResolution resolution) {
+    return resolution == HistoryResolution::MINUTE ? MEASUREMENT_ROLLUP_MINUTES
+           : resolution == HistoryResolution::HOUR ? MEASUREMENT_ROLLUP_HOURS
+           : resolution == HistoryResolution::DAY  ? MEASUREMENT_ROLLUP_DAYS
+                                                   : CAPACITY;
+  }
+
+  /**
+   * @brief Convert a resolution to its API name
+   * @param resolution Resolution
+   * @return "raw", "minute", "hour" or "day"
+   */
+  static const __FlashStringHelper* resolutionToString(HistoryResolution resolution);
+
+  /**
+   * @brief Parse an API resolution name
+   * @param name "raw", "minute", "hour" or "day"
+   * @param resolution Output parameter
+   * @return true if the name is known
+   */
+  static bool resolutionFromString(const String& name, HistoryResolution& resolution);
+
+  /**
+   * @brief Get the memory of all allocated ring buffers
+   * @return Size in bytes
+   */
+  static size_t getMemoryUsage();
+
+private:
+  /**
+   * @brief Packed sample: delta to previous sample and scaled value
+   */
+  struct PackedSample {
+    uint16_t delta; ///< Seconds since previous sample (0 for the oldest)
+    int16_t value;  ///< Value * VALUE_SCALE, INVALID_VALUE for NaN
+  };
+
+  /**
+   * @brief Rollup bucket, slot = bucket number % capacity
+   * @details The low 16 bits of the bucket number are kept as tag so stale
+   *          slots are detected without clearing them when time advances.
+   */
+  struct RollupBucket {
+    uint16_t tag;   ///< Low 16 bits of the bucket number
+    uint16_t count; ///< Samples in this bucket
+    int16_t min;    ///< Scaled minimum
+    int16_t max;    ///< Scaled maximum
+    int32_t sum;    ///< Scaled sum
+  };
+
+  /**
+   * @brief Ring buffer and rollups of one measurement
+   */
+  struct Channel {
+    char sensorId[SENSOR_ID_LEN]; ///< Bound sensor ID
+    uint8_t measurementIndex;     ///< Bound measurement index
+    uint16_t head;                ///< Physical index of the oldest sample
+    uint16_t count;               ///< Number of stored samples
+    uint32_t lastTimestamp;       ///< Epoch seconds of the newest sample
+    PackedSample samples[CAPACITY];
+    uint32_t newestBucket[TIER_COUNT]; ///< Newest bucket number per tier (0 = empty)
+    RollupBucket minuteBuckets[MEASUREMENT_ROLLUP_MINUTES];
+    RollupBucket hourBuckets[MEASUREMENT_ROLLUP_HOURS];
+    RollupBucket dayBuckets[MEASUREMENT_ROLLUP_DAYS];
+  };
+
+  MeasurementHistory() = default;
+  MeasurementHistory(const MeasurementHistory&) = delete;
+  MeasurementHistory& operator=(const MeasurementHistory&) = delete;
+
+  static size_t physicalIndex(const Channel& ch, size_t logicalIndex) {
+    return (ch.head + logicalIndex) % CAPACITY;
+  }
+
+  static size_t tierIndex(HistoryResolution resolution) {
+    return static_cast<size_t>(resolution) - static_cast<size_t>(HistoryResolution::MINUTE);
+  }
+
+  static RollupBucket* tierBuckets(Channel& ch, size_t tier) {
+    return tier == 0 ? ch.minuteBuckets : tier == 1 ? ch.hourBuckets : ch.dayBuckets;
+  }
+
+  static const RollupBucket* tierBuckets(const Channel& ch, size_t tier) {
+    return tier == 0 ? ch.minuteBuckets : tier == 1 ? ch.hourBuckets : ch.dayBuckets;
+  }
+
+  static void updateRollups(Channel& ch, uint32_t timestamp, int16_t value);
+
+  uint32_t getOldestTimestamp(const Channel& ch) const;
+
+  static int16_t encodeValue(float value);
+  static float decodeValue(int16_t stored) {
+    return stored == INVALID_VALUE ? NAN : static_cast<float>(stored) / VALUE_SCALE;
+  }
+
+  Channel* m_channels[CHANNEL_COUNT]{}; ///< nullptr until a measurement is bound
+  size_t m_allocatedChannels{0};
+};
+
+#endif // SENSOR_HISTORY_H
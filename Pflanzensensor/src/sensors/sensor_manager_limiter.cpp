@@ -0,0 +1,203 @@
+/**
+ * @file sensor_manager_limiter.cpp
+ * @brief Implementation of the resource-aware measurement slot limiter
+ */
+
+#include "sensors/sensor_manager_limiter.h"
+
+HardwareResource SensorManagerLimiter::resourceFor(const SharedHardwareInfo& hardware) {
+  if (hardware.exclusive) {
+    return HardwareResource::ALL;
+  }
+  switch (hardware.type) {
+  case SensorType::ANALOG:
+    return HardwareResource::ADC;
+  case SensorType::DHT:
+  case SensorType::DS18B20:
+  case SensorType::HX711:
+    return HardwareResource::PIN;
+  case SensorType::BMP280:
+    return HardwareResource::I2C;
+  case SensorType::SDS011:
+  case SensorType::MHZ19:
+  case SensorType::SERIAL_RECEIVER:
+    return HardwareResource::UART;
+  case SensorType::UNKNOWN:
+  default:
+    return HardwareResource::ALL;
+  }
+}
+
+bool SensorManagerLimiter::conflicts(HardwareResource a, uint8_t pinA, HardwareResource b,
+                                     uint8_t pinB) {
+  if (a == HardwareResource::ALL || b == HardwareResource::ALL) {
+    return true;
+  }
+  if (a == b) {
+    // Buses are shared as a whole, data pins only if they are the same pin
+    return a != HardwareResource::PIN || pinA == pinB;
+  }
+#if USE_MULTIPLEXER
+  // The multiplexer select pins belong to the ADC while it measures
+  if (a == HardwareResource::PIN || b == HardwareResource::PIN) {
+    HardwareResource other = a == HardwareResource::PIN ? b : a;
+    uint8_t pin = a == HardwareResource::PIN ? pinA : pinB;
+    if (other == HardwareResource::ADC &&
+        (pin == MULTIPLEXER_PIN_A || pin == MULTIPLEXER_PIN_B || pin == MULTIPLEXER_PIN_C)) {
+      return true;
+    }
+  }
+#endif
+  return false;
+}
+
+int SensorManagerLimiter::findHolder(SensorHandle sensor) const {
+  for (size_t i = 0; i < MAX_HOLDERS; i++) {
+    if (m_holders[i].used && m_holders[i].sensor == sensor) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+void SensorManagerLimiter::releaseExpired(unsigned long now) {
+  for (auto& holder : m_holders) {
+    if (holder.used && now - holder.acquiredTime >= SLOT_TIMEOUT_MS) {
+      logger.warning(F("SensorLimiter"), F("Erzwinge Freigabe des Slots von ") +
+                                             String(SensorRegistry::getId(holder.sensor)) +
+                                             F(" wegen Zeitüberschreitung"));
+      holder.used = false;
+      holder.sensor = INVALID_SENSOR_HANDLE;
+    }
+  }
+}
+
+bool SensorManagerLimiter::acquireSlot(SensorHandle sensor, const SharedHardwareInfo& hardware) {
+  unsigned long now = millis();
+  releaseExpired(now);
+
+  if (findHolder(sensor) >= 0) {
+    return true;
+  }
+
+  HardwareResource resource = resourceFor(hardware);
+  int freeIndex = -1;
+  uint8_t active = 0;
+  for (size_t i = 0; i < MAX_HOLDERS; i++) {
+    const Holder& holder = m_holders[i];
+    if (!holder.used) {
+      if (freeIndex < 0) {
+        freeIndex = static_cast<int>(i);
+      }
+      continue;
+    }
+    active++;
+    if (conflicts(resource, hardware.pin, holder.resource, holder.pin)) {
+      if (ConfigMgr.isDebugMeasurementCycle() && m_lastBlockingSensor != holder.sensor) {
+        LOG_DEBUG(F("SensorLimiter"), F("Slot-Anforderung von ") +
+                                          String(SensorRegistry::getId(sensor)) +
+                                          F(" fehlgeschlagen - Ressource belegt von: ") +
+                                          SensorRegistry::getId(holder.sensor));
+        m_lastBlockingSensor = holder.sensor;
+      }
+      return false;
+    }
+  }
+
+  if (freeIndex < 0) {
+    if (ConfigMgr.isDebugMeasurementCycle()) {
+      LOG_DEBUG(F("SensorLimiter"), F("Slot-Anforderung von ") +
+                                        String(SensorRegistry::getId(sensor)) +
+                                        F(" fehlgeschlagen - alle Slots belegt"));
+    }
+    return false;
+  }
+
+  Holder& holder = m_holders[freeIndex];
+  holder.used = true;
+  holder.resource = resource;
+  holder.pin = hardware.pin;
+  holder.sensor = sensor;
+  holder.acquiredTime = now;
+
+  active++;
+  if (active > m_maxParallel) {
+    m_maxParallel = active;
+  }
+  m_lastBlockingSensor = INVALID_SENSOR_HANDLE;
+
+  if (ConfigMgr.isDebugMeasurementCycle()) {
+    LOG_DEBUG(F("SensorLimiter"), F("Slot wurde von ") + String(SensorRegistry::getId(sensor)) +
+                                      F(" belegt (") + String(active) + F(" aktiv)"));
+  }
+  return true;
+}
+
+void SensorManagerLimiter::releaseSlot(SensorHandle sensor) {
+  int index = findHolder(sensor);
+  if (index >= 0) {
+    if (ConfigMgr.isDebugMeasurementCycle()) {
+      LOG_DEBUG(F("SensorLimiter"), F("Slot wurde von ") +
+                                        String(SensorRegistry::getId(sensor)) +
+                                        F(" freigegeben"));
+    }
+    m_holders[index].used = false;
+    m_holders[index].sensor = INVALID_SENSOR_HANDLE;
+    m_holders[index].acquiredTime = 0;
+    return;
+  }
+
+  for (const auto& holder : m_holders) {
+    if (holder.used) {
+      logger.warning(F("SensorLimiter"), F("Versuch von ") +
+                                             String(SensorRegistry::getId(sensor)) +
+                                             F(" einen Slot freizugeben, ohne einen zu halten"));
+      return;
+    }
+  }
+}
+
+void SensorManagerLimiter::recordCompletedCycle(size_t validValues) {
+  uint32_t epoch = millis() / BUCKET_MS;
+  Bucket& bucket = m_buckets[epoch % BUCKET_COUNT];
+  if (bucket.epoch != epoch) {
+    bucket.epoch = epoch;
+    bucket.cycles = 0;
+    bucket.values = 0;
+  }
+  if (bucket.cycles < UINT16_MAX) {
+    bucket.cycles++;
+  }
+  if (bucket.values <= UINT16_MAX - validValues) {
+    bucket.values += validValues;
+  }
+  m_totalCycles++;
+}
+
+unsigned long SensorManagerLimiter::getSlotHoldTime(SensorHandle sensor) const {
+  int index = findHolder(sensor);
+  if (index < 0) {
+    return 0;
+  }
+  return millis() - m_holders[index].acquiredTime;
+}
+
+SensorManagerLimiter::Throughput SensorManagerLimiter::getThroughput() const {
+  Throughput result;
+  uint32_t epoch = millis() / BUCKET_MS;
+  for (const auto& bucket : m_buckets) {
+    // The current, partially filled bucket and the five before it
+    if (epoch - bucket.epoch < BUCKET_COUNT) {
+      result.cyclesPerMinute += bucket.cycles;
+      result.valuesPerMinute += bucket.values;
+    }
+  }
+  for (const auto& holder : m_holders) {
+    if (holder.used) {
+      result.activeSlots++;
+    }
+  }
+  result.totalCycles = m_totalCycles;
+  result.maxParallel = m_maxParallel;
+  return result;
+}
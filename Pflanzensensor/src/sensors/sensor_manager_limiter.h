@@ -3,8 +3,9 @@
  * @file sensor_manager_limiter.h
  * @brief Manages access control for sensor measurements
  * @details Implements a singleton pattern to control concurrent access to
- * sensor measurement slots, preventing multiple sensors from measuring
- * simultaneously when they might interfere with each other.
+ * sensor measurement slots. Slots are granted per hardware resource (ADC,
+ * sensor pin, I2C bus, UART), so only sensors that would interfere with each
+ * other are serialized while independent sensors measure concurrently.
  */
 #ifndef SENSOR_MANAGER_LIMITER_H
 #define SENSOR_MANAGER_LIMITER_H
@@ -13,13 +14,28 @@
 
 #include "logger/logger.h"
 #include "managers/manager_config.h"
+#include "sensors/sensor_handle.h"
+#include "sensors/sensor_types.h"
+
+/**
+ * @enum HardwareResource
+ * @brief Hardware resource a sensor occupies while measuring
+ */
+enum class HardwareResource : uint8_t {
+  ADC,  ///< The single ADC (A0), including the multiplexer select pins
+  PIN,  ///< A dedicated data pin (DHT single-wire, DS18B20 one-wire bus)
+  I2C,  ///< The I2C bus
+  UART, ///< The serial port
+  ALL   ///< Unknown or exclusive hardware, conflicts with everything
+};
 
 /**
  * @class SensorManagerLimiter
- * @brief Manages measurement slots for sensors to prevent concurrent access
- * @details Implements a singleton pattern to ensure only one sensor can perform
- *          measurements at a time when they might interfere with each other.
- *          Includes timeout mechanisms to prevent deadlocks.
+ * @brief Manages measurement slots for sensors to prevent conflicting access
+ * @details Every holder occupies one hardware resource. A slot is granted if
+ *          no other holder occupies a conflicting resource. Includes timeout
+ *          mechanisms to prevent deadlocks and counts completed cycles for
+ *          the aggregate throughput.
  */
 class SensorManagerLimiter {
 public:
@@ -32,6 +48,20 @@ public:
   /// Total: ~25-31s, so 45s provides safe margin
   static constexpr unsigned long SLOT_TIMEOUT_MS = 45000; // 45 second timeout
 
+  /// Maximum number of sensors holding a slot at the same time
+  static constexpr size_t MAX_HOLDERS = 4;
+
+  /**
+   * @brief Aggregate measurement throughput
+   */
+  struct Throughput {
+    uint32_t cyclesPerMinute{0}; ///< Completed cycles in the last 60 s
+    uint32_t valuesPerMinute{0}; ///< Valid values of those cycles
+    uint32_t totalCycles{0};     ///< Completed cycles since boot
+    uint8_t activeSlots{0};      ///< Slots currently held
+    uint8_t maxParallel{0};      ///< Most slots held at the same time
+  };
+
   /**
    * @brief Gets the singleton instance of the limiter
    * @return Reference to the singleton instance
@@ -43,89 +73,84 @@ public:
 
   /**
    * @brief Attempts to acquire a measurement slot for a sensor
-   * @param sensorId Unique identifier of the requesting sensor
-   * @return true if slot was acquired, false if slot is currently held by
-   * another sensor
-   * @details Checks if slot is available or if current holder has timed out.
-   *          If current holder has timed out, forces release of the slot.
+   * @param sensor Handle of the requesting sensor
+   * @param hardware Hardware used by the sensor
+   * @return true if the slot was acquired or is already held by the sensor,
+   *         false if a conflicting resource is currently held
+   * @details Holders that exceeded SLOT_TIMEOUT_MS are released first.
    */
-  bool acquireSlot(const String& sensorId) {
-    unsigned long now = millis();
-
-    // Check if current holder has timed out
-    if (!m_currentSensor.isEmpty() && (now - m_slotAcquiredTime >= SLOT_TIMEOUT_MS)) {
-      logger.warning(F("SensorLimiter"), F("Erzwinge Freigabe des Slots von ") + m_currentSensor +
-                                             F(" wegen Zeitüberschreitung"));
-      m_currentSensor = "";
-    }
-
-    if (m_currentSensor.isEmpty()) {
-      m_currentSensor = sensorId;
-      m_slotAcquiredTime = now;
-      if (ConfigMgr.isDebugMeasurementCycle()) {
-        logger.debug(F("SensorLimiter"), F("Slot wurde von ") + sensorId + F(" belegt"));
-      }
-      return true;
-    }
-
-    if (ConfigMgr.isDebugMeasurementCycle() && m_lastBlockingSensor != m_currentSensor) {
-      logger.debug(F("SensorLimiter"), F("Slot-Anforderung von ") + sensorId +
-                                           F(" fehlgeschlagen - aktuell belegt von: ") +
-                                           m_currentSensor);
-      m_lastBlockingSensor = m_currentSensor;
-    }
-    return false;
-  }
+  bool acquireSlot(SensorHandle sensor, const SharedHardwareInfo& hardware);
 
   /**
-   * @brief Releases a measurement slot held by a sensor
-   * @param sensorId Unique identifier of the sensor releasing the slot
-   * @details Only allows release by the current slot holder.
-   *          Logs warning if a different sensor attempts to release the slot.
+   * @brief Releases the measurement slot held by a sensor
+   * @param sensor Handle of the sensor releasing the slot
+   * @details Logs a warning if the sensor does not hold a slot while others do.
    */
-  void releaseSlot(const String& sensorId) {
-    if (m_currentSensor == sensorId) {
-      if (ConfigMgr.isDebugMeasurementCycle()) {
-        logger.debug(F("SensorLimiter"), F("Slot wurde von ") + sensorId + F(" freigegeben"));
-      }
-      m_currentSensor = "";
-      m_slotAcquiredTime = 0;
-    } else if (!m_currentSensor.isEmpty()) {
-      logger.warning(F("SensorLimiter"), F("Versuch von ") + sensorId +
-                                             F(" den Slot freizugeben, aber aktuell belegt von: ") +
-                                             m_currentSensor);
-    }
-  }
+  void releaseSlot(SensorHandle sensor);
 
   /**
-   * @brief Checks if a sensor currently holds the measurement slot
-   * @param sensorId Unique identifier of the sensor to check
-   * @return true if the specified sensor holds the slot
+   * @brief Count a completed measurement cycle for the throughput
+   * @param validValues Number of valid values the cycle produced
    */
-  bool hasSlot(const String& sensorId) const { return m_currentSensor == sensorId; }
+  void recordCompletedCycle(size_t validValues);
 
   /**
-   * @brief Gets the ID of the sensor currently holding the slot
-   * @return Reference to the current sensor's ID string
+   * @brief Checks if a sensor currently holds a measurement slot
+   * @param sensor Handle of the sensor to check
+   * @return true if the specified sensor holds a slot
    */
-  const String& getCurrentSensor() const { return m_currentSensor; }
+  bool hasSlot(SensorHandle sensor) const { return findHolder(sensor) >= 0; }
 
   /**
-   * @brief Gets the duration the current slot has been held
-   * @return Time in milliseconds the slot has been held, 0 if slot is free
+   * @brief Gets the duration a sensor has held its slot
+   * @param sensor Handle of the sensor
+   * @return Time in milliseconds the slot has been held, 0 if none is held
    */
-  unsigned long getSlotHoldTime() const {
-    if (m_slotAcquiredTime == 0)
-      return 0;
-    return millis() - m_slotAcquiredTime;
-  }
+  unsigned long getSlotHoldTime(SensorHandle sensor) const;
+
+  /**
+   * @brief Gets the aggregate measurement throughput
+   * @return Throughput over the last minute and slot usage
+   */
+  Throughput getThroughput() const;
+
+  /**
+   * @brief Map the hardware info of a sensor to the resource it occupies
+   * @param hardware Hardware info from Sensor::getSharedHardwareInfo()
+   * @return Occupied resource
+   */
+  static HardwareResource resourceFor(const SharedHardwareInfo& hardware);
 
 private:
+  /// Width of one throughput bucket
+  static constexpr unsigned long BUCKET_MS = 10000;
+  /// Buckets covering one minute
+  static constexpr size_t BUCKET_COUNT = 6;
+
+  /**
+   * @brief One granted slot
+   */
+  struct Holder {
+    bool used{false};
+    HardwareResource resource{HardwareResource::ALL};
+    uint8_t pin{0};
+    SensorHandle sensor{INVALID_SENSOR_HANDLE};
+    unsigned long acquiredTime{0};
+  };
+
+  /**
+   * @brief Completed cycles within one BUCKET_MS window
+   */
+  struct Bucket {
+    uint32_t epoch{0};
+    uint16_t cycles{0};
+    uint16_t values{0};
+  };
+
   /**
    * @brief Private constructor for singleton pattern
-   * @details Initializes random seed for potential future use
    */
-  SensorManagerLimiter() { randomSeed(millis()); }
+  SensorManagerLimiter() = default;
 
   /**
    * @brief Default destructor
@@ -137,10 +162,15 @@ private:
   SensorManagerLimiter&
   operator=(const SensorManagerLimiter&) = delete; ///< Assignment operator disabled
 
-  String m_currentSensor;              ///< ID of sensor currently holding the slot
-  String m_lastBlockingSensor;         ///< ID of last sensor that was blocked from
-                                       ///< acquiring slot
-  unsigned long m_slotAcquiredTime{0}; ///< Timestamp when current slot was acquired
+  int findHolder(SensorHandle sensor) const;
+  void releaseExpired(unsigned long now);
+  static bool conflicts(HardwareResource a, uint8_t pinA, HardwareResource b, uint8_t pinB);
+
+  Holder m_holders[MAX_HOLDERS];                           ///< Granted slots
+  Bucket m_buckets[BUCKET_COUNT];                          ///< Throughput of the last minute
+  SensorHandle m_lastBlockingSensor{INVALID_SENSOR_HANDLE}; ///< Last holder that blocked
+  uint32_t m_totalCycles{0};                               ///< Completed cycles since boot
+  uint8_t m_maxParallel{0};                                ///< Most slots held at once
 };
 
 #endif // SENSOR_MANAGER_LIMITER_H
@@ -9,18 +9,18 @@ SensorMeasurementCycleManager::SensorMeasurementCycleManager(Sensor* sensor)
       m_lastState(MeasurementState::WAITING_FOR_DUE),
       m_lastSlotAttemptTime(0) {
   if (m_sensor) {
-    if (ConfigMgr.isDebugMeasurementCycle()) {
-      logger.debug(F("MeasurementCycle"),
-                   F("Initialisiere Zyklus-Manager für Sensor: ") + m_sensor->getName());
+    if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugMeasurementCycle())) {
+      LOG_DEBUG(F("MeasurementCycle"),
+                F("Initialisiere Zyklus-Manager für Sensor: ") + m_sensor->getName());
     }
 
     // Check warmup requirements
     m_state.needsWarmup = m_sensor->requiresWarmup(m_state.warmupTimeNeeded);
     if (m_state.needsWarmup) {
       m_state.warmupStartTime = millis(); // Starte Aufwärmphase sofort
-      if (ConfigMgr.isDebugMeasurementCycle()) {
-        logger.debug(F("MeasurementCycle"), m_sensor->getName() + F(": Starte Aufwärmphase von ") +
-                                                String(m_state.warmupTimeNeeded / 1000UL) + F("s"));
+      if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugMeasurementCycle())) {
+        LOG_DEBUG(F("MeasurementCycle"), m_sensor->getName() + F(": Starte Aufwärmphase von ") +
+                                             String(m_state.warmupTimeNeeded / 1000UL) + F("s"));
       }
     }
 
@@ -32,8 +32,8 @@ SensorMeasurementCycleManager::SensorMeasurementCycleManager(Sensor* sensor)
 
     // Schedule first measurement based on cycle start time
     m_state.scheduleNextMeasurement(m_cycleStartTime, 0); // Start immediately
-    if (ConfigMgr.isDebugMeasurementCycle()) {
-      logger.debug(F("MeasurementCycle"), F("Erste Messung für sofortige Ausführung geplant"));
+    if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugMeasurementCycle())) {
+      LOG_DEBUG(F("MeasurementCycle"), F("Erste Messung für sofortige Ausführung geplant"));
     }
   } else {
     logger.error(F("MeasurementCycle"), F("Created with null sensor!"));
@@ -48,11 +48,11 @@ bool SensorMeasurementCycleManager::updateMeasurementCycle() {
   // Update measurement interval in case it changed
   unsigned long currentInterval = m_sensor->getMeasurementInterval();
   if (currentInterval != m_state.measurementInterval) {
-    if (ConfigMgr.isDebugMeasurementCycle()) {
-      logger.debug(F("MeasurementCycle"), m_sensor->getName() +
-                                              F(": Messintervall aktualisiert von ") +
-                                              String(m_state.measurementInterval) + F("ms auf ") +
-                                              String(currentInterval) + F("ms"));
+    if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugMeasurementCycle())) {
+      LOG_DEBUG(F("MeasurementCycle"), m_sensor->getName() +
+                                           F(": Messintervall aktualisiert von ") +
+                                           String(m_state.measurementInterval) + F("ms auf ") +
+                                           String(currentInterval) + F("ms"));
     }
     m_state.measurementInterval = currentInterval;
   }
@@ -108,6 +108,37 @@ void SensorMeasurementCycleManager::reset() {
   m_lastSlotAttemptTime = 0; // Reset slot attempt time
 }
 
+unsigned long SensorMeasurementCycleManager::getNextWakeTime(unsigned long now) const {
+  if (!m_sensor) {
+    return now;
+  }
+
+  switch (m_state.state) {
+  case MeasurementState::WAITING_FOR_DUE:
+    if (m_state.needsWarmup) {
+      // Later of warmup end and due time
+      unsigned long warmupEnd = m_state.warmupStartTime + m_state.warmupTimeNeeded;
+      return static_cast<long>(warmupEnd - m_state.nextDueTime) > 0 ? warmupEnd
+                                                                     : m_state.nextDueTime;
+    }
+    return m_state.nextDueTime;
+  case MeasurementState::WAITING_FOR_SLOT:
+    return m_lastSlotAttemptTime + SLOT_RETRY_DELAY;
+  case MeasurementState::WAITING_FOR_DELAY:
+    return m_state.minimumDelayEndTime;
+  case MeasurementState::WARMUP:
+    if (m_state.warmupStartTime != 0) {
+      return m_state.warmupStartTime + m_state.warmupTimeNeeded;
+    }
+    return now;
+  case MeasurementState::MEASURING:
+    return m_sensor->getNextSampleTime();
+  default:
+    // INITIALIZING, PROCESSING, SENDING_INFLUX, DEINITIALIZING, ERROR
+    return now;
+  }
+}
+
 MeasurementState SensorMeasurementCycleManager::getCurrentState() const { return m_state.state; }
 
 const String& SensorMeasurementCycleManager::getLastError() const { return m_state.lastError; }
@@ -61,6 +61,40 @@ public:
    */
   bool isDue() const { return m_state.isDue(); }
 
+  /**
+   * @brief Scheduling and latency statistics of measurement cycles
+   * @details Lateness is the actual cycle start minus its due time. Latency
+   * is measured from the due time of a cycle until the sensor is back in
+   * WAITING_FOR_DUE (slot wait, init, warmup, sampling, processing and
+   * deinit included).
+   */
+  struct CycleStats {
+    uint32_t startedCycles{0};     ///< Cycles started since boot
+    unsigned long lastLateness{0}; ///< Start lateness of the last cycle (ms)
+    unsigned long maxLateness{0};  ///< Largest start lateness seen (ms)
+    float meanLateness{0.0f};      ///< Running mean start lateness (ms)
+    uint32_t completedCycles{0};   ///< Cycles completed since boot
+    unsigned long lastLatency{0};  ///< Latency of the last cycle (ms)
+    unsigned long maxLatency{0};   ///< Largest latency seen (ms)
+    float meanLatency{0.0f};       ///< Running mean latency (ms)
+  };
+
+  /**
+   * @brief Gets the time at which this cycle needs to be serviced next
+   * @param now Current millis() value
+   * @return millis() timestamp of the next wake-up (<= now: immediately)
+   * @details Derived from the current state: the next due time, the end of
+   * warmup, the minimum delay, the slot retry delay or the sensor's next
+   * sample time. Transient states request an immediate wake-up.
+   */
+  unsigned long getNextWakeTime(unsigned long now) const;
+
+  /**
+   * @brief Gets the cycle latency statistics
+   * @return Reference to the statistics
+   */
+  const CycleStats& getCycleStats() const { return m_cycleStats; }
+
   /**
    * @brief Forces the next measurement for this sensor ASAP
    */
@@ -94,6 +128,8 @@ private:
   unsigned long m_cycleStartTime{0};       ///< Start time of current measurement cycle
   unsigned long m_lastSlotAttemptTime{0};  ///< Last attempt to acquire measurement slot
   unsigned long m_slotRequestStartTime{0}; ///< When current slot request started
+  unsigned long m_cycleDueTime{0};         ///< Due time of the running cycle
+  CycleStats m_cycleStats;                 ///< Cycle latency statistics
 
   // State handlers (defined in separate files)
 
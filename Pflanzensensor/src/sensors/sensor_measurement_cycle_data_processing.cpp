@@ -1,5 +1,8 @@
 #include "managers/manager_sensor_persistence.h"
 #include "sensor_measurement_cycle.h"
+#include "sensors/sensor_history.h"
+#include "sensors/sensor_timeseries.h"
+#include "utils/helper.h"
 
 void SensorMeasurementCycleManager::handleProcessing() {
   // Process measurement results
@@ -11,11 +14,11 @@ void SensorMeasurementCycleManager::handleProcessing() {
   // **CRITICAL FIX: Use proper updateMeasurementData method instead of
   // const_cast**
   const MeasurementData& currentData = m_sensor->getMeasurementData();
-  logger.debug(F("MeasurementCycle"),
-               F("Verarbeite: Feldnamen=") + String(SensorConfig::MAX_MEASUREMENTS) +
-                   F(", Einheiten=") + String(SensorConfig::MAX_MEASUREMENTS) + F(", Werte=") +
-                   String(m_currentResults.size()) + F(", currentResults=") +
-                   String(m_currentResults.size()));
+  LOG_DEBUG(F("MeasurementCycle"),
+            F("Verarbeite: Feldnamen=") + String(SensorConfig::MAX_MEASUREMENTS) +
+             F(", Einheiten=") + String(SensorConfig::MAX_MEASUREMENTS) + F(", Werte=") +
+             String(m_currentResults.size()) + F(", currentResults=") +
+             String(m_currentResults.size()));
 
   // CRITICAL: Validate measurement data before processing
   if (!currentData.isValid()) {
@@ -53,6 +56,9 @@ void SensorMeasurementCycleManager::handleProcessing() {
       continue;
     }
     float value = m_currentResults[i];
+    const SampleAccumulator& stats = m_sensor->getSampleStatistics(i);
+    updatedData.variances[i] = stats.variance();
+    updatedData.sampleCounts[i] = stats.count();
     if (!isnan(value) && m_sensor->isValidValue(value, i)) {
       updatedData.values[i] = value;
       hasValidData = true;
@@ -72,40 +78,32 @@ void SensorMeasurementCycleManager::handleProcessing() {
 
         // Enqueue configuration changes to be written in batches (reduces flash wear)
         if (minMaxChanged) {
-          SensorPersistence::enqueueAbsoluteMinMax(m_sensor->getId(), i,
+          SensorPersistence::enqueueAbsoluteMinMax(m_sensor->getHandle(), i,
                                                    config.measurements[i].absoluteMin,
                                                    config.measurements[i].absoluteMax);
-          logger.debug(F("MeasurementCycle"), F("Absolute Min/Max aktualisiert für Sensor ") +
-                                                  m_sensor->getId() + F(" Messung ") + String(i));
+          LOG_DEBUG(F("MeasurementCycle"), F("Absolute Min/Max aktualisiert für Sensor ") +
+                                            m_sensor->getId() + F(" Messung ") + String(i));
         }
 
-        // Update lastValue in runtime config and persist if it changed
+        // Update lastValue in runtime config; the file is written by the
+        // write-behind cache (SensorPersistence::processPendingUpdates)
         {
           float prevLast = config.measurements[i].lastValue;
           if (isnan(prevLast) || (!isnan(value) && fabs(prevLast - value) > 1e-6f)) {
-            // Update in-memory
             config.measurements[i].lastValue = value;
+            SensorPersistence::enqueueLastValue(m_sensor->getHandle(), i, value,
+                                                config.measurements[i].lastRawValue);
+          }
+        }
 
-            // Prepare small JSON object to persist only the changed fields
-            DynamicJsonDocument tmpDoc(128);
-            JsonObject settings = tmpDoc.to<JsonObject>();
-            settings["lastValue"] = value;
-
-// For analog sensors also persist the last raw value. We don't
-// need to depend on AnalogSensor here; the measurement's
-// persisted runtime value is stored in the MeasurementConfig.
-#if USE_ANALOG
-            int lastRaw = config.measurements[i].lastRawValue;
-            settings["lastRawValue"] = lastRaw;
-#endif
-
-            // Persist changed fields (this will load/save the measurement JSON)
-            auto pres =
-                SensorPersistence::updateMeasurementSettings(m_sensor->getId(), i, settings);
-            if (!pres.isSuccess()) {
-              logger.warning(F("MeasurementCycle"),
-                             F("Konnte lastValue nicht persistieren: ") + pres.getMessage());
-            }
+        // Append to the RAM history and the flash archive; timestamps need NTP time
+        if (config.measurements[i].enabled) {
+          time_t now = Helper::getCurrentTime();
+          if (now > 24 * 3600) {
+            MeasurementHistory::getInstance().record(m_sensor->getId(), i,
+                                                     static_cast<uint32_t>(now), value);
+            TimeSeriesStore::getInstance().append(m_sensor->getId(), i,
+                                                  static_cast<uint32_t>(now), value);
           }
         }
       }
@@ -157,70 +155,76 @@ void SensorMeasurementCycleManager::handleSendingInflux() {
 }
 
 void SensorMeasurementCycleManager::handleDeinitializing() {
-  // CRITICAL: Flush pending updates for THIS sensor immediately after measurement cycle
-  // This ensures data is persisted right away instead of waiting for periodic flush
-  if (ConfigMgr.isDebugMeasurementCycle()) {
-    logger.debug(F("MeasurementCycle"),
-                 m_sensor->getName() + F(": Starte Flush der ausstehenden Updates"));
-  }
-  SensorPersistence::flushPendingUpdatesForSensor(m_sensor->getId());
-  if (ConfigMgr.isDebugMeasurementCycle()) {
-    logger.debug(F("MeasurementCycle"), m_sensor->getName() + F(": Flush abgeschlossen"));
-  }
+  // Runtime values (lastValue, min/max) stay in the write-behind cache and are
+  // flushed from the main loop by SensorPersistence::processPendingUpdates()
 
   // Check if this sensor needs deinitialization
   bool shouldDeinit = m_sensor->shouldDeinitializeAfterMeasurement();
 
   if (shouldDeinit) {
-    if (ConfigMgr.isDebugMeasurementCycle()) {
-      logger.debug(F("MeasurementCycle"), m_sensor->getName() + F(": Sensor deinitialisieren"));
+    if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugMeasurementCycle())) {
+      LOG_DEBUG(F("MeasurementCycle"), m_sensor->getName() + F(": Sensor deinitialisieren"));
     }
     m_sensor->deinitialize();
   }
 
   // CRITICAL: Release measurement slot AFTER all cleanup is done
   // This prevents other sensors from starting measurement while we're still
-  // flushing data or deinitializing
-  SensorManagerLimiter::getInstance().releaseSlot(m_sensor->getId());
-  if (ConfigMgr.isDebugMeasurementCycle()) {
-    logger.debug(F("MeasurementCycle"),
-                 m_sensor->getName() + F(": Messslot nach Cleanup freigegeben"));
+  // deinitializing
+  SensorManagerLimiter::getInstance().releaseSlot(m_sensor->getHandle());
+  if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugMeasurementCycle())) {
+    LOG_DEBUG(F("MeasurementCycle"),
+              m_sensor->getName() + F(": Messslot nach Cleanup freigegeben"));
   }
 
   // Calculate next measurement time safely
   unsigned long now = millis();
   unsigned long interval = m_state.measurementInterval;
 
-  // Prevent overflow by checking if we're close to rollover
-  if (now + interval < now) {
-    // Handle rollover case by scheduling for immediate measurement
-    m_state.scheduleNextMeasurement(now, 0);
-  } else {
-    m_state.scheduleNextMeasurement(now, interval);
+  // End-to-end latency from the due time to the end of this cycle
+  unsigned long latency = now - m_cycleDueTime;
+  m_cycleStats.completedCycles++;
+  m_cycleStats.lastLatency = latency;
+  if (latency > m_cycleStats.maxLatency) {
+    m_cycleStats.maxLatency = latency;
   }
+  m_cycleStats.meanLatency +=
+      (static_cast<float>(latency) - m_cycleStats.meanLatency) / m_cycleStats.completedCycles;
+
+  size_t validValues = 0;
+  for (float value : m_currentResults) {
+    if (!isnan(value)) {
+      validValues++;
+    }
+  }
+  SensorManagerLimiter::getInstance().recordCompletedCycle(validValues);
+
+  // Due times are compared with signed differences, so a due time past the
+  // millis() rollover needs no special handling
+  m_state.scheduleNextMeasurement(now, interval);
 
-  if (ConfigMgr.isDebugMeasurementCycle()) {
+  if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugMeasurementCycle())) {
     unsigned long elapsed = now - m_cycleStartTime;
-    unsigned long nextIn = m_state.nextDueTime > now ? m_state.nextDueTime - now : 0;
+    unsigned long nextIn = interval;
 
-    logger.debug(F("MeasurementCycle"), m_sensor->getName() + F(": Messzyklus abgeschlossen in ") +
-                                            String(elapsed) + F(" ms, nächste Messung in ") +
-                                            String(nextIn) + F(" ms"));
+    LOG_DEBUG(F("MeasurementCycle"), m_sensor->getName() + F(": Messzyklus abgeschlossen in ") +
+                                         String(elapsed) + F(" ms, nächste Messung in ") +
+                                         String(nextIn) + F(" ms"));
   }
 
   // **CRITICAL FIX: Add debug logging for measurement data if not already
   // logged**
-  if (ConfigMgr.isDebugMeasurementCycle()) {
+  if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugMeasurementCycle())) {
     const auto& data = m_sensor->getMeasurementData();
 
     // CRITICAL: Validate data before logging
     if (!data.isValid()) {
-      logger.debug(F("MeasurementCycle"), F("Messdaten ungültig, Debug-Logging überspringen"));
+      LOG_DEBUG(F("MeasurementCycle"), F("Messdaten ungültig, Debug-Logging überspringen"));
     } else {
-      logger.debug(F("MeasurementCycle"), F("Messdaten für ") + m_sensor->getName() +
-                                              F(": Felder=") +
-                                              String(SensorConfig::MAX_MEASUREMENTS) +
-                                              F(", Ergebnisse=") + String(m_currentResults.size()));
+      LOG_DEBUG(F("MeasurementCycle"), F("Messdaten für ") + m_sensor->getName() +
+                                           F(": Felder=") +
+                                           String(SensorConfig::MAX_MEASUREMENTS) +
+                                           F(", Ergebnisse=") + String(m_currentResults.size()));
 
       // Log each field name and unit with bounds checking
       size_t maxDebugFields = std::min(m_currentResults.size(), SensorConfig::MAX_MEASUREMENTS);
@@ -234,10 +238,10 @@ void SensorMeasurementCycleManager::handleDeinitializing() {
         } else {
           valueStr = String(m_currentResults[i], 2);
         }
-        logger.debug(F("MeasurementCycle"), F("Feld ") + String(i) + F(": Name='") +
-                                                String(data.fieldNames[i]) + F("' Wert='") +
-                                                valueStr + F("' Einheit='") +
-                                                String(data.units[i]) + F("'"));
+        LOG_DEBUG(F("MeasurementCycle"), F("Feld ") + String(i) + F(": Name='") +
+                                             String(data.fieldNames[i]) + F("' Wert='") +
+                                             valueStr + F("' Einheit='") +
+                                             String(data.units[i]) + F("'"));
       }
     }
   }
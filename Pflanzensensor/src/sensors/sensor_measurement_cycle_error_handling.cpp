@@ -1,12 +1,13 @@
 #include "sensor_measurement_cycle.h"
+#include "utils/file_io_queue.h"
 
 void SensorMeasurementCycleManager::handleError() {
   if (m_lastState != MeasurementState::WAITING_FOR_DUE &&
       m_lastState != MeasurementState::WAITING_FOR_SLOT) {
-    if (ConfigMgr.isDebugMeasurementCycle()) {
-      logger.debug(F("MeasurementCycle"), m_sensor->getName() + F(": Releasing slot due to error"));
+    if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugMeasurementCycle())) {
+      LOG_DEBUG(F("MeasurementCycle"), m_sensor->getName() + F(": Releasing slot due to error"));
     }
-    SensorManagerLimiter::getInstance().releaseSlot(m_sensor->getId());
+    SensorManagerLimiter::getInstance().releaseSlot(m_sensor->getHandle());
   }
 
   // Only increment error count for sensor-related errors
@@ -32,6 +33,7 @@ void SensorMeasurementCycleManager::handleError() {
         if (m_sensor->getSharedHardwareInfo().type == SensorType::DS18B20) {
           logger.error(F("MeasurementCycle"),
                        m_sensor->getName() + F(": DS18B20 failure detected, triggering reboot"));
+          FileIoQueue::getInstance().flushAll();
           // Allow time for logging to complete
           delay(1000);
           ESP.restart();
@@ -42,6 +44,7 @@ void SensorMeasurementCycleManager::handleError() {
         if (!m_sensor->config().hasPersistentError) {
           logger.error(F("MeasurementCycle"),
                        m_sensor->getName() + F(": First-time failure, triggering reboot"));
+          FileIoQueue::getInstance().flushAll();
           ESP.restart();
           return;
         }
@@ -87,10 +90,10 @@ void SensorMeasurementCycleManager::handleStateError(const String& error) {
   // Release slot if we were holding it
   if (m_lastState != MeasurementState::WAITING_FOR_DUE &&
       m_lastState != MeasurementState::WAITING_FOR_SLOT) {
-    if (ConfigMgr.isDebugMeasurementCycle()) {
-      logger.debug(F("MeasurementCycle"), m_sensor->getName() + F(": Releasing slot due to error"));
+    if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugMeasurementCycle())) {
+      LOG_DEBUG(F("MeasurementCycle"), m_sensor->getName() + F(": Releasing slot due to error"));
     }
-    SensorManagerLimiter::getInstance().releaseSlot(m_sensor->getId());
+    SensorManagerLimiter::getInstance().releaseSlot(m_sensor->getHandle());
   }
 
   m_state.setState(MeasurementState::ERROR, m_sensor->getName());
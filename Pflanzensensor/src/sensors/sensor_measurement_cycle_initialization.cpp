@@ -1,11 +1,12 @@
 #include "sensor_measurement_cycle.h"
 #if USE_DS18B20
 #include "sensors/sensor_ds18b20.h"
+#include "utils/file_io_queue.h"
 #endif
 
 void SensorMeasurementCycleManager::handleInitializing() {
-  if (ConfigMgr.isDebugMeasurementCycle()) {
-    logger.debug(F("MeasurementCycle"), m_sensor->getName() + F(": Beginne Initialisierung"));
+  if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugMeasurementCycle())) {
+    LOG_DEBUG(F("MeasurementCycle"), m_sensor->getName() + F(": Beginne Initialisierung"));
   }
 
   // Validate memory state before initialization
@@ -40,9 +41,9 @@ void SensorMeasurementCycleManager::handleInitializing() {
 
   // Check if sensor needs initialization
   if (!m_sensor->isInitialized()) {
-    if (ConfigMgr.isDebugMeasurementCycle()) {
-      logger.debug(F("MeasurementCycle"),
-                   m_sensor->getName() + F(": Sensor nicht initialisiert, rufe init() auf"));
+    if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugMeasurementCycle())) {
+      LOG_DEBUG(F("MeasurementCycle"),
+                m_sensor->getName() + F(": Sensor nicht initialisiert, rufe init() auf"));
     }
 
     auto initResult = m_sensor->init();
@@ -54,14 +55,14 @@ void SensorMeasurementCycleManager::handleInitializing() {
       return;
     }
 
-    if (ConfigMgr.isDebugMeasurementCycle()) {
-      logger.debug(F("MeasurementCycle"),
-                   m_sensor->getName() + F(": Sensorinitialisierung erfolgreich"));
+    if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugMeasurementCycle())) {
+      LOG_DEBUG(F("MeasurementCycle"),
+                m_sensor->getName() + F(": Sensorinitialisierung erfolgreich"));
     }
   } else {
-    if (ConfigMgr.isDebugMeasurementCycle()) {
-      logger.debug(F("MeasurementCycle"),
-                   m_sensor->getName() + F(": Sensor bereits initialisiert"));
+    if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugMeasurementCycle())) {
+      LOG_DEBUG(F("MeasurementCycle"),
+                m_sensor->getName() + F(": Sensor bereits initialisiert"));
     }
   }
 
@@ -74,6 +75,7 @@ void SensorMeasurementCycleManager::handleInitializing() {
                      m_sensor->getName() +
                          F(": Neustart vom Sensor angefordert, führe sauberen Neustart aus"));
       // Allow time for logging and cleanup
+      FileIoQueue::getInstance().flushAll();
       delay(1000);
       ESP.restart();
       return;
@@ -91,8 +93,8 @@ void SensorMeasurementCycleManager::handleInitializing() {
       m_state.errorCount++;
 
       // Stay in INITIALIZING state to allow retries
-      if (ConfigMgr.isDebugMeasurementCycle()) {
-        logger.debug(
+      if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugMeasurementCycle())) {
+        LOG_DEBUG(
             F("MeasurementCycle"),
             m_sensor->getName() + F(": Initialisierung fehlgeschlagen, versuche erneut (Versuch ") +
                 String(m_state.errorCount) + F("/") + String(MEASUREMENT_ERROR_COUNT) + F(")"));
@@ -118,8 +120,8 @@ void SensorMeasurementCycleManager::handleInitializing() {
     return;
   }
 
-  if (ConfigMgr.isDebugMeasurementCycle()) {
-    logger.debug(F("MeasurementCycle"), m_sensor->getName() + F(": Initialisierung erfolgreich"));
+  if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugMeasurementCycle())) {
+    LOG_DEBUG(F("MeasurementCycle"), m_sensor->getName() + F(": Initialisierung erfolgreich"));
   }
 
   m_state.needsInitialization = false;
@@ -8,39 +8,52 @@ bool SensorMeasurementCycleManager::handleWaitingForDue() {
     unsigned long warmupElapsed = now - m_state.warmupStartTime;
     if (warmupElapsed < m_state.warmupTimeNeeded) {
       // Still in warmup period
-      if (ConfigMgr.isDebugMeasurementCycle() && (now - m_lastDebugTime >= DEBUG_INTERVAL)) {
+      if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugMeasurementCycle()) &&
+          (now - m_lastDebugTime >= DEBUG_INTERVAL)) {
         unsigned long remaining = (m_state.warmupTimeNeeded - warmupElapsed) / 1000UL;
-        logger.debug(F("MeasurementCycle"), m_sensor->getName() + F(": Aufwärmphase läuft, ") +
-                                                String(remaining) + F(" s verbleibend"));
+        LOG_DEBUG(F("MeasurementCycle"), m_sensor->getName() + F(": Aufwärmphase läuft, ") +
+                                             String(remaining) + F(" s verbleibend"));
         m_lastDebugTime = now;
       }
       return false;
     }
     // Warmup complete
     m_state.needsWarmup = false;
-    if (ConfigMgr.isDebugMeasurementCycle()) {
-      logger.debug(F("MeasurementCycle"), m_sensor->getName() + F(": Aufwärmen abgeschlossen"));
+    if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugMeasurementCycle())) {
+      LOG_DEBUG(F("MeasurementCycle"), m_sensor->getName() + F(": Aufwärmen abgeschlossen"));
     }
   }
 
   if (!m_state.isDue()) {
     // Not time yet, check if we should log debug info
-    if (ConfigMgr.isDebugMeasurementCycle() && (now - m_lastDebugTime >= DEBUG_INTERVAL)) {
-      logger.debug(F("MeasurementCycle"),
-                   m_sensor->getName() + F(": Nächste Messung in ") +
-                       String((m_state.nextDueTime > now) ? (m_state.nextDueTime - now) : 0) +
-                       F(" ms fällig"));
+    if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugMeasurementCycle()) &&
+        (now - m_lastDebugTime >= DEBUG_INTERVAL)) {
+      LOG_DEBUG(F("MeasurementCycle"),
+                m_sensor->getName() + F(": Nächste Messung in ") +
+                    String(m_state.nextDueTime - now) +
+                    F(" ms fällig"));
       m_lastDebugTime = now;
     }
     return false;
   }
 
-  // Record the start time of this measurement cycle
+  // Record the start and due time of this measurement cycle
   m_cycleStartTime = now;
+  m_cycleDueTime = m_state.nextDueTime;
+
+  // Scheduling lateness: actual start minus due time
+  unsigned long lateness = now - m_cycleDueTime;
+  m_cycleStats.startedCycles++;
+  m_cycleStats.lastLateness = lateness;
+  if (lateness > m_cycleStats.maxLateness) {
+    m_cycleStats.maxLateness = lateness;
+  }
+  m_cycleStats.meanLateness +=
+      (static_cast<float>(lateness) - m_cycleStats.meanLateness) / m_cycleStats.startedCycles;
 
-  if (ConfigMgr.isDebugMeasurementCycle()) {
-    logger.debug(F("MeasurementCycle"),
-                 m_sensor->getName() + F(": Messintervall abgelaufen, fordere Slot an"));
+  if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugMeasurementCycle())) {
+    LOG_DEBUG(F("MeasurementCycle"),
+              m_sensor->getName() + F(": Messintervall abgelaufen, fordere Slot an"));
   }
 
   m_state.setState(MeasurementState::WAITING_FOR_SLOT, m_sensor->getName());
@@ -79,23 +92,24 @@ void SensorMeasurementCycleManager::handleWaitingForSlot() {
   }
 
   m_lastSlotAttemptTime = now;
-  bool slotAcquired = SensorManagerLimiter::getInstance().acquireSlot(m_sensor->getId());
+  bool slotAcquired = SensorManagerLimiter::getInstance().acquireSlot(
+      m_sensor->getHandle(), m_sensor->getSharedHardwareInfo());
 
   // Log only on first attempt or when result changes
   if (firstAttempt || slotAcquired != lastSlotResult) {
-    if (ConfigMgr.isDebugMeasurementCycle()) {
-      logger.debug(F("MeasurementCycle"),
-                   m_sensor->getName() + F(": Slot-Anforderung ") +
-                       (slotAcquired ? F("erfolgreich") : F("fehlgeschlagen")) + F(" nach ") +
-                       String(now - m_slotRequestStartTime) + F(" ms"));
+    if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugMeasurementCycle())) {
+      LOG_DEBUG(F("MeasurementCycle"),
+                m_sensor->getName() + F(": Slot-Anforderung ") +
+                    (slotAcquired ? F("erfolgreich") : F("fehlgeschlagen")) + F(" nach ") +
+                    String(now - m_slotRequestStartTime) + F(" ms"));
     }
     firstAttempt = false;
     lastSlotResult = slotAcquired;
   }
 
   if (slotAcquired) {
-    if (ConfigMgr.isDebugMeasurementCycle()) {
-      logger.debug(F("MeasurementCycle"), m_sensor->getName() + F(": Starte Initialisierung"));
+    if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugMeasurementCycle())) {
+      LOG_DEBUG(F("MeasurementCycle"), m_sensor->getName() + F(": Starte Initialisierung"));
     }
     m_state.setState(MeasurementState::INITIALIZING, m_sensor->getName());
     firstAttempt = true;        // Reset for next cycle
@@ -118,14 +132,14 @@ void SensorMeasurementCycleManager::handleWaitingForDelay() {
 void SensorMeasurementCycleManager::handleWarmup() {
   if (m_state.warmupStartTime == 0) {
     m_state.warmupStartTime = millis();
-    if (ConfigMgr.isDebugMeasurementCycle()) {
-      logger.debug(F("MeasurementCycle"), m_sensor->getName() + F(": Starte Aufwärmphase"));
+    if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugMeasurementCycle())) {
+      LOG_DEBUG(F("MeasurementCycle"), m_sensor->getName() + F(": Starte Aufwärmphase"));
     }
   }
 
   if (millis() - m_state.warmupStartTime >= m_state.warmupTimeNeeded) {
-    if (ConfigMgr.isDebugMeasurementCycle()) {
-      logger.debug(F("MeasurementCycle"), m_sensor->getName() + F(": Aufwärmen abgeschlossen"));
+    if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugMeasurementCycle())) {
+      LOG_DEBUG(F("MeasurementCycle"), m_sensor->getName() + F(": Aufwärmen abgeschlossen"));
     }
     m_state.warmupStartTime = 0;
     m_state.setMinimumDelay(WARMUP_DELAY);
@@ -144,11 +158,11 @@ void SensorMeasurementCycleManager::handleMeasuring() {
     handleStateError(F("Messung in performMeasurementCycle fehlgeschlagen"));
     return;
   }
-  m_currentResults = m_sensor->getAveragedResults(); // Use DRY base method
+  m_sensor->getAveragedResults(m_currentResults); // Reuses the vector capacity
   // Record the completion time immediately so the UI shows the most
   // accurate 'last measurement' timestamp. This avoids delays introduced
   // by processing / persistence steps.
   m_sensor->updateLastMeasurementTime();
-  logger.debug(F("MeasurementCycle"), m_sensor->getName() + F(": Wechsel in Verarbeitungszustand"));
+  LOG_DEBUG(F("MeasurementCycle"), m_sensor->getName() + F(": Wechsel in Verarbeitungszustand"));
   m_state.setState(MeasurementState::PROCESSING, m_sensor->getName());
 }
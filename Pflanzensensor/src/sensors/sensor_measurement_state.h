@@ -74,10 +74,10 @@ struct MeasurementStateInfo {
    */
   void setState(MeasurementState newState, const String& sensorName = "") {
     if (state != newState) {
-      if (ConfigMgr.isDebugMeasurementCycle()) {
+      if (LOG_DEBUG_ENABLED(ConfigMgr.isDebugMeasurementCycle())) {
         String transition =
             sensorName + F(": State ") + stateToString(state) + F(" -> ") + stateToString(newState);
-        logger.debug(F("MeasurementState"), transition);
+        LOG_DEBUG(F("MeasurementState"), transition);
       }
       state = newState;
       stateStartTime = millis();
@@ -93,9 +93,10 @@ struct MeasurementStateInfo {
   /**
    * @brief Determines if the measurement is due based on the current time
    * @return true if it's time for the next measurement
-   * @details Compares the current time against the scheduled nextDueTime
+   * @details Compares the current time against the scheduled nextDueTime.
+   * The signed difference keeps the comparison valid across millis() rollover.
    */
-  bool isDue() const { return millis() >= nextDueTime; }
+  bool isDue() const { return static_cast<long>(millis() - nextDueTime) >= 0; }
 
   /**
    * @brief Schedules the next measurement based on the base time and interval
@@ -121,8 +122,11 @@ struct MeasurementStateInfo {
    * @brief Checks if the minimum delay has elapsed
    * @return true if the minimum delay period has passed
    * @details Compares current time against the calculated end time of the delay
+   * (rollover-safe)
    */
-  bool isMinimumDelayElapsed() const { return millis() >= minimumDelayEndTime; }
+  bool isMinimumDelayElapsed() const {
+    return static_cast<long>(millis() - minimumDelayEndTime) >= 0;
+  }
 
   /**
    * @brief Records an error and updates error tracking information
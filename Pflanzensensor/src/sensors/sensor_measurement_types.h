@@ -93,7 +93,7 @@ public:
       }
 
       m_queue.push_back(sensor);
-      logger.debug(F("SensorQueue"), sensor->getName() + F(": Added to measurement queue"));
+      LOG_DEBUG(F("SensorQueue"), sensor->getName() + F(": Added to measurement queue"));
       return true;
     }
     return false;
@@ -108,7 +108,8 @@ public:
       m_activeSensor = m_queue.front();
       m_queue.erase(m_queue.begin()); // Remove from front of queue
 
-      if (!SensorManagerLimiter::getInstance().acquireSlot(m_activeSensor->getId())) {
+      if (!SensorManagerLimiter::getInstance().acquireSlot(
+              m_activeSensor->getHandle(), m_activeSensor->getSharedHardwareInfo())) {
         m_state = SensorQueueState::WAITING_FOR_SLOT;
         m_queue.push_back(m_activeSensor); // Put back in queue
         m_activeSensor = nullptr;
@@ -129,7 +130,7 @@ public:
         return;
       }
 
-      logger.debug(F("SensorQueue"), m_activeSensor->getName() + F(": Starting measurement"));
+      LOG_DEBUG(F("SensorQueue"), m_activeSensor->getName() + F(": Starting measurement"));
     }
   }
 
@@ -158,7 +159,7 @@ private:
       m_activeSensor->deinitialize();
     }
 
-    SensorManagerLimiter::getInstance().releaseSlot(m_activeSensor->getId());
+    SensorManagerLimiter::getInstance().releaseSlot(m_activeSensor->getHandle());
 
     // Re-queue if retries left
     if (timing.errorCount < MAX_RETRIES) {
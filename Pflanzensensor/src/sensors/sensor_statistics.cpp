@@ -0,0 +1,125 @@
+/**
+ * @file sensor_statistics.cpp
+ * @brief Robust estimators for the measurement sample window
+ */
+
+#include "sensors/sensor_statistics.h"
+
+#include <algorithm>
+
+namespace SampleEstimators {
+
+float median(float* samples, size_t count) {
+  if (count == 0) {
+    return NAN;
+  }
+  size_t mid = count / 2;
+  std::nth_element(samples, samples + mid, samples + count);
+  float upper = samples[mid];
+  if (count % 2 != 0) {
+    return upper;
+  }
+  // Even count: nth_element leaves the lower half in front of mid
+  float lower = *std::max_element(samples, samples + mid);
+  return (lower + upper) / 2.0f;
+}
+
+float trimmedMean(float* samples, size_t count, float fraction) {
+  if (count == 0) {
+    return NAN;
+  }
+  if (!(fraction > 0.0f)) {
+    fraction = 0.0f;
+  }
+  size_t trim = static_cast<size_t>(fraction * count);
+  // Small windows would round every fraction down to no trimming at all
+  if (trim == 0 && fraction > 0.0f && count > 2) {
+    trim = 1;
+  }
+  if (trim * 2 >= count) {
+    trim = (count - 1) / 2;
+  }
+  std::sort(samples, samples + count);
+  float sum = 0.0f;
+  for (size_t i = trim; i < count - trim; i++) {
+    sum += samples[i];
+  }
+  return sum / (count - 2 * trim);
+}
+
+float hampelMean(const float* samples, float* scratch, size_t count, float threshold) {
+  if (count == 0) {
+    return NAN;
+  }
+  std::copy(samples, samples + count, scratch);
+  float center = median(scratch, count);
+  for (size_t i = 0; i < count; i++) {
+    scratch[i] = fabsf(samples[i] - center);
+  }
+  // 1.4826 scales the MAD to the standard deviation of normal data
+  float limit = threshold * 1.4826f * median(scratch, count);
+
+  float sum = 0.0f;
+  for (size_t i = 0; i < count; i++) {
+    sum += fabsf(samples[i] - center) > limit ? center : samples[i];
+  }
+  return sum / count;
+}
+
+float aggregate(const SampleAccumulator& stats, AggregationMode mode, float parameter) {
+  size_t count = stats.windowCount();
+  if (mode == AggregationMode::MEAN || count == 0 || SampleAccumulator::WINDOW_SIZE == 0) {
+    return stats.mean();
+  }
+
+  // Scratch space on the stack; the window itself stays untouched
+  float buffer[SampleAccumulator::WINDOW_SIZE > 0 ? SampleAccumulator::WINDOW_SIZE : 1];
+  float scratch[SampleAccumulator::WINDOW_SIZE > 0 ? SampleAccumulator::WINDOW_SIZE : 1];
+  std::copy(stats.window(), stats.window() + count, buffer);
+
+  switch (mode) {
+  case AggregationMode::MEDIAN:
+    return median(buffer, count);
+  case AggregationMode::TRIMMED_MEAN:
+    return trimmedMean(buffer, count, parameter);
+  case AggregationMode::HAMPEL:
+    return hampelMean(buffer, scratch, count, parameter);
+  case AggregationMode::MEAN:
+  default:
+    return stats.mean();
+  }
+}
+
+} // namespace SampleEstimators
+
+const char* aggregationModeToString(AggregationMode mode) {
+  switch (mode) {
+  case AggregationMode::MEDIAN:
+    return "median";
+  case AggregationMode::TRIMMED_MEAN:
+    return "trimmed";
+  case AggregationMode::HAMPEL:
+    return "hampel";
+  case AggregationMode::MEAN:
+  default:
+    return "mean";
+  }
+}
+
+bool aggregationModeFromString(const char* name, AggregationMode& mode) {
+  if (!name) {
+    return false;
+  }
+  if (strcmp(name, "mean") == 0) {
+    mode = AggregationMode::MEAN;
+  } else if (strcmp(name, "median") == 0) {
+    mode = AggregationMode::MEDIAN;
+  } else if (strcmp(name, "trimmed") == 0) {
+    mode = AggregationMode::TRIMMED_MEAN;
+  } else if (strcmp(name, "hampel") == 0) {
+    mode = AggregationMode::HAMPEL;
+  } else {
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,196 @@
+/**
+ * @file sensor_statistics.h
+ * @brief Fixed-footprint streaming statistics for measurement samples
+ * @details Replaces the per-cycle sample vectors of the measurement loop.
+ *          Count, mean and variance (Welford), min and max are updated per
+ *          sample without storing it. The robust estimators (median, trimmed
+ *          mean, Hampel) work on the optional window of SENSOR_SAMPLE_WINDOW
+ *          values.
+ */
+#ifndef SENSOR_STATISTICS_H
+#define SENSOR_STATISTICS_H
+
+#include <Arduino.h>
+
+#include <array>
+#include <cstddef>
+
+#include "sensor_config.h" // Ensure configuration macros are defined first
+
+// Check if SENSOR_SAMPLE_WINDOW is defined
+#ifndef SENSOR_SAMPLE_WINDOW
+#define SENSOR_SAMPLE_WINDOW MEASUREMENT_AVERAGE_COUNT
+#warning "SENSOR_SAMPLE_WINDOW not defined in config file, defaulting to MEASUREMENT_AVERAGE_COUNT"
+#endif
+
+/**
+ * @brief How the samples of one measurement cycle are combined
+ */
+enum class AggregationMode : uint8_t {
+  MEAN,         ///< Arithmetic mean (Welford)
+  MEDIAN,       ///< Median of the sample window
+  TRIMMED_MEAN, ///< Mean after dropping the lowest/highest trim fraction
+  HAMPEL        ///< Mean after replacing outliers (> k * MAD) by the median
+};
+
+/// Default fraction dropped at each end for AggregationMode::TRIMMED_MEAN
+static constexpr float DEFAULT_TRIM_FRACTION = 0.2f;
+/// Default outlier threshold in scaled MADs for AggregationMode::HAMPEL
+static constexpr float DEFAULT_HAMPEL_THRESHOLD = 3.0f;
+
+/**
+ * @class StreamingStats
+ * @brief Welford accumulator with an optional fixed sample window
+ * @tparam WINDOW Number of most recent samples kept (0 = none)
+ * @details NaN samples are ignored. No heap allocation; the footprint is
+ *          known at compile time.
+ */
+template <size_t WINDOW> class StreamingStats {
+public:
+  /// Number of samples the window can hold
+  static constexpr size_t WINDOW_SIZE = WINDOW;
+
+  /**
+   * @brief Reset all statistics for a new measurement cycle
+   */
+  void reset() {
+    m_count = 0;
+    m_windowCount = 0;
+    m_mean = 0.0f;
+    m_m2 = 0.0f;
+    m_min = NAN;
+    m_max = NAN;
+  }
+
+  /**
+   * @brief Add one sample
+   * @param value Sample value (NaN is ignored)
+   */
+  void add(float value) {
+    if (isnan(value)) {
+      return;
+    }
+    if (m_count < UINT16_MAX) {
+      m_count++;
+    }
+    float delta = value - m_mean;
+    m_mean += delta / m_count;
+    m_m2 += delta * (value - m_mean);
+
+    if (m_count == 1 || value < m_min) {
+      m_min = value;
+    }
+    if (m_count == 1 || value > m_max) {
+      m_max = value;
+    }
+
+    if (WINDOW > 0) {
+      // Keep the newest samples; the window is a ring once it is full
+      m_window[m_windowCount % (WINDOW > 0 ? WINDOW : 1)] = value;
+      if (m_windowCount < UINT16_MAX) {
+        m_windowCount++;
+      }
+    }
+  }
+
+  /// @return Number of valid samples added since reset()
+  uint16_t count() const { return m_count; }
+
+  /// @return Arithmetic mean, NaN without samples
+  float mean() const { return m_count > 0 ? m_mean : NAN; }
+
+  /// @return Sample variance (n-1), 0 for a single sample, NaN without samples
+  float variance() const {
+    if (m_count == 0) {
+      return NAN;
+    }
+    return m_count > 1 ? m_m2 / (m_count - 1) : 0.0f;
+  }
+
+  /// @return Smallest sample, NaN without samples
+  float min() const { return m_min; }
+
+  /// @return Largest sample, NaN without samples
+  float max() const { return m_max; }
+
+  /// @return Number of samples currently held in the window
+  size_t windowCount() const { return m_windowCount < WINDOW ? m_windowCount : WINDOW; }
+
+  /// @return Pointer to the window samples (unordered once the ring wrapped)
+  const float* window() const { return m_window.data(); }
+
+private:
+  uint16_t m_count{0};
+  uint16_t m_windowCount{0};
+  float m_mean{0.0f};
+  float m_m2{0.0f};
+  float m_min{NAN};
+  float m_max{NAN};
+  std::array<float, WINDOW> m_window{};
+};
+
+/// Accumulator type used per measurement channel
+using SampleAccumulator = StreamingStats<SENSOR_SAMPLE_WINDOW>;
+
+namespace SampleEstimators {
+
+/**
+ * @brief Median of a sample buffer
+ * @param samples Samples; reordered in place (nth_element)
+ * @param count Number of samples
+ * @return Median, NaN for an empty buffer
+ */
+float median(float* samples, size_t count);
+
+/**
+ * @brief Alpha-trimmed mean of a sample buffer
+ * @param samples Samples; sorted in place
+ * @param count Number of samples
+ * @param fraction Fraction dropped at each end (clamped to [0, 0.5)); a
+ *        positive fraction drops at least one sample at each end once there
+ *        are three or more samples
+ * @return Trimmed mean, NaN for an empty buffer
+ */
+float trimmedMean(float* samples, size_t count, float fraction);
+
+/**
+ * @brief Hampel-filtered mean of a sample buffer
+ * @details Samples further than threshold * 1.4826 * MAD from the median are
+ *          replaced by the median before averaging.
+ * @param samples Samples; left unchanged
+ * @param scratch Buffer with room for @p count values
+ * @param count Number of samples
+ * @param threshold Outlier threshold in scaled MADs
+ * @return Filtered mean, NaN for an empty buffer
+ */
+float hampelMean(const float* samples, float* scratch, size_t count, float threshold);
+
+/**
+ * @brief Combine the samples of one cycle according to an aggregation mode
+ * @details Falls back to the Welford mean for MEAN, for an empty window and
+ *          when SENSOR_SAMPLE_WINDOW is 0. Uses a stack buffer only.
+ * @param stats Accumulator of the channel
+ * @param mode Aggregation mode
+ * @param parameter Trim fraction (TRIMMED_MEAN) or threshold (HAMPEL)
+ * @return Aggregated value, NaN without valid samples
+ */
+float aggregate(const SampleAccumulator& stats, AggregationMode mode, float parameter);
+
+} // namespace SampleEstimators
+
+/**
+ * @brief Convert an aggregation mode to its JSON name
+ * @param mode Aggregation mode
+ * @return "mean", "median", "trimmed" or "hampel"
+ */
+const char* aggregationModeToString(AggregationMode mode);
+
+/**
+ * @brief Parse an aggregation mode from its JSON name
+ * @param name Name as written by aggregationModeToString()
+ * @param mode Output mode (unchanged on failure)
+ * @return true if the name was recognised
+ */
+bool aggregationModeFromString(const char* name, AggregationMode& mode);
+
+#endif // SENSOR_STATISTICS_H
@@ -0,0 +1,485 @@
+/**
+ * @file sensor_timeseries.cpp
+ * @brief Implementation of the compressed LittleFS time-series store
+ */
+
+#include "sensors/sensor_timeseries.h"
+
+#include <LittleFS.h>
+
+#include "logger/logger.h"
+#include "managers/manager_config.h"
+#include "utils/crc32.h"
+
+static const char TIMESERIES_DIR[] PROGMEM = "/ts";
+
+// Header bytes covered by the CRC (everything except the CRC itself)
+static constexpr size_t HEADER_CRC_OFFSET = 30;
+
+/**
+ * @brief Append the lowest @p bits bits of @p value MSB-first to a bit buffer
+ */
+static void writeBits(uint8_t* buffer, uint16_t& bitPos, uint32_t value, uint8_t bits) {
+  for (int8_t i = bits - 1; i >= 0; i--) {
+    if ((value >> i) & 1U) {
+      buffer[bitPos >> 3] |= 0x80 >> (bitPos & 7);
+    }
+    bitPos++;
+  }
+}
+
+/**
+ * @brief Read @p bits bits MSB-first from a bit buffer
+ * @return Read value, 0 once the buffer is exhausted
+ */
+static uint32_t readBits(const uint8_t* buffer, uint16_t& bitPos, uint8_t bits,
+                         size_t totalBits) {
+  uint32_t value = 0;
+  for (uint8_t i = 0; i < bits; i++) {
+    value <<= 1;
+    if (bitPos < totalBits && (buffer[bitPos >> 3] & (0x80 >> (bitPos & 7)))) {
+      value |= 1U;
+    }
+    bitPos++;
+  }
+  return value;
+}
+
+static float bitsToFloat(uint32_t bits) {
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+String TimeSeriesStore::segmentPath(uint32_t sequence) {
+  return String(FPSTR(TIMESERIES_DIR)) + "/" + String(sequence) + ".seg";
+}
+
+void TimeSeriesStore::serializeHeader(const BlockHeader& header, uint8_t* out) {
+  uint16_t magic = BLOCK_MAGIC;
+  memcpy(out, &magic, 2);
+  out[2] = header.measurementIndex;
+  out[3] = header.payloadBytes;
+  memcpy(out + 4, header.sensorId, SENSOR_ID_LEN);
+  memcpy(out + 16, &header.count, 2);
+  memcpy(out + 18, &header.firstTimestamp, 4);
+  memcpy(out + 22, &header.lastTimestamp, 4);
+  memcpy(out + 26, &header.firstValueBits, 4);
+}
+
+bool TimeSeriesStore::deserializeHeader(const uint8_t* in, BlockHeader& header) {
+  uint16_t magic;
+  memcpy(&magic, in, 2);
+  if (magic != BLOCK_MAGIC || in[3] > TIMESERIES_BLOCK_SIZE) {
+    return false;
+  }
+  header.measurementIndex = in[2];
+  header.payloadBytes = in[3];
+  memcpy(header.sensorId, in + 4, SENSOR_ID_LEN);
+  header.sensorId[SENSOR_ID_LEN - 1] = '\0';
+  memcpy(&header.count, in + 16, 2);
+  memcpy(&header.firstTimestamp, in + 18, 4);
+  memcpy(&header.lastTimestamp, in + 22, 4);
+  memcpy(&header.firstValueBits, in + 26, 4);
+  return header.count > 0;
+}
+
+ResourceResult TimeSeriesStore::begin() {
+  String dir = FPSTR(TIMESERIES_DIR);
+  if (!LittleFS.exists(dir) && !LittleFS.mkdir(dir)) {
+    return ResourceResult::fail(ResourceError::FILESYSTEM_ERROR,
+                                F("Zeitreihen-Verzeichnis konnte nicht angelegt werden"));
+  }
+
+  m_segmentCount = 0;
+  Dir entries = LittleFS.openDir(dir);
+  while (entries.next()) {
+    String name = entries.fileName();
+    if (!name.endsWith(".seg")) {
+      continue;
+    }
+    SegmentInfo info{};
+    info.sequence = strtoul(name.c_str(), nullptr, 10);
+
+    // Keep the index sorted by sequence; drop the oldest segment on overflow
+    if (m_segmentCount == TIMESERIES_MAX_SEGMENTS) {
+      if (info.sequence < m_segments[0].sequence) {
+        LittleFS.remove(segmentPath(info.sequence));
+        continue;
+      }
+      LittleFS.remove(segmentPath(m_segments[0].sequence));
+      memmove(&m_segments[0], &m_segments[1], sizeof(SegmentInfo) * (m_segmentCount - 1));
+      m_segmentCount--;
+    }
+    size_t pos = m_segmentCount;
+    while (pos > 0 && m_segments[pos - 1].sequence > info.sequence) {
+      m_segments[pos] = m_segments[pos - 1];
+      pos--;
+    }
+    m_segments[pos] = info;
+    m_segmentCount++;
+  }
+
+  for (size_t i = 0; i < m_segmentCount; i++) {
+    scanSegment(m_segments[i]);
+    yield();
+  }
+
+  m_initialized = true;
+  Stats stats = getStats();
+  logger.info(F("TimeSeries"), String(stats.segmentCount) + F(" Segmente, ") +
+                                   String(stats.storedSamples) + F(" Werte, ") +
+                                   String(stats.storedBytes) + F(" Bytes"));
+  return ResourceResult::success();
+}
+
+bool TimeSeriesStore::scanSegment(SegmentInfo& info) {
+  File file = LittleFS.open(segmentPath(info.sequence), "r+");
+  if (!file) {
+    return false;
+  }
+
+  info.firstTimestamp = 0;
+  info.lastTimestamp = 0;
+  info.samples = 0;
+
+  // Only headers are read; payloads are skipped with seek
+  uint8_t raw[HEADER_SIZE];
+  uint32_t validSize = 0;
+  while (file.read(raw, HEADER_SIZE) == HEADER_SIZE) {
+    BlockHeader header;
+    if (!deserializeHeader(raw, header) ||
+        validSize + HEADER_SIZE + header.payloadBytes > file.size()) {
+      break;
+    }
+    // Blocks of different measurements interleave, so the earliest is kept
+    if (info.samples == 0 || header.firstTimestamp < info.firstTimestamp) {
+      info.firstTimestamp = header.firstTimestamp;
+    }
+    if (header.lastTimestamp > info.lastTimestamp) {
+      info.lastTimestamp = header.lastTimestamp;
+    }
+    info.samples += header.count;
+    validSize += HEADER_SIZE + header.payloadBytes;
+    file.seek(validSize, SeekSet);
+  }
+
+  // Cut off a record torn by a power loss so new blocks stay readable
+  if (validSize < file.size()) {
+    logger.warning(F("TimeSeries"), F("Segment ") + String(info.sequence) +
+                                        F(" gekürzt auf ") + String(validSize) + F(" Bytes"));
+    file.truncate(validSize);
+  }
+  info.size = validSize;
+  file.close();
+  return true;
+}
+
+TimeSeriesStore::Encoder* TimeSeriesStore::findEncoder(const String& sensorId,
+                                                       size_t measurementIndex, bool bind) {
+  for (auto& enc : m_encoders) {
+    if (enc.used && enc.header.measurementIndex == measurementIndex &&
+        sensorId.equals(enc.header.sensorId)) {
+      return &enc;
+    }
+  }
+  if (!bind) {
+    return nullptr;
+  }
+  for (auto& enc : m_encoders) {
+    if (!enc.used) {
+      memset(&enc, 0, sizeof(enc));
+      strncpy(enc.header.sensorId, sensorId.c_str(), SENSOR_ID_LEN - 1);
+      enc.header.measurementIndex = static_cast<uint8_t>(measurementIndex);
+      enc.used = true;
+      return &enc;
+    }
+  }
+  return nullptr;
+}
+
+void TimeSeriesStore::startBlock(Encoder& enc, uint32_t timestamp, uint32_t valueBits) {
+  memset(enc.payload, 0, sizeof(enc.payload));
+  enc.bitPos = 0;
+  enc.header.count = 1;
+  enc.header.firstTimestamp = timestamp;
+  enc.header.lastTimestamp = timestamp;
+  enc.header.firstValueBits = valueBits;
+  enc.lastDelta = 0;
+  enc.lastValueBits = valueBits;
+  enc.lastLeading = NO_WINDOW;
+  enc.lastTrailing = 0;
+}
+
+void TimeSeriesStore::encodeSample(Encoder& enc, uint32_t timestamp, uint32_t valueBits) {
+  // Timestamp: delta-of-delta with variable-length prefix
+  int32_t delta = static_cast<int32_t>(timestamp - enc.header.lastTimestamp);
+  int32_t dod = delta - enc.lastDelta;
+  if (dod == 0) {
+    writeBits(enc.payload, enc.bitPos, 0b0, 1);
+  } else if (dod >= -63 && dod <= 64) {
+    writeBits(enc.payload, enc.bitPos, 0b10, 2);
+    writeBits(enc.payload, enc.bitPos, static_cast<uint32_t>(dod + 63), 7);
+  } else if (dod >= -255 && dod <= 256) {
+    writeBits(enc.payload, enc.bitPos, 0b110, 3);
+    writeBits(enc.payload, enc.bitPos, static_cast<uint32_t>(dod + 255), 9);
+  } else if (dod >= -2047 && dod <= 2048) {
+    writeBits(enc.payload, enc.bitPos, 0b1110, 4);
+    writeBits(enc.payload, enc.bitPos, static_cast<uint32_t>(dod + 2047), 12);
+  } else {
+    writeBits(enc.payload, enc.bitPos, 0b1111, 4);
+    writeBits(enc.payload, enc.bitPos, static_cast<uint32_t>(dod), 32);
+  }
+  enc.lastDelta = delta;
+  enc.header.lastTimestamp = timestamp;
+
+  // Value: XOR with the previous value, reusing the last bit window if possible
+  uint32_t x = valueBits ^ enc.lastValueBits;
+  if (x == 0) {
+    writeBits(enc.payload, enc.bitPos, 0b0, 1);
+  } else {
+    uint8_t leading = __builtin_clz(x);
+    uint8_t trailing = __builtin_ctz(x);
+    if (enc.lastLeading != NO_WINDOW && leading >= enc.lastLeading &&
+        trailing >= enc.lastTrailing) {
+      uint8_t meaningful = 32 - enc.lastLeading - enc.lastTrailing;
+      writeBits(enc.payload, enc.bitPos, 0b10, 2);
+      writeBits(enc.payload, enc.bitPos, x >> enc.lastTrailing, meaningful);
+    } else {
+      uint8_t meaningful = 32 - leading - trailing;
+      writeBits(enc.payload, enc.bitPos, 0b11, 2);
+      writeBits(enc.payload, enc.bitPos, leading, 5);
+      writeBits(enc.payload, enc.bitPos, meaningful - 1, 5);
+      writeBits(enc.payload, enc.bitPos, x >> trailing, meaningful);
+      enc.lastLeading = leading;
+      enc.lastTrailing = trailing;
+    }
+  }
+  enc.lastValueBits = valueBits;
+  enc.header.count++;
+}
+
+void TimeSeriesStore::append(const String& sensorId, size_t measurementIndex, uint32_t timestamp,
+                             float value) {
+  if (isnan(value)) {
+    return;
+  }
+  Encoder* enc = findEncoder(sensorId, measurementIndex, true);
+  if (!enc) {
+    return;
+  }
+
+  uint32_t valueBits;
+  memcpy(&valueBits, &value, sizeof(valueBits));
+
+  if (enc->header.count == 0) {
+    startBlock(*enc, timestamp, valueBits);
+    return;
+  }
+
+  // Block full: write it and start a new one with this sample
+  if (enc->bitPos + MAX_SAMPLE_BITS > TIMESERIES_BLOCK_SIZE * 8 ||
+      enc->header.count == UINT16_MAX) {
+    writeBlock(*enc);
+    startBlock(*enc, timestamp, valueBits);
+    return;
+  }
+
+  encodeSample(*enc, timestamp, valueBits);
+}
+
+bool TimeSeriesStore::openNewSegment() {
+  uint32_t sequence = m_segmentCount > 0 ? m_segments[m_segmentCount - 1].sequence + 1 : 0;
+
+  // Bounded total size: drop the oldest segment before creating a new one
+  if (m_segmentCount == TIMESERIES_MAX_SEGMENTS) {
+    LittleFS.remove(segmentPath(m_segments[0].sequence));
+    memmove(&m_segments[0], &m_segments[1], sizeof(SegmentInfo) * (m_segmentCount - 1));
+    m_segmentCount--;
+  }
+
+  SegmentInfo& info = m_segments[m_segmentCount];
+  info = SegmentInfo{};
+  info.sequence = sequence;
+  m_segmentCount++;
+
+  if (ConfigMgr.isDebugSensor()) {
+    LOG_DEBUG(F("TimeSeries"), F("Neues Segment ") + String(sequence));
+  }
+  return true;
+}
+
+void TimeSeriesStore::writeBlock(Encoder& enc) {
+  if (!m_initialized || enc.header.count == 0) {
+    return;
+  }
+
+  enc.header.payloadBytes = static_cast<uint8_t>((enc.bitPos + 7) / 8);
+  size_t recordSize = HEADER_SIZE + enc.header.payloadBytes;
+
+  if (m_segmentCount == 0 ||
+      m_segments[m_segmentCount - 1].size + recordSize > TIMESERIES_SEGMENT_SIZE) {
+    openNewSegment();
+  }
+  SegmentInfo& info = m_segments[m_segmentCount - 1];
+
+  uint8_t raw[HEADER_SIZE];
+  serializeHeader(enc.header, raw);
+  uint32_t crc = updateCRC32(CRC32_INITIAL, raw, HEADER_CRC_OFFSET);
+  crc = ~updateCRC32(crc, enc.payload, enc.header.payloadBytes);
+  memcpy(raw + HEADER_CRC_OFFSET, &crc, 4);
+
+  File file = LittleFS.open(segmentPath(info.sequence), "a");
+  if (!file) {
+    logger.error(F("TimeSeries"), F("Segment konnte nicht geöffnet werden"));
+    return;
+  }
+  size_t written = file.write(raw, HEADER_SIZE);
+  written += file.write(enc.payload, enc.header.payloadBytes);
+  file.close();
+
+  if (written != recordSize) {
+    logger.error(F("TimeSeries"), F("Block unvollständig geschrieben"));
+    scanSegment(info); // Re-sync index and truncate the torn record
+    return;
+  }
+
+  if (info.samples == 0 || enc.header.firstTimestamp < info.firstTimestamp) {
+    info.firstTimestamp = enc.header.firstTimestamp;
+  }
+  if (enc.header.lastTimestamp > info.lastTimestamp) {
+    info.lastTimestamp = enc.header.lastTimestamp;
+  }
+  info.samples += enc.header.count;
+  info.size += recordSize;
+  m_blocksWritten++;
+  enc.header.count = 0;
+}
+
+void TimeSeriesStore::flush() {
+  for (auto& enc : m_encoders) {
+    if (enc.used && enc.header.count > 0) {
+      writeBlock(enc);
+    }
+  }
+}
+
+size_t TimeSeriesStore::decodeBlock(const BlockHeader& header, const uint8_t* payload,
+                                    uint32_t from, uint32_t to, size_t limit,
+                                    const SampleCallback& callback) {
+  size_t emitted = 0;
+  size_t totalBits = header.payloadBytes * 8;
+  uint16_t bitPos = 0;
+  uint32_t timestamp = header.firstTimestamp;
+  uint32_t valueBits = header.firstValueBits;
+  int32_t delta = 0;
+  uint8_t leading = NO_WINDOW;
+  uint8_t trailing = 0;
+
+  for (uint16_t i = 0; i < header.count && emitted < limit; i++) {
+    if (i > 0) {
+      int32_t dod;
+      if (readBits(payload, bitPos, 1, totalBits) == 0) {
+        dod = 0;
+      } else if (readBits(payload, bitPos, 1, totalBits) == 0) {
+        dod = static_cast<int32_t>(readBits(payload, bitPos, 7, totalBits)) - 63;
+      } else if (readBits(payload, bitPos, 1, totalBits) == 0) {
+        dod = static_cast<int32_t>(readBits(payload, bitPos, 9, totalBits)) - 255;
+      } else if (readBits(payload, bitPos, 1, totalBits) == 0) {
+        dod = static_cast<int32_t>(readBits(payload, bitPos, 12, totalBits)) - 2047;
+      } else {
+        dod = static_cast<int32_t>(readBits(payload, bitPos, 32, totalBits));
+      }
+      delta += dod;
+      timestamp += delta;
+
+      if (readBits(payload, bitPos, 1, totalBits) == 1) {
+        if (readBits(payload, bitPos, 1, totalBits) == 1) {
+          leading = readBits(payload, bitPos, 5, totalBits);
+          uint8_t meaningful = readBits(payload, bitPos, 5, totalBits) + 1;
+          trailing = 32 - leading - meaningful;
+        }
+        uint8_t meaningful = 32 - leading - trailing;
+        valueBits ^= readBits(payload, bitPos, meaningful, totalBits) << trailing;
+      }
+    }
+    if (timestamp >= from && timestamp <= to) {
+      callback(timestamp, bitsToFloat(valueBits));
+      emitted++;
+    }
+  }
+  return emitted;
+}
+
+size_t TimeSeriesStore::query(const String& sensorId, size_t measurementIndex, uint32_t from,
+                              uint32_t to, size_t limit, const SampleCallback& callback) {
+  unsigned long start = millis();
+  size_t emitted = 0;
+  uint8_t raw[HEADER_SIZE];
+  uint8_t payload[TIMESERIES_BLOCK_SIZE];
+
+  for (size_t s = 0; s < m_segmentCount && emitted < limit; s++) {
+    const SegmentInfo& info = m_segments[s];
+    // Segment index: skip segments outside the requested range
+    if (info.samples == 0 || info.lastTimestamp < from || info.firstTimestamp > to) {
+      continue;
+    }
+    File file = LittleFS.open(segmentPath(info.sequence), "r");
+    if (!file) {
+      continue;
+    }
+    uint32_t offset = 0;
+    while (emitted < limit && offset + HEADER_SIZE <= info.size &&
+           file.read(raw, HEADER_SIZE) == HEADER_SIZE) {
+      BlockHeader header;
+      if (!deserializeHeader(raw, header)) {
+        break;
+      }
+      offset += HEADER_SIZE + header.payloadBytes;
+      bool matches = header.measurementIndex == measurementIndex &&
+                     sensorId.equals(header.sensorId) && header.lastTimestamp >= from &&
+                     header.firstTimestamp <= to;
+      if (!matches) {
+        file.seek(offset, SeekSet);
+        continue;
+      }
+      if (file.read(payload, header.payloadBytes) != header.payloadBytes) {
+        break;
+      }
+      uint32_t crc = updateCRC32(CRC32_INITIAL, raw, HEADER_CRC_OFFSET);
+      crc = ~updateCRC32(crc, payload, header.payloadBytes);
+      uint32_t storedCrc;
+      memcpy(&storedCrc, raw + HEADER_CRC_OFFSET, 4);
+      if (crc != storedCrc) {
+        logger.warning(F("TimeSeries"), F("CRC-Fehler in Segment ") + String(info.sequence));
+        continue;
+      }
+      emitted += decodeBlock(header, payload, from, to, limit - emitted, callback);
+    }
+    file.close();
+    yield();
+  }
+
+  // Samples not yet written to flash
+  Encoder* enc = findEncoder(sensorId, measurementIndex, false);
+  if (enc && enc->header.count > 0 && emitted < limit) {
+    BlockHeader header = enc->header;
+    header.payloadBytes = static_cast<uint8_t>((enc->bitPos + 7) / 8);
+    emitted += decodeBlock(header, enc->payload, from, to, limit - emitted, callback);
+  }
+
+  m_lastQueryMs = millis() - start;
+  return emitted;
+}
+
+TimeSeriesStore::Stats TimeSeriesStore::getStats() const {
+  Stats stats;
+  stats.segmentCount = m_segmentCount;
+  for (size_t i = 0; i < m_segmentCount; i++) {
+    stats.storedBytes += m_segments[i].size;
+    stats.storedSamples += m_segments[i].samples;
+  }
+  stats.blocksWritten = m_blocksWritten;
+  stats.lastQueryMs = m_lastQueryMs;
+  return stats;
+}
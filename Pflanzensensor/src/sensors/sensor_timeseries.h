@@ -0,0 +1,190 @@
+/**
+ * @file sensor_timeseries.h
+ * @brief Compressed append-only time-series store on LittleFS
+ * @details Measurement values are compressed per measurement in RAM blocks
+ *          (Gorilla-style: delta-of-delta timestamps and XOR-encoded floats)
+ *          and appended as CRC-protected records to segment files in /ts.
+ *          Segments are rotated once they reach TIMESERIES_SEGMENT_SIZE and
+ *          at most TIMESERIES_MAX_SEGMENTS are kept. A RAM index with the time
+ *          range of every segment lets range queries skip whole segments.
+ *          LittleFS is used instead of a raw region behind
+ *          FlashPersistence::getSafeOffset() because that area is overwritten
+ *          by OTA updates.
+ */
+#ifndef SENSOR_TIMESERIES_H
+#define SENSOR_TIMESERIES_H
+
+#include <Arduino.h>
+
+#include <functional>
+
+#include "configs/config.h"
+#include "sensors/sensor_count.h"
+#include "utils/result_types.h"
+
+// Check if TIMESERIES_SEGMENT_SIZE is defined
+#ifndef TIMESERIES_SEGMENT_SIZE
+#define TIMESERIES_SEGMENT_SIZE 16384
+#warning "TIMESERIES_SEGMENT_SIZE not defined in config file, defaulting to 16384 bytes"
+#endif
+
+// Check if TIMESERIES_MAX_SEGMENTS is defined
+#ifndef TIMESERIES_MAX_SEGMENTS
+#define TIMESERIES_MAX_SEGMENTS 8
+#warning "TIMESERIES_MAX_SEGMENTS not defined in config file, defaulting to 8 segments"
+#endif
+
+// Check if TIMESERIES_BLOCK_SIZE is defined
+#ifndef TIMESERIES_BLOCK_SIZE
+#define TIMESERIES_BLOCK_SIZE 128
+#warning "TIMESERIES_BLOCK_SIZE not defined in config file, defaulting to 128 bytes"
+#endif
+
+/**
+ * @class TimeSeriesStore
+ * @brief Singleton managing compressed long-term measurement history
+ * @details Samples are buffered in one RAM block per measurement and written
+ *          when the block is full or flush() is called. Samples of a block
+ *          that was not yet written are lost on power failure.
+ */
+class TimeSeriesStore {
+public:
+  /// Number of RAM encoders (one per possible measurement)
+  static constexpr size_t CHANNEL_COUNT = SensorCounter::getTotalMeasurementCount();
+  /// Maximum sensor ID length incl. terminator
+  static constexpr size_t SENSOR_ID_LEN = 12;
+
+  /// Callback for queried samples
+  using SampleCallback = std::function<void(uint32_t timestamp, float value)>;
+
+  /**
+   * @brief Storage statistics
+   */
+  struct Stats {
+    uint32_t segmentCount{0};  ///< Segment files in use
+    uint32_t storedBytes{0};   ///< Bytes in all segment files
+    uint32_t storedSamples{0}; ///< Samples in all segment files
+    uint32_t blocksWritten{0}; ///< Blocks appended since boot
+    uint32_t lastQueryMs{0};   ///< Duration of the last range query
+  };
+
+  /**
+   * @brief Gets the singleton instance
+   * @return Reference to the singleton instance
+   */
+  static TimeSeriesStore& getInstance() {
+    static TimeSeriesStore instance;
+    return instance;
+  }
+
+  /**
+   * @brief Scan existing segments and build the segment index
+   * @return ResourceResult indicating success or failure
+   */
+  ResourceResult begin();
+
+  /**
+   * @brief Append a sample to the RAM block of a measurement
+   * @param sensorId Sensor ID
+   * @param measurementIndex Measurement index
+   * @param timestamp Epoch seconds
+   * @param value Measured value
+   */
+  void append(const String& sensorId, size_t measurementIndex, uint32_t timestamp, float value);
+
+  /**
+   * @brief Write all partially filled RAM blocks (e.g. before a reboot)
+   */
+  void flush();
+
+  /**
+   * @brief Query samples of one measurement within a time range
+   * @param sensorId Sensor ID
+   * @param measurementIndex Measurement index
+   * @param from First epoch second (inclusive)
+   * @param to Last epoch second (inclusive)
+   * @param limit Maximum number of samples
+   * @param callback Invoked for every sample in ascending block order
+   * @return Number of samples passed to the callback
+   */
+  size_t query(const String& sensorId, size_t measurementIndex, uint32_t from, uint32_t to,
+               size_t limit, const SampleCallback& callback);
+
+  /**
+   * @brief Get storage statistics
+   * @return Current statistics
+   */
+  Stats getStats() const;
+
+private:
+  static_assert(TIMESERIES_BLOCK_SIZE <= 255, "TIMESERIES_BLOCK_SIZE must fit into one byte");
+
+  static constexpr uint16_t BLOCK_MAGIC = 0x5453;  ///< "TS"
+  static constexpr size_t HEADER_SIZE = 34;        ///< Serialized block header size
+  static constexpr size_t MAX_SAMPLE_BITS = 80;    ///< Worst-case bits per encoded sample
+  static constexpr uint8_t NO_WINDOW = 0xFF;       ///< No XOR window yet
+
+  /**
+   * @brief Block header as stored in front of every payload
+   */
+  struct BlockHeader {
+    char sensorId[SENSOR_ID_LEN];
+    uint8_t measurementIndex;
+    uint8_t payloadBytes;
+    uint16_t count;
+    uint32_t firstTimestamp;
+    uint32_t lastTimestamp;
+    uint32_t firstValueBits;
+  };
+
+  /**
+   * @brief Per-measurement encoder state and RAM block
+   */
+  struct Encoder {
+    bool used;
+    BlockHeader header;
+    uint16_t bitPos;
+    int32_t lastDelta;
+    uint32_t lastValueBits;
+    uint8_t lastLeading;
+    uint8_t lastTrailing;
+    uint8_t payload[TIMESERIES_BLOCK_SIZE];
+  };
+
+  /**
+   * @brief RAM index entry of one segment file
+   */
+  struct SegmentInfo {
+    uint32_t sequence;
+    uint32_t firstTimestamp;
+    uint32_t lastTimestamp;
+    uint32_t size;
+    uint32_t samples;
+  };
+
+  TimeSeriesStore() = default;
+  TimeSeriesStore(const TimeSeriesStore&) = delete;
+  TimeSeriesStore& operator=(const TimeSeriesStore&) = delete;
+
+  Encoder* findEncoder(const String& sensorId, size_t measurementIndex, bool bind);
+  void startBlock(Encoder& enc, uint32_t timestamp, uint32_t valueBits);
+  void encodeSample(Encoder& enc, uint32_t timestamp, uint32_t valueBits);
+  void writeBlock(Encoder& enc);
+  bool openNewSegment();
+  bool scanSegment(SegmentInfo& info);
+
+  static String segmentPath(uint32_t sequence);
+  static void serializeHeader(const BlockHeader& header, uint8_t* out);
+  static bool deserializeHeader(const uint8_t* in, BlockHeader& header);
+  static size_t decodeBlock(const BlockHeader& header, const uint8_t* payload, uint32_t from,
+                            uint32_t to, size_t limit, const SampleCallback& callback);
+
+  bool m_initialized{false};
+  Encoder m_encoders[CHANNEL_COUNT]{};
+  SegmentInfo m_segments[TIMESERIES_MAX_SEGMENTS]{};
+  size_t m_segmentCount{0};
+  uint32_t m_blocksWritten{0};
+  uint32_t m_lastQueryMs{0};
+};
+
+#endif // SENSOR_TIMESERIES_H
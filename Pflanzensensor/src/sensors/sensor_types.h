@@ -13,6 +13,7 @@
 
 #include "sensor_config.h" // Ensure configuration macros are defined first
 #include "sensors/sensor_autocalibration.h"
+#include "sensors/sensor_statistics.h"
 
 class Sensor;
 
@@ -79,6 +80,18 @@ struct MeasurementConfig {
    * @brief Whether to invert the scale for analog measurements (if applicable)
    */
   bool inverted{false};
+  /**
+   * @brief How the samples of one cycle are combined (mean, median, trimmed, hampel)
+   */
+  AggregationMode aggregation{AggregationMode::MEAN};
+  /**
+   * @brief Fraction dropped at each end for the trimmed mean
+   */
+  float trimFraction{DEFAULT_TRIM_FRACTION};
+  /**
+   * @brief Outlier threshold in scaled MADs for the Hampel filter
+   */
+  float hampelThreshold{DEFAULT_HAMPEL_THRESHOLD};
   /**
    * @brief Absolute minimum value ever measured for this measurement
    */
@@ -191,6 +204,8 @@ struct SensorConfig {
  */
 struct MeasurementData {
   std::array<float, SensorConfig::MAX_MEASUREMENTS> values; ///< Measurement values
+  std::array<float, SensorConfig::MAX_MEASUREMENTS> variances; ///< Sample variance per cycle
+  std::array<uint16_t, SensorConfig::MAX_MEASUREMENTS> sampleCounts; ///< Valid samples per cycle
   char fieldNames[SensorConfig::MAX_MEASUREMENTS][SensorConfig::FIELD_NAME_LEN];
   char units[SensorConfig::MAX_MEASUREMENTS][SensorConfig::UNIT_LEN];
   size_t activeValues{0};                             ///< Number of active values
@@ -200,10 +215,12 @@ struct MeasurementData {
 
   /**
    * @brief Default constructor
-   * @details Initializes all values to 0.0 and sets valid=true
+   * @details Initializes all values to 0.0, variances to NaN and sets valid=true
    */
   MeasurementData() : valid(true) {
     values.fill(0.0f);
+    variances.fill(NAN);
+    sampleCounts.fill(0);
     for (size_t i = 0; i < SensorConfig::MAX_MEASUREMENTS; ++i) {
       fieldNames[i][0] = '\0';
       units[i][0] = '\0';
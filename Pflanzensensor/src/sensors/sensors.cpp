@@ -24,7 +24,7 @@ Sensor::Sensor(const SensorConfig& config, SensorManager* sensorManager)
   m_statuses.resize(config.activeMeasurements, "unknown");
 
   // Initialize state
-  m_state.samples.resize(config.activeMeasurements);
+  resetSampleStatistics(config.activeMeasurements);
   m_state.sampleCount = 0;
   m_state.measurementIndex = 0;
   m_state.sampleIndex = 0;
@@ -172,7 +172,7 @@ bool Sensor::shouldRetry() const { return m_errorState.errorCount < MAX_RETRIES;
 SensorResult Sensor::validateMemoryState() const {
   // Check if measurement data is marked as valid
   if (!m_measurementDataValid) {
-    logger.debug(getName(), F(": Measurement data marked as invalid, attempting recovery"));
+    LOG_DEBUG(getName(), F(": Measurement data marked as invalid, attempting recovery"));
     return SensorResult::fail(SensorError::RESOURCE_ERROR,
                               F("Measurement data invalid (deinitialized)"));
   }
@@ -302,10 +302,10 @@ void Sensor::updateStatus(size_t measurementIndex) {
   const auto& limits = config().measurements[measurementIndex].limits;
 
   // Determine if this is a one-sided sensor
-  bool isOneSided = false;
-  if (getId().startsWith("SDS011") || getId().startsWith("MHZ19")) {
-    isOneSided = true; // PM and CO2 sensors use one-sided limits
-  }
+  // PM and CO2 sensors use one-sided limits; checked by type instead of an ID
+  // prefix so no temporary String is built per measurement
+  SensorType type = getSharedHardwareInfo().type;
+  bool isOneSided = type == SensorType::SDS011 || type == SensorType::MHZ19;
 
   // Ensure statuses vector is large enough
   if (measurementIndex >= m_statuses.size()) {
@@ -437,22 +437,8 @@ SensorResult Sensor::performMeasurementCycle() {
     m_state.readInProgress = true;
     m_state.operationStartTime = millis();
     m_state.sampleCount = 0;
-    m_state.samples.clear();
-    try {
-      m_state.samples.resize(numMeasurements);
-      // Pre-allocate inner vectors to avoid heap allocations during the
-      // time-critical fetchSample() calls which can trigger mallocs and
-      // contribute to watchdog resets. Reserve NUM_SAMPLES elements for
-      // each channel ahead of time.
-      for (size_t i = 0; i < m_state.samples.size(); ++i) {
-        m_state.samples[i].reserve(NUM_SAMPLES);
-      }
-    } catch (const std::exception& e) {
-      logger.error(getName(), F(": Failed to resize samples vector: ") + String(e.what()));
-      m_state.readInProgress = false;
-      return SensorResult::fail(SensorError::MEMORY_ERROR,
-                                F("Failed to allocate measurement memory"));
-    }
+    // Fixed-size accumulators: no heap allocation during fetchSample()
+    resetSampleStatistics(numMeasurements);
     m_state.measurementIndex = 0;
     m_state.sampleIndex = 0;
     m_state.measurementStarted = true;
@@ -479,7 +465,8 @@ SensorResult Sensor::performMeasurementCycle() {
         m_state.lastSampleTime = millis();
         return SensorResult::fail(SensorError::PENDING, "pending");
       }
-      m_state.samples[m_state.measurementIndex].push_back(value);
+      m_state.stats[m_state.measurementIndex].add(value);
+      m_state.sampleCount++;
       m_state.lastSampleTime = millis();
       m_state.sampleIndex++;
       // After each sample, return pending to allow nonblocking delay
@@ -493,10 +480,9 @@ SensorResult Sensor::performMeasurementCycle() {
   m_state.readInProgress = false;
   m_state.measurementStarted = false;
   // Defensive: If all samples are NaN, log and return error
-  std::vector<float> averages = averageSamples();
   size_t validCount = 0;
-  for (float v : averages) {
-    if (!isnan(v))
+  for (size_t i = 0; i < m_state.activeChannels; ++i) {
+    if (m_state.stats[i].count() > 0)
       validCount++;
   }
   if (validCount == 0) {
@@ -511,34 +497,46 @@ SensorResult Sensor::performMeasurementCycle() {
 }
 
 /**
- * @brief Computes the average of the collected samples for each channel
- * @return Vector of averaged values (one per channel)
+ * @brief Resets the per-channel accumulators for a new measurement cycle
+ * @param channels Number of channels used in the cycle
  */
-std::vector<float> Sensor::averageSamples() const {
-  std::vector<float> averages;
-  for (const auto& channelSamples : m_state.samples) {
-    if (channelSamples.empty()) {
-      averages.push_back(NAN);
-      continue;
-    }
-    float sum = 0.0f;
-    size_t count = 0;
-    for (float v : channelSamples) {
-      if (!isnan(v)) {
-        sum += v;
-        ++count;
-      }
-    }
-    averages.push_back(count > 0 ? sum / count : NAN);
+void Sensor::resetSampleStatistics(size_t channels) {
+  m_state.activeChannels = min(channels, SensorConfig::MAX_MEASUREMENTS);
+  for (auto& channelStats : m_state.stats) {
+    channelStats.reset();
   }
-  return averages;
 }
 
 /**
  * @brief Returns the averaged results for each measurement channel
- * @return Vector of averaged values (one per channel)
+ * @details Uses the aggregation mode configured per measurement (mean,
+ * median, trimmed mean or Hampel filter).
+ * @param results Output vector, one value per channel (NaN without valid samples)
+ */
+void Sensor::getAveragedResults(std::vector<float>& results) const {
+  results.clear();
+  const auto& measurements = config().measurements;
+  for (size_t i = 0; i < m_state.activeChannels; ++i) {
+    if (i < measurements.size()) {
+      const MeasurementConfig& meas = measurements[i];
+      float parameter = meas.aggregation == AggregationMode::HAMPEL ? meas.hampelThreshold
+                                                                     : meas.trimFraction;
+      results.push_back(SampleEstimators::aggregate(m_state.stats[i], meas.aggregation, parameter));
+    } else {
+      results.push_back(m_state.stats[i].mean());
+    }
+  }
+}
+
+/**
+ * @brief Returns the sample statistics of the last measurement cycle
+ * @param index Measurement index
+ * @return Accumulator of the channel (empty for out-of-range indices)
  */
-std::vector<float> Sensor::getAveragedResults() const { return averageSamples(); }
+const SampleAccumulator& Sensor::getSampleStatistics(size_t index) const {
+  static const SampleAccumulator empty{};
+  return index < m_state.activeChannels ? m_state.stats[index] : empty;
+}
 
 /**
  * @brief Helper to clear and shrink a std::vector (frees memory)
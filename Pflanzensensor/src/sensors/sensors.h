@@ -12,13 +12,21 @@
 
 #include "logger/logger.h"
 #include "sensor_config.h" // Ensure configuration macros are defined first
+#include "sensor_handle.h"
 #include "sensor_measurement_state.h"
+#include "sensor_statistics.h"
 #include "sensor_types.h"
 #include "utils/result_types.h"
 
 // Forward declaration
 class SensorManager;
 
+/**
+ * @brief Log a debug message of a sensor if sensor debug is enabled
+ * @details For use in Sensor members; the message is only built if it is logged.
+ */
+#define SENSOR_LOG_DEBUG(message) LOG_DEBUG_IF(ConfigMgr.isDebugSensor(), getName(), message)
+
 // --- Threshold utility declarations ---
 struct ThresholdDefaults {
   float yellowLow;
@@ -37,7 +45,9 @@ struct SensorMeasurementState {
   bool readInProgress = false;             ///< True if a measurement is in progress
   unsigned long operationStartTime = 0;    ///< When the measurement started
   size_t sampleCount = 0;                  ///< Number of samples collected
-  std::vector<std::vector<float>> samples; ///< [measurement][sample]
+  /// Per-channel streaming statistics of the current cycle
+  std::array<SampleAccumulator, SensorConfig::MAX_MEASUREMENTS> stats;
+  size_t activeChannels = 0;               ///< Channels in use in the current cycle
   unsigned long lastSampleTime = 0;        ///< Timestamp of last sample (for nonblocking delay)
   size_t measurementIndex = 0;             ///< Current measurement index in cycle
   size_t sampleIndex = 0;                  ///< Current sample index for measurement
@@ -57,6 +67,7 @@ public:
 protected:
   class SensorManager* m_sensorManager;                   ///< Reference to sensor manager
   String m_id;                                            ///< Local copy of sensor ID
+  SensorHandle m_handle{INVALID_SENSOR_HANDLE};           ///< Handle assigned by SensorFactory
   SensorConfig m_tempConfig;                              ///< Sensor configuration (stored locally)
   bool m_enabled{false};                                  ///< Whether the sensor is enabled
   bool m_initialized{false};                              ///< Whether the sensor is initialized
@@ -324,6 +335,18 @@ public:
    */
   const String& getId() const;
 
+  /**
+   * @brief Gets the sensor handle used on the measurement hot path
+   * @return Handle assigned by SensorFactory, INVALID_SENSOR_HANDLE before
+   */
+  inline SensorHandle getHandle() const { return m_handle; }
+
+  /**
+   * @brief Sets the sensor handle (called by SensorFactory)
+   * @param handle Handle from SensorRegistry::registerSensor()
+   */
+  inline void setHandle(SensorHandle handle) { m_handle = handle; }
+
   /**
    * @brief Gets sensor name
    * @return Sensor name string
@@ -383,9 +406,16 @@ public:
 
   /**
    * @brief Returns the averaged results for each measurement channel
-   * @return Vector of averaged values (one per channel)
+   * @param results Output vector, resized to the channel count (capacity is reused)
    */
-  virtual std::vector<float> getAveragedResults() const;
+  virtual void getAveragedResults(std::vector<float>& results) const;
+
+  /**
+   * @brief Returns the sample statistics of the last measurement cycle
+   * @param index Measurement index
+   * @return Accumulator of the channel (empty for out-of-range indices)
+   */
+  const SampleAccumulator& getSampleStatistics(size_t index) const;
 
   // Status manipulation
   /**
@@ -428,21 +458,22 @@ public:
   virtual SensorResult performMeasurementCycle();
 
   /**
-   * @brief Updates last measurement timestamp
+   * @brief Gets the millis() time at which the next sample may be taken
+   * @return lastSampleTime + minimumDelay during a running cycle, otherwise now
    */
-  void updateLastMeasurementTime();
+  unsigned long getNextSampleTime() const {
+    if (!m_state.measurementStarted || m_state.lastSampleTime == 0) {
+      return millis();
+    }
+    return m_state.lastSampleTime + config().minimumDelay;
+  }
 
-protected:
   /**
-   * @brief Log a debug message if sensor debug is enabled
-   * @param msg The message to log
+   * @brief Updates last measurement timestamp
    */
-  inline void logDebug(const String& msg) const {
-    if (ConfigMgr.isDebugSensor()) {
-      logger.debug(getName(), msg);
-    }
-  }
+  void updateLastMeasurementTime();
 
+protected:
   /**
    * @brief Log sensor-specific debug details (override in derived classes)
    */
@@ -481,10 +512,10 @@ protected:
   virtual bool fetchSample(float& value, size_t index) = 0;
 
   /**
-   * @brief Computes the average of the collected samples for each channel
-   * @return Vector of averaged values (one per channel)
+   * @brief Resets the per-channel accumulators for a new measurement cycle
+   * @param channels Number of channels used in the cycle
    */
-  std::vector<float> averageSamples() const;
+  void resetSampleStatistics(size_t channels);
 
   SensorMeasurementState m_state; ///< Generic measurement state
 };
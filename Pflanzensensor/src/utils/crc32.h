@@ -0,0 +1,33 @@
+/**
+ * @file crc32.h
+ * @brief CRC32 (IEEE 802.3) checksum helpers
+ */
+
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <Arduino.h>
+
+/// Initial running CRC state for updateCRC32()
+static constexpr uint32_t CRC32_INITIAL = 0xFFFFFFFF;
+
+/**
+ * @brief Feed data into a running CRC32 state
+ * @param crc Running state (start with CRC32_INITIAL)
+ * @param data Data to add
+ * @param length Number of bytes
+ * @return Updated running state; finish with ~state
+ */
+uint32_t updateCRC32(uint32_t crc, const uint8_t* data, size_t length);
+
+/**
+ * @brief Calculate the CRC32 of a buffer
+ * @param data Data to checksum
+ * @param length Number of bytes
+ * @return CRC32 value
+ */
+inline uint32_t calculateCRC32(const uint8_t* data, size_t length) {
+  return ~updateCRC32(CRC32_INITIAL, data, length);
+}
+
+#endif // CRC32_H
@@ -0,0 +1,190 @@
+/**
+ * @file file_io_queue.cpp
+ * @brief Implementation of the central LittleFS write queue
+ */
+
+#include "utils/file_io_queue.h"
+
+#include <LittleFS.h>
+
+#include <algorithm>
+
+#include "logger/logger.h"
+
+bool FileIoQueue::append(const char* path, const String& data) {
+  return enqueue(path, data, false);
+}
+
+bool FileIoQueue::write(const char* path, const String& content) {
+  return enqueue(path, content, true);
+}
+
+int FileIoQueue::findPending(const char* path) const {
+  for (size_t i = 0; i < m_pending.size(); i++) {
+    if (m_pending[i].path == path) {
+      return static_cast<int>(i);
+    }
+  }
+  return -1;
+}
+
+bool FileIoQueue::enqueue(const char* path, const String& data, bool replace) {
+  m_stats.intents++;
+  int index = findPending(path);
+  if (index >= 0) {
+    // Group commit: the intent joins the pending write of the same file
+    PendingWrite& pending = m_pending[index];
+    if (replace) {
+      m_stats.pendingBytes -= pending.data.length();
+      pending.data = data;
+      pending.replace = true;
+    } else {
+      pending.data += data;
+    }
+    m_stats.coalesced++;
+  } else {
+    m_pending.push_back(PendingWrite{String(path), data, replace, millis()});
+  }
+  m_stats.pendingBytes += data.length();
+  m_stats.depth = m_pending.size();
+  m_stats.maxDepth = std::max(m_stats.maxDepth, m_stats.depth);
+
+  // Make room by writing the oldest files early. While a write is running
+  // (e.g. the logger reporting a failed write) the intent is only queued.
+  bool success = true;
+  while (!m_writing && !m_pending.empty() &&
+         (m_stats.pendingBytes > FILE_IO_QUEUE_MAX_BYTES ||
+          m_pending.size() > FILE_IO_QUEUE_MAX_FILES)) {
+    bool own = m_pending.front().path == path;
+    m_stats.forcedWrites++;
+    if (!writeAt(0) && own) {
+      success = false;
+    }
+  }
+  return success;
+}
+
+bool FileIoQueue::writeFile(const PendingWrite& pending) {
+  File file = LittleFS.open(pending.path, pending.replace ? "w" : "a");
+  if (!file) {
+    return false;
+  }
+  size_t written =
+      file.write(reinterpret_cast<const uint8_t*>(pending.data.c_str()), pending.data.length());
+  file.close();
+  return written == pending.data.length();
+}
+
+bool FileIoQueue::writeAt(size_t index) {
+  // Taken out of the queue first, so intents queued meanwhile start a new write
+  PendingWrite pending = std::move(m_pending[index]);
+  m_pending.erase(m_pending.begin() + index);
+  m_stats.pendingBytes -= pending.data.length();
+  m_stats.depth = m_pending.size();
+
+  m_writing = true;
+  bool success = writeFile(pending);
+  m_writing = false;
+
+  uint32_t latency = millis() - pending.queuedAt;
+  m_stats.writes++;
+  m_stats.lastLatencyMs = latency;
+  m_stats.maxLatencyMs = std::max(m_stats.maxLatencyMs, latency);
+  m_stats.totalLatencyMs += latency;
+  accountFile(pending.path.c_str(), pending.data.length(), success);
+  return success;
+}
+
+void FileIoQueue::accountFile(const char* path, size_t bytes, bool success) {
+  FileStats* stats = nullptr;
+  for (auto& entry : m_fileStats) {
+    if (strcmp(entry.path, path) == 0) {
+      stats = &entry;
+      break;
+    }
+  }
+  if (!stats && m_fileStats.size() < STATS_FILE_COUNT) {
+    FileStats entry{};
+    strncpy(entry.path, path, sizeof(entry.path) - 1);
+    m_fileStats.push_back(entry);
+    stats = &m_fileStats.back();
+  }
+
+  if (success) {
+    if (stats) {
+      stats->bytes += bytes;
+      stats->writes++;
+      stats->failed = false;
+    }
+    return;
+  }
+
+  m_stats.failedWrites++;
+  // Only the first failure in a row is logged: a failing log file would
+  // otherwise queue a new error line with every write
+  bool report = !stats || !stats->failed;
+  if (stats) {
+    stats->failed = true;
+  }
+  if (report) {
+    logger.error(F("FileIO"), F("Schreiben fehlgeschlagen: ") + String(path) + F(" (") +
+                                  String(bytes) + F(" Bytes)"));
+  }
+}
+
+void FileIoQueue::process(bool clientPending) {
+  if (m_pending.empty() || m_writing) {
+    return;
+  }
+
+  // Requests are served first, unless the oldest write has waited too long
+  unsigned long start = millis();
+  if (clientPending && start - m_pending.front().queuedAt < FILE_IO_MAX_DELAY_MS) {
+    return;
+  }
+
+  // The oldest file first; at least one write per slice, so the queue drains
+  do {
+    writeAt(0);
+    yield();
+  } while (!m_pending.empty() && millis() - start < FILE_IO_SLICE_MS);
+}
+
+void FileIoQueue::flush(const char* path) {
+  if (m_writing) {
+    return;
+  }
+  int index = findPending(path);
+  if (index >= 0) {
+    writeAt(index);
+  }
+}
+
+void FileIoQueue::flushAll() {
+  if (m_writing) {
+    return;
+  }
+  // Logged before the hooks run, so the logger's hook moves the line into
+  // the queue and it is written as well
+  if (!m_pending.empty()) {
+    LOG_DEBUG(F("FileIO"),
+              F("Schreibe ") + String(m_pending.size()) + F(" ausstehende Dateien"));
+  }
+  for (FlushHook hook : m_flushHooks) {
+    hook();
+  }
+
+  while (!m_pending.empty()) {
+    writeAt(0);
+    yield();
+  }
+}
+
+void FileIoQueue::addFlushHook(FlushHook hook) {
+  for (FlushHook existing : m_flushHooks) {
+    if (existing == hook) {
+      return;
+    }
+  }
+  m_flushHooks.push_back(hook);
+}
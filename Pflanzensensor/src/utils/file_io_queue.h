@@ -0,0 +1,178 @@
+/**
+ * @file file_io_queue.h
+ * @brief Central write queue for small LittleFS files
+ * @details Modules hand their writes to the queue as intents ("append these
+ *          bytes", "replace the file with this content") instead of writing
+ *          synchronously. Intents for the same file are merged in RAM, so a
+ *          burst of log lines becomes one append. The queue is worked off
+ *          from loop() in bounded time slices while no HTTP client is being
+ *          served, and flushAll() writes everything before a reboot or an OTA
+ *          update. Data still in the queue is lost on a power failure.
+ */
+#ifndef FILE_IO_QUEUE_H
+#define FILE_IO_QUEUE_H
+
+#include <Arduino.h>
+
+#include <vector>
+
+#include "configs/config.h"
+
+// Check if FILE_IO_QUEUE_MAX_BYTES is defined
+#ifndef FILE_IO_QUEUE_MAX_BYTES
+#define FILE_IO_QUEUE_MAX_BYTES 4096
+#warning "FILE_IO_QUEUE_MAX_BYTES not defined in config file, defaulting to 4096 bytes"
+#endif
+
+// Check if FILE_IO_QUEUE_MAX_FILES is defined
+#ifndef FILE_IO_QUEUE_MAX_FILES
+#define FILE_IO_QUEUE_MAX_FILES 8
+#warning "FILE_IO_QUEUE_MAX_FILES not defined in config file, defaulting to 8 files"
+#endif
+
+// Check if FILE_IO_SLICE_MS is defined
+#ifndef FILE_IO_SLICE_MS
+#define FILE_IO_SLICE_MS 20
+#warning "FILE_IO_SLICE_MS not defined in config file, defaulting to 20 ms"
+#endif
+
+// Check if FILE_IO_MAX_DELAY_MS is defined
+#ifndef FILE_IO_MAX_DELAY_MS
+#define FILE_IO_MAX_DELAY_MS 2000
+#warning "FILE_IO_MAX_DELAY_MS not defined in config file, defaulting to 2000 ms"
+#endif
+
+/**
+ * @class FileIoQueue
+ * @brief Singleton collecting file writes and executing them from loop()
+ * @details A reader of a queued file calls flush() for that path first, so
+ *          it sees its own writes. Modules that buffer data themselves
+ *          (e.g. SensorPersistence) register a flush hook that flushAll()
+ *          runs before the queue is drained.
+ */
+class FileIoQueue {
+public:
+  /// Files with their own byte counters in the statistics
+  static constexpr size_t STATS_FILE_COUNT = 8;
+
+  /// Writes the data a module buffers itself
+  using FlushHook = void (*)();
+
+  /**
+   * @brief Queue statistics since boot
+   */
+  struct Stats {
+    uint32_t depth{0};          ///< Files with pending writes
+    uint32_t maxDepth{0};       ///< Highest depth seen
+    uint32_t pendingBytes{0};   ///< Bytes waiting in RAM
+    uint32_t intents{0};        ///< append() and write() calls
+    uint32_t coalesced{0};      ///< Intents merged into a pending write
+    uint32_t writes{0};         ///< File writes executed
+    uint32_t forcedWrites{0};   ///< Writes executed early because the queue was full
+    uint32_t failedWrites{0};   ///< Writes that failed
+    uint32_t lastLatencyMs{0};  ///< Time from the first intent to the write, last write
+    uint32_t maxLatencyMs{0};   ///< Highest latency seen
+    uint32_t totalLatencyMs{0}; ///< Sum of all latencies, for the average
+  };
+
+  /**
+   * @brief Bytes written per file
+   */
+  struct FileStats {
+    char path[32];
+    uint32_t bytes;
+    uint32_t writes;
+    bool failed; ///< The last write failed; further failures are not logged
+  };
+
+  /**
+   * @brief Gets the singleton instance
+   * @return Reference to the singleton instance
+   */
+  static FileIoQueue& getInstance() {
+    static FileIoQueue instance;
+    return instance;
+  }
+
+  /**
+   * @brief Queue bytes to be appended to a file
+   * @param path File path
+   * @param data Bytes to append
+   * @return false if the data had to be written at once and that failed
+   */
+  bool append(const char* path, const String& data);
+
+  /**
+   * @brief Queue the new content of a file
+   * @details Replaces every pending write of the same file.
+   * @param path File path
+   * @param content Complete file content
+   * @return false if the content had to be written at once and that failed
+   */
+  bool write(const char* path, const String& content);
+
+  /**
+   * @brief Execute pending writes for at most FILE_IO_SLICE_MS
+   * @param clientPending Whether an HTTP client is being served; writes then
+   *        wait until the oldest one is FILE_IO_MAX_DELAY_MS old
+   */
+  void process(bool clientPending);
+
+  /**
+   * @brief Write the pending data of one file now
+   * @param path File path
+   */
+  void flush(const char* path);
+
+  /**
+   * @brief Run all flush hooks and write every pending file now
+   */
+  void flushAll();
+
+  /**
+   * @brief Register a hook that flushAll() runs first
+   * @param hook Function writing the data a module buffers itself
+   */
+  void addFlushHook(FlushHook hook);
+
+  /**
+   * @brief Get the queue statistics
+   * @return Statistics since boot
+   */
+  const Stats& getStats() const { return m_stats; }
+
+  /**
+   * @brief Get the per-file statistics
+   * @return Files written since boot, at most STATS_FILE_COUNT
+   */
+  const std::vector<FileStats>& getFileStats() const { return m_fileStats; }
+
+private:
+  FileIoQueue() = default;
+  FileIoQueue(const FileIoQueue&) = delete;
+  FileIoQueue& operator=(const FileIoQueue&) = delete;
+
+  /**
+   * @brief Pending write of one file
+   */
+  struct PendingWrite {
+    String path;
+    String data;
+    bool replace;           ///< Truncate the file before writing
+    unsigned long queuedAt; ///< Time of the first merged intent
+  };
+
+  bool enqueue(const char* path, const String& data, bool replace);
+  int findPending(const char* path) const;
+  bool writeAt(size_t index);
+  bool writeFile(const PendingWrite& pending);
+  void accountFile(const char* path, size_t bytes, bool success);
+
+  std::vector<PendingWrite> m_pending;
+  std::vector<FlushHook> m_flushHooks;
+  std::vector<FileStats> m_fileStats;
+  Stats m_stats;
+  bool m_writing{false};
+};
+
+#endif // FILE_IO_QUEUE_H
@@ -6,105 +6,277 @@
 #include "flash_persistence.h"
 #include "../logger/logger.h"
 #include "../managers/manager_config_preferences.h"
+#include "../managers/manager_sensor_persistence.h"
+#include "crc32.h"
 #include "critical_section.h"
 #include <ESP8266WiFi.h>
 
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <new>
+
 #ifdef USE_WEBSERVER
 #include <LittleFS.h>
 #endif
 
-// CRC32 lookup table (same as before)
-static const uint32_t crc32_table[256] PROGMEM = {
-    0x00000000, 0x77073096, 0xee0e612c, 0x990951ba, 0x076dc419, 0x706af48f, 0xe963a535, 0x9e6495a3,
-    0x0edb8832, 0x79dcb8a4, 0xe0d5e91e, 0x97d2d988, 0x09b64c2b, 0x7eb17cbd, 0xe7b82d07, 0x90bf1d91,
-    0x1db71064, 0x6ab020f2, 0xf3b97148, 0x84be41de, 0x1adad47d, 0x6ddde4eb, 0xf4d4b551, 0x83d385c7,
-    0x136c9856, 0x646ba8c0, 0xfd62f97a, 0x8a65c9ec, 0x14015c4f, 0x63066cd9, 0xfa0f3d63, 0x8d080df5,
-    0x3b6e20c8, 0x4c69105e, 0xd56041e4, 0xa2677172, 0x3c03e4d1, 0x4b04d447, 0xd20d85fd, 0xa50ab56b,
-    0x35b5a8fa, 0x42b2986c, 0xdbbbc9d6, 0xacbcf940, 0x32d86ce3, 0x45df5c75, 0xdcd60dcf, 0xabd13d59,
-    0x26d930ac, 0x51de003a, 0xc8d75180, 0xbfd06116, 0x21b4f4b5, 0x56b3c423, 0xcfba9599, 0xb8bda50f,
-    0x2802b89e, 0x5f058808, 0xc60cd9b2, 0xb10be924, 0x2f6f7c87, 0x58684c11, 0xc1611dab, 0xb6662d3d,
-    0x76dc4190, 0x01db7106, 0x98d220bc, 0xefd5102a, 0x71b18589, 0x06b6b51f, 0x9fbfe4a5, 0xe8b8d433,
-    0x7807c9a2, 0x0f00f934, 0x9609a88e, 0xe10e9818, 0x7f6a0dbb, 0x086d3d2d, 0x91646c97, 0xe6635c01,
-    0x6b6b51f4, 0x1c6c6162, 0x856530d8, 0xf262004e, 0x6c0695ed, 0x1b01a57b, 0x8208f4c1, 0xf50fc457,
-    0x65b0d9c6, 0x12b7e950, 0x8bbeb8ea, 0xfcb9887c, 0x62dd1ddf, 0x15da2d49, 0x8cd37cf3, 0xfbd44c65,
-    0x4db26158, 0x3ab551ce, 0xa3bc0074, 0xd4bb30e2, 0x4adfa541, 0x3dd895d7, 0xa4d1c46d, 0xd3d6f4fb,
-    0x4369e96a, 0x346ed9fc, 0xad678846, 0xda60b8d0, 0x44042d73, 0x33031de5, 0xaa0a4c5f, 0xdd0d7cc9,
-    0x5005713c, 0x270241aa, 0xbe0b1010, 0xc90c2086, 0x5768b525, 0x206f85b3, 0xb966d409, 0xce61e49f,
-    0x5edef90e, 0x29d9c998, 0xb0d09822, 0xc7d7a8b4, 0x59b33d17, 0x2eb40d81, 0xb7bd5c3b, 0xc0ba6cad,
-    0xedb88320, 0x9abfb3b6, 0x03b6e20c, 0x74b1d29a, 0xead54739, 0x9dd277af, 0x04db2615, 0x73dc1683,
-    0xe3630b12, 0x94643b84, 0x0d6d6a3e, 0x7a6a5aa8, 0xe40ecf0b, 0x9309ff9d, 0x0a00ae27, 0x7d079eb1,
-    0xf00f9344, 0x8708a3d2, 0x1e01f268, 0x6906c2fe, 0xf762575d, 0x806567cb, 0x196c3671, 0x6e6b06e7,
-    0xfed41b76, 0x89d32be0, 0x10da7a5a, 0x67dd4acc, 0xf9b9df6f, 0x8ebeeff9, 0x17b7be43, 0x60b08ed5,
-    0xd6d6a3e8, 0xa1d1937e, 0x38d8c2c4, 0x4fdff252, 0xd1bb67f1, 0xa6bc5767, 0x3fb506dd, 0x48b2364b,
-    0xd80d2bda, 0xaf0a1b4c, 0x36034af6, 0x41047a60, 0xdf60efc3, 0xa867df55, 0x316e8eef, 0x4669be79,
-    0xcb61b38c, 0xbc66831a, 0x256fd2a0, 0x5268e236, 0xcc0c7795, 0xbb0b4703, 0x220216b9, 0x5505262f,
-    0xc5ba3bbe, 0xb2bd0b28, 0x2bb45a92, 0x5cb36a04, 0xc2d7ffa7, 0xb5d0cf31, 0x2cd99e8b, 0x5bdeae1d,
-    0x9b64c2b0, 0xec63f226, 0x756aa39c, 0x026d930a, 0x9c0906a9, 0xeb0e363f, 0x72076785, 0x05005713,
-    0x95bf4a82, 0xe2b87a14, 0x7bb12bae, 0x0cb61b38, 0x92d28e9b, 0xe5d5be0d, 0x7cdcefb7, 0x0bdbdf21,
-    0x86d3d2d4, 0xf1d4e242, 0x68ddb3f8, 0x1fda836e, 0x81be16cd, 0xf6b9265b, 0x6fb077e1, 0x18b74777,
-    0x88085ae6, 0xff0f6a70, 0x66063bca, 0x11010b5c, 0x8f659eff, 0xf862ae69, 0x616bffd3, 0x166ccf45,
-    0xa00ae278, 0xd70dd2ee, 0x4e048354, 0x3903b3c2, 0xa7672661, 0xd06016f7, 0x4969474d, 0x3e6e77db,
-    0xaed16a4a, 0xd9d65adc, 0x40df0b66, 0x37d83bf0, 0xa9bcae53, 0xdebb9ec5, 0x47b2cf7f, 0x30b5ffe9,
-    0xbdbdf21c, 0xcabac28a, 0x53b39330, 0x24b4a3a6, 0xbad03605, 0xcdd70693, 0x54de5729, 0x23d967bf,
-    0xb3667a2e, 0xc4614ab8, 0x5d681b02, 0x2a6f2b94, 0xb40bbe37, 0xc30c8ea1, 0x5a05df1b, 0x2d02ef8d};
+namespace {
 
-uint32_t FlashPersistence::calculateCRC32(const uint8_t* data, size_t length) {
-  uint32_t crc = 0xFFFFFFFF;
-  for (size_t i = 0; i < length; i++) {
-    uint8_t index = (crc ^ data[i]) & 0xFF;
-    crc = (crc >> 8) ^ pgm_read_dword(&crc32_table[index]);
+FlashPersistence::Stats s_stats;
+
+/**
+ * @brief Receives the backup image as a byte stream
+ */
+class ImageSink {
+public:
+  virtual ~ImageSink() = default;
+  virtual bool write(const uint8_t* data, size_t length) = 0;
+
+  uint32_t crc() const { return ~m_crc; }
+  uint32_t size() const { return m_size; }
+
+protected:
+  void account(const uint8_t* data, size_t length) {
+    m_crc = updateCRC32(m_crc, data, length);
+    m_size += length;
   }
-  return ~crc;
-}
 
-uint32_t FlashPersistence::getSafeOffset() {
-  uint32_t sketchSize = ESP.getSketchSize();
-  uint32_t safeOffset =
-      ((sketchSize + FP_FLASH_SECTOR_SIZE - 1) / FP_FLASH_SECTOR_SIZE + FP_SAFETY_MARGIN_SECTORS) *
-      FP_FLASH_SECTOR_SIZE;
+private:
+  uint32_t m_crc{CRC32_INITIAL};
+  uint32_t m_size{0};
+};
+
+// Only checksums the image, to detect an unchanged backup before writing
+class CrcSink : public ImageSink {
+public:
+  bool write(const uint8_t* data, size_t length) override {
+    account(data, length);
+    return true;
+  }
+};
 
-  uint32_t sketchEnd = ESP.getFreeSketchSpace() + sketchSize;
-  if (safeOffset + FP_PREFS_MAX_SIZE > sketchEnd) {
-    logger.error(F("FlashPers"), F("Nicht genug Flash-Speicher"));
-    return 0;
+// Collects the image sector by sector and programs only sectors that differ
+class SectorWriter : public ImageSink {
+public:
+  SectorWriter(uint32_t offset, uint32_t capacity, uint32_t* sector, uint32_t sectorSize)
+      : m_offset(offset), m_capacity(capacity), m_sector(sector), m_sectorSize(sectorSize) {}
+
+  bool write(const uint8_t* data, size_t length) override {
+    if (size() + length > m_capacity) {
+      return false;
+    }
+    account(data, length);
+    uint8_t* buffer = reinterpret_cast<uint8_t*>(m_sector);
+    while (length > 0) {
+      size_t chunk = std::min(length, static_cast<size_t>(m_sectorSize - m_fill));
+      memcpy(buffer + m_fill, data, chunk);
+      m_fill += chunk;
+      data += chunk;
+      length -= chunk;
+      if (m_fill == m_sectorSize && !flushSector()) {
+        return false;
+      }
+    }
+    return true;
   }
 
-  return safeOffset;
-}
+  // Write the last, partly filled sector
+  bool finish() { return m_fill == 0 || flushSector(); }
 
-uint32_t FlashPersistence::getJsonStorageOffset() {
-  uint32_t prefsOffset = getSafeOffset();
-  if (prefsOffset == 0) {
-    return 0;
+  uint32_t sectorsErased() const { return m_sectorsErased; }
+  uint32_t sectorsUnchanged() const { return m_sectorsUnchanged; }
+
+private:
+  bool flushSector() {
+    // Unused bytes stay in the erased state
+    memset(reinterpret_cast<uint8_t*>(m_sector) + m_fill, 0xFF, m_sectorSize - m_fill);
+    m_fill = 0;
+
+    uint32_t address = m_offset + m_sectorIndex * m_sectorSize;
+    m_sectorIndex++;
+
+    // Compare with the flash content in small reads; equal sectors are skipped
+    bool equal = true;
+    uint32_t current[64];
+    for (uint32_t pos = 0; pos < m_sectorSize && equal; pos += sizeof(current)) {
+      if (!ESP.flashRead(address + pos, current, sizeof(current))) {
+        equal = false;
+        break;
+      }
+      equal = memcmp(current, reinterpret_cast<uint8_t*>(m_sector) + pos, sizeof(current)) == 0;
+    }
+    if (equal) {
+      m_sectorsUnchanged++;
+      return true;
+    }
+
+    {
+      CriticalSection cs;
+      if (!ESP.flashEraseSector(address / m_sectorSize) ||
+          !ESP.flashWrite(address, m_sector, m_sectorSize)) {
+        return false;
+      }
+    }
+    m_sectorsErased++;
+    yield();
+    return true;
   }
 
-  // JSON storage starts after preferences area
-  uint32_t jsonOffset = prefsOffset + FP_PREFS_MAX_SIZE;
+  uint32_t m_offset;
+  uint32_t m_capacity;
+  uint32_t* m_sector;
+  uint32_t m_sectorSize;
+  uint32_t m_fill{0};
+  uint32_t m_sectorIndex{0};
+  uint32_t m_sectorsErased{0};
+  uint32_t m_sectorsUnchanged{0};
+};
+
+// Sequential reader over flash; the flash is read in aligned 256-byte blocks
+class FlashReader {
+public:
+  explicit FlashReader(uint32_t offset)
+      : m_offset(offset & ~(sizeof(m_buffer) - 1)), m_skip(offset & (sizeof(m_buffer) - 1)) {}
+
+  bool read(uint8_t* data, size_t length) {
+    uint8_t* buffer = reinterpret_cast<uint8_t*>(m_buffer);
+    while (length > 0) {
+      if (m_pos == sizeof(m_buffer)) {
+        if (!ESP.flashRead(m_offset, m_buffer, sizeof(m_buffer))) {
+          return false;
+        }
+        m_offset += sizeof(m_buffer);
+        m_pos = m_skip;
+        m_skip = 0;
+      }
+      size_t chunk = std::min(length, sizeof(m_buffer) - m_pos);
+      memcpy(data, buffer + m_pos, chunk);
+      m_pos += chunk;
+      data += chunk;
+      length -= chunk;
+    }
+    return true;
+  }
 
-  uint32_t sketchSize = ESP.getSketchSize();
-  uint32_t sketchEnd = ESP.getFreeSketchSpace() + sketchSize;
+private:
+  uint32_t m_buffer[64];
+  uint32_t m_offset;
+  size_t m_skip;
+  size_t m_pos{sizeof(m_buffer)};
+};
 
-  if (jsonOffset + FP_JSON_MAX_SIZE > sketchEnd) {
-    logger.error(F("FlashPers"), F("Nicht genug Flash für JSON-Speicher"));
-    return 0;
+// Longest "namespace:key=value" line, as read back by LineReader
+constexpr size_t FP_LINE_MAX = 256;
+
+/**
+ * @brief Streams "namespace:key=value" lines into an ImageSink
+ * @details The parts of a line are handed to the sink directly, so no line
+ *          and no text is assembled in RAM.
+ */
+class TextEncoder {
+public:
+  explicit TextEncoder(ImageSink& sink) : m_sink(sink) {}
+
+  void put(const char* ns, const char* key, const char* value) {
+    // A longer line would be cut by the restore, so the backup fails instead
+    if (strlen(ns) + strlen(key) + strlen(value) + 2 >= FP_LINE_MAX) {
+      m_ok = false;
+      return;
+    }
+    text(ns);
+    text(":");
+    text(key);
+    text("=");
+    text(value);
+    text("\n");
   }
 
-  return jsonOffset;
-}
+  void putBool(const char* ns, const char* key, bool value) { put(ns, key, value ? "1" : "0"); }
 
-ResourceResult FlashPersistence::saveToFlash() {
-  logger.info(F("FlashPers"), F("Speichere Preferences als Text..."));
+  void putUInt(const char* ns, const char* key, uint32_t value) {
+    char buffer[12];
+    ultoa(value, buffer, 10);
+    put(ns, key, buffer);
+  }
 
-  uint32_t offset = getSafeOffset();
-  if (offset == 0) {
-    return ResourceResult::fail(ResourceError::INSUFFICIENT_SPACE, F("No flash space"));
+  void putInt(const char* ns, const char* key, int32_t value) {
+    char buffer[12];
+    ltoa(value, buffer, 10);
+    put(ns, key, buffer);
   }
 
-  // Build simple text format: "namespace:key=value\n"
-  // This is done OUTSIDE critical section (WiFi still active, safe)
-  String textData;
-  textData.reserve(8192); // Pre-allocate to reduce fragmentation
+  // Same text as String(float): two decimals, "inf"/"-inf" for the range limits
+  void putFloat(const char* ns, const char* key, float value) {
+    char buffer[24];
+    dtostrf(value, 0, 2, buffer);
+    put(ns, key, buffer);
+  }
 
+  void text(const char* text) {
+    if (m_ok && !m_sink.write(reinterpret_cast<const uint8_t*>(text), strlen(text))) {
+      m_ok = false;
+    }
+  }
+
+  bool ok() const { return m_ok; }
+
+private:
+  ImageSink& m_sink;
+  bool m_ok{true};
+};
+
+/**
+ * @brief Splits a flash region into lines, parsed in place in a fixed buffer
+ * @details Line ends ("\n" or "\r") are dropped and empty lines skipped. A
+ *          line longer than the buffer is returned in pieces.
+ */
+class LineReader {
+public:
+  LineReader(FlashReader& reader, uint32_t length) : m_reader(reader), m_remaining(length) {}
+
+  /**
+   * @brief Read the next line
+   * @return The zero-terminated line, valid until the next call, or nullptr
+   *         at the end of the region or on a read error
+   */
+  char* next() {
+    size_t length = 0;
+    while (m_remaining > 0) {
+      uint8_t c;
+      if (!m_reader.read(&c, 1)) {
+        m_failed = true;
+        return nullptr;
+      }
+      m_remaining--;
+      if (c == '\n' || c == '\r') {
+        if (length > 0) {
+          break;
+        }
+        continue;
+      }
+      m_line[length++] = static_cast<char>(c);
+      if (length == sizeof(m_line) - 1) {
+        break;
+      }
+    }
+    if (length == 0) {
+      return nullptr;
+    }
+    m_line[length] = '\0';
+    return m_line;
+  }
+
+  bool failed() const { return m_failed; }
+
+private:
+  FlashReader& m_reader;
+  uint32_t m_remaining;
+  char m_line[FP_LINE_MAX];
+  bool m_failed{false};
+};
+
+// Encode all known Preferences as "namespace:key=value" lines
+void encodePrefs(TextEncoder& out) {
   Preferences prefs;
 
   // List of all namespaces to backup
@@ -113,73 +285,59 @@ ResourceResult FlashPersistence::saveToFlash() {
                               PreferencesNamespaces::DISP,    PreferencesNamespaces::DEBUG,
                               PreferencesNamespaces::LOG,     PreferencesNamespaces::LED_TRAFFIC};
 
-  // Export each namespace
-  for (const char* ns : namespaces) {
-    if (!prefs.begin(ns, true))
-      continue;
+  // Export each namespace; the values come from the Preferences cache, so no
+  // namespace has to be opened for the backup
+  auto putString = [&out](const char* ns, const char* key, const char* defaultValue) {
+    out.put(ns, key, PreferencesManager::getString(ns, key, defaultValue).c_str());
+  };
+  auto putBool = [&out](const char* ns, const char* key, bool defaultValue) {
+    out.putBool(ns, key, PreferencesManager::getBool(ns, key, defaultValue));
+  };
 
+  for (const char* ns : namespaces) {
     // Get all keys (Preferences library limitation - we know the keys)
+    out.put(ns, "initialized", "1"); // Marker key for namespace existence
+
     // For general namespace
     if (strcmp(ns, PreferencesNamespaces::GENERAL) == 0) {
-      textData += String(ns) + ":initialized=1\n"; // Marker key for namespace existence
-      textData += String(ns) + ":device_name=" + prefs.getString("device_name", "") + "\n";
-      textData += String(ns) + ":admin_pwd=" + prefs.getString("admin_pwd", "") + "\n";
-      textData += String(ns) +
-                  ":md5_verify=" + String(prefs.getBool("md5_verify", false) ? "1" : "0") + "\n";
-      textData +=
-          String(ns) + ":file_log=" + String(prefs.getBool("file_log", false) ? "1" : "0") + "\n";
-      textData += String(ns) + ":flower_sens=" + prefs.getString("flower_sens", "") + "\n";
+      putString(ns, "device_name", "");
+      putString(ns, "admin_pwd", "");
+      putBool(ns, "md5_verify", false);
+      putBool(ns, "file_log", false);
+      putString(ns, "flower_sens", "");
     }
     // For WiFi namespaces
     else if (strncmp(ns, "wifi", 4) == 0) {
-      textData += String(ns) + ":initialized=1\n";
-      textData += String(ns) + ":ssid=" + prefs.getString("ssid", "") + "\n";
-      textData += String(ns) + ":pwd=" + prefs.getString("pwd", "") + "\n";
+      putString(ns, "ssid", "");
+      putString(ns, "pwd", "");
     }
     // For display namespace
     else if (strcmp(ns, PreferencesNamespaces::DISP) == 0) {
-      textData += String(ns) + ":initialized=1\n";
-      textData +=
-          String(ns) + ":show_ip=" + String(prefs.getBool("show_ip", true) ? "1" : "0") + "\n";
-      textData += String(ns) +
-                  ":show_clock=" + String(prefs.getBool("show_clock", true) ? "1" : "0") + "\n";
-      textData += String(ns) +
-                  ":show_flower=" + String(prefs.getBool("show_flower", true) ? "1" : "0") + "\n";
-      textData += String(ns) +
-                  ":show_fabmobil=" + String(prefs.getBool("show_fabmobil", true) ? "1" : "0") +
-                  "\n";
-      textData += String(ns) + ":screen_dur=" + String(prefs.getUInt("screen_dur", 5)) + "\n";
-      textData += String(ns) + ":clock_fmt=" + prefs.getString("clock_fmt", "24h") + "\n";
+      putBool(ns, "show_ip", true);
+      putBool(ns, "show_clock", true);
+      putBool(ns, "show_flower", true);
+      putBool(ns, "show_fabmobil", true);
+      out.putUInt(ns, "screen_dur", PreferencesManager::getUInt(ns, "screen_dur", 5));
+      putString(ns, "clock_fmt", "24h");
     }
     // For debug namespace
     else if (strcmp(ns, PreferencesNamespaces::DEBUG) == 0) {
-      textData += String(ns) + ":initialized=1\n";
-      textData += String(ns) + ":ram=" + String(prefs.getBool("ram", false) ? "1" : "0") + "\n";
-      textData += String(ns) +
-                  ":meas_cycle=" + String(prefs.getBool("meas_cycle", false) ? "1" : "0") + "\n";
-      textData +=
-          String(ns) + ":sensor=" + String(prefs.getBool("sensor", false) ? "1" : "0") + "\n";
-      textData +=
-          String(ns) + ":display=" + String(prefs.getBool("display", false) ? "1" : "0") + "\n";
-      textData +=
-          String(ns) + ":websocket=" + String(prefs.getBool("websocket", false) ? "1" : "0") + "\n";
+      putBool(ns, "ram", false);
+      putBool(ns, "meas_cycle", false);
+      putBool(ns, "sensor", false);
+      putBool(ns, "display", false);
+      putBool(ns, "websocket", false);
     }
     // For log namespace
     else if (strcmp(ns, PreferencesNamespaces::LOG) == 0) {
-      textData += String(ns) + ":initialized=1\n";
-      textData += String(ns) + ":level=" + prefs.getString("level", "INFO") + "\n";
-      textData += String(ns) +
-                  ":file_enabled=" + String(prefs.getBool("file_enabled", false) ? "1" : "0") +
-                  "\n";
+      putString(ns, "level", "INFO");
+      putBool(ns, "file_enabled", false);
     }
     // For LED traffic namespace
     else if (strcmp(ns, PreferencesNamespaces::LED_TRAFFIC) == 0) {
-      textData += String(ns) + ":initialized=1\n";
-      textData += String(ns) + ":mode=" + String(prefs.getUChar("mode", 0)) + "\n";
-      textData += String(ns) + ":sel_meas=" + prefs.getString("sel_meas", "") + "\n";
+      out.putUInt(ns, "mode", PreferencesManager::getUChar(ns, "mode", 0));
+      putString(ns, "sel_meas", "");
     }
-
-    prefs.end();
   }
 
   // Also backup sensor namespaces (dynamic: s_SENSORID)
@@ -187,11 +345,10 @@ ResourceResult FlashPersistence::saveToFlash() {
   const char* knownSensors[] = {"ANALOG", "DHT", "DHT22"};
 
   for (const char* sensorId : knownSensors) {
-    String sensorNs = "s_" + String(sensorId);
-    if (sensorNs.length() > 15)
-      sensorNs = sensorNs.substring(0, 15);
+    char sensorNs[16]; // Namespace names are cut to 15 characters
+    snprintf(sensorNs, sizeof(sensorNs), "s_%s", sensorId);
 
-    if (!prefs.begin(sensorNs.c_str(), true))
+    if (!prefs.begin(sensorNs, true))
       continue; // Namespace doesn't exist
 
     // Check if it's initialized
@@ -200,301 +357,473 @@ ResourceResult FlashPersistence::saveToFlash() {
       continue;
     }
 
-    textData += sensorNs + ":initialized=1\n";
-    textData += sensorNs + ":name=" + prefs.getString("name", "") + "\n";
-    textData += sensorNs + ":meas_int=" + String(prefs.getUInt("meas_int", 10000)) + "\n";
-    textData += sensorNs + ":has_err=" + String(prefs.getBool("has_err", false) ? "1" : "0") + "\n";
+    char value[FP_LINE_MAX] = "";
+    out.put(sensorNs, "initialized", "1");
+    prefs.getString("name", value, sizeof(value));
+    out.put(sensorNs, "name", value);
+    out.putUInt(sensorNs, "meas_int", prefs.getUInt("meas_int", 10000));
+    out.putBool(sensorNs, "has_err", prefs.getBool("has_err", false));
 
-    // Save all measurements (max 8 measurements per sensor)
+    // Save all measurements (max 8 measurements per sensor); each key is
+    // formatted into the same buffer before its value is read
+    char key[16];
     for (uint8_t idx = 0; idx < 8; idx++) {
-      String prefix = "m" + String(idx) + "_";
+      auto measKey = [&key, idx](const char* suffix) {
+        snprintf(key, sizeof(key), "m%u_%s", static_cast<unsigned>(idx), suffix);
+        return key;
+      };
+      auto putMeasString = [&](const char* suffix) {
+        value[0] = '\0';
+        prefs.getString(measKey(suffix), value, sizeof(value));
+        out.put(sensorNs, key, value);
+      };
+      auto putMeasBool = [&](const char* suffix) {
+        measKey(suffix);
+        out.putBool(sensorNs, key, prefs.getBool(key, false));
+      };
+      auto putMeasInt = [&](const char* suffix, int32_t defaultValue) {
+        measKey(suffix);
+        out.putInt(sensorNs, key, prefs.getInt(key, defaultValue));
+      };
+      auto putMeasUChar = [&](const char* suffix) {
+        measKey(suffix);
+        out.putUInt(sensorNs, key, prefs.getUChar(key, 0));
+      };
+      auto putMeasFloat = [&](const char* suffix, float defaultValue) {
+        measKey(suffix);
+        out.putFloat(sensorNs, key, prefs.getFloat(key, defaultValue));
+      };
 
       // Check if measurement exists
-      if (!prefs.isKey((prefix + "en").c_str()))
+      if (!prefs.isKey(measKey("en")))
         break;
 
-      textData += sensorNs + ":" + prefix +
-                  "en=" + String(prefs.getBool((prefix + "en").c_str(), false) ? "1" : "0") + "\n";
-      textData +=
-          sensorNs + ":" + prefix + "nm=" + prefs.getString((prefix + "nm").c_str(), "") + "\n";
-      textData +=
-          sensorNs + ":" + prefix + "fn=" + prefs.getString((prefix + "fn").c_str(), "") + "\n";
-      textData +=
-          sensorNs + ":" + prefix + "un=" + prefs.getString((prefix + "un").c_str(), "") + "\n";
-      textData += sensorNs + ":" + prefix +
-                  "min=" + String(prefs.getInt((prefix + "min").c_str(), 0)) + "\n";
-      textData += sensorNs + ":" + prefix +
-                  "max=" + String(prefs.getInt((prefix + "max").c_str(), 0)) + "\n";
-      textData += sensorNs + ":" + prefix +
-                  "yl=" + String(prefs.getUChar((prefix + "yl").c_str(), 0)) + "\n";
-      textData += sensorNs + ":" + prefix +
-                  "gl=" + String(prefs.getUChar((prefix + "gl").c_str(), 0)) + "\n";
-      textData += sensorNs + ":" + prefix +
-                  "gh=" + String(prefs.getUChar((prefix + "gh").c_str(), 0)) + "\n";
-      textData += sensorNs + ":" + prefix +
-                  "yh=" + String(prefs.getUChar((prefix + "yh").c_str(), 0)) + "\n";
-      textData += sensorNs + ":" + prefix +
-                  "inv=" + String(prefs.getBool((prefix + "inv").c_str(), false) ? "1" : "0") +
-                  "\n";
-      textData += sensorNs + ":" + prefix +
-                  "cal=" + String(prefs.getBool((prefix + "cal").c_str(), false) ? "1" : "0") +
-                  "\n";
-      textData += sensorNs + ":" + prefix +
-                  "acd=" + String(prefs.getUInt((prefix + "acd").c_str(), 86400)) + "\n";
-      textData += sensorNs + ":" + prefix +
-                  "rmin=" + String(prefs.getInt((prefix + "rmin").c_str(), INT32_MAX)) + "\n";
-      textData += sensorNs + ":" + prefix +
-                  "rmax=" + String(prefs.getInt((prefix + "rmax").c_str(), INT32_MIN)) + "\n";
-      textData += sensorNs + ":" + prefix +
-                  "absMin=" + String(prefs.getFloat((prefix + "absMin").c_str(), INFINITY)) + "\n";
-      textData += sensorNs + ":" + prefix +
-                  "absMax=" + String(prefs.getFloat((prefix + "absMax").c_str(), -INFINITY)) + "\n";
+      putMeasBool("en");
+      putMeasString("nm");
+      putMeasString("fn");
+      putMeasString("un");
+      putMeasInt("min", 0);
+      putMeasInt("max", 0);
+      putMeasUChar("yl");
+      putMeasUChar("gl");
+      putMeasUChar("gh");
+      putMeasUChar("yh");
+      putMeasBool("inv");
+      putMeasBool("cal");
+      measKey("acd");
+      out.putUInt(sensorNs, key, prefs.getUInt(key, 86400));
+      putMeasInt("rmin", INT32_MAX);
+      putMeasInt("rmax", INT32_MIN);
+      putMeasFloat("absMin", INFINITY);
+      putMeasFloat("absMax", -INFINITY);
     }
 
     prefs.end();
   }
+}
 
-  uint32_t dataSize = textData.length();
-  logger.info(F("FlashPers"), F("Textgröße: ") + String(dataSize) + F(" Bytes"));
-
-  if (dataSize == 0 || dataSize > FP_MAX_CONFIG_SIZE - 16) {
-    return ResourceResult::fail(ResourceError::VALIDATION_ERROR, F("Invalid data size"));
+// Write one restored "key=value" into the open namespace, guessing the type
+void putValue(Preferences& prefs, const char* key, const char* value) {
+  // Determine type and write
+  // Check for boolean (exactly "0" or "1")
+  if (strcmp(value, "0") == 0 || strcmp(value, "1") == 0) {
+    prefs.putBool(key, value[0] == '1');
+  }
+  // Check for special float values (inf, -inf, ovf)
+  else if (strcmp(value, "inf") == 0 || strcmp(value, "ovf") == 0) {
+    prefs.putFloat(key, INFINITY);
+  } else if (strcmp(value, "-inf") == 0 || strcmp(value, "-ovf") == 0) {
+    prefs.putFloat(key, -INFINITY);
   }
+  // Check if it's a float (contains '.' AND starts with digit or '-')
+  else if (strchr(value, '.') != nullptr && strlen(value) > 0 &&
+           (isdigit(value[0]) || value[0] == '-')) {
+    prefs.putFloat(key, atof(value));
+  }
+  // Check if it's a number (integer)
+  else if (strlen(value) > 0 && (isdigit(value[0]) || value[0] == '-')) {
+    // Check if all chars are digits (or minus sign at start)
+    bool isNumber = true;
+    for (size_t j = (value[0] == '-' ? 1 : 0); value[j] != '\0'; j++) {
+      if (!isdigit(value[j])) {
+        isNumber = false;
+        break;
+      }
+    }
 
-  // Calculate CRC (outside critical section)
-  uint32_t crc = calculateCRC32((const uint8_t*)textData.c_str(), dataSize);
+    if (isNumber) {
+      long val = atol(value);
 
-  // Prepare header (outside critical section)
-  uint8_t header[16];
-  memcpy(header, &FP_MAGIC_NUMBER, 4);
-  header[4] = FP_VERSION;
-  memcpy(header + 5, &dataSize, 4);
-  memcpy(header + 9, &crc, 4);
-  memset(header + 13, 0, 3);
+      // Decide between UChar, UInt, and Int based on value
+      if (val >= 0 && val <= 255) {
+        prefs.putUChar(key, (uint8_t)val);
+      } else if (val >= 0 && val <= 4294967295L) {
+        prefs.putUInt(key, (uint32_t)val);
+      } else {
+        prefs.putInt(key, (int32_t)val);
+      }
+    } else {
+      // Not a number - store as string
+      prefs.putString(key, value);
+    }
+  } else {
+    // String
+    prefs.putString(key, value);
+  }
+}
 
-  // CRITICAL SECTION: Disable interrupts during flash operations
-  // WiFi stays ON, but interrupts are disabled to prevent conflicts
-  {
-    CriticalSection cs;
 
-    // Erase sectors (interrupts disabled, safe to do flash ops)
-    uint32_t sectorsNeeded = ((dataSize + 16 + FP_FLASH_SECTOR_SIZE - 1) / FP_FLASH_SECTOR_SIZE);
-    for (uint32_t i = 0; i < sectorsNeeded; i++) {
-      uint32_t sectorAddr = (offset + i * FP_FLASH_SECTOR_SIZE) / FP_FLASH_SECTOR_SIZE;
+#ifdef USE_WEBSERVER
+/**
+ * @brief Config file included in the backup
+ */
+struct JsonFile {
+  char filename[32]; ///< LittleFS names have at most 31 characters
+  uint32_t size;
+};
 
-      if (!ESP.flashEraseSector(sectorAddr)) {
-        return ResourceResult::fail(ResourceError::OPERATION_FAILED, F("Erase failed"));
-      }
-    }
+constexpr uint8_t MAX_JSON_FILES = 16;
 
-    // Write header
-    if (!ESP.flashWrite(offset, (uint32_t*)header, 16)) {
-      return ResourceResult::fail(ResourceError::OPERATION_FAILED, F("Write header failed"));
+/**
+ * @brief List the /config files of the backup
+ * @details The JSON configs and the measurement store, which holds the
+ *          settings of every measurement since the per-sensor JSON files were
+ *          migrated into it.
+ */
+uint8_t collectJsonFiles(JsonFile* files) {
+  uint8_t fileCount = 0;
+  Dir dir = LittleFS.openDir("/config");
+  while (dir.next() && fileCount < MAX_JSON_FILES) {
+    String filename = dir.fileName();
+    bool isStore = (F("/config/") + filename).equals(SensorPersistence::getMeasurementStorePath());
+    if ((isStore || (filename.endsWith(".json") && !filename.endsWith(".example"))) &&
+        filename.length() < sizeof(files[fileCount].filename)) {
+      strcpy(files[fileCount].filename, filename.c_str());
+      files[fileCount].size = dir.fileSize();
+      fileCount++;
     }
+  }
+  return fileCount;
+}
+#endif
 
-    // Write data in chunks (textData is in RAM, safe)
-    const char* dataPtr = textData.c_str();
-    uint32_t written = 0;
-    uint32_t writeOffset = offset + 16;
+} // namespace
 
-    while (written < dataSize) {
-      uint32_t chunk[256];
-      uint32_t chunkSize = min((uint32_t)1024, dataSize - written);
-      memcpy(chunk, dataPtr + written, chunkSize);
-      uint32_t alignedSize = (chunkSize + 3) & ~3;
+const FlashPersistence::Stats& FlashPersistence::getStats() { return s_stats; }
 
-      if (!ESP.flashWrite(writeOffset, chunk, alignedSize)) {
-        return ResourceResult::fail(ResourceError::OPERATION_FAILED, F("Write failed"));
-      }
+uint32_t FlashPersistence::calculateCRC32(const uint8_t* data, size_t length) {
+  return ::calculateCRC32(data, length);
+}
 
-      written += chunkSize;
-      writeOffset += alignedSize;
-    }
-  } // CriticalSection ends here, interrupts restored
+uint32_t FlashPersistence::getSafeOffset() {
+  uint32_t sketchSize = ESP.getSketchSize();
+  uint32_t safeOffset =
+      ((sketchSize + FP_FLASH_SECTOR_SIZE - 1) / FP_FLASH_SECTOR_SIZE + FP_SAFETY_MARGIN_SECTORS) *
+      FP_FLASH_SECTOR_SIZE;
 
-  logger.info(F("FlashPers"), F("Erfolgreich gespeichert"));
-  return ResourceResult::success();
+  uint32_t sketchEnd = ESP.getFreeSketchSpace() + sketchSize;
+  if (safeOffset + FP_SLOT_COUNT * FP_SLOT_SIZE > sketchEnd) {
+    logger.error(F("FlashPers"),
+                 F("Nicht genug Flash-Speicher für Sicherungen: benötigt ") +
+                     String(safeOffset + FP_SLOT_COUNT * FP_SLOT_SIZE - sketchSize) +
+                     F(" Bytes hinter dem Sketch, frei ") + String(ESP.getFreeSketchSpace()));
+    return 0;
+  }
+
+  return safeOffset;
 }
 
-ResourceResult FlashPersistence::restoreFromFlash() {
-  // CRITICAL: NO LOGGER CALLS - heap is too fragmented, use Serial only
-  Serial.println(F("[FlashPers] Stelle Textformat wieder her..."));
+ResourceResult FlashPersistence::checkFlashSpace() {
+  if (getSafeOffset() == 0) {
+    return ResourceResult::fail(ResourceError::INSUFFICIENT_SPACE,
+                                F("No flash space for the backup slots"));
+  }
+  return ResourceResult::success();
+}
 
+uint32_t FlashPersistence::getSlotOffset(uint8_t slot) {
   uint32_t offset = getSafeOffset();
   if (offset == 0) {
-    Serial.println(F("[FlashPers] FEHLER: Kein Flash-Speicher"));
-    return ResourceResult::fail(ResourceError::OPERATION_FAILED, F("No flash space"));
+    return 0;
   }
+  return offset + slot * FP_SLOT_SIZE;
+}
 
-  // Read header
-  uint8_t header[16];
-  if (!ESP.flashRead(offset, (uint32_t*)header, 16)) {
-    Serial.println(F("[FlashPers] FEHLER: Header-Lesen fehlgeschlagen"));
-    return ResourceResult::fail(ResourceError::OPERATION_FAILED, F("Read header failed"));
+bool FlashPersistence::readValidSlot(uint8_t slot, SlotHeader& header) {
+  uint32_t offset = getSlotOffset(slot);
+  if (offset == 0 || !ESP.flashRead(offset, reinterpret_cast<uint32_t*>(&header), sizeof(header))) {
+    return false;
   }
 
-  uint32_t magic;
-  memcpy(&magic, header, 4);
-  if (magic != FP_MAGIC_NUMBER) {
-    Serial.println(F("[FlashPers] FEHLER: Keine gültige Konfiguration"));
-    return ResourceResult::fail(ResourceError::RESOURCE_ERROR, F("No valid config"));
+  uint32_t headerCrc =
+      calculateCRC32(reinterpret_cast<const uint8_t*>(&header), offsetof(SlotHeader, headerCrc));
+  if (header.magic != FP_MAGIC_NUMBER || header.version != FP_VERSION ||
+      header.headerCrc != headerCrc || header.imageSize > FP_SLOT_DATA_SIZE ||
+      header.prefsSize + header.manifestSize > header.imageSize) {
+    return false;
   }
 
-  uint8_t version = header[4];
-  if (version != FP_VERSION) {
-    Serial.println(F("[FlashPers] FEHLER: Versionskonflikt"));
-    return ResourceResult::fail(ResourceError::VERSION_MISMATCH, F("Version mismatch"));
+  // The image CRC catches a slot whose data sectors were partly rewritten
+  FlashReader reader(offset + FP_FLASH_SECTOR_SIZE);
+  uint32_t crc = CRC32_INITIAL;
+  uint8_t chunk[256];
+  for (uint32_t pos = 0; pos < header.imageSize;) {
+    uint32_t chunkSize = std::min(static_cast<uint32_t>(sizeof(chunk)), header.imageSize - pos);
+    if (!reader.read(chunk, chunkSize)) {
+      return false;
+    }
+    crc = updateCRC32(crc, chunk, chunkSize);
+    pos += chunkSize;
   }
+  return ~crc == header.imageCrc;
+}
 
-  uint32_t dataSize, storedCRC;
-  memcpy(&dataSize, header + 5, 4);
-  memcpy(&storedCRC, header + 9, 4);
+int8_t FlashPersistence::findNewestSlot(SlotHeader& header) {
+  int8_t newest = -1;
+  for (uint8_t slot = 0; slot < FP_SLOT_COUNT; slot++) {
+    SlotHeader candidate;
+    if (readValidSlot(slot, candidate) && (newest < 0 || candidate.sequence > header.sequence)) {
+      header = candidate;
+      newest = slot;
+    }
+  }
+  return newest;
+}
+
+ResourceResult FlashPersistence::writeBackup(bool includeJson) {
+  unsigned long start = millis();
+  if (getSafeOffset() == 0) {
+    return ResourceResult::fail(ResourceError::INSUFFICIENT_SPACE, F("No flash space"));
+  }
 
-  if (dataSize == 0 || dataSize > FP_MAX_CONFIG_SIZE) {
-    Serial.println(F("[FlashPers] FEHLER: Ungültige Größe"));
-    return ResourceResult::fail(ResourceError::VALIDATION_ERROR, F("Invalid size"));
+#ifdef USE_WEBSERVER
+  JsonFile files[MAX_JSON_FILES];
+  uint8_t fileCount = includeJson ? collectJsonFiles(files) : 0;
+  if (includeJson) {
+    logger.info(F("FlashPers"), String(fileCount) + F(" JSON-Dateien gefunden"));
   }
+#endif
 
+  // Image: Preferences text, manifest, then the JSON files back to back. All
+  // parts are streamed into the sink, so the image is never held in RAM; the
+  // section sizes are taken from the sink while it is written.
+  uint32_t prefsSize = 0;
+  uint32_t manifestSize = 0;
+  auto writeImage = [&](ImageSink& sink) -> bool {
+    TextEncoder out(sink);
+    encodePrefs(out);
+    prefsSize = sink.size();
+
+    // Manifest: first line = file count, then filename|size
+    char number[12];
+#ifdef USE_WEBSERVER
+    out.text(utoa(fileCount, number, 10));
+    out.text("\n");
+    for (uint8_t i = 0; i < fileCount; i++) {
+      out.text(files[i].filename);
+      out.text("|");
+      out.text(ultoa(files[i].size, number, 10));
+      out.text("\n");
+    }
+#else
+    out.text(utoa(0, number, 10));
+    out.text("\n");
+#endif
+    manifestSize = sink.size() - prefsSize;
+    if (!out.ok()) {
+      return false;
+    }
+
+#ifdef USE_WEBSERVER
+    char path[48];
+    for (uint8_t i = 0; i < fileCount; i++) {
+      snprintf(path, sizeof(path), "/config/%s", files[i].filename);
+      File f = LittleFS.open(path, "r");
+      if (!f) {
+        logger.warning(F("FlashPers"), F("Konnte nicht öffnen: ") + String(files[i].filename));
+        return false;
+      }
+      uint8_t buffer[256];
+      uint32_t remaining = files[i].size;
+      while (remaining > 0) {
+        size_t toRead = std::min(static_cast<uint32_t>(sizeof(buffer)), remaining);
+        size_t actualRead = f.read(buffer, toRead);
+        if (actualRead == 0 || !sink.write(buffer, actualRead)) {
+          f.close();
+          return false;
+        }
+        remaining -= actualRead;
+      }
+      f.close();
+    }
+#endif
+    return true;
+  };
+
+  // Pass 1: an image equal to the newest backup needs no flash write at all
+  SlotHeader newest;
+  int8_t newestSlot = findNewestSlot(newest);
+  CrcSink checksum;
+  if (!writeImage(checksum)) {
+    return ResourceResult::fail(ResourceError::FILESYSTEM_ERROR, F("Config read failed"));
+  }
+  logger.info(F("FlashPers"), F("Textgröße: ") + String(prefsSize) + F(" Bytes"));
+  if (prefsSize == 0 || prefsSize > FP_PREFS_MAX_SIZE) {
+    return ResourceResult::fail(ResourceError::VALIDATION_ERROR, F("Invalid data size"));
+  }
+  if (checksum.size() - prefsSize > FP_JSON_MAX_SIZE) {
+    return ResourceResult::fail(ResourceError::INSUFFICIENT_SPACE, F("JSON too large"));
+  }
+  const uint32_t expectedPrefsSize = prefsSize;
+  const uint32_t expectedManifestSize = manifestSize;
+  uint32_t imageSectors = (checksum.size() + FP_FLASH_SECTOR_SIZE - 1) / FP_FLASH_SECTOR_SIZE;
+  if (newestSlot >= 0 && newest.imageCrc == checksum.crc() &&
+      newest.imageSize == checksum.size() && newest.prefsSize == prefsSize) {
+    s_stats.backupMs = millis() - start;
+    s_stats.sectorsErased = 0;
+    s_stats.sectorsUnchanged = imageSectors;
+    s_stats.imageBytes = checksum.size();
+    s_stats.slot = newestSlot;
+    s_stats.sequence = newest.sequence;
+    logger.info(F("FlashPers"), F("Backup unverändert, Slot ") +
+                                    String(newestSlot == 0 ? 'A' : 'B') + F(" bleibt aktuell"));
+    return ResourceResult::success();
+  }
+
+  // Pass 2: write into the other slot so the newest backup stays intact
+  uint8_t slot = newestSlot == 0 ? 1 : 0;
+  uint32_t sequence = newestSlot >= 0 ? newest.sequence + 1 : 1;
+  uint32_t slotOffset = getSlotOffset(slot);
+
+  std::unique_ptr<uint32_t[]> sector(new (std::nothrow)
+                                         uint32_t[FP_FLASH_SECTOR_SIZE / sizeof(uint32_t)]);
+  if (!sector) {
+    return ResourceResult::fail(ResourceError::INSUFFICIENT_MEMORY, F("No sector buffer"));
+  }
+
+  // Drop the slot header first, so a backup torn by a power cut is never valid
+  {
+    CriticalSection cs;
+    if (!ESP.flashEraseSector(slotOffset / FP_FLASH_SECTOR_SIZE)) {
+      return ResourceResult::fail(ResourceError::OPERATION_FAILED, F("Erase failed"));
+    }
+  }
+
+  SectorWriter writer(slotOffset + FP_FLASH_SECTOR_SIZE, FP_SLOT_DATA_SIZE, sector.get(),
+                      FP_FLASH_SECTOR_SIZE);
+  if (!writeImage(writer) || !writer.finish()) {
+    return ResourceResult::fail(ResourceError::OPERATION_FAILED, F("Write failed"));
+  }
+  // The header describes the sections of pass 1, so both passes must agree
+  if (prefsSize != expectedPrefsSize || manifestSize != expectedManifestSize ||
+      writer.size() != checksum.size()) {
+    return ResourceResult::fail(ResourceError::OPERATION_FAILED, F("Config changed"));
+  }
+
+  // The header is written last; from now on this slot is the newest
+  SlotHeader header{};
+  header.magic = FP_MAGIC_NUMBER;
+  header.version = FP_VERSION;
+  header.sequence = sequence;
+  header.prefsSize = prefsSize;
+  header.manifestSize = manifestSize;
+  header.imageSize = writer.size();
+  header.imageCrc = writer.crc();
+  header.headerCrc =
+      calculateCRC32(reinterpret_cast<const uint8_t*>(&header), offsetof(SlotHeader, headerCrc));
+  {
+    CriticalSection cs;
+    if (!ESP.flashWrite(slotOffset, reinterpret_cast<uint32_t*>(&header), sizeof(header))) {
+      return ResourceResult::fail(ResourceError::OPERATION_FAILED, F("Write header failed"));
+    }
+  }
+
+  s_stats.backupMs = millis() - start;
+  s_stats.sectorsErased = writer.sectorsErased() + 1;
+  s_stats.sectorsUnchanged = writer.sectorsUnchanged();
+  s_stats.imageBytes = writer.size();
+  s_stats.slot = slot;
+  s_stats.sequence = sequence;
+  logger.info(F("FlashPers"), F("Backup Nr. ") + String(sequence) + F(" in Slot ") +
+                                  String(slot == 0 ? 'A' : 'B') + F(": ") +
+                                  String(s_stats.sectorsErased) + F(" Sektoren gelöscht, ") +
+                                  String(s_stats.sectorsUnchanged) + F(" unverändert, ") +
+                                  String(s_stats.backupMs) + F(" ms"));
+  return ResourceResult::success();
+}
+
+ResourceResult FlashPersistence::saveToFlash() {
+  logger.info(F("FlashPers"), F("Speichere Preferences als Text..."));
+  auto result = writeBackup(false);
+  if (result.isSuccess()) {
+    logger.info(F("FlashPers"), F("Erfolgreich gespeichert"));
+  }
+  return result;
+}
+
+ResourceResult FlashPersistence::restorePrefs(uint8_t slot, const SlotHeader& header) {
   Serial.print(F("[FlashPers] Lese "));
-  Serial.print(dataSize);
+  Serial.print(header.prefsSize);
   Serial.println(F(" Bytes..."));
 
-  //  CRITICAL: Don't malloc the entire buffer - heap fragmentation!
-  // CRC check skipped - we rely on magic number + version for validation
-  // Instead, read and parse line-by-line in small chunks
-  // Instead, read and parse line-by-line in small chunks
+  // Parsed line by line in a fixed buffer: no heap is allocated, whatever
+  // the size of the configuration
   Preferences prefs;
   int lineCount = 0;
   char currentNs[32] = "";
   bool nsOpen = false;
 
-  char lineBuffer[256];
-  int linePos = 0;
-  uint32_t readOffset = offset + 16;
-  uint32_t bytesRead = 0;
-
-  // Read and parse in 256-byte chunks
-  while (bytesRead < dataSize) {
-    // Read chunk
-    char chunk[256];
-    uint32_t chunkSize = min((uint32_t)256, dataSize - bytesRead);
-    uint32_t alignedSize = (chunkSize + 3) & ~3;
-
-    if (!ESP.flashRead(readOffset, (uint32_t*)chunk, alignedSize)) {
-      Serial.println(F("[FlashPers] FEHLER: Lesen fehlgeschlagen"));
-      if (nsOpen)
+  FlashReader reader(getSlotOffset(slot) + FP_FLASH_SECTOR_SIZE);
+  LineReader lines(reader, header.prefsSize);
+  while (char* line = lines.next()) {
+    // Parse "namespace:key=value" in place
+    char* colon = strchr(line, ':');
+    char* equals = colon ? strchr(colon + 1, '=') : nullptr;
+    if (!equals) {
+      continue;
+    }
+    *colon = '\0';
+    *equals = '\0';
+    const char* ns = line;
+    const char* key = colon + 1;
+    const char* value = equals + 1;
+
+    // Check if we need to switch namespace
+    if (strcmp(ns, currentNs) != 0) {
+      if (nsOpen) {
         prefs.end();
-      return ResourceResult::fail(ResourceError::OPERATION_FAILED, F("Read failed"));
-    }
-
-    // Process each byte in chunk
-    for (uint32_t i = 0; i < chunkSize; i++) {
-      char c = chunk[i];
-
-      if (c == '\n' || c == '\r' || linePos >= 255) {
-        if (linePos > 0) {
-          lineBuffer[linePos] = '\0';
-
-          // Parse "namespace:key=value"
-          char* colon = strchr(lineBuffer, ':');
-          if (colon) {
-            *colon = '\0';
-            char* ns = lineBuffer;
-            char* keyValue = colon + 1;
-
-            char* equals = strchr(keyValue, '=');
-            if (equals) {
-              *equals = '\0';
-              char* key = keyValue;
-              char* value = equals + 1;
-
-              // Check if we need to switch namespace
-              if (strcmp(ns, currentNs) != 0) {
-                if (nsOpen) {
-                  prefs.end();
-                  nsOpen = false;
-                }
-
-                if (prefs.begin(ns, false)) {
-                  strncpy(currentNs, ns, 31);
-                  currentNs[31] = '\0';
-                  nsOpen = true;
-                } else {
-                  Serial.print(F("[FlashPers] FEHLER: Kann Namespace nicht öffnen: "));
-                  Serial.println(ns);
-                  linePos = 0;
-                  continue;
-                }
-              }
-
-              if (nsOpen) {
-                // Determine type and write
-                // Check for boolean (exactly "0" or "1")
-                if (strcmp(value, "0") == 0 || strcmp(value, "1") == 0) {
-                  prefs.putBool(key, value[0] == '1');
-                }
-                // Check for special float values (inf, -inf, ovf)
-                else if (strcmp(value, "inf") == 0 || strcmp(value, "ovf") == 0) {
-                  prefs.putFloat(key, INFINITY);
-                } else if (strcmp(value, "-inf") == 0 || strcmp(value, "-ovf") == 0) {
-                  prefs.putFloat(key, -INFINITY);
-                }
-                // Check if it's a float (contains '.' AND starts with digit or '-')
-                else if (strchr(value, '.') != nullptr && strlen(value) > 0 &&
-                         (isdigit(value[0]) || value[0] == '-')) {
-                  prefs.putFloat(key, atof(value));
-                }
-                // Check if it's a number (integer)
-                else if (strlen(value) > 0 && (isdigit(value[0]) || value[0] == '-')) {
-                  // Check if all chars are digits (or minus sign at start)
-                  bool isNumber = true;
-                  for (size_t j = (value[0] == '-' ? 1 : 0); value[j] != '\0'; j++) {
-                    if (!isdigit(value[j])) {
-                      isNumber = false;
-                      break;
-                    }
-                  }
-
-                  if (isNumber) {
-                    long val = atol(value);
-
-                    // Decide between UChar, UInt, and Int based on value
-                    if (val >= 0 && val <= 255) {
-                      prefs.putUChar(key, (uint8_t)val);
-                    } else if (val >= 0 && val <= 4294967295L) {
-                      prefs.putUInt(key, (uint32_t)val);
-                    } else {
-                      prefs.putInt(key, (int32_t)val);
-                    }
-                  } else {
-                    // Not a number - store as string
-                    prefs.putString(key, value);
-                  }
-                } else {
-                  // String
-                  prefs.putString(key, value);
-                }
-                lineCount++;
-              }
-            }
-          }
-        }
-        linePos = 0;
+        nsOpen = false;
+      }
+      currentNs[0] = '\0';
+
+      if (prefs.begin(ns, false)) {
+        strncpy(currentNs, ns, sizeof(currentNs) - 1);
+        currentNs[sizeof(currentNs) - 1] = '\0';
+        nsOpen = true;
       } else {
-        if (linePos < 255) {
-          lineBuffer[linePos++] = c;
-        }
+        Serial.print(F("[FlashPers] FEHLER: Kann Namespace nicht öffnen: "));
+        Serial.println(ns);
       }
     }
 
-    bytesRead += chunkSize;
-    readOffset += alignedSize;
+    if (nsOpen) {
+      putValue(prefs, key, value);
+      lineCount++;
+    }
+  }
+
+  if (lines.failed()) {
+    Serial.println(F("[FlashPers] FEHLER: Lesen fehlgeschlagen"));
+    if (nsOpen)
+      prefs.end();
+    return ResourceResult::fail(ResourceError::OPERATION_FAILED, F("Read failed"));
   }
 
   // Close last namespace
   if (nsOpen) {
     prefs.end();
   }
+  PreferencesManager::invalidateCache();
 
   Serial.print(F("[FlashPers] "));
   Serial.print(lineCount);
@@ -503,17 +832,46 @@ ResourceResult FlashPersistence::restoreFromFlash() {
   return ResourceResult::success();
 }
 
+ResourceResult FlashPersistence::restoreFromFlash() {
+  // CRITICAL: NO LOGGER CALLS - heap is too fragmented, use Serial only
+  Serial.println(F("[FlashPers] Stelle Textformat wieder her..."));
+  unsigned long start = millis();
+
+  SlotHeader header;
+  int8_t slot = findNewestSlot(header);
+  if (slot < 0) {
+    Serial.println(F("[FlashPers] FEHLER: Keine gültige Konfiguration"));
+    return ResourceResult::fail(ResourceError::RESOURCE_ERROR, F("No valid config"));
+  }
+
+  auto result = restorePrefs(slot, header);
+  s_stats.restoreMs = millis() - start;
+  s_stats.slot = slot;
+  s_stats.sequence = header.sequence;
+
+  Serial.print(F("[FlashPers] Slot "));
+  Serial.print(slot == 0 ? 'A' : 'B');
+  Serial.print(F(", Nr. "));
+  Serial.print(header.sequence);
+  Serial.print(F(", "));
+  Serial.print(s_stats.restoreMs);
+  Serial.println(F(" ms"));
+  return result;
+}
+
 ResourceResult FlashPersistence::clearFlash() {
   logger.info(F("FlashPers"), F("Lösche Flash..."));
 
-  uint32_t offset = getSafeOffset();
-  if (offset == 0) {
+  if (getSafeOffset() == 0) {
     return ResourceResult::success();
   }
 
-  uint32_t sectorAddr = offset / FP_FLASH_SECTOR_SIZE;
-  if (!ESP.flashEraseSector(sectorAddr)) {
-    return ResourceResult::fail(ResourceError::OPERATION_FAILED, F("Erase failed"));
+  // Without a header no slot is valid
+  for (uint8_t slot = 0; slot < FP_SLOT_COUNT; slot++) {
+    CriticalSection cs;
+    if (!ESP.flashEraseSector(getSlotOffset(slot) / FP_FLASH_SECTOR_SIZE)) {
+      return ResourceResult::fail(ResourceError::OPERATION_FAILED, F("Erase failed"));
+    }
   }
 
   logger.info(F("FlashPers"), F("Gelöscht"));
@@ -521,15 +879,8 @@ ResourceResult FlashPersistence::clearFlash() {
 }
 
 bool FlashPersistence::hasValidConfig() {
-  uint32_t offset = getSafeOffset();
-  if (offset == 0)
-    return false;
-
-  uint32_t magic;
-  if (!ESP.flashRead(offset, &magic, 4))
-    return false;
-
-  return (magic == FP_MAGIC_NUMBER);
+  SlotHeader header;
+  return findNewestSlot(header) >= 0;
 }
 
 // ==================== NEW: Combined Preferences + Config Files ====================
@@ -537,24 +888,17 @@ bool FlashPersistence::hasValidConfig() {
 ResourceResult FlashPersistence::saveAllToFlash() {
   logger.info(F("FlashPers"), F("Sichere Preferences + Config-Dateien..."));
 
+  // Cached min/max and last values go into the measurement store first
+  SensorPersistence::flushAllPendingUpdates();
+
   // NEW SIMPLIFIED ARCHITECTURE:
   // WiFi stays ON throughout the entire process. We use CriticalSection
   // to disable interrupts during flash operations, which prevents
   // WiFi callbacks from interfering without actually disconnecting WiFi.
   // This is much cleaner and more reliable.
-
-  // STEP 1: Save Preferences to flash
-  auto prefsResult = saveToFlash();
-  if (!prefsResult.isSuccess()) {
-    return prefsResult;
-  }
-
-  // STEP 2: Save JSON config files to separate flash area
-  // No delay needed - CriticalSection handles everything safely
-  auto jsonResult = saveJsonToFlash();
-  if (!jsonResult.isSuccess()) {
-    logger.warning(F("FlashPers"), F("JSON-Sicherung fehlgeschlagen"));
-    return jsonResult;
+  auto result = writeBackup(true);
+  if (!result.isSuccess()) {
+    return result;
   }
 
   logger.info(F("FlashPers"), F("Erfolgreich gespeichert (Preferences + JSON-Configs)"));
@@ -563,232 +907,46 @@ ResourceResult FlashPersistence::saveAllToFlash() {
 
 ResourceResult FlashPersistence::restoreAllFromFlash() {
   Serial.println(F("[FlashPers] Stelle Preferences + Config-Dateien wieder her..."));
+  unsigned long start = millis();
 
   // NO WIFI DISCONNECT needed for restore - read operations don't conflict
+  SlotHeader header;
+  int8_t slot = findNewestSlot(header);
+  if (slot < 0) {
+    Serial.println(F("[FlashPers] FEHLER: Keine gültige Konfiguration"));
+    return ResourceResult::fail(ResourceError::RESOURCE_ERROR, F("No valid config"));
+  }
 
-  // STEP 1: Restore Preferences from flash (separate area)
-  auto prefsResult = restoreFromFlash();
+  // STEP 1: Restore Preferences from the image
+  auto prefsResult = restorePrefs(slot, header);
   if (!prefsResult.isSuccess()) {
     return prefsResult;
   }
 
-  // STEP 2: Restore JSON config files from separate flash area
-  auto jsonResult = restoreJsonFromFlash();
+  // STEP 2: Restore JSON config files behind the Preferences text
+  auto jsonResult = restoreJson(slot, header);
   if (!jsonResult.isSuccess()) {
     Serial.println(F("[FlashPers] WARNUNG: JSON-Wiederherstellung fehlgeschlagen"));
     // Not fatal - preferences are restored
   }
 
-  Serial.println(F("[FlashPers] Wiederherstellung abgeschlossen"));
+  s_stats.restoreMs = millis() - start;
+  s_stats.slot = slot;
+  s_stats.sequence = header.sequence;
+  Serial.print(F("[FlashPers] Wiederherstellung abgeschlossen in "));
+  Serial.print(s_stats.restoreMs);
+  Serial.println(F(" ms"));
   return ResourceResult::success();
 }
 
-// Helper methods for JSON storage in separate flash area
-
-ResourceResult FlashPersistence::saveJsonToFlash() {
-  logger.info(F("FlashPers"), F("Sichere JSON-Configs in Flash..."));
-
-#ifndef USE_WEBSERVER
-  return ResourceResult::success(); // Nothing to do without web support
-#else
-  uint32_t offset = getJsonStorageOffset();
-  if (offset == 0) {
-    return ResourceResult::fail(ResourceError::INSUFFICIENT_SPACE, F("No flash for JSON"));
-  }
-
-  // STEP 1: Collect file metadata (WiFi ON, safe)
-  struct FileInfo {
-    String filename;
-    size_t size;
-  };
-  FileInfo files[16]; // Max 16 JSON files
-  uint8_t fileCount = 0;
-
-  Dir dir = LittleFS.openDir("/config");
-  while (dir.next() && fileCount < 16) {
-    String filename = dir.fileName();
-    if (filename.endsWith(".json") && !filename.endsWith(".example")) {
-      File f = LittleFS.open("/config/" + filename, "r");
-      if (f) {
-        files[fileCount].filename = filename;
-        files[fileCount].size = f.size();
-        fileCount++;
-        f.close();
-      }
-    }
-  }
-
-  if (fileCount == 0) {
-    logger.info(F("FlashPers"), F("Keine JSON-Dateien zum Sichern"));
-    return ResourceResult::success();
-  }
-
-  logger.info(F("FlashPers"), String(fileCount) + F(" JSON-Dateien gefunden"));
-
-  // STEP 2: Build manifest (WiFi ON, safe)
-  String manifest;
-  manifest.reserve(512);
-  manifest += String(fileCount) + "\n";
-
-  uint32_t totalSize = 16; // header
-  for (uint8_t i = 0; i < fileCount; i++) {
-    manifest += files[i].filename + "|" + String(files[i].size) + "\n";
-    totalSize += files[i].size;
-  }
-  totalSize += manifest.length();
-
-  logger.info(F("FlashPers"), F("JSON Gesamt: ") + String(totalSize) + F(" Bytes"));
-
-  if (totalSize > FP_JSON_MAX_SIZE) {
-    return ResourceResult::fail(ResourceError::INSUFFICIENT_SPACE, F("JSON too large"));
-  }
-
-  uint32_t manifestSize = manifest.length();
-
-  // STEP 3: Prepare header (WiFi ON, safe)
-  uint8_t header[16];
-  memcpy(header, &FP_MAGIC_NUMBER, 4);
-  header[4] = FP_VERSION;
-  memcpy(header + 5, &manifestSize, 4);
-  uint32_t placeholder_crc = 0;
-  memcpy(header + 9, &placeholder_crc, 4);
-  memset(header + 13, 0, 3);
-
-  uint32_t sectorsNeeded = ((totalSize + FP_FLASH_SECTOR_SIZE - 1) / FP_FLASH_SECTOR_SIZE);
-  logger.debug(F("FlashPers"), F("Lösche ") + String(sectorsNeeded) + F(" Sektoren..."));
-
-  // STEP 4: CRITICAL SECTION - Erase and write header/manifest
-  {
-    CriticalSection cs;
-
-    // Erase all needed sectors
-    for (uint32_t i = 0; i < sectorsNeeded; i++) {
-      uint32_t sectorAddr = (offset + i * FP_FLASH_SECTOR_SIZE) / FP_FLASH_SECTOR_SIZE;
-      if (!ESP.flashEraseSector(sectorAddr)) {
-        return ResourceResult::fail(ResourceError::OPERATION_FAILED, F("JSON erase failed"));
-      }
-    }
-
-    // Write header
-    uint32_t writeOffset = offset;
-    if (!ESP.flashWrite(writeOffset, (uint32_t*)header, 16)) {
-      return ResourceResult::fail(ResourceError::OPERATION_FAILED, F("Header write failed"));
-    }
-    writeOffset += 16;
-
-    // Write manifest in chunks
-    const char* manifestPtr = manifest.c_str();
-    uint32_t manifestWritten = 0;
-
-    while (manifestWritten < manifestSize) {
-      uint32_t chunk[256];
-      uint32_t chunkSize = min((uint32_t)1024, manifestSize - manifestWritten);
-      memcpy(chunk, manifestPtr + manifestWritten, chunkSize);
-      uint32_t alignedSize = (chunkSize + 3) & ~3;
-
-      if (!ESP.flashWrite(writeOffset, chunk, alignedSize)) {
-        return ResourceResult::fail(ResourceError::OPERATION_FAILED, F("Manifest write failed"));
-      }
-
-      manifestWritten += chunkSize;
-      writeOffset += alignedSize;
-    }
-
-    // STEP 5: Write each JSON file individually in its own critical section
-    // This allows us to read from LittleFS with interrupts enabled between files
-    for (uint8_t fileIdx = 0; fileIdx < fileCount; fileIdx++) {
-      String filepath = "/config/" + files[fileIdx].filename;
-
-      // Exit critical section temporarily to read file
-    } // End of CriticalSection for header/manifest
-  }
-
-  // STEP 6: Write file contents one by one (each in its own critical section)
-  uint32_t writeOffset = offset + 16 + ((manifestSize + 3) & ~3);
-
-  for (uint8_t fileIdx = 0; fileIdx < fileCount; fileIdx++) {
-    String filepath = "/config/" + files[fileIdx].filename;
-
-    // Open and read file (WiFi ON, interrupts enabled, safe for LittleFS)
-    File f = LittleFS.open(filepath, "r");
-    if (!f) {
-      logger.warning(F("FlashPers"), F("Konnte nicht öffnen: ") + files[fileIdx].filename);
-      continue;
-    }
-
-    size_t fileSize = f.size();
-    size_t bytesRead = 0;
-
-    // Read and write in small chunks
-    while (bytesRead < fileSize) {
-      // Read chunk from LittleFS (interrupts enabled, safe)
-      uint8_t buffer[128];
-      size_t chunkSize =
-          (fileSize - bytesRead > sizeof(buffer)) ? sizeof(buffer) : (fileSize - bytesRead);
-      size_t actualRead = f.read(buffer, chunkSize);
-
-      if (actualRead == 0)
-        break;
-
-      // Prepare aligned buffer for flash write
-      uint32_t alignedChunk[32];
-      uint32_t alignedSize = (actualRead + 3) & ~3;
-      memset(alignedChunk, 0xFF, alignedSize);
-      memcpy(alignedChunk, buffer, actualRead);
-
-      // CRITICAL SECTION for flash write only
-      {
-        CriticalSection cs;
-        if (!ESP.flashWrite(writeOffset, alignedChunk, alignedSize)) {
-          f.close();
-          return ResourceResult::fail(ResourceError::OPERATION_FAILED,
-                                      F("File write failed: ") + files[fileIdx].filename);
-        }
-      }
-
-      bytesRead += actualRead;
-      writeOffset += alignedSize;
-    }
-
-    f.close();
-    logger.debug(F("FlashPers"), F("Gesichert: ") + files[fileIdx].filename);
-  }
-
-  logger.info(F("FlashPers"), F("JSON-Configs erfolgreich in Flash gesichert"));
-  return ResourceResult::success();
-#endif
-}
-
-ResourceResult FlashPersistence::restoreJsonFromFlash() {
+ResourceResult FlashPersistence::restoreJson(uint8_t slot, const SlotHeader& header) {
   Serial.println(F("[FlashPers] Stelle JSON-Configs aus Flash wieder her..."));
 
 #ifndef USE_WEBSERVER
   return ResourceResult::success();
 #else
-  uint32_t offset = getJsonStorageOffset();
-  if (offset == 0) {
-    Serial.println(F("[FlashPers] Kein JSON Flash-Speicher"));
-    return ResourceResult::fail(ResourceError::OPERATION_FAILED, F("No JSON flash"));
-  }
-
-  // Read header
-  uint8_t header[16];
-  if (!ESP.flashRead(offset, (uint32_t*)header, 16)) {
-    Serial.println(F("[FlashPers] JSON Header-Lesen fehlgeschlagen"));
-    return ResourceResult::fail(ResourceError::OPERATION_FAILED, F("Read JSON header failed"));
-  }
-
-  uint32_t magic;
-  memcpy(&magic, header, 4);
-  if (magic != FP_MAGIC_NUMBER) {
-    Serial.println(F("[FlashPers] Keine gültigen JSON-Configs"));
-    return ResourceResult::success(); // Not an error, just no backup
-  }
-
-  uint32_t manifestSize;
-  memcpy(&manifestSize, header + 5, 4);
-
-  if (manifestSize == 0 || manifestSize > 4096) {
+  uint32_t manifestSize = header.manifestSize;
+  if (manifestSize == 0) {
     Serial.println(F("[FlashPers] Ungültige Manifest-Größe"));
     return ResourceResult::fail(ResourceError::VALIDATION_ERROR, F("Invalid manifest size"));
   }
@@ -797,40 +955,21 @@ ResourceResult FlashPersistence::restoreJsonFromFlash() {
   Serial.print(manifestSize);
   Serial.println(F(" Bytes"));
 
-  // Read manifest in chunks
-  String manifest;
-  manifest.reserve(manifestSize + 1);
-  uint32_t readOffset = offset + 16;
-  uint32_t bytesRead = 0;
-
-  while (bytesRead < manifestSize) {
-    char chunk[256];
-    uint32_t chunkSize = min((uint32_t)256, manifestSize - bytesRead);
-    uint32_t alignedSize = (chunkSize + 3) & ~3;
-
-    if (!ESP.flashRead(readOffset, (uint32_t*)chunk, alignedSize)) {
-      Serial.println(F("[FlashPers] Manifest lesen fehlgeschlagen"));
-      return ResourceResult::fail(ResourceError::OPERATION_FAILED, F("Manifest read failed"));
-    }
-
-    for (uint32_t i = 0; i < chunkSize; i++) {
-      manifest += chunk[i];
-    }
-
-    bytesRead += chunkSize;
-    readOffset += alignedSize;
-  }
+  // The manifest is parsed line by line while a second reader follows the
+  // file data behind it, so neither is copied into RAM
+  uint32_t manifestOffset = getSlotOffset(slot) + FP_FLASH_SECTOR_SIZE + header.prefsSize;
+  FlashReader manifestReader(manifestOffset);
+  FlashReader reader(manifestOffset + manifestSize);
+  LineReader lines(manifestReader, manifestSize);
 
   // Parse manifest: first line = file count, then filename|size
-  int lineStart = 0;
-  int lineEnd = manifest.indexOf('\n');
-
-  if (lineEnd == -1) {
+  const char* line = lines.next();
+  if (!line) {
     Serial.println(F("[FlashPers] Ungültiges Manifest-Format"));
     return ResourceResult::fail(ResourceError::VALIDATION_ERROR, F("Invalid manifest"));
   }
 
-  uint8_t fileCount = manifest.substring(lineStart, lineEnd).toInt();
+  uint8_t fileCount = strtoul(line, nullptr, 10);
   Serial.print(F("[FlashPers] "));
   Serial.print(fileCount);
   Serial.println(F(" Dateien im Manifest"));
@@ -840,24 +979,21 @@ ResourceResult FlashPersistence::restoreJsonFromFlash() {
     LittleFS.mkdir("/config");
   }
 
-  lineStart = lineEnd + 1;
-
-  // Restore each file
+  // Restore each file; the files follow the manifest back to back
   for (uint8_t i = 0; i < fileCount; i++) {
-    lineEnd = manifest.indexOf('\n', lineStart);
-    if (lineEnd == -1)
+    char* entry = lines.next();
+    if (!entry)
       break;
 
-    String line = manifest.substring(lineStart, lineEnd);
-    int pipePos = line.indexOf('|');
-
-    if (pipePos == -1) {
-      lineStart = lineEnd + 1;
-      continue;
+    char* pipe = strchr(entry, '|');
+    if (!pipe) {
+      Serial.println(F("[FlashPers] Ungültiger Manifest-Eintrag"));
+      return ResourceResult::fail(ResourceError::VALIDATION_ERROR, F("Invalid manifest entry"));
     }
 
-    String filename = line.substring(0, pipePos);
-    size_t fileSize = line.substring(pipePos + 1).toInt();
+    *pipe = '\0';
+    const char* filename = entry;
+    size_t fileSize = strtoul(pipe + 1, nullptr, 10);
 
     Serial.print(F("[FlashPers] Wiederherstellung: "));
     Serial.print(filename);
@@ -865,15 +1001,14 @@ ResourceResult FlashPersistence::restoreJsonFromFlash() {
     Serial.print(fileSize);
     Serial.println(F(" Bytes)"));
 
-    // Read file from flash and write to LittleFS
-    String dstPath = "/config/" + filename;
+    // Read file from flash and write to LittleFS; the data is read even if
+    // the file cannot be created, so the next file starts at the right place
+    char dstPath[48];
+    snprintf(dstPath, sizeof(dstPath), "/config/%s", filename);
     File dst = LittleFS.open(dstPath, "w");
-
     if (!dst) {
       Serial.print(F("[FlashPers] Konnte nicht erstellen: "));
       Serial.println(dstPath);
-      lineStart = lineEnd + 1;
-      continue;
     }
 
     size_t fileRead = 0;
@@ -881,29 +1016,26 @@ ResourceResult FlashPersistence::restoreJsonFromFlash() {
       uint8_t buffer[128];
       size_t chunkSize =
           (fileSize - fileRead > sizeof(buffer)) ? sizeof(buffer) : (fileSize - fileRead);
-      uint32_t alignedSize = (chunkSize + 3) & ~3;
-      uint32_t alignedBuffer[32];
 
-      if (!ESP.flashRead(readOffset, alignedBuffer, alignedSize)) {
+      if (!reader.read(buffer, chunkSize)) {
         Serial.println(F("[FlashPers] Datei-Lesen fehlgeschlagen"));
-        dst.close();
-        lineStart = lineEnd + 1;
-        break;
+        if (dst)
+          dst.close();
+        return ResourceResult::fail(ResourceError::OPERATION_FAILED, F("File read failed"));
+      }
+      if (dst) {
+        dst.write(buffer, chunkSize);
       }
-
-      memcpy(buffer, alignedBuffer, chunkSize);
-      dst.write(buffer, chunkSize);
 
       fileRead += chunkSize;
-      readOffset += alignedSize;
       yield();
     }
 
-    dst.close();
-    Serial.print(F("[FlashPers] OK: "));
-    Serial.println(filename);
-
-    lineStart = lineEnd + 1;
+    if (dst) {
+      dst.close();
+      Serial.print(F("[FlashPers] OK: "));
+      Serial.println(filename);
+    }
   }
 
   Serial.println(F("[FlashPers] JSON-Wiederherstellung abgeschlossen"));
@@ -15,11 +15,38 @@
  * @brief Stores Preferences as simple key=value text format in flash
  *
  * Format: Each line is "namespace:key=value"
- * No JSON parsing needed - just String.indexOf() and substring()
- * Minimal heap allocations during restore
+ * The text is streamed into flash on save and parsed line by line in a fixed
+ * buffer on restore, so neither direction builds a String of the whole text
+ * and the heap used by a restore does not depend on the size of the config.
+ *
+ * The backup image (Preferences text, then a manifest and the JSON config
+ * files plus the measurement store) is written alternately into two slots A and B. Each slot starts with
+ * a header sector holding a sequence number and the CRC of the image; restore
+ * uses the valid slot with the highest sequence number, so a power cut during
+ * a backup leaves the previous backup intact. Data sectors whose content is
+ * already in flash are neither erased nor programmed.
+ *
+ * Flash layout: the slots sit in the free OTA area behind the sketch, after
+ * FP_SAFETY_MARGIN_SECTORS (40 KB). Both slots need FP_SLOT_COUNT *
+ * FP_SLOT_SIZE = 88 KB; the former single area needed 40 KB. Without that much
+ * free sketch space no backup can be written; checkFlashSpace() reports this
+ * at boot and a filesystem update is refused.
  */
 class FlashPersistence {
 public:
+  /**
+   * @brief Statistics of the last backup and restore since boot
+   */
+  struct Stats {
+    uint32_t backupMs{0};         ///< Duration of the last backup
+    uint32_t sectorsErased{0};    ///< Sectors erased by the last backup (header included)
+    uint32_t sectorsUnchanged{0}; ///< Data sectors of the last backup already in flash
+    uint32_t imageBytes{0};       ///< Size of the last backup image
+    uint32_t restoreMs{0};        ///< Duration of the last restore
+    uint32_t sequence{0};         ///< Sequence number of the last backup or restore
+    int8_t slot{-1};              ///< Slot of the last backup or restore (0 = A, 1 = B)
+  };
+
   /**
    * @brief Save all Preferences to flash as simple text
    */
@@ -42,6 +69,8 @@ public:
 
   /**
    * @brief Save all Preferences AND config JSON files to flash
+   * @details Pending sensor updates are flushed first, so the measurement
+   *          store in the backup holds the current settings and min/max values.
    * @return ResourceResult indicating success or failure
    */
   static ResourceResult saveAllToFlash();
@@ -52,29 +81,86 @@ public:
    */
   static ResourceResult restoreAllFromFlash();
 
+  /**
+   * @brief Check that both backup slots fit behind the sketch
+   * @details Logs an error with the required and the free bytes otherwise.
+   * @return ResourceResult, INSUFFICIENT_SPACE if backups are not possible
+   */
+  static ResourceResult checkFlashSpace();
+
+  /**
+   * @brief Get backup and restore statistics
+   * @return Statistics since boot
+   */
+  static const Stats& getStats();
+
 private:
   FlashPersistence() = default;
 
   // Magic number to identify our data
   static constexpr uint32_t FP_MAGIC_NUMBER = 0x50464C54; // "PFLT"
-  static constexpr uint8_t FP_VERSION = 4;                // Version 4 = text format + config files
+  static constexpr uint8_t FP_VERSION = 5;                // Version 5 = A/B slots
 
   // Flash layout constants
   static constexpr uint32_t FP_SAFETY_MARGIN_SECTORS = 10;
-  static constexpr uint32_t FP_MAX_CONFIG_SIZE = 64 * 1024;
   static constexpr uint32_t FP_FLASH_SECTOR_SIZE = 4096;
 
   // Separate storage areas to avoid heap exhaustion
   static constexpr uint32_t FP_PREFS_MAX_SIZE = 8 * 1024; // 8KB for Preferences
   static constexpr uint32_t FP_JSON_MAX_SIZE = 32 * 1024; // 32KB for JSON configs
 
+  // A slot is one header sector followed by the image sectors
+  static constexpr uint32_t FP_SLOT_DATA_SIZE = FP_PREFS_MAX_SIZE + FP_JSON_MAX_SIZE;
+  static constexpr uint32_t FP_SLOT_SIZE = FP_FLASH_SECTOR_SIZE + FP_SLOT_DATA_SIZE;
+  static constexpr uint8_t FP_SLOT_COUNT = 2;
+  static_assert(FP_SLOT_COUNT * FP_SLOT_SIZE == 88 * 1024,
+                "Backup footprint changed, update the layout note above");
+
+  /**
+   * @brief Slot header at the start of the header sector
+   */
+  struct SlotHeader {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t reserved[3];
+    uint32_t sequence;     ///< Higher is newer
+    uint32_t prefsSize;    ///< Bytes of Preferences text at the start of the image
+    uint32_t manifestSize; ///< Bytes of the JSON manifest behind the Preferences text
+    uint32_t imageSize;    ///< Total image bytes
+    uint32_t imageCrc;     ///< CRC32 of the image
+    uint32_t headerCrc;    ///< CRC32 of the fields above
+  };
+  static_assert(sizeof(SlotHeader) % 4 == 0, "flashWrite needs whole words");
+
   static uint32_t getSafeOffset();
-  static uint32_t getJsonStorageOffset(); // Second area for JSON files
+  static uint32_t getSlotOffset(uint8_t slot);
   static uint32_t calculateCRC32(const uint8_t* data, size_t length);
 
-  // Helper methods for JSON storage
-  static ResourceResult saveJsonToFlash();
-  static ResourceResult restoreJsonFromFlash();
+  /**
+   * @brief Read a slot header and verify it and the image behind it
+   * @param slot Slot index
+   * @param header Header of the slot (output)
+   * @return true if header and image are intact
+   */
+  static bool readValidSlot(uint8_t slot, SlotHeader& header);
+
+  /**
+   * @brief Find the valid slot with the highest sequence number
+   * @param header Header of that slot (output)
+   * @return Slot index or -1 if no slot is valid
+   */
+  static int8_t findNewestSlot(SlotHeader& header);
+
+  /**
+   * @brief Write a backup image into the older slot
+   * @param includeJson Whether to add the JSON config files
+   * @return ResourceResult indicating success or failure
+   */
+  static ResourceResult writeBackup(bool includeJson);
+
+  // Helper methods for restoring the parts of the image
+  static ResourceResult restorePrefs(uint8_t slot, const SlotHeader& header);
+  static ResourceResult restoreJson(uint8_t slot, const SlotHeader& header);
 };
 
 #endif // FLASH_PERSISTENCE_H
@@ -2,9 +2,11 @@
 #include "utils/helper.h"
 
 #include <LittleFS.h>
+#include <umm_malloc/umm_malloc.h>
 
 #include "logger/logger.h"
 #include "utils/critical_section.h"
+#include "utils/file_io_queue.h"
 
 // Forward declaration for the static helper in wifi.cpp
 extern bool tryAllWiFiCredentials();
@@ -47,7 +49,23 @@ time_t Helper::getCurrentTime() {
   return logger.getSynchronizedTime();
 }
 
+// The reboot counter only changes in incrementRebootCount(); -1 = not read yet
+static int32_t s_rebootCount = -1;
+
+// Main loop rate, evaluated in one-second windows
+static uint32_t s_loopCount = 0;
+static uint32_t s_loopsPerSecond = 0;
+static unsigned long s_loopWindowStart = 0;
+static float s_allocsPerLoop = -1.0f;
+#ifdef UMM_STATS_FULL
+static size_t s_allocWindowStart = 0;
+#endif
+
 uint32_t Helper::getRebootCount() {
+  if (s_rebootCount >= 0) {
+    return s_rebootCount;
+  }
+
   CriticalSection cs;
 
   if (!LittleFS.exists(REBOOT_COUNT_FILE)) {
@@ -61,9 +79,29 @@ uint32_t Helper::getRebootCount() {
 
   String countStr = file.readString();
   file.close();
-  return countStr.toInt();
+  s_rebootCount = countStr.toInt();
+  return s_rebootCount;
+}
+
+void Helper::countLoopIteration() {
+  s_loopCount++;
+  unsigned long elapsed = millis() - s_loopWindowStart;
+  if (elapsed >= 1000) {
+    s_loopsPerSecond = s_loopCount * 1000UL / elapsed;
+#ifdef UMM_STATS_FULL
+    size_t allocs = umm_get_malloc_count() + umm_get_realloc_count();
+    s_allocsPerLoop = static_cast<float>(allocs - s_allocWindowStart) / s_loopCount;
+    s_allocWindowStart = allocs;
+#endif
+    s_loopCount = 0;
+    s_loopWindowStart += elapsed;
+  }
 }
 
+uint32_t Helper::getLoopsPerSecond() { return s_loopsPerSecond; }
+
+float Helper::getAllocationsPerLoop() { return s_allocsPerLoop; }
+
 String Helper::getFormattedUptime() {
   unsigned long uptime = millis() / 1000;
   unsigned int days = uptime / 86400;
@@ -97,15 +135,13 @@ ResourceResult Helper::incrementRebootCount() {
   }
   count++;
 
-  file = LittleFS.open(F("/reboot_count.txt"), "w");
-  if (!file) {
+  // Written from loop() by the I/O queue; the counter is served from RAM
+  if (!FileIoQueue::getInstance().write(REBOOT_COUNT_FILE, String(count) + F("\r\n"))) {
     return ResourceResult::fail(ResourceError::FILESYSTEM_ERROR,
-                                F("Fehler beim Öffnen der Neustartzähler-Datei zum Schreiben"));
+                                F("Fehler beim Schreiben der Neustartzähler-Datei"));
   }
-
-  file.println(count);
-  file.close();
-  logger.debug(F("Helper"), F("Neustartzähler erhöht auf: ") + String(count));
+  s_rebootCount = count;
+  LOG_DEBUG(F("Helper"), F("Neustartzähler erhöht auf: ") + String(count));
   return ResourceResult::success();
 }
 
@@ -47,7 +47,7 @@ public:
                                     F(": ") + result.getMessage());
         return false;
       }
-      logger.debug(F("main"), String(componentName) + F(" erfolgreich initialisiert"));
+      LOG_DEBUG(F("main"), String(componentName) + F(" erfolgreich initialisiert"));
       return true;
     } catch (const std::exception& e) {
       logger.error(F("main"), String(F("Ausnahme während der Initialisierung von ")) +
@@ -89,10 +89,35 @@ public:
    * @brief Get system reboot count
    * @return Number of system reboots
    * @details Retrieves the number of times the system has been rebooted.
-   *          Value is persisted in flash memory across reboots.
+   *          Value is persisted in flash memory across reboots; the file is
+   *          read once and then served from RAM.
    */
   static uint32_t getRebootCount();
 
+  /**
+   * @brief Count one iteration of the main loop
+   * @details Called once per loop(); the rate is evaluated in one-second
+   *          windows.
+   */
+  static void countLoopIteration();
+
+  /**
+   * @brief Get the main loop rate
+   * @return Loop iterations per second over the last full window
+   */
+  static uint32_t getLoopsPerSecond();
+
+  /**
+   * @brief Get the heap allocations per main loop iteration
+   * @details Counts malloc() and realloc() calls, e.g. from String
+   *          concatenation, in the windows of countLoopIteration(). The
+   *          allocator only counts them in a build with UMM_STATS_FULL
+   *          (env:debug).
+   * @return Allocations per iteration over the last full window, or -1 if
+   *         they are not counted
+   */
+  static float getAllocationsPerLoop();
+
   /**
    * @brief Format uptime into human readable string
    * @return Formatted uptime string
@@ -104,7 +129,7 @@ public:
   /**
    * @brief Increment and save reboot counter to flash
    * @return ResourceResult indicating success or failure
-   * @details Increments the reboot counter and persists it to flash memory.
+   * @details Increments the reboot counter and queues it in FileIoQueue.
    *          Should be called during system initialization.
    */
   static ResourceResult incrementRebootCount();
@@ -0,0 +1,278 @@
+/**
+ * @file log_store.cpp
+ * @brief Implementation of the log-structured LittleFS record store
+ */
+
+#include "utils/log_store.h"
+
+#include <algorithm>
+
+#include "logger/logger.h"
+#include "utils/crc32.h"
+
+LogStore::LogStore(const char* path, size_t segmentSize, size_t maxKeys)
+    : m_path(path), m_segmentSize(segmentSize), m_maxKeys(maxKeys) {}
+
+String LogStore::tmpPath() const { return m_path + ".tmp"; }
+
+bool LogStore::openLog() {
+  m_file = LittleFS.open(m_path, "a+");
+  return static_cast<bool>(m_file);
+}
+
+int LogStore::findIndex(uint32_t key) const {
+  auto it = std::lower_bound(m_index.begin(), m_index.end(), key,
+                             [](const IndexEntry& e, uint32_t k) { return e.key < k; });
+  if (it == m_index.end() || it->key != key) {
+    return -1;
+  }
+  return static_cast<int>(it - m_index.begin());
+}
+
+bool LogStore::updateIndex(uint32_t key, uint32_t offset, size_t valueLength) {
+  uint32_t location = (static_cast<uint32_t>(valueLength) << 24) | (offset & OFFSET_MASK);
+  auto it = std::lower_bound(m_index.begin(), m_index.end(), key,
+                             [](const IndexEntry& e, uint32_t k) { return e.key < k; });
+  if (it != m_index.end() && it->key == key) {
+    m_liveBytes -= recordSize(it->location >> 24);
+    it->location = location;
+  } else {
+    if (m_index.size() >= m_maxKeys) {
+      return false;
+    }
+    m_index.insert(it, IndexEntry{key, location});
+  }
+  m_liveBytes += recordSize(valueLength);
+  return true;
+}
+
+bool LogStore::readRecord(File& file, uint32_t offset, uint32_t& key, uint8_t* value,
+                          size_t& length) {
+  uint8_t header[RECORD_HEADER_SIZE];
+  if (!file.seek(offset, SeekSet) || file.read(header, sizeof(header)) != sizeof(header) ||
+      header[0] != RECORD_MAGIC) {
+    return false;
+  }
+  length = header[1];
+  memcpy(&key, header + 2, sizeof(key));
+
+  uint32_t storedCrc;
+  if (file.read(value, length) != length ||
+      file.read(reinterpret_cast<uint8_t*>(&storedCrc), sizeof(storedCrc)) != sizeof(storedCrc)) {
+    return false;
+  }
+  uint32_t crc = updateCRC32(CRC32_INITIAL, header, sizeof(header));
+  crc = ~updateCRC32(crc, value, length);
+  return crc == storedCrc;
+}
+
+ResourceResult LogStore::mount() {
+  unsigned long start = millis();
+  if (m_file) {
+    m_file.close();
+  }
+  m_index.clear();
+  m_liveBytes = 0;
+  m_size = 0;
+  m_mounted = false;
+
+  // A compaction that stopped between remove and rename left only the copy
+  if (!LittleFS.exists(m_path) && LittleFS.exists(tmpPath())) {
+    LittleFS.rename(tmpPath(), m_path);
+  } else if (LittleFS.exists(tmpPath())) {
+    LittleFS.remove(tmpPath());
+  }
+
+  if (!openLog()) {
+    return ResourceResult::fail(ResourceError::FILESYSTEM_ERROR,
+                                F("Log-Datei konnte nicht geöffnet werden: ") + m_path);
+  }
+
+  // Sequential scan: the newest record of a key wins
+  uint8_t value[MAX_VALUE_SIZE];
+  uint32_t fileSize = m_file.size();
+  uint32_t offset = 0;
+  while (offset + recordSize(0) <= fileSize) {
+    uint32_t key;
+    size_t length;
+    if (!readRecord(m_file, offset, key, value, length) ||
+        offset + recordSize(length) > fileSize) {
+      break;
+    }
+    if (!updateIndex(key, offset, length)) {
+      logger.warning(F("LogStore"), F("Index voll, ignoriere Schlüssel ") + String(key));
+    }
+    offset += recordSize(length);
+  }
+
+  // Cut off a record torn by a power loss so new records stay reachable
+  if (offset < fileSize) {
+    logger.warning(F("LogStore"), m_path + F(" gekürzt auf ") + String(offset) + F(" Bytes"));
+    m_file.truncate(offset);
+  }
+  m_size = offset;
+  m_mounted = true;
+  m_stats.mountMs = millis() - start;
+  return ResourceResult::success();
+}
+
+bool LogStore::append(uint32_t key, const void* value, size_t length) {
+  if (!m_mounted || length > MAX_VALUE_SIZE) {
+    return false;
+  }
+  if (findIndex(key) < 0 && m_index.size() >= m_maxKeys) {
+    logger.error(F("LogStore"), F("Index voll, Schlüssel ") + String(key) + F(" abgelehnt"));
+    return false;
+  }
+
+  uint8_t header[RECORD_HEADER_SIZE];
+  header[0] = RECORD_MAGIC;
+  header[1] = static_cast<uint8_t>(length);
+  memcpy(header + 2, &key, sizeof(key));
+  uint32_t crc = updateCRC32(CRC32_INITIAL, header, sizeof(header));
+  crc = ~updateCRC32(crc, static_cast<const uint8_t*>(value), length);
+
+  // O_APPEND: the record always lands at the end of the log
+  size_t written = m_file.write(header, sizeof(header));
+  written += m_file.write(static_cast<const uint8_t*>(value), length);
+  written += m_file.write(reinterpret_cast<const uint8_t*>(&crc), sizeof(crc));
+  if (written != recordSize(length)) {
+    logger.error(F("LogStore"), F("Schreibfehler in ") + m_path);
+    return false;
+  }
+
+  updateIndex(key, m_size, length);
+  m_size += written;
+  m_stats.recordsAppended++;
+  m_stats.bytesAppended += written;
+  return true;
+}
+
+bool LogStore::commit() {
+  if (!m_mounted) {
+    return false;
+  }
+  m_file.flush();
+
+  // Compact only if it frees at least half a segment, so a log whose live
+  // data alone is close to the segment size is not rewritten on every commit
+  if (m_size >= m_segmentSize && m_size - m_liveBytes >= m_segmentSize / 2) {
+    // An aborted compaction keeps the flushed log, so the records are durable
+    return compact() || m_mounted;
+  }
+  return true;
+}
+
+bool LogStore::compact() {
+  unsigned long start = millis();
+  File out = LittleFS.open(tmpPath(), "w");
+  if (!out) {
+    logger.error(F("LogStore"), F("Kompaktierung: ") + tmpPath() + F(" nicht beschreibbar"));
+    return false;
+  }
+
+  // Copy the newest record of every key; offsets are rewritten in place
+  uint8_t value[MAX_VALUE_SIZE];
+  uint32_t newOffset = 0;
+  std::vector<IndexEntry> newIndex = m_index;
+  for (auto& entry : newIndex) {
+    uint32_t key;
+    size_t length;
+    if (!readRecord(m_file, entry.location & OFFSET_MASK, key, value, length)) {
+      out.close();
+      LittleFS.remove(tmpPath());
+      logger.error(F("LogStore"), F("Kompaktierung abgebrochen: Datensatz defekt"));
+      return false;
+    }
+    uint8_t header[RECORD_HEADER_SIZE] = {RECORD_MAGIC, static_cast<uint8_t>(length)};
+    memcpy(header + 2, &key, sizeof(key));
+    uint32_t crc = updateCRC32(CRC32_INITIAL, header, sizeof(header));
+    crc = ~updateCRC32(crc, value, length);
+    size_t written = out.write(header, sizeof(header));
+    written += out.write(value, length);
+    written += out.write(reinterpret_cast<const uint8_t*>(&crc), sizeof(crc));
+    if (written != recordSize(length)) {
+      // Filesystem full or write error: the original log stays in place
+      out.close();
+      LittleFS.remove(tmpPath());
+      logger.error(F("LogStore"), F("Kompaktierung abgebrochen: Schreibfehler in ") + tmpPath());
+      return false;
+    }
+    entry.location = (static_cast<uint32_t>(length) << 24) | newOffset;
+    newOffset += recordSize(length);
+    yield();
+  }
+  out.close();
+
+  // The size of the closed file shows whether the last data reached the flash
+  File copy = LittleFS.open(tmpPath(), "r");
+  uint32_t copiedSize = copy ? copy.size() : 0;
+  if (copy) {
+    copy.close();
+  }
+  if (copiedSize != newOffset) {
+    LittleFS.remove(tmpPath());
+    logger.error(F("LogStore"), F("Kompaktierung abgebrochen: ") + tmpPath() + F(" hat ") +
+                                    String(copiedSize) + F(" statt ") + String(newOffset) +
+                                    F(" Bytes"));
+    return false;
+  }
+  m_file.close();
+
+  // The rename is the switch-over; mount() finishes it after a power loss
+  LittleFS.remove(m_path);
+  if (!LittleFS.rename(tmpPath(), m_path) || !openLog()) {
+    logger.error(F("LogStore"), F("Kompaktierung: Umbenennen fehlgeschlagen"));
+    m_mounted = false;
+    return false;
+  }
+
+  m_index.swap(newIndex);
+  m_size = newOffset;
+  m_liveBytes = newOffset;
+  m_stats.compactions++;
+  logger.info(F("LogStore"), m_path + F(" kompaktiert auf ") + String(newOffset) + F(" Bytes in ") +
+                                 String(millis() - start) + F(" ms"));
+  return true;
+}
+
+bool LogStore::read(uint32_t key, void* value, size_t maxLength, size_t& length) {
+  int index = findIndex(key);
+  if (index < 0) {
+    return false;
+  }
+  uint8_t buffer[MAX_VALUE_SIZE];
+  uint32_t storedKey;
+  if (!readRecord(m_file, m_index[index].location & OFFSET_MASK, storedKey, buffer, length) ||
+      storedKey != key) {
+    return false;
+  }
+  if (length > maxLength) {
+    length = maxLength;
+  }
+  memcpy(value, buffer, length);
+  return true;
+}
+
+bool LogStore::clear() {
+  if (m_file) {
+    m_file.close();
+  }
+  m_index.clear();
+  m_size = 0;
+  m_liveBytes = 0;
+  LittleFS.remove(tmpPath());
+  bool removed = !LittleFS.exists(m_path) || LittleFS.remove(m_path);
+  if (m_mounted && !openLog()) {
+    m_mounted = false;
+  }
+  return removed;
+}
+
+LogStore::Stats LogStore::getStats() const {
+  Stats stats = m_stats;
+  stats.logBytes = m_size;
+  stats.liveBytes = m_liveBytes;
+  stats.liveRecords = m_index.size();
+  return stats;
+}
@@ -0,0 +1,153 @@
+/**
+ * @file log_store.h
+ * @brief Log-structured key-value record store on LittleFS
+ * @details Records are appended to a single log file as
+ *          [magic][value length][key (4 bytes)][value][CRC32 (4 bytes)].
+ *          A sorted RAM index maps every key to the offset of its newest
+ *          record; it is rebuilt by one sequential scan at mount. Once the log
+ *          reaches its segment size, the live records are copied into a fresh
+ *          file that replaces the log with a single rename (compaction).
+ *          Only LittleFS and the CRC32 helper are used, so the store also
+ *          builds on the host.
+ */
+#ifndef LOG_STORE_H
+#define LOG_STORE_H
+
+#include <Arduino.h>
+#include <LittleFS.h>
+
+#include <vector>
+
+#include "utils/result_types.h"
+
+/**
+ * @class LogStore
+ * @brief Append-only key-value store with CRC-protected records
+ * @details Values are opaque byte strings of up to MAX_VALUE_SIZE bytes.
+ *          append() only writes to the open log; commit() makes the appended
+ *          records durable. A record torn by a power loss fails its CRC and is
+ *          cut off at the next mount.
+ */
+class LogStore {
+public:
+  /// Largest value a record can hold
+  static constexpr size_t MAX_VALUE_SIZE = 255;
+  /// Bytes in front of the value (magic, length, key)
+  static constexpr size_t RECORD_HEADER_SIZE = 6;
+  /// Bytes behind the value (CRC32)
+  static constexpr size_t RECORD_TRAILER_SIZE = 4;
+
+  /**
+   * @brief Store statistics
+   */
+  struct Stats {
+    uint32_t logBytes{0};        ///< Current size of the log file
+    uint32_t liveBytes{0};       ///< Bytes of the newest record of every key
+    uint32_t liveRecords{0};     ///< Number of keys
+    uint32_t recordsAppended{0}; ///< Records appended since mount
+    uint32_t bytesAppended{0};   ///< Bytes appended since mount
+    uint32_t compactions{0};     ///< Compactions since mount
+    uint32_t mountMs{0};         ///< Duration of the last mount scan
+  };
+
+  /**
+   * @brief Create a store
+   * @param path Log file path
+   * @param segmentSize Log size that triggers a compaction
+   * @param maxKeys Capacity of the RAM index
+   */
+  LogStore(const char* path, size_t segmentSize, size_t maxKeys);
+
+  /**
+   * @brief Open the log and rebuild the RAM index
+   * @details Finishes an interrupted compaction and cuts off torn records.
+   * @return ResourceResult indicating success or failure
+   */
+  ResourceResult mount();
+
+  /// @return true once mount() succeeded
+  bool isMounted() const { return m_mounted; }
+
+  /**
+   * @brief Append a record; supersedes any older record of the key
+   * @param key Record key
+   * @param value Value bytes
+   * @param length Number of value bytes (at most MAX_VALUE_SIZE)
+   * @return true if the record was written
+   */
+  bool append(uint32_t key, const void* value, size_t length);
+
+  /**
+   * @brief Make all appended records durable and compact if the log is full
+   * @details A compaction that cannot write its copy (e.g. filesystem full)
+   *          removes the copy and keeps the log unchanged.
+   * @return true if the records are durable
+   */
+  bool commit();
+
+  /**
+   * @brief Read the newest value of a key
+   * @param key Record key
+   * @param value Output buffer
+   * @param maxLength Size of the output buffer
+   * @param length Number of bytes read
+   * @return true if the key exists and its record is intact
+   */
+  bool read(uint32_t key, void* value, size_t maxLength, size_t& length);
+
+  /**
+   * @brief Check whether a key has a record
+   * @param key Record key
+   * @return true if the key exists
+   */
+  bool contains(uint32_t key) const { return findIndex(key) >= 0; }
+
+  /**
+   * @brief Remove all records and the log file
+   * @return true on success
+   */
+  bool clear();
+
+  /**
+   * @brief Get store statistics
+   * @return Current statistics
+   */
+  Stats getStats() const;
+
+private:
+  /// Marks the start of every record
+  static constexpr uint8_t RECORD_MAGIC = 0xA5;
+  /// The upper 8 bits of IndexEntry::location hold the value length
+  static constexpr uint32_t OFFSET_MASK = 0x00FFFFFF;
+
+  /**
+   * @brief RAM index entry: key and location of its newest record
+   */
+  struct IndexEntry {
+    uint32_t key;
+    uint32_t location; ///< Value length << 24 | record offset
+  };
+
+  static uint32_t recordSize(size_t valueLength) {
+    return RECORD_HEADER_SIZE + valueLength + RECORD_TRAILER_SIZE;
+  }
+
+  int findIndex(uint32_t key) const;
+  bool updateIndex(uint32_t key, uint32_t offset, size_t valueLength);
+  bool readRecord(File& file, uint32_t offset, uint32_t& key, uint8_t* value, size_t& length);
+  bool compact();
+  bool openLog();
+  String tmpPath() const;
+
+  String m_path;
+  size_t m_segmentSize;
+  size_t m_maxKeys;
+  bool m_mounted{false};
+  File m_file;
+  uint32_t m_size{0};
+  uint32_t m_liveBytes{0};
+  std::vector<IndexEntry> m_index;
+  Stats m_stats;
+};
+
+#endif // LOG_STORE_H
@@ -17,6 +17,28 @@ int g_activeWiFiSlot = -1; // -1 means not connected
 // Track WiFi connection attempts for display
 String g_wifiAttemptsInfo = "";
 
+// Set by the config subscription when a stored SSID or password changes
+static bool g_credentialsChanged = false;
+
+/**
+ * @brief Subscribe to the WiFi credential keys once
+ * @details Changes arrive with interrupts disabled, so only a flag is set.
+ */
+static void subscribeCredentialChanges() {
+  static bool subscribed = false;
+  if (subscribed) {
+    return;
+  }
+  subscribed = true;
+  static constexpr ConfigKey CREDENTIAL_KEYS[] = {
+      ConfigKey::WIFI_SSID_1,     ConfigKey::WIFI_SSID_2,     ConfigKey::WIFI_SSID_3,
+      ConfigKey::WIFI_PASSWORD_1, ConfigKey::WIFI_PASSWORD_2, ConfigKey::WIFI_PASSWORD_3};
+  auto onChange = [](ConfigKey, const ConfigValue&) { g_credentialsChanged = true; };
+  for (ConfigKey key : CREDENTIAL_KEYS) {
+    ConfigMgr.subscribeConfigKey(key, onChange);
+  }
+}
+
 /**
  * @brief Attempt to connect to WiFi using up to 3 credentials.
  * @details Tries each SSID/PASSWORD pair in order. Returns true if connected,
@@ -75,7 +97,7 @@ bool tryAllWiFiCredentials() {
     const int MAX_ATTEMPTS = 20; // 10 seconds (20 * 500ms)
     while (WiFi.status() != WL_CONNECTED && attempts < MAX_ATTEMPTS) {
       delay(500);
-      logger.debug(F("WiFi"), F("."));
+      LOG_DEBUG(F("WiFi"), F("."));
       attempts++;
 
       // Update display every 2 seconds (every 4 attempts)
@@ -155,6 +177,8 @@ void startAPMode() {
 bool isCaptivePortalAPActive() { return apModeActive; }
 
 ResourceResult setupWiFi() {
+  subscribeCredentialChanges();
+  g_credentialsChanged = false;
   WiFi.mode(WIFI_STA);
   WiFi.setAutoReconnect(true);
 
@@ -225,6 +249,12 @@ TypedResult<ResourceError, bool> checkPort(uint16_t port) {
   }
 }
 
+bool takeWiFiCredentialsChanged() {
+  bool changed = g_credentialsChanged;
+  g_credentialsChanged = false;
+  return changed;
+}
+
 int getActiveWiFiSlot() { return g_activeWiFiSlot; }
 
 String getWiFiConnectionAttemptsInfo() { return g_wifiAttemptsInfo; }
@@ -304,7 +334,7 @@ bool tryAllWiFiCredentialsWithDisplay(std::function<void(const String&, bool)> d
     const int MAX_ATTEMPTS = 20; // 10 seconds (20 * 500ms)
     while (WiFi.status() != WL_CONNECTED && attempts < MAX_ATTEMPTS) {
       delay(500);
-      logger.debug(F("WiFi"), F("."));
+      LOG_DEBUG(F("WiFi"), F("."));
       attempts++;
 
       // Show progress every 2 seconds
@@ -79,6 +79,14 @@ bool isCaptivePortalAPActive();
 
 extern bool apModeActive;
 
+/**
+ * @brief Check whether WiFi credentials changed since the last setupWiFi()
+ * @details Clears the flag. Lets the main loop leave AP mode once the user
+ *          stored new credentials.
+ * @return true if an SSID or password was changed
+ */
+bool takeWiFiCredentialsChanged();
+
 // Forward declaration for internal WiFi credential cycling helper
 bool tryAllWiFiCredentials();
 
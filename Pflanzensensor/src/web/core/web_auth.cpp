@@ -12,7 +12,7 @@
 #include "logger/logger.h"
 
 WebAuth::WebAuth(ESP8266WebServer& server) : _server(server) {
-  logger.debug(F("WebAuth"), F("Initialisiere WebAuth"));
+  LOG_DEBUG(F("WebAuth"), F("Initialisiere WebAuth"));
 }
 
 String WebAuth::base64_decode(const String& input) {
@@ -67,7 +67,7 @@ bool WebAuth::authenticate(UserRole requiredRole) {
 void WebAuth::setCredentials(const String& username, const String& password, UserRole role) {
   _credentials[username] = password;
   _roles[username] = role;
-  logger.debug(F("WebAuth"), String(F("Zugangsdaten gesetzt für Benutzer: ")) + username);
+  LOG_DEBUG(F("WebAuth"), String(F("Zugangsdaten gesetzt für Benutzer: ")) + username);
 }
 
 String WebAuth::createSession(const String& username, UserRole role) {
@@ -116,8 +116,8 @@ void WebAuth::cleanupSessions() {
 
   while (it != _sessions.end()) {
     if (now - it->second.lastAccess > SESSION_TIMEOUT) {
-      logger.debug(F("WebAuth"),
-                   String(F("Entferne abgelaufene Sitzung für Benutzer: ")) + it->second.username);
+      LOG_DEBUG(F("WebAuth"),
+                String(F("Entferne abgelaufene Sitzung für Benutzer: ")) + it->second.username);
       it = _sessions.erase(it);
     } else {
       ++it;
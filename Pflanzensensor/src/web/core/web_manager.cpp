@@ -65,8 +65,8 @@ void WebManager::handleClientInternal() {
 
     // Only log if handler count has changed
     if (currentHandlerCount != lastHandlerCount) {
-      logger.debug(F("WebManager"), F("Active handlers: ") + String(currentHandlerCount) + F("/") +
-                                        String(MAX_ACTIVE_HANDLERS));
+      LOG_DEBUG(F("WebManager"), F("Active handlers: ") + String(currentHandlerCount) + F("/") +
+                                     String(MAX_ACTIVE_HANDLERS));
       lastHandlerCount = currentHandlerCount;
     }
 
@@ -87,6 +87,11 @@ void WebManager::handleClientInternal() {
     auto& ws = WebSocketService::getInstance();
     if (ws.isInitialized()) {
       ws.loop();
+      // Log lines queued for the clients; not looked up through the cache,
+      // which would keep the handler from being evicted
+      if (LogHandler::s_instance) {
+        LogHandler::s_instance->loop();
+      }
     }
 #endif
   }
@@ -116,7 +121,7 @@ void WebManager::stop() {
   delay(100);
   yield();
 
-  logger.debug(F("WebManager"), F("WebManager stopped and cleaned up"));
+  LOG_DEBUG(F("WebManager"), F("WebManager stopped and cleaned up"));
   logger.endMemoryTracking(F("web_manager_stop"));
 }
 
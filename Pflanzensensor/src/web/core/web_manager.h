@@ -105,6 +105,13 @@ public:
    */
   bool isInitialized() const { return _initialized; }
 
+  /**
+   * @brief Check if an HTTP client is being served
+   * @return true while a request is read or its connection is kept open
+   * @details Used by FileIoQueue to defer file writes until the server is idle.
+   */
+  bool isClientPending() { return _initialized && _server && _server->client().connected(); }
+
   /**
    * @brief Get reference to underlying web server
    * @return Reference to ESP8266WebServer instance
@@ -153,6 +160,15 @@ public:
    */
   void handleSetConfigValue();
 
+  /**
+   * @brief Handle batched config value update requests
+   * @details Processes POST requests to /admin/config/setConfigValues with
+   *          several key/value entries, sent as a JSON array or as repeated
+   *          form fields. The entries are applied together and persisted
+   *          once per Preferences namespace.
+   */
+  void handleSetConfigValues();
+
   /**
    * @brief Get the update mode start time (for timeout recovery)
    */
@@ -20,7 +20,7 @@ void WebManager::initializeRemainingHandlers() {
         if (url == "/") {
           BaseHandler* handler = getCachedHandler("startpage");
           if (!handler) {
-            logger.debug(F("WebManager"), F("Lazy-Loading: StartpageHandler"));
+            LOG_DEBUG(F("WebManager"), F("Lazy-Loading: StartpageHandler"));
             auto newHandler = std::make_unique<StartpageHandler>(*_server, *_auth, *_cssService);
 
             // Set handler type context for route registration
@@ -43,7 +43,7 @@ void WebManager::initializeRemainingHandlers() {
         else if (url.startsWith("/logs")) {
           BaseHandler* handler = getCachedHandler("log");
           if (!handler) {
-            logger.debug(F("WebManager"), F("Lazy-Loading: LogHandler"));
+            LOG_DEBUG(F("WebManager"), F("Lazy-Loading: LogHandler"));
             auto newHandler = std::unique_ptr<LogHandler>(
                 LogHandler::getInstance(*_server, *_auth, *_cssService));
 
@@ -68,7 +68,7 @@ void WebManager::initializeRemainingHandlers() {
                  _sensorManager) {
           BaseHandler* handler = getCachedHandler("admin_sensor");
           if (!handler) {
-            logger.debug(F("WebManager"), F("Lazy-Loading: AdminSensorHandler"));
+            LOG_DEBUG(F("WebManager"), F("Lazy-Loading: AdminSensorHandler"));
             auto newHandler = std::make_unique<AdminSensorHandler>(*_server, *_auth, *_cssService,
                                                                    *_sensorManager);
 
@@ -92,7 +92,7 @@ void WebManager::initializeRemainingHandlers() {
         else if (url.startsWith("/admin/display")) {
           BaseHandler* handler = getCachedHandler("display");
           if (!handler) {
-            logger.debug(F("WebManager"), F("Lazy-Loading: AdminDisplayHandler"));
+            LOG_DEBUG(F("WebManager"), F("Lazy-Loading: AdminDisplayHandler"));
             auto newHandler = std::make_unique<AdminDisplayHandler>(*_server);
 
             _router->setHandlerTypeContext("display");
@@ -112,9 +112,9 @@ void WebManager::initializeRemainingHandlers() {
         }
 #endif
         // General admin routes (excluding special cases handled above)
-        // NOTE: /admin/config/setConfigValue is an essential route registered
+        // NOTE: /admin/config/setConfigValue(s) are essential routes registered
         // early in WebManager::setupRoutes. Avoid lazy-loading the full
-        // AdminHandler for requests to that path to prevent registering
+        // AdminHandler for requests to those paths to prevent registering
         // additional routes and hitting the max-routes limit.
         else if (url.startsWith("/admin") && !url.startsWith("/admin/sensors") &&
                  !url.startsWith("/admin/display") && !(url == "/admin/update") &&
@@ -123,7 +123,7 @@ void WebManager::initializeRemainingHandlers() {
                    url.startsWith("/admin/config/setConfigValue"))) {
           BaseHandler* handler = getCachedHandler("admin");
           if (!handler) {
-            logger.debug(F("WebManager"), F("Lazy-Loading: AdminHandler für URL: ") + url);
+            LOG_DEBUG(F("WebManager"), F("Lazy-Loading: AdminHandler für URL: ") + url);
             auto newHandler = std::make_unique<AdminHandler>(*_server, *_auth, *_cssService);
 
             _router->setHandlerTypeContext("admin");
@@ -142,10 +142,11 @@ void WebManager::initializeRemainingHandlers() {
           }
         }
         // Sensor data routes
-        else if (url == "/getLatestValues" || (url.startsWith("/sensor") && _sensorManager)) {
+        else if (url == "/getLatestValues" || url.startsWith("/api/history") ||
+                 (url.startsWith("/sensor") && _sensorManager)) {
           BaseHandler* handler = getCachedHandler("sensor");
           if (!handler) {
-            logger.debug(F("WebManager"), F("Lazy-Loading: SensorHandler"));
+            LOG_DEBUG(F("WebManager"), F("Lazy-Loading: SensorHandler"));
             auto newHandler =
                 std::make_unique<SensorHandler>(*_server, *_auth, *_cssService, *_sensorManager);
 
@@ -190,12 +191,12 @@ void WebManager::cleanupNonEssentialHandlers() {
   // lists or callbacks that must be released via cleanup(). Simply
   // clearing the list would drop unique_ptrs without calling their
   // cleanup hooks which can leak memory/resources on constrained devices.
-  logger.debug(F("WebManager"),
-               F("Bereinige Handler-Cache (") + String(m_handlerCache.size()) + F(" Einträge)"));
+  LOG_DEBUG(F("WebManager"),
+            F("Bereinige Handler-Cache (") + String(m_handlerCache.size()) + F(" Einträge)"));
 
   for (auto& entry : m_handlerCache) {
     if (entry.handler) {
-      logger.debug(F("WebManager"), F("Cleanup: ") + entry.handlerType);
+      LOG_DEBUG(F("WebManager"), F("Cleanup: ") + entry.handlerType);
       entry.handler->cleanup();
     }
   }
@@ -217,7 +218,7 @@ void WebManager::cleanupHandlers() {
   // Cleanup all cached handlers
   for (auto& entry : m_handlerCache) {
     if (entry.handler) {
-      logger.debug(F("WebManager"), F("Cleanup cached: ") + entry.handlerType);
+      LOG_DEBUG(F("WebManager"), F("Cleanup cached: ") + entry.handlerType);
       entry.handler->cleanup();
     }
   }
@@ -235,7 +236,7 @@ void WebManager::cacheHandler(std::unique_ptr<BaseHandler> handler, const String
   // Check if handler already exists in cache
   for (auto& entry : m_handlerCache) {
     if (entry.handlerType == handlerType) {
-      logger.debug(F("WebManager"), F("Handler bereits im Cache: ") + handlerType);
+      LOG_DEBUG(F("WebManager"), F("Handler bereits im Cache: ") + handlerType);
       entry.lastAccess = millis(); // Update access time
       return;
     }
@@ -7,10 +7,33 @@
 
 #include "configs/config.h"
 #include "logger/logger.h"
+#include "utils/file_io_queue.h"
 #include "web/core/web_manager.h"
 
+namespace {
+
+ConfigValueType parseConfigValueType(const String& typeStr) {
+  if (typeStr == "bool") {
+    return ConfigValueType::BOOL;
+  } else if (typeStr == "int") {
+    return ConfigValueType::INT;
+  } else if (typeStr == "uint") {
+    return ConfigValueType::UINT;
+  } else if (typeStr == "float") {
+    return ConfigValueType::FLOAT;
+  }
+  return ConfigValueType::STRING; // default
+}
+
+// Debug flags and the log level may be changed without authentication
+bool isPublicConfigUpdate(const String& namespaceName, const String& key) {
+  return namespaceName == "debug" || (namespaceName == "log" && key == "level");
+}
+
+} // namespace
+
 void WebManager::handleSetUpdate() {
-  logger.debug(F("WebManager"), F("Betrete WebManager::handleSetUpdate()"));
+  LOG_DEBUG(F("WebManager"), F("Betrete WebManager::handleSetUpdate()"));
 
   // 1. Verify server instance
   if (!_server) {
@@ -19,13 +42,13 @@ void WebManager::handleSetUpdate() {
   }
 
   // 2. Basic auth check with detailed logging
-  logger.debug(F("WebManager"), F("Prüfe Authentifizierung..."));
+  LOG_DEBUG(F("WebManager"), F("Prüfe Authentifizierung..."));
   if (!_server->authenticate("admin", ConfigMgr.getAdminPassword().c_str())) {
     logger.warning(F("WebManager"), F("Authentifizierung für setUpdate-Anfrage fehlgeschlagen"));
     _server->requestAuthentication();
     return;
   }
-  logger.debug(F("WebManager"), F("Authentifizierung erfolgreich"));
+  LOG_DEBUG(F("WebManager"), F("Authentifizierung erfolgreich"));
 
   // 3. Verify request method
   if (_server->method() != HTTP_POST) {
@@ -36,9 +59,9 @@ void WebManager::handleSetUpdate() {
 
   // 4. Get and validate request body
   String json = _server->arg("plain");
-  logger.debug(F("WebManager"),
-               "Empfangene Länge des Update-Request-Bodys: " + String(json.length()));
-  logger.debug(F("WebManager"), "Roher Request-Body: " + json);
+  LOG_DEBUG(F("WebManager"),
+            "Empfangene Länge des Update-Request-Bodys: " + String(json.length()));
+  LOG_DEBUG(F("WebManager"), "Roher Request-Body: " + json);
 
   // 5. Validate request and extract flags
   bool fileSystemUpdate, firmwareUpdate, updateMode;
@@ -48,8 +71,8 @@ void WebManager::handleSetUpdate() {
   }
 
   // 6. Log the intended update type
-  logger.debug(F("WebManager"), F("Setze Flags - FS: ") + String(fileSystemUpdate) + F(", FW: ") +
-                                    String(firmwareUpdate) + F(", Modus: ") + String(updateMode));
+  LOG_DEBUG(F("WebManager"), F("Setze Flags - FS: ") + String(fileSystemUpdate) + F(", FW: ") +
+                                 String(firmwareUpdate) + F(", Modus: ") + String(updateMode));
 
   // 7. Save configuration and prepare for update
   if (!prepareUpdateMode(fileSystemUpdate, firmwareUpdate, updateMode)) {
@@ -62,17 +85,17 @@ void WebManager::handleSetUpdate() {
   String jsonResponse;
   serializeJson(response, jsonResponse);
 
-  logger.debug(F("WebManager"), F("Sende Erfolgsantwort"));
+  LOG_DEBUG(F("WebManager"), F("Sende Erfolgsantwort"));
   _server->send(200, F("application/json"), jsonResponse);
   // Try to flush TCP buffers and then close the client socket so the
   // browser receives the response reliably before we reboot.
-  logger.debug(F("WebManager"), F("Flush und schließe Client-Socket (wenn möglich)"));
+  LOG_DEBUG(F("WebManager"), F("Flush und schließe Client-Socket (wenn möglich)"));
   _server->client().flush();
   // Small pause to let the stack push out bytes
   delay(200);
   // Explicitly stop the client to terminate the TCP connection cleanly
   _server->client().stop();
-  logger.debug(F("WebManager"), F("Antwort gesendet und Client-Socket gestoppt"));
+  LOG_DEBUG(F("WebManager"), F("Antwort gesendet und Client-Socket gestoppt"));
 
   // 9. Handle update mode and reboot if necessary
   if (updateMode) {
@@ -87,7 +110,7 @@ void WebManager::handleSetUpdate() {
       _server->handleClient();
       // If there are no active clients, we can proceed earlier
       if (!_server->client().connected()) {
-        logger.debug(F("WebManager"), F("Kein aktiver Client mehr - bereit zum Neustart"));
+        LOG_DEBUG(F("WebManager"), F("Kein aktiver Client mehr - bereit zum Neustart"));
         break;
       }
       delay(50);
@@ -97,12 +120,15 @@ void WebManager::handleSetUpdate() {
 
     // Stop non-critical services
     if (_sensorManager) {
-      logger.debug(F("WebManager"), F("Stoppe Sensor-Manager..."));
+      LOG_DEBUG(F("WebManager"), F("Stoppe Sensor-Manager..."));
       _sensorManager->stopAll();
       _sensorManager = nullptr;
     }
 
-    logger.debug(F("WebManager"), F("Führe Aufräumarbeiten durch..."));
+    // Persist cached runtime values and queued files before rebooting
+    FileIoQueue::getInstance().flushAll();
+
+    LOG_DEBUG(F("WebManager"), F("Führe Aufräumarbeiten durch..."));
     cleanup();
 
     logger.info(F("WebManager"), F("Starte neu im Update-Modus..."));
@@ -110,7 +136,7 @@ void WebManager::handleSetUpdate() {
     ESP.restart();
   }
 
-  logger.debug(F("WebManager"), F("Verlasse WebManager::handleSetUpdate()"));
+  LOG_DEBUG(F("WebManager"), F("Verlasse WebManager::handleSetUpdate()"));
 }
 
 void WebManager::handleSetConfigValue() {
@@ -145,33 +171,13 @@ void WebManager::handleSetConfigValue() {
       return;
     }
 
-    // Parse type parameter
-    ConfigValueType type = ConfigValueType::STRING; // default
-    if (typeStr == "bool") {
-      type = ConfigValueType::BOOL;
-    } else if (typeStr == "int") {
-      type = ConfigValueType::INT;
-    } else if (typeStr == "uint") {
-      type = ConfigValueType::UINT;
-    } else if (typeStr == "float") {
-      type = ConfigValueType::FLOAT;
-    } else if (typeStr == "string") {
-      type = ConfigValueType::STRING;
-    }
+    ConfigValueType type = parseConfigValueType(typeStr);
 
-    logger.debug(F("WebManager"), String(F("Setze Konfiguration: ")) + namespaceName + F(".") +
-                                      key + F(" = ") + value + F(" (Typ: ") + typeStr + F(")"));
-
-    // Determine whether this particular update is allowed without auth.
-    bool isPublicUpdate = false;
-    if (namespaceName == "debug") {
-      isPublicUpdate = true; // allow toggling debug flags without auth
-    } else if (namespaceName == "log" && key == "level") {
-      isPublicUpdate = true; // allow changing log level without auth
-    }
+    LOG_DEBUG(F("WebManager"), String(F("Setze Konfiguration: ")) + namespaceName + F(".") +
+                                   key + F(" = ") + value + F(" (Typ: ") + typeStr + F(")"));
 
     // If this is not a public update, require authentication
-    if (!isPublicUpdate) {
+    if (!isPublicConfigUpdate(namespaceName, key)) {
       if (!_server->authenticate("admin", ConfigMgr.getAdminPassword().c_str())) {
         logger.warning(F("WebManager"),
                        F("Authentifizierung für setConfigValue-Anfrage fehlgeschlagen"));
@@ -199,7 +205,7 @@ void WebManager::handleSetConfigValue() {
   } else {
     // Legacy JSON method - kept for backward compatibility during transition
     String json = _server->arg("plain");
-    logger.debug(F("WebManager"), "Empfangene Legacy-Konfigurations-Update-Anfrage: " + json);
+    LOG_DEBUG(F("WebManager"), "Empfangene Legacy-Konfigurations-Update-Anfrage: " + json);
 
     // Parse JSON
     StaticJsonDocument<512> doc;
@@ -249,6 +255,109 @@ void WebManager::handleSetConfigValue() {
   }
 }
 
+void WebManager::handleSetConfigValues() {
+  if (!_server) {
+    logger.error(F("WebManager"), F("Serverinstanz ist null"));
+    return;
+  }
+
+  std::vector<ConfigManager::ConfigUpdate> updates;
+  String contentType = _server->header("Content-Type");
+  bool isFormEncoded = contentType.indexOf("application/x-www-form-urlencoded") >= 0;
+
+  if (isFormEncoded || _server->hasArg("namespace")) {
+    // Form: the namespace/key/value/type fields of setConfigValue, repeated
+    // once per entry; every entry starts with its namespace field
+    for (int i = 0; i < _server->args(); i++) {
+      String name = _server->argName(i);
+      if (name == "namespace") {
+        if (updates.size() >= CONFIG_BATCH_MAX_ENTRIES) {
+          sendErrorResponse(400, F("Zu viele Einträge"));
+          return;
+        }
+        updates.emplace_back();
+        updates.back().namespaceName = _server->arg(i);
+      } else if (updates.empty()) {
+        continue;
+      } else if (name == "key") {
+        updates.back().key = _server->arg(i);
+      } else if (name == "value") {
+        updates.back().value = _server->arg(i);
+      } else if (name == "type") {
+        updates.back().type = parseConfigValueType(_server->arg(i));
+      }
+    }
+  } else {
+    // JSON: [{"namespace": ..., "key": ..., "value": ..., "type": ...}, ...]
+    const String& json = _server->arg("plain");
+    DynamicJsonDocument doc(256 + json.length() * 2);
+    DeserializationError error = deserializeJson(doc, json);
+    if (error) {
+      String errorMsg = String(F("JSON-Parsefehler: ")) + error.c_str();
+      logger.error(F("WebManager"), errorMsg);
+      sendErrorResponse(400, errorMsg);
+      return;
+    }
+
+    JsonArrayConst entries = doc.is<JsonArrayConst>() ? doc.as<JsonArrayConst>()
+                                                      : doc["updates"].as<JsonArrayConst>();
+    if (entries.size() > CONFIG_BATCH_MAX_ENTRIES) {
+      sendErrorResponse(400, F("Zu viele Einträge"));
+      return;
+    }
+    updates.reserve(entries.size());
+    for (JsonObjectConst entry : entries) {
+      ConfigManager::ConfigUpdate update;
+      update.namespaceName = entry["namespace"] | "";
+      update.key = entry["key"] | "";
+      // Booleans and numbers are accepted unquoted
+      if (entry["value"].is<bool>()) {
+        update.value = entry["value"].as<bool>() ? F("true") : F("false");
+      } else {
+        update.value = entry["value"].as<String>();
+      }
+      update.type = parseConfigValueType(entry["type"] | "string");
+      updates.push_back(update);
+    }
+  }
+
+  if (updates.empty()) {
+    sendErrorResponse(400, F("Keine Einträge in der Anfrage"));
+    return;
+  }
+
+  // The batch is public only if every entry is
+  bool isPublicUpdate = true;
+  for (const auto& update : updates) {
+    if (update.namespaceName.isEmpty() || update.key.isEmpty()) {
+      sendErrorResponse(400, F("Fehlender Namespace- oder Schlüssel-Parameter"));
+      return;
+    }
+    isPublicUpdate = isPublicUpdate && isPublicConfigUpdate(update.namespaceName, update.key);
+  }
+  if (!isPublicUpdate && !_server->authenticate("admin", ConfigMgr.getAdminPassword().c_str())) {
+    logger.warning(F("WebManager"),
+                   F("Authentifizierung für setConfigValues-Anfrage fehlgeschlagen"));
+    _server->requestAuthentication();
+    return;
+  }
+
+  auto result = ConfigMgr.setConfigValues(updates);
+  if (!result.isSuccess()) {
+    logger.error(F("WebManager"), String(F("Konfigurationswerte konnten nicht gesetzt werden: ")) +
+                                      result.getMessage());
+    sendErrorResponse(400, result.getMessage());
+    return;
+  }
+
+  StaticJsonDocument<200> response;
+  response["success"] = true;
+  response["applied"] = updates.size();
+  String jsonResponse;
+  serializeJson(response, jsonResponse);
+  _server->send(200, F("application/json"), jsonResponse);
+}
+
 ResourceResult WebManager::validateUpdateRequest(const String& json, bool& fileSystemUpdate,
                                                  bool& firmwareUpdate, bool& updateMode) {
   if (json.length() == 0) {
@@ -295,7 +404,7 @@ bool WebManager::prepareUpdateMode(bool fileSystemUpdate, bool firmwareUpdate, b
     return false;
   }
 
-  logger.debug(F("WebManager"), F("Konfiguration erfolgreich gespeichert"));
+  LOG_DEBUG(F("WebManager"), F("Konfiguration erfolgreich gespeichert"));
   return true;
 }
 
@@ -81,8 +81,8 @@ ResourceResult WebManager::beginUpdateMode() {
   try {
     // Startzeit für Update-Modus setzen (Timeout-Absicherung)
     m_updateModeStartTime = millis();
-    logger.debug(F("WebManager"),
-                 F("Update-Modus Startzeit gesetzt: ") + String(m_updateModeStartTime));
+    LOG_DEBUG(F("WebManager"),
+              F("Update-Modus Startzeit gesetzt: ") + String(m_updateModeStartTime));
 
     // Alle Dienste zuerst stoppen
     if (_sensorManager) {
@@ -175,7 +175,7 @@ ResourceResult WebManager::setupMinimalServices() {
     _server->on("/favicon.ico", HTTP_GET,
                 [this]() { serveStaticFile("/favicon.ico", "image/x-icon", "max-age=86400"); });
 
-    logger.debug(F("WebManager"), F("Statische Dateien für Update-Modus registriert"));
+    LOG_DEBUG(F("WebManager"), F("Statische Dateien für Update-Modus registriert"));
 
     _server->begin();
 
@@ -264,7 +264,7 @@ ResourceResult WebManager::setupServices() {
     _server->on("/favicon.ico", HTTP_GET,
                 [this]() { serveStaticFile("/favicon.ico", "image/x-icon", "max-age=86400"); });
 
-    logger.debug(F("WebManager"), F("Routen für statische Dateien konfiguriert"));
+    LOG_DEBUG(F("WebManager"), F("Routen für statische Dateien konfiguriert"));
 
     logger.info(F("WebManager"), F("Statische Dateiauslieferung erfolgreich initialisiert"));
 
@@ -279,7 +279,7 @@ ResourceResult WebManager::setupServices() {
 }
 
 void WebManager::setupMiddleware() {
-  logger.debug(F("WebManager"), F("Middleware wird eingerichtet..."));
+  LOG_DEBUG(F("WebManager"), F("Middleware wird eingerichtet..."));
 
   // Middleware: Öffentliche Assets und Startseite sind zugänglich; Admin-Routen benötigen Authentifizierung.
   _router->addMiddleware([this](HTTPMethod method, String url) {
@@ -301,9 +301,9 @@ void WebManager::setupMiddleware() {
 
   // Logging-Middleware hinzufügen
   _router->addMiddleware([this](HTTPMethod method, String url) {
-    logger.debug(F("WebManager"), F("Anfrage: ") + methodToString(method) + F(" ") + url);
+    LOG_DEBUG(F("WebManager"), F("Anfrage: ") + methodToString(method) + F(" ") + url);
     return true;
   });
 
-  logger.debug(F("WebManager"), F("Middleware-Konfiguration abgeschlossen"));
+  LOG_DEBUG(F("WebManager"), F("Middleware-Konfiguration abgeschlossen"));
 }
@@ -13,12 +13,12 @@ void WebManager::setupRoutes() {
     return;
   }
 
-  logger.debug(F("WebManager"), F("Registriere essenzielle Routen (Lazy-Loading für Handler)"));
+  LOG_DEBUG(F("WebManager"), F("Registriere essenzielle Routen (Lazy-Loading für Handler)"));
 
   // CRITICAL: Register file upload routes FIRST using _server.on()
   // These MUST be registered before any router routes to take priority
   // File uploads cannot go through the router system
-  logger.debug(F("WebManager"), F("Registriere Upload-Routen (vor Router)"));
+  LOG_DEBUG(F("WebManager"), F("Registriere Upload-Routen (vor Router)"));
 
   // Config upload route - needs direct server registration for file upload support
   _server->on(
@@ -65,7 +65,7 @@ void WebManager::setupRoutes() {
         // AdminHandler must be loaded for this
         BaseHandler* handler = getCachedHandler("admin");
         if (!handler) {
-          logger.debug(F("WebManager"), F("Lazy-Loading AdminHandler für Upload"));
+          LOG_DEBUG(F("WebManager"), F("Lazy-Loading AdminHandler für Upload"));
           auto newHandler = std::make_unique<AdminHandler>(*_server, *_auth, *_cssService);
           auto result = newHandler->registerRoutes(*_router);
           if (result.isSuccess()) {
@@ -80,7 +80,7 @@ void WebManager::setupRoutes() {
           _server->send(500, F("text/plain"), F("Handler-Ladefehler"));
         }
       });
-  logger.debug(F("WebManager"), F("Upload-Route /admin/uploadConfig registriert"));
+  LOG_DEBUG(F("WebManager"), F("Upload-Route /admin/uploadConfig registriert"));
 
   // Essential routes that cannot be lazy-loaded due to special handling
 
@@ -95,6 +95,8 @@ void WebManager::setupRoutes() {
   // Add config value update route - used frequently
   _router->addRoute(HTTP_POST, "/admin/config/setConfigValue",
                     [this]() { handleSetConfigValue(); });
+  _router->addRoute(HTTP_POST, "/admin/config/setConfigValues",
+                    [this]() { handleSetConfigValues(); });
 
   // Register OTA routes - critical for firmware updates, cannot be lazy-loaded
   if (_otaHandler) {
@@ -135,7 +137,7 @@ void WebManager::setupMinimalRoutes() {
     return;
   }
 
-  logger.debug(F("WebManager"), F("Registriere minimale Routen (Lazy-Loading aktiv)"));
+  LOG_DEBUG(F("WebManager"), F("Registriere minimale Routen (Lazy-Loading aktiv)"));
 
   // Create minimal admin handler
   _minimalAdminHandler = std::make_unique<AdminMinimalHandler>(*_server, *_auth);
@@ -165,16 +167,16 @@ void WebManager::setupMinimalRoutes() {
     HTTPMethod method = _server->method();
 
     // Debug: Log every request that hits onNotFound
-    logger.debug(F("WebManager"), F("onNotFound aufgerufen für: ") +
-                                      String(method == HTTP_GET    ? F("GET")
-                                             : method == HTTP_POST ? F("POST")
-                                                                   : F("OTHER")) +
-                                      F(" ") + uri);
+    LOG_DEBUG(F("WebManager"), F("onNotFound aufgerufen für: ") +
+                                   String(method == HTTP_GET    ? F("GET")
+                                          : method == HTTP_POST ? F("POST")
+                                                                : F("OTHER")) +
+                                   F(" ") + uri);
 
     // Let router handle the request
     if (_router && _router->handleRequest(method, uri)) {
       // Request was handled by router
-      logger.debug(F("WebManager"), F("Router hat Request behandelt: ") + uri);
+      LOG_DEBUG(F("WebManager"), F("Router hat Request behandelt: ") + uri);
       return;
     }
 
@@ -197,6 +199,6 @@ void WebManager::removeRoute(const String& path, HTTPMethod method) {
   if (_router) {
     // Implementation depends on your WebRouter class
     // This is a placeholder
-    logger.debug(F("WebManager"), F("Entferne Route: ") + methodToString(method) + " " + path);
+    LOG_DEBUG(F("WebManager"), F("Entferne Route: ") + methodToString(method) + " " + path);
   }
 }
@@ -19,9 +19,9 @@ WebRouter::WebRouter(ESP8266WebServer& server) : _server(server) {
     _routes.reserve(MAX_ROUTES);
     _middleware.reserve(MAX_MIDDLEWARE);
 
-    logger.debug(F("WebRouter"), F("WebRouter mit Grenzen initialisiert:"));
-    logger.debug(F("WebRouter"), String(F("- Max Routen: ")) + String(MAX_ROUTES));
-    logger.debug(F("WebRouter"), String(F("- Max Middleware: ")) + String(MAX_MIDDLEWARE));
+    LOG_DEBUG(F("WebRouter"), F("WebRouter mit Grenzen initialisiert:"));
+    LOG_DEBUG(F("WebRouter"), String(F("- Max Routen: ")) + String(MAX_ROUTES));
+    LOG_DEBUG(F("WebRouter"), String(F("- Max Middleware: ")) + String(MAX_MIDDLEWARE));
   } catch (const std::exception& e) {
     logger.error(F("WebRouter"), F("Zuweisung der Router-Puffer fehlgeschlagen"));
   }
@@ -48,8 +48,8 @@ RouterResult WebRouter::addRoute(HTTPMethod method, const String& url, HandlerCa
   for (const auto& route : _routes) {
     if (route.url == url && route.method == method) {
       // Route already exists - update handler if different handlerType
-      logger.debug(F("WebRouter"),
-                   F("Route bereits registriert: ") + methodToString(method) + F(" ") + url);
+      LOG_DEBUG(F("WebRouter"),
+                F("Route bereits registriert: ") + methodToString(method) + F(" ") + url);
       return RouterResult::success();
     }
   }
@@ -69,8 +69,8 @@ RouterResult WebRouter::addRoute(HTTPMethod method, const String& url, HandlerCa
 }
 
 void WebRouter::serveStatic(const String& urlPrefix, fs::FS& fs, const String& path, bool cache) {
-  logger.debug(F("WebRouter"),
-               String(F("Einrichte statische Route: ")) + urlPrefix + " -> " + path);
+  LOG_DEBUG(F("WebRouter"),
+            String(F("Einrichte statische Route: ")) + urlPrefix + " -> " + path);
 
   if (!fs.exists(path)) {
     logger.warning(F("WebRouter"), String(F("Statische Datei nicht gefunden: ")) + path);
@@ -79,8 +79,8 @@ void WebRouter::serveStatic(const String& urlPrefix, fs::FS& fs, const String& p
   // Use ESP8266WebServer's built-in static file serving
   _server.serveStatic(urlPrefix.c_str(), fs, path.c_str(), cache ? "max-age=3600" : nullptr);
 
-  logger.debug(F("WebRouter"),
-               String(F("Statische Route registriert: ")) + urlPrefix + " -> " + path);
+  LOG_DEBUG(F("WebRouter"),
+            String(F("Statische Route registriert: ")) + urlPrefix + " -> " + path);
 }
 
 bool WebRouter::handleRequest(HTTPMethod method, const String& url) {
@@ -152,7 +152,7 @@ String WebRouter::methodToString(HTTPMethod method) {
 bool WebRouter::executeMiddleware(HTTPMethod method, const String& url) {
   for (const auto& mw : _middleware) {
     if (!mw(method, url)) {
-      logger.debug(F("WebRouter"), String(F("Middleware blockierte Anfrage: ")) + url);
+      LOG_DEBUG(F("WebRouter"), String(F("Middleware blockierte Anfrage: ")) + url);
       return false;
     }
   }
@@ -172,8 +172,8 @@ Route* WebRouter::findRoute(HTTPMethod method, const String& url) {
 }
 
 void WebRouter::logRouteRegistration(HTTPMethod method, const String& url) {
-  logger.debug(F("WebRouter"),
-               String(F("Route erfolgreich registriert: ")) + methodToString(method) + " " + url);
+  LOG_DEBUG(F("WebRouter"),
+            String(F("Route erfolgreich registriert: ")) + methodToString(method) + " " + url);
 }
 
 RouterResult WebRouter::removeRoute(HTTPMethod method, const String& url) {
@@ -183,18 +183,18 @@ RouterResult WebRouter::removeRoute(HTTPMethod method, const String& url) {
 
   if (it != _routes.end()) {
     _routes.erase(it, _routes.end());
-    logger.debug(F("WebRouter"), F("Route entfernt: ") + methodToString(method) + F(" ") + url);
+    LOG_DEBUG(F("WebRouter"), F("Route entfernt: ") + methodToString(method) + F(" ") + url);
     return RouterResult::success();
   }
 
-  logger.debug(F("WebRouter"),
-               F("Route nicht gefunden zum Entfernen: ") + methodToString(method) + F(" ") + url);
+  LOG_DEBUG(F("WebRouter"),
+            F("Route nicht gefunden zum Entfernen: ") + methodToString(method) + F(" ") + url);
   return RouterResult::fail(RouterError::INVALID_ROUTE, F("Route nicht gefunden"));
 }
 
 void WebRouter::removeHandlerRoutes(const String& handlerType) {
   if (handlerType.isEmpty()) {
-    logger.debug(F("WebRouter"), F("Leerer handlerType - überspringe Route-Entfernung"));
+    LOG_DEBUG(F("WebRouter"), F("Leerer handlerType - überspringe Route-Entfernung"));
     return;
   }
 
@@ -207,6 +207,6 @@ void WebRouter::removeHandlerRoutes(const String& handlerType) {
     logger.info(F("WebRouter"), F("Handler-Routen entfernt: ") + handlerType + F(" (") +
                                     String(removedCount) + F(" Routen)"));
   } else {
-    logger.debug(F("WebRouter"), F("Keine Routen gefunden für Handler: ") + handlerType);
+    LOG_DEBUG(F("WebRouter"), F("Keine Routen gefunden für Handler: ") + handlerType);
   }
 }
@@ -11,8 +11,17 @@
 #include "configs/config.h"
 #include "logger/logger.h"
 #include "managers/manager_config.h"
+#include "managers/manager_config_preferences.h"
 #include "managers/manager_sensor.h"
+#include "managers/manager_sensor_persistence.h"
+#include "sensors/sensor_timeseries.h"
+#include "utils/file_io_queue.h"
+#include "utils/flash_persistence.h"
+#include "utils/helper.h"
 #include "web/handler/admin_handler.h"
+#if USE_WEBSOCKET
+#include "web/handler/log_handler.h"
+#endif
 
 void AdminHandler::generateAndSendDebugSettingsCard() {
   sendChunk(F("<div class='card'><h3>Log Einstellungen</h3>"));
@@ -176,6 +185,12 @@ void AdminHandler::generateAndSendSystemInfoCard() {
   yield();
   sendChunk(F("<tr><td>Laufzeit</td><td>"));
   sendChunk(formatUptime());
+  sendChunk(F("</td></tr><tr><td>Loop-Durchläufe</td><td>"));
+  sendChunk(String(Helper::getLoopsPerSecond()));
+  sendChunk(F(" /s</td></tr>"));
+  sendChunk(F("<tr><td>Heap-Allokationen pro Loop</td><td>"));
+  float allocsPerLoop = Helper::getAllocationsPerLoop();
+  sendChunk(allocsPerLoop < 0 ? String(F("nur mit UMM_STATS_FULL")) : String(allocsPerLoop, 2));
   sendChunk(F("</td></tr>"));
   yield();
   sendChunk(F("<tr><td>WiFi SSID</td><td>"));
@@ -199,27 +214,160 @@ void AdminHandler::generateAndSendSystemInfoCard() {
       sendChunk(F("</td></tr><tr><td>Dateisystem Frei</td><td>"));
       sendChunk(formatMemorySize(fs_info.totalBytes - fs_info.usedBytes));
       sendChunk(F("</td></tr>"));
-      if (ConfigMgr.isFileLoggingEnabled() && LittleFS.exists("/log.txt")) {
-        File logFile = LittleFS.open("/log.txt", "r");
-        if (logFile) {
-          size_t logSize = logFile.size();
-          logFile.close();
-          sendChunk(F("<tr><td>Log Datei Größe</td><td>"));
-          sendChunk(formatMemorySize(logSize));
-          sendChunk(F(" ("));
-          if (MAX_LOG_FILE_SIZE > 0) {
-            sendChunk(String((logSize * 100) / MAX_LOG_FILE_SIZE));
-          } else {
-            sendChunk(F("0"));
-          }
-          sendChunk(F("% belegt)</td></tr>"));
+      if (ConfigMgr.isFileLoggingEnabled()) {
+        logger.flushFileLog();
+        const LogSegments& segments = logger.getSegments();
+        size_t logSize = segments.totalSize();
+        sendChunk(F("<tr><td>Log Datei Größe</td><td>"));
+        sendChunk(formatMemorySize(logSize));
+        sendChunk(F(" ("));
+        if (MAX_LOG_FILE_SIZE > 0) {
+          sendChunk(String((logSize * 100) / MAX_LOG_FILE_SIZE));
+        } else {
+          sendChunk(F("0"));
         }
+        sendChunk(F("% belegt, "));
+        sendChunk(String(segments.current() - segments.first() + 1));
+        sendChunk(F(" Segmente)</td></tr>"));
       }
     } else {
       sendChunk(F("<tr><td>Dateisystem</td><td>Fehler beim Zugriff</td></tr>"));
     }
   }
   yield();
+  {
+    const auto& stats = SensorPersistence::getFlushStats();
+    sendChunk(F("<tr><td>Sensor-Cache ausstehend</td><td>"));
+    sendChunk(String(SensorPersistence::getPendingUpdateCount()));
+    sendChunk(F(" (max. "));
+    sendChunk(String(stats.pendingHighWater));
+    sendChunk(F(", "));
+    sendChunk(String(stats.coalescingRatio() * 100.0f, 0));
+    sendChunk(F("% zusammengefasst)</td></tr><tr><td>Sensor-Cache Flushes</td><td>"));
+    sendChunk(String(stats.flushCount));
+    sendChunk(F("</td></tr><tr><td>Messungsspeicher Commits</td><td>"));
+    sendChunk(String(stats.commits));
+    sendChunk(F(" ("));
+    sendChunk(formatMemorySize(stats.bytesWritten));
+    sendChunk(F(")</td></tr>"));
+
+    const auto storeStats = SensorPersistence::getStoreStats();
+    sendChunk(F("<tr><td>Messungsspeicher</td><td>"));
+    sendChunk(String(storeStats.liveRecords));
+    sendChunk(F(" Einträge, "));
+    sendChunk(formatMemorySize(storeStats.logBytes));
+    sendChunk(F(", "));
+    sendChunk(String(storeStats.compactions));
+    sendChunk(F(" Kompaktierungen</td></tr><tr><td>Sensor-Konfiguration geladen</td><td>"));
+    sendChunk(String(SensorPersistence::getLoadStats().loadMs));
+    sendChunk(F(" ms, Heap-Spitze "));
+    sendChunk(formatMemorySize(SensorPersistence::getLoadStats().heapPeak()));
+    sendChunk(F("</td></tr>"));
+  }
+  {
+    const auto& prefStats = PreferencesManager::getCacheStats();
+    sendChunk(F("<tr><td>Preferences-Zugriffe</td><td>"));
+    sendChunk(String(prefStats.sessions));
+    sendChunk(F(" (Boot: "));
+    sendChunk(String(prefStats.bootSessions));
+    sendChunk(F("), "));
+    sendChunk(String(prefStats.cacheHits));
+    sendChunk(F(" aus Cache, "));
+    sendChunk(String(prefStats.skippedWrites));
+    sendChunk(F(" unveränderte Schreibvorgänge übersprungen</td></tr>"));
+  }
+  {
+    const auto& flashStats = FlashPersistence::getStats();
+    if (flashStats.slot >= 0) {
+      sendChunk(F("<tr><td>Flash-Backup</td><td>Nr. "));
+      sendChunk(String(flashStats.sequence));
+      sendChunk(F(" in Slot "));
+      sendChunk(flashStats.slot == 0 ? F("A") : F("B"));
+      sendChunk(F(", "));
+      sendChunk(String(flashStats.sectorsErased));
+      sendChunk(F(" Sektoren gelöscht, "));
+      sendChunk(String(flashStats.sectorsUnchanged));
+      sendChunk(F(" unverändert, Backup "));
+      sendChunk(String(flashStats.backupMs));
+      sendChunk(F(" ms, Wiederherstellung "));
+      sendChunk(String(flashStats.restoreMs));
+      sendChunk(F(" ms</td></tr>"));
+    }
+  }
+  {
+    const auto& ioStats = FileIoQueue::getInstance().getStats();
+    sendChunk(F("<tr><td>Schreibwarteschlange</td><td>"));
+    sendChunk(String(ioStats.depth));
+    sendChunk(F(" Dateien ausstehend (max. "));
+    sendChunk(String(ioStats.maxDepth));
+    sendChunk(F("), "));
+    sendChunk(String(ioStats.writes));
+    sendChunk(F(" Schreibvorgänge für "));
+    sendChunk(String(ioStats.intents));
+    sendChunk(F(" Aufträge, Latenz "));
+    sendChunk(String(ioStats.writes > 0 ? ioStats.totalLatencyMs / ioStats.writes : 0));
+    sendChunk(F(" ms (max. "));
+    sendChunk(String(ioStats.maxLatencyMs));
+    sendChunk(F(" ms)"));
+    if (ioStats.failedWrites > 0) {
+      sendChunk(F(", "));
+      sendChunk(String(ioStats.failedWrites));
+      sendChunk(F(" fehlgeschlagen"));
+    }
+    for (const auto& file : FileIoQueue::getInstance().getFileStats()) {
+      sendChunk(F("<br>"));
+      sendChunk(file.path);
+      sendChunk(F(": "));
+      sendChunk(formatMemorySize(file.bytes));
+      sendChunk(F(" in "));
+      sendChunk(String(file.writes));
+      sendChunk(F(" Schreibvorgängen"));
+    }
+    sendChunk(F("</td></tr>"));
+  }
+  {
+    const auto logStats = logger.getFileLogStats();
+    sendChunk(F("<tr><td>Log-Puffer</td><td>"));
+    sendChunk(String(logStats.ringUsed));
+    sendChunk(F(" / "));
+    sendChunk(String(LogRing::capacity()));
+    sendChunk(F(" Bytes, "));
+    sendChunk(String(logStats.lines));
+    sendChunk(F(" Zeilen ("));
+    sendChunk(String(logStats.logTimeUs > 0
+                         ? static_cast<uint32_t>(logStats.lines * 1000000ULL / logStats.logTimeUs)
+                         : 0));
+    sendChunk(F(" Zeilen/s), "));
+    sendChunk(String(logStats.flushes));
+    sendChunk(F(" Übertragungen"));
+    if (logStats.dropped > 0) {
+      sendChunk(F(", "));
+      sendChunk(String(logStats.dropped));
+      sendChunk(F(" verworfen"));
+    }
+    sendChunk(F("</td></tr>"));
+  }
+#if USE_WEBSOCKET
+  sendChunk(F("<tr><td>WebSocket-Logs</td><td>"));
+  sendChunk(String(LogHandler::getDroppedMessages()));
+  sendChunk(F(" Zeilen für langsame Clients verworfen</td></tr>"));
+#endif
+  {
+    const auto tsStats = TimeSeriesStore::getInstance().getStats();
+    sendChunk(F("<tr><td>Zeitreihenarchiv</td><td>"));
+    sendChunk(String(tsStats.segmentCount));
+    sendChunk(F(" Segmente, "));
+    sendChunk(formatMemorySize(tsStats.storedBytes));
+    sendChunk(F(", "));
+    sendChunk(String(tsStats.storedSamples));
+    sendChunk(F(" Werte"));
+    if (tsStats.storedSamples > 0) {
+      sendChunk(F(" ("));
+      sendChunk(String(static_cast<float>(tsStats.storedBytes) / tsStats.storedSamples, 2));
+      sendChunk(F(" Bytes/Wert)"));
+    }
+    sendChunk(F("</td></tr>"));
+  }
   sendChunk(F("</table>"));
   // Add Download Config button (exports Preferences as JSON)
   sendChunk(F("<div style='margin-top:8px;'>"));
@@ -13,6 +13,7 @@
 #include "managers/manager_config.h"
 #include "managers/manager_config_persistence.h"
 #include "managers/manager_resource.h"
+#include "utils/file_io_queue.h"
 
 void AdminHandler::handleDownloadConfig() {
   logger.info(F("AdminHandler"), F("Config-Download angefordert"));
@@ -141,6 +142,7 @@ void AdminHandler::handleUploadConfigRestore() {
   if (!uploadFile) {
     logger.error(F("AdminHandler"), F("Konnte Upload-Datei nicht öffnen"));
     LittleFS.remove("/prefs_upload.json");
+    FileIoQueue::getInstance().flushAll();
     delay(1000);
     ESP.restart();
     return;
@@ -156,6 +158,7 @@ void AdminHandler::handleUploadConfigRestore() {
   if (error) {
     logger.error(F("AdminHandler"), F("Ungültige JSON-Datei: ") + String(error.c_str()));
     LittleFS.remove("/prefs_upload.json");
+    FileIoQueue::getInstance().flushAll();
     delay(1000);
     ESP.restart();
     return;
@@ -176,6 +179,7 @@ void AdminHandler::handleUploadConfigRestore() {
   }
 
   // Reboot to apply settings
+  FileIoQueue::getInstance().flushAll();
   delay(500);
   ESP.restart();
 }
@@ -30,7 +30,7 @@ RouterResult AdminHandler::onRegisterRoutes(WebRouter& router) {
     logger.error(F("AdminHandler"), F("Registrieren der /admin-Route fehlgeschlagen"));
     return result;
   }
-  logger.debug(F("AdminHandler"), F("Registrierte /admin-Route"));
+  LOG_DEBUG(F("AdminHandler"), F("Registrierte /admin-Route"));
 
   // Note: Config updates are now handled by unified /admin/config/setConfigValue
   // Old /admin/updateSettings route has been removed.
@@ -47,7 +47,7 @@ RouterResult AdminHandler::onRegisterRoutes(WebRouter& router) {
     logger.error(F("AdminHandler"), F("Registrieren der /admin/reset-Route fehlgeschlagen"));
     return result;
   }
-  logger.debug(F("AdminHandler"), F("Registrierte /admin/reset-Route"));
+  LOG_DEBUG(F("AdminHandler"), F("Registrierte /admin/reset-Route"));
 
   // Register reboot route
   result = router.addRoute(HTTP_POST, "/admin/reboot", [this]() {
@@ -61,7 +61,7 @@ RouterResult AdminHandler::onRegisterRoutes(WebRouter& router) {
     logger.error(F("AdminHandler"), F("Registrieren der /admin/reboot-Route fehlgeschlagen"));
     return result;
   }
-  logger.debug(F("AdminHandler"), F("Registrierte /admin/reboot-Route"));
+  LOG_DEBUG(F("AdminHandler"), F("Registrierte /admin/reboot-Route"));
 
   // Register config set route
   // Note: /admin/config/set handled by legacy route in WebManager; admin
@@ -78,7 +78,7 @@ RouterResult AdminHandler::onRegisterRoutes(WebRouter& router) {
     logger.error(F("AdminHandler"), F("Registrieren der /admin/downloadLog-Route fehlgeschlagen"));
     return result;
   }
-  logger.debug(F("AdminHandler"), F("Registrierte /admin/downloadLog-Route"));
+  LOG_DEBUG(F("AdminHandler"), F("Registrierte /admin/downloadLog-Route"));
 
   // Register config download route
   result = router.addRoute(HTTP_GET, "/admin/downloadConfig", [this]() {
@@ -93,13 +93,13 @@ RouterResult AdminHandler::onRegisterRoutes(WebRouter& router) {
                  F("Registrieren der /admin/downloadConfig-Route fehlgeschlagen"));
     return result;
   }
-  logger.debug(F("AdminHandler"), F("Registrierte /admin/downloadConfig-Route"));
+  LOG_DEBUG(F("AdminHandler"), F("Registrierte /admin/downloadConfig-Route"));
 
   // Config upload route is registered directly in WebManager::setupRoutes()
   // because it needs file upload support which requires _server.on()
   // See web_manager_routes.cpp for the actual registration
-  logger.debug(F("AdminHandler"),
-               F("Config-Upload-Route wird im WebManager registriert (File-Upload)"));
+  LOG_DEBUG(F("AdminHandler"),
+            F("Config-Upload-Route wird im WebManager registriert (File-Upload)"));
 
   // Register WiFi settings update route
   result = router.addRoute(HTTP_POST, "/admin/updateWiFi", [this]() {
@@ -113,7 +113,7 @@ RouterResult AdminHandler::onRegisterRoutes(WebRouter& router) {
     logger.error(F("AdminHandler"), F("Registrieren der /admin/updateWiFi-Route fehlgeschlagen"));
     return result;
   }
-  logger.debug(F("AdminHandler"), F("Registrierte /admin/updateWiFi-Route"));
+  LOG_DEBUG(F("AdminHandler"), F("Registrierte /admin/updateWiFi-Route"));
 
   logger.logMemoryStats(F("AdminRegisterRoutes"));
   return result;
@@ -133,7 +133,7 @@ HandlerResult AdminHandler::handlePost(const String& uri, const std::map<String,
 // the single AJAX endpoint /admin/updateSettings.
 
 void AdminHandler::handleAdminPage() {
-  logger.debug(F("AdminHandler"), F("handleAdminPage called"));
+  LOG_DEBUG(F("AdminHandler"), F("handleAdminPage called"));
   logger.logMemoryStats(F("AdminPageStart"));
 
   std::vector<String> css = {"admin"};
@@ -153,7 +153,7 @@ void AdminHandler::handleAdminPage() {
         sendChunk(F("</div>"));
       },
       css, js);
-  logger.debug(F("AdminHandler"), F("Adminseite erfolgreich gesendet"));
+  LOG_DEBUG(F("AdminHandler"), F("Adminseite erfolgreich gesendet"));
 }
 
 void AdminHandler::handleDownloadLog() {
@@ -162,22 +162,11 @@ void AdminHandler::handleDownloadLog() {
     return;
   }
 
-  const char* LOG_FILE = "/log.txt";
-  if (!LittleFS.exists(LOG_FILE)) {
-    this->sendError(404, F("Keine Log-Datei gefunden"));
-    return;
-  }
-
-  File logFile = LittleFS.open(LOG_FILE, "r");
-  if (!logFile) {
-    this->sendError(500, F("Öffnen der Log-Datei fehlgeschlagen"));
-    return;
-  }
-
-  size_t fileSize = logFile.size();
+  logger.flushFileLog();
+  const LogSegments& segments = logger.getSegments();
+  size_t fileSize = segments.totalSize();
   if (fileSize == 0) {
-    logFile.close();
-    this->sendError(404, F("Log-Datei ist leer"));
+    this->sendError(404, F("Keine Log-Datei gefunden"));
     return;
   }
 
@@ -192,14 +181,24 @@ void AdminHandler::handleDownloadLog() {
   uint8_t buffer[CHUNK_SIZE];
   size_t remainingBytes = fileSize;
 
-  while (remainingBytes > 0) {
-    size_t bytesToRead = min(remainingBytes, CHUNK_SIZE);
-    size_t bytesRead = logFile.read(buffer, bytesToRead);
-    if (bytesRead == 0)
-      break;
-    _server.sendContent((char*)buffer, bytesRead);
-    remainingBytes -= bytesRead;
-    yield();
+  // The segments are sent oldest first as one file
+  char path[LogSegments::PATH_SIZE];
+  for (uint32_t sequence = segments.first(); sequence <= segments.current() && remainingBytes > 0;
+       sequence++) {
+    LogSegments::formatPath(sequence, path);
+    File logFile = LittleFS.open(path, "r");
+    if (!logFile) {
+      continue;
+    }
+    while (remainingBytes > 0) {
+      size_t bytesToRead = min(remainingBytes, CHUNK_SIZE);
+      size_t bytesRead = logFile.read(buffer, bytesToRead);
+      if (bytesRead == 0)
+        break;
+      _server.sendContent((char*)buffer, bytesRead);
+      remainingBytes -= bytesRead;
+      yield();
+    }
+    logFile.close();
   }
-  logFile.close();
 }
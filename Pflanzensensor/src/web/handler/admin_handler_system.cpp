@@ -12,8 +12,8 @@
 #include "managers/manager_config.h"
 #include "managers/manager_config_persistence.h"
 #include "managers/manager_sensor.h"
-#include "managers/manager_sensor_persistence.h"
 #include "utils/critical_section.h"
+#include "utils/file_io_queue.h"
 #include "web/handler/admin_handler.h"
 
 // Configuration storage: Preferences library (flash-based key-value store)
@@ -49,6 +49,7 @@ void AdminHandler::handleConfigReset() {
   delay(2000);
   if (result.isSuccess()) {
     logger.warning(F("AdminHandler"), F("Neustart nach Zurücksetzen der Konfiguration"));
+    FileIoQueue::getInstance().flushAll();
     ESP.restart();
   }
 }
@@ -66,6 +67,9 @@ void AdminHandler::handleReboot() {
       },
       css, js);
 
+  // Zwischengespeicherte Laufzeitwerte und Dateien vor dem Neustart schreiben
+  FileIoQueue::getInstance().flushAll();
+
   // Verzögerter Neustart
   delay(200);
   logger.warning(F("AdminHandler"), F("Starte ESP neu"));
@@ -13,6 +13,7 @@
 
 #include "../core/web_auth.h"
 #include "base_handler.h"
+#include "../../utils/file_io_queue.h"
 
 /**
  * @class AdminMinimalHandler
@@ -35,7 +36,7 @@ public:
    *          - Initializes logging
    */
   AdminMinimalHandler(ESP8266WebServer& server, WebAuth& auth) : BaseHandler(server), _auth(auth) {
-    logger.debug(F("AdminMinimalHandler"), F("Initialisiere AdminMinimalHandler"));
+    LOG_DEBUG(F("AdminMinimalHandler"), F("Initialisiere AdminMinimalHandler"));
   }
 
   /**
@@ -53,7 +54,7 @@ public:
     if (!result.isSuccess()) {
       return result;
     }
-    logger.debug(F("AdminMinimalHandler"), F("Reboot Route registriert"));
+    LOG_DEBUG(F("AdminMinimalHandler"), F("Reboot Route registriert"));
     return RouterResult::success();
   }
 
@@ -111,6 +112,7 @@ public:
 
     delay(500); // Give time to send response
     logger.warning(F("AdminMinimalHandler"), F("Starte Sensor neu"));
+    FileIoQueue::getInstance().flushAll();
     ESP.restart();
   }
 
@@ -30,15 +30,15 @@ void AdminSensorHandler::handleAnalogMinMax() {
   float newMin = _server.arg("min").toFloat();
   float newMax = _server.arg("max").toFloat();
 
-  logger.debug(F("AdminSensorHandler"), F("handleAnalogMinMax: sensor=") + sensorId +
-                                            F(", measurement=") + String(measurementIndex) +
-                                            F(", min=") + String(newMin) + F(", max=") +
-                                            String(newMax));
+  LOG_DEBUG(F("AdminSensorHandler"), F("handleAnalogMinMax: sensor=") + sensorId +
+                                         F(", measurement=") + String(measurementIndex) +
+                                         F(", min=") + String(newMin) + F(", max=") +
+                                         String(newMax));
 
   // Debug: print all incoming arguments
   for (int i = 0; i < _server.args(); ++i) {
-    logger.debug(F("AdminSensorHandler"),
-                 F("POST arg: ") + _server.argName(i) + F(" = ") + _server.arg(i));
+    LOG_DEBUG(F("AdminSensorHandler"),
+              F("POST arg: ") + _server.argName(i) + F(" = ") + _server.arg(i));
   }
 
   if (!_sensorManager.isHealthy()) {
@@ -93,8 +93,8 @@ void AdminSensorHandler::handleAnalogMinMax() {
     changed = true;
   }
   if (changed) {
-    logger.debug(F("AdminSensorHandler"),
-                 F("Analog-Min/Max geändert, Konfiguration wird aktualisiert und persistiert"));
+    LOG_DEBUG(F("AdminSensorHandler"),
+              F("Analog-Min/Max geändert, Konfiguration wird aktualisiert und persistiert"));
     // Persist min/max in config
     config.measurements[measurementIndex].minValue = analog->getMinValue(measurementIndex);
     config.measurements[measurementIndex].maxValue = analog->getMaxValue(measurementIndex);
@@ -111,14 +111,14 @@ void AdminSensorHandler::handleAnalogMinMax() {
           500, F("{\"success\":false,\"error\":\"Fehler beim Speichern der Min/Max-Werte\"}"));
       return;
     }
-    logger.debug(F("AdminSensorHandler"),
-                 F("Erfolgreich Analog-Min/Max aktualisiert für ") + sensorId + F("[") +
-                     String(measurementIndex) + F("]: min=") +
-                     String(config.measurements[measurementIndex].minValue) + F(", max=") +
-                     String(config.measurements[measurementIndex].maxValue));
+    LOG_DEBUG(F("AdminSensorHandler"),
+              F("Erfolgreich Analog-Min/Max aktualisiert für ") + sensorId + F("[") +
+                  String(measurementIndex) + F("]: min=") +
+                  String(config.measurements[measurementIndex].minValue) + F(", max=") +
+                  String(config.measurements[measurementIndex].maxValue));
   } else {
-    logger.debug(F("AdminSensorHandler"),
-                 F("Keine Änderungen für Analog-Min/Max-Werte festgestellt"));
+    LOG_DEBUG(F("AdminSensorHandler"),
+              F("Keine Änderungen für Analog-Min/Max-Werte festgestellt"));
   }
 
   sendJsonResponse(200, F("{\"success\":true}"));
@@ -289,8 +289,8 @@ void AdminSensorHandler::handleAnalogAutocal() {
       }
     } else {
       if (ConfigMgr.isDebugSensor()) {
-        logger.debug(F("AdminSensorHandler"), F("Initiale Autocal-Min/Max entspricht vorhandener "
-                                                "Konfiguration; Persistierung übersprungen"));
+        LOG_DEBUG(F("AdminSensorHandler"), F("Initiale Autocal-Min/Max entspricht vorhandener "
+                                             "Konfiguration; Persistierung übersprungen"));
       }
     }
 
@@ -321,15 +321,15 @@ void AdminSensorHandler::handleAnalogAutocal() {
           }
         } else {
           if (ConfigMgr.isDebugSensor()) {
-            logger.debug(
+            LOG_DEBUG(
                 F("AdminSensorHandler"),
                 F("Kein letzter Rohwert verfügbar, initiale absolute Roh-Extrema nicht gesetzt"));
           }
         }
       } else {
         if (ConfigMgr.isDebugSensor()) {
-          logger.debug(F("AdminSensorHandler"),
-                       F("Absolute Roh-Extrema bereits vorhanden, seeding uebersprungen"));
+          LOG_DEBUG(F("AdminSensorHandler"),
+                    F("Absolute Roh-Extrema bereits vorhanden, seeding uebersprungen"));
         }
       }
     }
@@ -385,9 +385,9 @@ void AdminSensorHandler::handleAnalogAutocalDuration() {
   size_t measurementIndex = _server.arg("measurement_index").toInt();
   unsigned long dur = _server.arg("duration").toInt();
 
-  logger.debug(F("AdminSensorHandler"), F("handleAnalogAutocalDuration: sensor=") + sensorId +
-                                            F(", measurement=") + String(measurementIndex) +
-                                            F(", duration=") + String(dur));
+  LOG_DEBUG(F("AdminSensorHandler"), F("handleAnalogAutocalDuration: sensor=") + sensorId +
+                                         F(", measurement=") + String(measurementIndex) +
+                                         F(", duration=") + String(dur));
 
   if (!_sensorManager.isHealthy()) {
     sendJsonResponse(500,
@@ -25,12 +25,12 @@ void AdminSensorHandler::handleSingleSensorUpdate() {
     return;
   }
   String id = _server.arg("sensor_id");
-  logger.debug(F("AdminSensorHandler"),
-               F("handleSingleSensorUpdate: empfangene sensor_id = ") + id);
+  LOG_DEBUG(F("AdminSensorHandler"),
+            F("handleSingleSensorUpdate: empfangene sensor_id = ") + id);
   // Log all POST arguments
   for (int i = 0; i < _server.args(); ++i) {
-    logger.debug(F("AdminSensorHandler"),
-                 F("POST arg: ") + _server.argName(i) + F(" = ") + _server.arg(i));
+    LOG_DEBUG(F("AdminSensorHandler"),
+              F("POST arg: ") + _server.argName(i) + F(" = ") + _server.arg(i));
   }
   if (!_sensorManager.isHealthy()) {
     sendJsonResponse(500,
@@ -179,9 +179,9 @@ void AdminSensorHandler::handleMeasurementName() {
   size_t measurementIndex = _server.arg("measurement_index").toInt();
   String newName = _server.arg("name");
 
-  logger.debug(F("AdminSensorHandler"), F("handleMeasurementName: sensor_id=") + id +
-                                            F(", measurement_index=") + String(measurementIndex) +
-                                            F(", name='") + newName + F("'"));
+  LOG_DEBUG(F("AdminSensorHandler"), F("handleMeasurementName: sensor_id=") + id +
+                                         F(", measurement_index=") + String(measurementIndex) +
+                                         F(", name='") + newName + F("'"));
 
   if (!_sensorManager.isHealthy()) {
     sendJsonResponse(500, F("{\"success\":false,\"error\":\"Sensor manager not healthy\"}"));
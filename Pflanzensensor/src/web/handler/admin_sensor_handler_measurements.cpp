@@ -22,8 +22,8 @@ void AdminSensorHandler::handleMeasurementInterval() {
   unsigned long intervalSeconds = _server.arg("interval").toInt();
   unsigned long intervalMilliseconds = intervalSeconds * 1000;
 
-  logger.debug(F("AdminSensorHandler"), F("handleMeasurementInterval: sensor=") + sensorId +
-                                            F(", interval=") + String(intervalSeconds) + F("s"));
+  LOG_DEBUG(F("AdminSensorHandler"), F("handleMeasurementInterval: sensor=") + sensorId +
+                                         F(", interval=") + String(intervalSeconds) + F("s"));
 
   // Validate interval
   if (intervalSeconds < 10 || intervalSeconds > 3600) {
@@ -152,7 +152,7 @@ void AdminSensorHandler::handleTriggerMeasurement() {
 
   String sensorId = _server.arg("sensor_id");
   String measurementIndexStr = _server.arg("measurement_index");
-  logger.debug(
+  LOG_DEBUG(
       F("AdminSensorHandler"),
       "Triggering measurement for sensor: " + sensorId +
           (measurementIndexStr.length() > 0 ? " measurement: " + measurementIndexStr : ""));
@@ -26,8 +26,8 @@ void AdminSensorHandler::handleResetAbsoluteMinMax() {
   String sensorId = _server.arg("sensor_id");
   size_t measurementIndex = _server.arg("measurement_index").toInt();
 
-  logger.debug(F("AdminSensorHandler"), F("handleResetAbsoluteMinMax: sensor=") + sensorId +
-                                            F(", measurement=") + String(measurementIndex));
+  LOG_DEBUG(F("AdminSensorHandler"), F("handleResetAbsoluteMinMax: sensor=") + sensorId +
+                                         F(", measurement=") + String(measurementIndex));
 
   if (!_sensorManager.isHealthy()) {
     sendJsonResponse(500,
@@ -71,7 +71,7 @@ void AdminSensorHandler::handleResetAbsoluteMinMax() {
   // Reload the sensor configuration from the JSON file to ensure in-memory
   // values are updated
   if (ConfigMgr.isDebugSensor()) {
-    logger.debug(F("AdminSensorHandler"), F("Reloading sensor configuration after reset"));
+    LOG_DEBUG(F("AdminSensorHandler"), F("Reloading sensor configuration after reset"));
   }
 
   auto reloadResult = SensorPersistence::load();
@@ -81,8 +81,8 @@ void AdminSensorHandler::handleResetAbsoluteMinMax() {
                        reloadResult.getMessage());
   } else {
     if (ConfigMgr.isDebugSensor()) {
-      logger.debug(F("AdminSensorHandler"),
-                   F("Sensor-Konfiguration nach dem Zurücksetzen erfolgreich neu geladen"));
+      LOG_DEBUG(F("AdminSensorHandler"),
+                F("Sensor-Konfiguration nach dem Zurücksetzen erfolgreich neu geladen"));
     }
   }
 
@@ -108,8 +108,8 @@ void AdminSensorHandler::handleResetAbsoluteRawMinMax() {
   String sensorId = _server.arg("sensor_id");
   size_t measurementIndex = _server.arg("measurement_index").toInt();
 
-  logger.debug(F("AdminSensorHandler"), F("handleResetAbsoluteRawMinMax: sensor=") + sensorId +
-                                            F(", measurement=") + String(measurementIndex));
+  LOG_DEBUG(F("AdminSensorHandler"), F("handleResetAbsoluteRawMinMax: sensor=") + sensorId +
+                                         F(", measurement=") + String(measurementIndex));
 
   if (!_sensorManager.isHealthy()) {
     sendJsonResponse(500,
@@ -144,9 +144,9 @@ void AdminSensorHandler::handleResetAbsoluteRawMinMax() {
   config.measurements[measurementIndex].absoluteRawMax = INT_MIN;
 
   if (ConfigMgr.isDebugSensor()) {
-    logger.debug(F("AdminSensorHandler"),
-                 F("Zurücksetzen der absoluten Roh-Min/Max-Werte für Sensor ") + sensorId +
-                     F(" Messung ") + String(measurementIndex));
+    LOG_DEBUG(F("AdminSensorHandler"),
+              F("Zurücksetzen der absoluten Roh-Min/Max-Werte für Sensor ") + sensorId +
+                  F(" Messung ") + String(measurementIndex));
   }
 
   // Use atomic update to reset absolute raw min/max values
@@ -162,8 +162,8 @@ void AdminSensorHandler::handleResetAbsoluteRawMinMax() {
 
   // No need to reload configs anymore - we now have a single source of truth
   if (ConfigMgr.isDebugSensor()) {
-    logger.debug(F("AdminSensorHandler"), F("Zurücksetzen abgeschlossen für Sensor ") + sensorId +
-                                              F(" Messung ") + String(measurementIndex));
+    LOG_DEBUG(F("AdminSensorHandler"), F("Zurücksetzen abgeschlossen für Sensor ") + sensorId +
+                                           F(" Messung ") + String(measurementIndex));
   }
 
   logger.info(F("AdminSensorHandler"), F("Absolute Roh-Min/Max zurückgesetzt für ") + sensorId +
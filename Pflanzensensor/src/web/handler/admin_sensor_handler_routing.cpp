@@ -7,10 +7,10 @@
 #include "logger/logger.h"
 
 RouterResult AdminSensorHandler::onRegisterRoutes(WebRouter& router) {
-  logger.debug(F("AdminSensorHandler"), F("Registriere Admin-Sensor-Routen"));
+  LOG_DEBUG(F("AdminSensorHandler"), F("Registriere Admin-Sensor-Routen"));
 
   auto result = router.addRoute(HTTP_GET, "/admin/sensors", [this]() {
-    logger.debug(F("AdminSensorHandler"), F("GET /admin/sensors aufgerufen"));
+    LOG_DEBUG(F("AdminSensorHandler"), F("GET /admin/sensors aufgerufen"));
     handleSensorConfig();
   });
   if (!result.isSuccess()) {
@@ -20,7 +20,7 @@ RouterResult AdminSensorHandler::onRegisterRoutes(WebRouter& router) {
   }
 
   result = router.addRoute(HTTP_POST, "/admin/sensors", [this]() {
-    logger.debug(F("AdminSensorHandler"), F("POST /admin/sensors aufgerufen"));
+    LOG_DEBUG(F("AdminSensorHandler"), F("POST /admin/sensors aufgerufen"));
     handleSensorUpdate();
   });
   if (!result.isSuccess()) {
@@ -33,7 +33,7 @@ RouterResult AdminSensorHandler::onRegisterRoutes(WebRouter& router) {
   // with namespace="general", key="flower_sens"
 
   result = router.addRoute(HTTP_POST, "/admin/sensor_update", [this]() {
-    logger.debug(F("AdminSensorHandler"), F("POST /admin/sensor_update aufgerufen"));
+    LOG_DEBUG(F("AdminSensorHandler"), F("POST /admin/sensor_update aufgerufen"));
     handleSingleSensorUpdate();
   });
   if (!result.isSuccess()) {
@@ -44,7 +44,7 @@ RouterResult AdminSensorHandler::onRegisterRoutes(WebRouter& router) {
   }
 
   result = router.addRoute(HTTP_POST, "/admin/measurement_interval", [this]() {
-    logger.debug(F("AdminSensorHandler"), F("POST /admin/measurement_interval aufgerufen"));
+    LOG_DEBUG(F("AdminSensorHandler"), F("POST /admin/measurement_interval aufgerufen"));
     handleMeasurementInterval();
   });
   if (!result.isSuccess()) {
@@ -56,7 +56,7 @@ RouterResult AdminSensorHandler::onRegisterRoutes(WebRouter& router) {
 
 #if USE_ANALOG
   result = router.addRoute(HTTP_POST, "/admin/analog_minmax", [this]() {
-    logger.debug(F("AdminSensorHandler"), F("POST /admin/analog_minmax aufgerufen"));
+    LOG_DEBUG(F("AdminSensorHandler"), F("POST /admin/analog_minmax aufgerufen"));
     handleAnalogMinMax();
   });
   if (!result.isSuccess()) {
@@ -67,7 +67,7 @@ RouterResult AdminSensorHandler::onRegisterRoutes(WebRouter& router) {
   }
 
   result = router.addRoute(HTTP_POST, "/admin/analog_autocal", [this]() {
-    logger.debug(F("AdminSensorHandler"), F("POST /admin/analog_autocal aufgerufen"));
+    LOG_DEBUG(F("AdminSensorHandler"), F("POST /admin/analog_autocal aufgerufen"));
     handleAnalogAutocal();
   });
   if (!result.isSuccess()) {
@@ -78,7 +78,7 @@ RouterResult AdminSensorHandler::onRegisterRoutes(WebRouter& router) {
   }
 
   result = router.addRoute(HTTP_POST, "/admin/analog_autocal_duration", [this]() {
-    logger.debug(F("AdminSensorHandler"), F("POST /admin/analog_autocal_duration aufgerufen"));
+    LOG_DEBUG(F("AdminSensorHandler"), F("POST /admin/analog_autocal_duration aufgerufen"));
     handleAnalogAutocalDuration();
   });
   if (!result.isSuccess()) {
@@ -90,7 +90,7 @@ RouterResult AdminSensorHandler::onRegisterRoutes(WebRouter& router) {
 #endif
 
   result = router.addRoute(HTTP_POST, "/admin/thresholds", [this]() {
-    logger.debug(F("AdminSensorHandler"), F("POST /admin/thresholds aufgerufen"));
+    LOG_DEBUG(F("AdminSensorHandler"), F("POST /admin/thresholds aufgerufen"));
     handleThresholds();
   });
   if (!result.isSuccess()) {
@@ -101,7 +101,7 @@ RouterResult AdminSensorHandler::onRegisterRoutes(WebRouter& router) {
   }
 
   result = router.addRoute(HTTP_POST, "/admin/measurement_name", [this]() {
-    logger.debug(F("AdminSensorHandler"), F("POST /admin/measurement_name aufgerufen"));
+    LOG_DEBUG(F("AdminSensorHandler"), F("POST /admin/measurement_name aufgerufen"));
     handleMeasurementName();
   });
   if (!result.isSuccess()) {
@@ -112,7 +112,7 @@ RouterResult AdminSensorHandler::onRegisterRoutes(WebRouter& router) {
   }
 
   result = router.addRoute(HTTP_POST, "/admin/reset_absolute_minmax", [this]() {
-    logger.debug(F("AdminSensorHandler"), F("POST /admin/reset_absolute_minmax aufgerufen"));
+    LOG_DEBUG(F("AdminSensorHandler"), F("POST /admin/reset_absolute_minmax aufgerufen"));
     handleResetAbsoluteMinMax();
   });
   if (!result.isSuccess()) {
@@ -123,7 +123,7 @@ RouterResult AdminSensorHandler::onRegisterRoutes(WebRouter& router) {
   }
 
   result = router.addRoute(HTTP_POST, "/admin/reset_absolute_raw_minmax", [this]() {
-    logger.debug(F("AdminSensorHandler"), F("POST /admin/reset_absolute_raw_minmax aufgerufen"));
+    LOG_DEBUG(F("AdminSensorHandler"), F("POST /admin/reset_absolute_raw_minmax aufgerufen"));
     handleResetAbsoluteRawMinMax();
   });
   if (!result.isSuccess()) {
@@ -137,7 +137,7 @@ RouterResult AdminSensorHandler::onRegisterRoutes(WebRouter& router) {
   // Route intentionally not registered to avoid exposing duplicate functionality
 
   result = router.addRoute(HTTP_POST, "/trigger_measurement", [this]() {
-    logger.debug(F("AdminSensorHandler"), F("POST /trigger_measurement aufgerufen"));
+    LOG_DEBUG(F("AdminSensorHandler"), F("POST /trigger_measurement aufgerufen"));
     handleTriggerMeasurement();
   });
   if (!result.isSuccess()) {
@@ -148,7 +148,7 @@ RouterResult AdminSensorHandler::onRegisterRoutes(WebRouter& router) {
   }
 
   result = router.addRoute(HTTP_GET, "/admin/getSensorConfig", [this]() {
-    logger.debug(F("AdminSensorHandler"), F("GET /admin/getSensorConfig aufgerufen"));
+    LOG_DEBUG(F("AdminSensorHandler"), F("GET /admin/getSensorConfig aufgerufen"));
     handleGetSensorConfigJson();
   });
   if (!result.isSuccess()) {
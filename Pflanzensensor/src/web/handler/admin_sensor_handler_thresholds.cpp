@@ -82,17 +82,17 @@ void AdminSensorHandler::handleThresholds() {
   String thresholdsCsv = _server.arg("thresholds");
 
   // Debug: print all incoming arguments
-  logger.debug(F("AdminSensorHandler"), F("handleThresholds: sensor=") + sensorId +
-                                            F(", measurement=") + String(measurementIndex) +
-                                            F(", thresholds=") + thresholdsCsv);
-  logger.debug(F("AdminSensorHandler"), F("sensorId length: ") + String(sensorId.length()));
-  logger.debug(F("AdminSensorHandler"),
-               F("thresholdsCsv length: ") + String(thresholdsCsv.length()));
+  LOG_DEBUG(F("AdminSensorHandler"), F("handleThresholds: sensor=") + sensorId +
+                                         F(", measurement=") + String(measurementIndex) +
+                                         F(", thresholds=") + thresholdsCsv);
+  LOG_DEBUG(F("AdminSensorHandler"), F("sensorId length: ") + String(sensorId.length()));
+  LOG_DEBUG(F("AdminSensorHandler"),
+            F("thresholdsCsv length: ") + String(thresholdsCsv.length()));
 
   // Print all POST args for full context
   for (int i = 0; i < _server.args(); ++i) {
-    logger.debug(F("AdminSensorHandler"),
-                 F("POST arg: ") + _server.argName(i) + F(" = ") + _server.arg(i));
+    LOG_DEBUG(F("AdminSensorHandler"),
+              F("POST arg: ") + _server.argName(i) + F(" = ") + _server.arg(i));
   }
 
   if (!_sensorManager.isHealthy()) {
@@ -127,10 +127,10 @@ void AdminSensorHandler::handleThresholds() {
                  &thresholds[2], &thresholds[3]);
 
   // Debug: print parsed threshold values
-  logger.debug(F("AdminSensorHandler"),
-               F("Parsed thresholds: n=") + String(n) + F(", values=") + String(thresholds[0], 2) +
-                   F(",") + String(thresholds[1], 2) + F(",") + String(thresholds[2], 2) + F(",") +
-                   String(thresholds[3], 2));
+  LOG_DEBUG(F("AdminSensorHandler"),
+            F("Parsed thresholds: n=") + String(n) + F(", values=") + String(thresholds[0], 2) +
+                F(",") + String(thresholds[1], 2) + F(",") + String(thresholds[2], 2) + F(",") +
+                String(thresholds[3], 2));
 
   if (n != 4) {
     logger.error(F("AdminSensorHandler"), F("Ungültiges Schwellenwert-Format: ") + thresholdsCsv);
@@ -154,10 +154,10 @@ void AdminSensorHandler::handleThresholds() {
   bool changed = false;
 
   // Debug: print limits before
-  logger.debug(F("AdminSensorHandler"), F("Limits before: ") + String(limits.yellowLow, 2) +
-                                            F(",") + String(limits.greenLow, 2) + F(",") +
-                                            String(limits.greenHigh, 2) + F(",") +
-                                            String(limits.yellowHigh, 2));
+  LOG_DEBUG(F("AdminSensorHandler"), F("Limits before: ") + String(limits.yellowLow, 2) +
+                                         F(",") + String(limits.greenLow, 2) + F(",") +
+                                         String(limits.greenHigh, 2) + F(",") +
+                                         String(limits.yellowHigh, 2));
 
   if (limits.yellowLow != thresholds[0]) {
     limits.yellowLow = thresholds[0];
@@ -177,10 +177,10 @@ void AdminSensorHandler::handleThresholds() {
   }
 
   // Debug: print limits after
-  logger.debug(F("AdminSensorHandler"), F("Limits after: ") + String(limits.yellowLow, 2) + F(",") +
-                                            String(limits.greenLow, 2) + F(",") +
-                                            String(limits.greenHigh, 2) + F(",") +
-                                            String(limits.yellowHigh, 2));
+  LOG_DEBUG(F("AdminSensorHandler"), F("Limits after: ") + String(limits.yellowLow, 2) + F(",") +
+                                         String(limits.greenLow, 2) + F(",") +
+                                         String(limits.greenHigh, 2) + F(",") +
+                                         String(limits.yellowHigh, 2));
 
   if (changed) {
     // Persist thresholds to config manager
@@ -14,11 +14,11 @@
 #include "web/core/components.h"
 
 void AdminSensorHandler::handleSensorConfig() {
-  logger.debug(F("AdminSensorHandler"), F("handleSensorConfig() aufgerufen"));
+  LOG_DEBUG(F("AdminSensorHandler"), F("handleSensorConfig() aufgerufen"));
 
   if (!validateRequest()) {
-    logger.debug(F("AdminSensorHandler"),
-                 F("Authentifizierung in handleSensorConfig fehlgeschlagen"));
+    LOG_DEBUG(F("AdminSensorHandler"),
+              F("Authentifizierung in handleSensorConfig fehlgeschlagen"));
     this->sendError(401, F("Authentifizierung erforderlich"));
     return;
   }
@@ -415,7 +415,7 @@ void AdminSensorHandler::renderSensorMeasurementRow(Sensor* sensor, size_t i, si
 }
 
 void AdminSensorHandler::renderFlowerStatusSensorCard() {
-  logger.debug(F("AdminSensorHandler"), F("renderFlowerStatusSensorCard()"));
+  LOG_DEBUG(F("AdminSensorHandler"), F("renderFlowerStatusSensorCard()"));
 
   sendChunk(F("<div class='card'>"));
   sendChunk(F("<h2>Gesicht der Blume</h2>"));
@@ -12,6 +12,9 @@
 
 LogHandler* LogHandler::s_instance = nullptr;
 bool LogHandler::s_initialized = false;
+#if USE_WEBSOCKET
+uint32_t LogHandler::s_droppedMessages = 0;
+#endif
 
 RouterResult LogHandler::onRegisterRoutes(WebRouter& router) {
   if (!isInitialized()) {
@@ -21,14 +24,18 @@ RouterResult LogHandler::onRegisterRoutes(WebRouter& router) {
                               F("LogHandler nicht initialisiert"));
   }
 
-  logger.debug(F("LogHandler"), F("Registriere Log-Routen"));
+  LOG_DEBUG(F("LogHandler"), F("Registriere Log-Routen"));
   auto result = router.addRoute(HTTP_GET, "/logs", [this]() {
-    logger.debug(F("LogHandler"), F("Log route handler called"));
+    LOG_DEBUG(F("LogHandler"), F("Log route handler called"));
     handleLogs();
   });
   if (!result.isSuccess())
     return result;
 
+  result = router.addRoute(HTTP_GET, "/logs/query", [this]() { handleQuery(); });
+  if (!result.isSuccess())
+    return result;
+
 #if USE_WEBSOCKET
   if (!initWebSocket()) {
     return RouterResult::fail(RouterError::OPERATION_FAILED,
@@ -65,7 +72,7 @@ void LogHandler::handleLogs() {
     return;
   }
 
-  logger.debug(F("LogHandler"), F("Verarbeite Logseiten-Anfrage"));
+  LOG_DEBUG(F("LogHandler"), F("Verarbeite Logseiten-Anfrage"));
   _cleaned = false;
 
   // Check memory before proceeding
@@ -176,7 +183,95 @@ void LogHandler::handleLogs() {
       },
       css, js);
 
-  logger.debug(F("LogHandler"), F("Log-Seite erfolgreich gesendet"));
+  LOG_DEBUG(F("LogHandler"), F("Log-Seite erfolgreich gesendet"));
+}
+
+void LogHandler::handleQuery() {
+  if (!_server.authenticate("admin", ConfigMgr.getAdminPassword().c_str())) {
+    _server.requestAuthentication();
+    return;
+  }
+
+  LogQuery::Filter filter;
+  if (_server.hasArg(F("level"))) {
+    filter.minLevel = static_cast<uint8_t>(Logger::stringToLogLevel(_server.arg(F("level"))));
+  }
+  String module = _server.arg(F("module"));
+  filter.module = module.c_str();
+  if (_server.hasArg(F("from"))) {
+    filter.from = strtoul(_server.arg(F("from")).c_str(), nullptr, 10);
+  }
+  if (_server.hasArg(F("to"))) {
+    filter.to = strtoul(_server.arg(F("to")).c_str(), nullptr, 10);
+  }
+  // Cursor as "<segment>:<offset>" from the previous response
+  LogQuery::Cursor cursor;
+  if (_server.hasArg(F("cursor"))) {
+    String text = _server.arg(F("cursor"));
+    char* end;
+    cursor.sequence = strtoul(text.c_str(), &end, 10);
+    if (*end == ':') {
+      cursor.offset = strtoul(end + 1, nullptr, 10);
+    }
+  }
+  size_t limit = QUERY_DEFAULT_LIMIT;
+  if (_server.hasArg(F("limit"))) {
+    long requested = _server.arg(F("limit")).toInt();
+    if (requested > 0) {
+      limit = min(static_cast<size_t>(requested), QUERY_MAX_LIMIT);
+    }
+  }
+
+  beginChunkedResponse(F("application/json"));
+  sendChunk(F("{\"lines\":["));
+
+  char buffer[256];
+  size_t used = 0;
+  bool firstLine = true;
+  auto flushBuffer = [&]() {
+    buffer[used] = '\0';
+    sendChunk(String(buffer));
+    used = 0;
+    yield();
+  };
+  LogQuery::Result result =
+      logger.queryFileLog(filter, cursor, limit, [&](const char* line, size_t length) {
+        // Room for the longest escape, the closing quote and a comma
+        if (used > sizeof(buffer) - 10) {
+          flushBuffer();
+        }
+        if (!firstLine) {
+          buffer[used++] = ',';
+        }
+        buffer[used++] = '"';
+        for (size_t i = 0; i < length; i++) {
+          if (used > sizeof(buffer) - 10) {
+            flushBuffer();
+          }
+          char c = line[i];
+          if (c == '"' || c == '\\') {
+            buffer[used++] = '\\';
+            buffer[used++] = c;
+          } else if (static_cast<unsigned char>(c) < 0x20) {
+            used += snprintf(buffer + used, sizeof(buffer) - used, "\\u%04x", c);
+          } else {
+            buffer[used++] = c;
+          }
+        }
+        buffer[used++] = '"';
+        firstLine = false;
+      });
+  buffer[used] = '\0';
+
+  char footer[128];
+  snprintf(footer, sizeof(footer),
+           "],\"count\":%u,\"next\":\"%lu:%lu\",\"more\":%s,\"scanned\":%u,\"skipped\":%u}",
+           static_cast<unsigned>(result.count), static_cast<unsigned long>(result.next.sequence),
+           static_cast<unsigned long>(result.next.offset), result.more ? "true" : "false",
+           static_cast<unsigned>(result.scannedBytes),
+           static_cast<unsigned>(result.skippedSegments));
+  sendChunk(String(buffer) + footer);
+  endChunkedResponse();
 }
 
 void LogHandler::cleanupLogs() {
@@ -185,25 +280,14 @@ void LogHandler::cleanupLogs() {
 
   // Remove disconnected clients
   for (auto it = _clients.begin(); it != _clients.end();) {
-    if (!ws.isInitialized() || !ws.clientIsConnected(*it)) {
+    if (!ws.isInitialized() || !ws.clientIsConnected(it->clientId)) {
       it = _clients.erase(it);
     } else {
       ++it;
     }
   }
-
-  // Send cleanup notification to remaining clients
-  StaticJsonDocument<128> doc;
-  doc["type"] = "cleanup";
-  doc["timestamp"] = millis();
-
-  String json;
-  serializeJson(doc, json);
-
-  for (auto client : _clients) {
-    if (ws.isInitialized()) {
-      ws.sendTXT(client, json);
-    }
+  if (_clients.empty()) {
+    releaseFrames();
   }
 #endif
   yield();
@@ -238,7 +322,7 @@ bool LogHandler::initWebSocket() {
     return false;
   }
 
-  logger.debug(F("LogHandler"), F("WebSocket server already initialized"));
+  LOG_DEBUG(F("LogHandler"), F("WebSocket server already initialized"));
 
   // Register logger callback for broadcasting logs
   logger.setCallback([](LogLevel level, const String& message) {
@@ -252,15 +336,12 @@ bool LogHandler::initWebSocket() {
 
 void LogHandler::loop() {
 #if USE_WEBSOCKET
-  if (!isInitialized())
+  if (!isInitialized() || _clients.empty())
     return;
 
-  auto& ws = WebSocketService::getInstance();
-  if (ws.isInitialized()) {
-    ws.loop();
-  }
+  sendQueuedLogs();
 
-  // Clean up old logs periodically
+  // Remove clients that disconnected without an event
   unsigned long now = millis();
   if (now - _lastCleanup >= LOG_CLEANUP_INTERVAL) {
     cleanupLogs();
@@ -279,72 +360,198 @@ void LogHandler::broadcastLog(LogLevel level, const String& message) {
   // DO NOT log inside this function! Logging here would cause infinite
   // recursion.
 
-  if (!isInitialized()) {
+  // Additional safety check - if the logger callback is disabled, don't
+  // broadcast
+  if (!isInitialized() || _clients.empty() || !logger.isCallbackEnabled()) {
     inBroadcast = false;
     return;
   }
 
-  // Check if we're in a critical operation (like config save)
-  if (ESP.getFreeHeap() < 4000 || ResourceMgr.isInCriticalOperation()) {
-    inBroadcast = false;
-    return;
+  // Module name from "<prefix> [<module>] <text>"
+  char module[LogRing::MODULE_NAME_SIZE] = {};
+  int moduleStart = message.indexOf('[');
+  int moduleEnd = moduleStart >= 0 ? message.indexOf(']', moduleStart) : -1;
+  if (moduleEnd > moduleStart) {
+    size_t length = std::min<size_t>(moduleEnd - moduleStart - 1, sizeof(module) - 1);
+    memcpy(module, message.c_str() + moduleStart + 1, length);
   }
 
-  // Additional safety check - if the logger callback is disabled, don't
-  // broadcast
-  if (!logger.isCallbackEnabled()) {
+  uint8_t levelValue = static_cast<uint8_t>(level);
+  bool subscribed = false;
+  for (const auto& client : _clients) {
+    subscribed = subscribed || isSubscribed(client, levelValue, module);
+  }
+  if (!subscribed) {
     inBroadcast = false;
     return;
   }
 
-  auto& ws = WebSocketService::getInstance();
-  if (!ws.isInitialized() || _clients.empty()) {
+  // Without memory for the frame the line is lost for every subscribed client
+  if (ESP.getFreeHeap() < 4000 || ResourceMgr.isInCriticalOperation()) {
+    for (auto& client : _clients) {
+      if (isSubscribed(client, levelValue, module)) {
+        client.dropped++;
+        s_droppedMessages++;
+      }
+    }
     inBroadcast = false;
     return;
   }
 
-  // Create JSON document for the log message
-  // Reduced document size to save RAM; payload contains only level/message/timestamp
-  StaticJsonDocument<256> doc;
-  doc["type"] = "log";
-  doc["level"] = Logger::logLevelToString(level);
-  doc["message"] = message;
-  doc["timestamp"] = logger.isNTPInitialized() ? logger.getSynchronizedTime() : millis();
-
-  String json;
-  serializeJson(doc, json);
+  // Encode the frame once for all clients
+  static const char* const LEVEL_NAMES[] = {"DEBUG", "INFO", "WARNING", "ERROR"};
+  unsigned long timestamp = logger.isNTPInitialized() ? logger.getSynchronizedTime() : millis();
+  char tail[40];
+  int tailLength = snprintf(tail, sizeof(tail), "\",\"timestamp\":%lu}", timestamp);
+  char json[WebSocketService::MAX_MESSAGE_SIZE];
+  size_t used = snprintf(json, sizeof(json), "{\"type\":\"log\",\"level\":\"%s\",\"message\":\"",
+                         LEVEL_NAMES[levelValue & 3]);
+  const size_t messageStart = used;
+  const size_t messageEnd = sizeof(json) - tailLength - 1;
+  bool cut = false;
+  for (size_t i = 0; i < message.length(); i++) {
+    char c = message[i];
+    bool control = static_cast<unsigned char>(c) < 0x20;
+    size_t needed = (c == '"' || c == '\\') ? 2 : control ? 6 : 1;
+    if (used + needed > messageEnd) {
+      cut = true;
+      break;
+    }
+    if (c == '"' || c == '\\') {
+      json[used++] = '\\';
+      json[used++] = c;
+    } else if (control) {
+      used += snprintf(json + used, sizeof(json) - used, "\\u%04x", c);
+    } else {
+      json[used++] = c;
+    }
+  }
+  if (cut) {
+    // Do not leave a partial UTF-8 character, browsers reject the frame
+    size_t start = used;
+    while (start > messageStart && (json[start - 1] & 0xC0) == 0x80) {
+      start--;
+    }
+    uint8_t lead = start > messageStart ? json[start - 1] : 0;
+    if (lead >= 0xC0) {
+      size_t sequence = lead >= 0xF0 ? 4 : lead >= 0xE0 ? 3 : 2;
+      if (used - (start - 1) < sequence) {
+        used = start - 1;
+      }
+    }
+  }
+  memcpy(json + used, tail, tailLength + 1);
+
+  // Clients that have not sent the oldest frame yet lose it
+  LogFrame& frame = _frames[_nextFrame % WEBSOCKET_LOG_QUEUE];
+  for (auto& client : _clients) {
+    if (_nextFrame - client.nextFrame >= WEBSOCKET_LOG_QUEUE) {
+      client.nextFrame++;
+      if (isSubscribed(client, frame.level, frame.module)) {
+        client.dropped++;
+        s_droppedMessages++;
+      }
+    }
+  }
+  frame.level = levelValue;
+  memcpy(frame.module, module, sizeof(module));
+  frame.text = json;
+  _nextFrame++;
+  inBroadcast = false;
+#endif
+}
 
-  int failureCount = 0;
-  const int MAX_FAILURES = 3;
+void LogHandler::sendQueuedLogs() {
+  auto& ws = WebSocketService::getInstance();
+  if (!ws.isInitialized())
+    return;
 
   for (auto it = _clients.begin(); it != _clients.end();) {
-    if (!ws.clientIsConnected(*it)) {
-      // Do not log here to avoid recursion
-      it = _clients.erase(it);
-      if (_clients.empty())
-        break;
-      continue;
+    LogSubscriber& client = *it;
+    bool failed = false;
+    if (client.dropped != client.reportedDropped) {
+      char notice[48];
+      snprintf(notice, sizeof(notice), "{\"type\":\"dropped\",\"count\":%lu}",
+               static_cast<unsigned long>(client.dropped - client.reportedDropped));
+      client.reportedDropped = client.dropped;
+      failed = !ws.sendTXT(client.clientId, notice);
     }
-    // Do not log here to avoid recursion
-    if (!ws.sendTXT(*it, json)) {
-      // Do not log here to avoid recursion
-      it = _clients.erase(it);
-      failureCount++;
-      yield();
-      if (failureCount >= MAX_FAILURES) {
-        // Do not log here to avoid recursion
-        _clients.clear();
-        break;
+    uint8_t sent = 0;
+    while (!failed && sent < FRAMES_PER_LOOP && client.nextFrame != _nextFrame) {
+      const LogFrame& frame = _frames[client.nextFrame % WEBSOCKET_LOG_QUEUE];
+      client.nextFrame++;
+      if (isSubscribed(client, frame.level, frame.module)) {
+        failed = !ws.sendTXT(client.clientId, frame.text);
+        sent++;
       }
-      if (_clients.empty())
-        break;
+    }
+    if (failed) {
+      // Do not log here, the line would be queued for this client again
+      it = _clients.erase(it);
     } else {
-      // Do not log here to avoid recursion
       ++it;
     }
   }
-  inBroadcast = false;
-#endif
+  if (_clients.empty()) {
+    releaseFrames();
+  }
+}
+
+bool LogHandler::isSubscribed(const LogSubscriber& client, uint8_t level, const char* module) {
+  if (level < client.minLevel) {
+    return false;
+  }
+  if (client.modules.isEmpty()) {
+    return true;
+  }
+  if (module[0] == '\0') {
+    return false;
+  }
+  // The module list is ",A,B,"
+  const char* names = client.modules.c_str();
+  size_t length = strlen(module);
+  for (const char* name = strstr(names, module); name; name = strstr(name + 1, module)) {
+    if (name > names && name[-1] == ',' && name[length] == ',') {
+      return true;
+    }
+  }
+  return false;
+}
+
+void LogHandler::subscribe(uint8_t clientNum, const char* level, const char* modules) {
+  auto it = std::find_if(_clients.begin(), _clients.end(),
+                         [clientNum](const LogSubscriber& client) {
+                           return client.clientId == clientNum;
+                         });
+  if (it == _clients.end())
+    return;
+
+  it->minLevel = (level && level[0] != '\0')
+                     ? static_cast<uint8_t>(Logger::stringToLogLevel(String(level)))
+                     : 0;
+  it->modules = String();
+  if (modules && modules[0] != '\0') {
+    it->modules = ',';
+    for (const char* c = modules; *c; c++) {
+      if (*c != ' ') {
+        it->modules += *c;
+      }
+    }
+    it->modules += ',';
+  }
+
+  StaticJsonDocument<64> response;
+  response["type"] = "subscribed";
+  response["level"] = Logger::logLevelToString(static_cast<LogLevel>(it->minLevel));
+  String jsonResponse;
+  serializeJson(response, jsonResponse);
+  WebSocketService::getInstance().sendTXT(clientNum, jsonResponse);
+}
+
+void LogHandler::releaseFrames() {
+  for (auto& frame : _frames) {
+    frame.text = String();
+  }
 }
 
 void LogHandler::cleanupAllClients() {
@@ -355,18 +562,18 @@ void LogHandler::cleanupAllClients() {
   auto& ws = WebSocketService::getInstance();
 
   // Clear the client list
-  for (auto clientId : _clients) {
-    if (ws.isInitialized() && ws.clientIsConnected(clientId)) {
-      ws.sendTXT(clientId, F("{\"type\":\"shutdown\"}"));
+  for (const auto& client : _clients) {
+    if (ws.isInitialized() && ws.clientIsConnected(client.clientId)) {
+      ws.sendTXT(client.clientId, F("{\"type\":\"shutdown\"}"));
     }
   }
 
   _clients.clear();
-  _messageQueue.clear();
+  releaseFrames();
   _content.clear();
   _cleaned = false;
 
-  logger.debug(F("LogHandler"), F("All WebSocket clients cleaned up"));
+  LOG_DEBUG(F("LogHandler"), F("All WebSocket clients cleaned up"));
 #if USE_WEBSOCKET
   // Unregister logger callback to free std::function memory
   logger.setCallback(nullptr);
@@ -391,12 +598,17 @@ void LogHandler::handleWebSocketEvent(uint8_t num, WStype_t type, uint8_t* paylo
   case WStype_CONNECTED: {
     IPAddress ip = ws.remoteIP(num);
     if (ConfigMgr.isDebugWebSocket()) {
-      logger.debug(F("LogHandler"),
-                   "WebSocket client " + String(num) + " connected from " + ip.toString());
+      LOG_DEBUG(F("LogHandler"),
+                "WebSocket client " + String(num) + " connected from " + ip.toString());
     }
-    // Only add if not already present
-    if (std::find(_clients.begin(), _clients.end(), num) == _clients.end()) {
-      _clients.push_back(num);
+    // Only add if not already present; new clients get all lines from now on
+    if (std::find_if(_clients.begin(), _clients.end(), [num](const LogSubscriber& client) {
+          return client.clientId == num;
+        }) == _clients.end()) {
+      LogSubscriber client;
+      client.clientId = num;
+      client.nextFrame = _nextFrame;
+      _clients.push_back(client);
     }
     // Send welcome message with minimal memory usage
     StaticJsonDocument<128> doc; // Reduced size
@@ -412,10 +624,9 @@ void LogHandler::handleWebSocketEvent(uint8_t num, WStype_t type, uint8_t* paylo
   }
   case WStype_DISCONNECTED: {
     if (ConfigMgr.isDebugWebSocket()) {
-      logger.debug(F("LogHandler"), "WebSocket client " + String(num) + " disconnected");
+      LOG_DEBUG(F("LogHandler"), "WebSocket client " + String(num) + " disconnected");
     }
     // Remove only the disconnected client
-    _clients.remove(num);
     cleanupClientResources(num);
     break;
   }
@@ -460,6 +671,12 @@ void LogHandler::handleWebSocketEvent(uint8_t num, WStype_t type, uint8_t* paylo
       return;
     }
 
+    // {"type":"subscribe","data":"<minimum level>","modules":"<A,B>"}
+    if (strcmp(typeStr, "subscribe") == 0) {
+      subscribe(num, dataStr, doc["modules"].as<const char*>());
+      break;
+    }
+
     String type = String(typeStr);
     String data = dataStr ? String(dataStr) : "";
 
@@ -472,7 +689,6 @@ void LogHandler::handleWebSocketEvent(uint8_t num, WStype_t type, uint8_t* paylo
       logger.error(F("LogHandler"), "WebSocket error on client " + String(num));
     }
     cleanupClientResources(num);
-    _clients.remove(num);
     break;
   }
 
@@ -490,7 +706,7 @@ void LogHandler::handleWebSocketEvent(uint8_t num, WStype_t type, uint8_t* paylo
   default:
     if (ConfigMgr.isDebugWebSocket()) {
       if (type != WStype_PING) { // Don't log PING events
-        logger.debug(F("LogHandler"), "Unhandled WebSocket event type: " + String(type));
+        LOG_DEBUG(F("LogHandler"), "Unhandled WebSocket event type: " + String(type));
       }
     }
     break;
@@ -500,10 +716,11 @@ void LogHandler::handleWebSocketEvent(uint8_t num, WStype_t type, uint8_t* paylo
 
 void LogHandler::cleanupClientResources(uint8_t clientNum) {
 #if USE_WEBSOCKET
-  _messageQueue.erase(
-      std::remove_if(_messageQueue.begin(), _messageQueue.end(),
-                     [clientNum](const QueuedMessage& msg) { return msg.clientId == clientNum; }),
-      _messageQueue.end());
+  _clients.remove_if(
+      [clientNum](const LogSubscriber& client) { return client.clientId == clientNum; });
+  if (_clients.empty()) {
+    releaseFrames();
+  }
 #endif
 }
 
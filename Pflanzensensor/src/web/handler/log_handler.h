@@ -17,9 +17,18 @@
 #include "configs/config.h"
 #if USE_WEBSOCKET
 #include "../services/websocket.h"
+#include "logger/log_ring.h"
 #endif
 #include "base_handler.h"
 
+#if USE_WEBSOCKET
+// Check if WEBSOCKET_LOG_QUEUE is defined
+#ifndef WEBSOCKET_LOG_QUEUE
+#define WEBSOCKET_LOG_QUEUE 16
+#warning "WEBSOCKET_LOG_QUEUE not defined in config file, defaulting to 16 lines"
+#endif
+#endif
+
 class WebManager; ///< Forward declaration for web manager
 class WebAuth;    ///< Forward declaration for authentication service
 class CSSService; ///< Forward declaration for CSS service
@@ -33,6 +42,12 @@ class CSSService; ///< Forward declaration for CSS service
  *          - Client connections
  *          - Log cleanup
  *          - Interface generation
+ *
+ *          Log lines for WebSocket clients are encoded once into a shared
+ *          ring of WEBSOCKET_LOG_QUEUE frames. Every client reads the ring at
+ *          its own position and only gets the lines matching its
+ *          subscription. Frames a client has not received before they are
+ *          overwritten are counted as dropped for that client.
  */
 class LogHandler : public BaseHandler {
   friend class WebManager; // Allow WebManager to access private members
@@ -43,6 +58,11 @@ public:
   static constexpr uint16_t WS_PORT = 81; ///< WebSocket server port
 #endif
   static constexpr unsigned long LOG_CLEANUP_INTERVAL = 60000; ///< Cleanup interval (60 seconds)
+#if USE_WEBSOCKET
+  static constexpr uint8_t FRAMES_PER_LOOP = 4; ///< Log frames sent per client and loop
+#endif
+  static constexpr size_t QUERY_DEFAULT_LIMIT = 100; ///< Lines per query without limit parameter
+  static constexpr size_t QUERY_MAX_LIMIT = 500;     ///< Most lines per query
 
   /**
    * @brief Constructor
@@ -144,15 +164,19 @@ public:
 
 #if USE_WEBSOCKET
   /**
-   * @brief Process WebSocket events and clean up logs
-   * @details Performs periodic tasks:
-   *          - Processes WebSocket messages
-   *          - Cleans up old logs
-   *          - Manages connections
-   *          - Updates state
+   * @brief Send queued log lines and clean up clients
+   * @details Called from WebManager::handleClient() after the WebSocket
+   *          events were processed. Sends up to FRAMES_PER_LOOP frames per
+   *          client.
    */
   void loop();
 
+  /**
+   * @brief Log frames dropped for slow clients since boot
+   * @return Frames that were overwritten before they were sent, summed over all clients
+   */
+  static uint32_t getDroppedMessages() { return s_droppedMessages; }
+
   /**
    * @brief Clean up all WebSocket clients
    * @details Performs client cleanup:
@@ -164,14 +188,11 @@ public:
   void cleanupAllClients();
 
   /**
-   * @brief Broadcast log message to all connected clients
+   * @brief Queue a log message for all subscribed clients
    * @param level Log level of message
-   * @param message Log message content
-   * @details Sends log message to clients:
-   *          - Formats message
-   *          - Checks client status
-   *          - Handles errors
-   *          - Updates queues
+   * @param message Formatted log message ("<prefix> [<module>] <text>")
+   * @details Encodes the message once if any client subscribed to it. The
+   *          frames are sent from loop(); nothing is sent from here.
    */
   void broadcastLog(LogLevel level, const String& message);
 
@@ -200,6 +221,17 @@ public:
    */
   void handleLogs();
 
+  /**
+   * @brief Handle a filtered log query (GET /logs/query)
+   * @details Streams the matching lines of the log file as JSON. Parameters:
+   *          - level: minimum level (DEBUG, INFO, WARNING, ERROR)
+   *          - module: exact module name
+   *          - from, to: time window in epoch seconds
+   *          - limit: maximum number of lines
+   *          - cursor: "next" of the previous response to continue paging
+   */
+  void handleQuery();
+
   /**
    * @brief Clean up handler resources
    * @return true if cleanup was successful, false if already cleaned
@@ -213,7 +245,6 @@ public:
     if (!_cleaned) {
 #if USE_WEBSOCKET
       cleanupAllClients();
-      _messageQueue.clear();
 #endif
       _content.clear();
       _cleaned = true;
@@ -223,34 +254,39 @@ public:
     return false;
   }
 
+private:
 #if USE_WEBSOCKET
   /**
-   * @struct QueuedMessage
-   * @brief Structure for queued WebSocket messages
-   * @details Contains message information:
-   *          - Client identifier
-   *          - Message content
-   *          - Queue management
+   * @struct LogSubscriber
+   * @brief WebSocket client receiving log lines
+   */
+  struct LogSubscriber {
+    uint8_t clientId;            ///< WebSocket client number
+    uint8_t minLevel{0};         ///< Lowest LogLevel as integer
+    String modules;              ///< ",A,B," for the selected modules, empty for all
+    uint32_t nextFrame{0};       ///< Sequence number of the next frame to send
+    uint32_t dropped{0};         ///< Frames overwritten before they were sent
+    uint32_t reportedDropped{0}; ///< Drops already reported to the client
+  };
+
+  /**
+   * @struct LogFrame
+   * @brief Log line encoded for the WebSocket clients
    */
-  struct QueuedMessage {
-    uint8_t clientId; ///< Identifier of target client
-    String message;   ///< Message content to send
-
-    /**
-     * @brief Constructor for QueuedMessage
-     * @param id Client identifier
-     * @param msg Message content
-     */
-    QueuedMessage(uint8_t id, const String& msg) : clientId(id), message(msg) {}
+  struct LogFrame {
+    uint8_t level{0};                            ///< LogLevel as integer
+    char module[LogRing::MODULE_NAME_SIZE] = {}; ///< Module name, cut if longer
+    String text;                                 ///< Encoded JSON message
   };
 #endif
 
-private:
   WebAuth& _auth;          ///< Reference to authentication service
   CSSService& _cssService; ///< Reference to CSS service
 #if USE_WEBSOCKET
-  std::list<uint8_t> _clients;              ///< List of connected client IDs
-  std::vector<QueuedMessage> _messageQueue; ///< Queue of pending messages
+  std::list<LogSubscriber> _clients;     ///< Connected clients and their subscriptions
+  LogFrame _frames[WEBSOCKET_LOG_QUEUE]; ///< Shared ring, indexed by sequence number
+  uint32_t _nextFrame{0};                ///< Sequence number of the next frame
+  static uint32_t s_droppedMessages;     ///< Dropped frames of all clients
 #endif
   unsigned long _lastCleanup;    ///< Timestamp of last cleanup
   String _content;               ///< Current log content
@@ -271,15 +307,38 @@ private:
   bool initWebSocket();
 
   /**
-   * @brief Clean up resources for a specific client
+   * @brief Remove a client and its queued frames
    * @param clientNum Client number to clean up
-   * @details Performs client-specific cleanup:
-   *          - Closes connection
-   *          - Removes from lists
-   *          - Clears messages
+   * @details Frees the shared frames once the last client is gone.
    */
   void cleanupClientResources(uint8_t clientNum);
 
+  /**
+   * @brief Set the log lines a client receives
+   * @param clientNum Client number
+   * @param level Minimum level name, nullptr for all levels
+   * @param modules Comma-separated module names, nullptr or empty for all
+   */
+  void subscribe(uint8_t clientNum, const char* level, const char* modules);
+
+  /**
+   * @brief Check whether a client subscribed to a log line
+   * @param client Subscribed client
+   * @param level LogLevel as integer
+   * @param module Module name
+   * @return true if the line is sent to the client
+   */
+  static bool isSubscribed(const LogSubscriber& client, uint8_t level, const char* module);
+
+  /**
+   * @brief Send queued frames to the clients
+   * @details Reports drops to a client before its next frame.
+   */
+  void sendQueuedLogs();
+
+  /// Free the shared frames once no client is left
+  void releaseFrames();
+
   /**
    * @brief Handle client message
    * @param clientNum Client number
@@ -305,11 +364,7 @@ private:
 #endif
 
   /**
-   * @brief Clean up old logs
-   * @details Manages log retention:
-   *          - Removes old entries
-   *          - Updates storage
-   *          - Maintains limits
+   * @brief Remove clients whose connection is gone
    */
   void cleanupLogs();
 
@@ -332,7 +387,6 @@ protected:
   void onCleanup() override {
 #if USE_WEBSOCKET
     cleanupAllClients();
-    _messageQueue.clear();
 #endif
     _content.clear();
     _initialized = false;
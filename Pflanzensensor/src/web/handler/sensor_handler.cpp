@@ -9,14 +9,22 @@
 
 #include "logger/logger.h"
 #include "managers/manager_config.h"
+#include "managers/manager_sensor_persistence.h"
+#include "sensors/sensor_history.h"
+#include "sensors/sensor_manager_limiter.h"
+#include "sensors/sensor_timeseries.h"
 #include "utils/helper.h"
 #include "web/core/components.h"
 
 // Maximum number of values per sensor
 static constexpr size_t MAX_VALUES = 10;
 
+// Default and maximum number of samples per archive request
+static constexpr size_t ARCHIVE_DEFAULT_LIMIT = 1000;
+static constexpr size_t ARCHIVE_MAX_LIMIT = 5000;
+
 RouterResult SensorHandler::onRegisterRoutes(WebRouter& router) {
-  logger.debug(F("SensorHandler"), F("Registriere Sensor-Routen"));
+  LOG_DEBUG(F("SensorHandler"), F("Registriere Sensor-Routen"));
 
   // Register Latest Values endpoint
   auto latestResult =
@@ -24,6 +32,18 @@ RouterResult SensorHandler::onRegisterRoutes(WebRouter& router) {
   if (!latestResult.isSuccess())
     return latestResult;
 
+  // Register measurement history endpoint
+  auto historyResult =
+      router.addRoute(HTTP_GET, "/api/history", [this]() { handleGetHistory(); });
+  if (!historyResult.isSuccess())
+    return historyResult;
+
+  // Register long-term archive endpoint (compressed flash store)
+  auto archiveResult =
+      router.addRoute(HTTP_GET, "/api/history/archive", [this]() { handleGetArchive(); });
+  if (!archiveResult.isSuccess())
+    return archiveResult;
+
   return RouterResult::success();
 }
 
@@ -114,7 +134,7 @@ void SensorHandler::handleGetLatestValues() {
     }
 
     if (!sensor->isEnabled()) {
-      logger.debug(F("SensorHandler"), F("Sensor ") + sensorName + F(" ist deaktiviert"));
+      LOG_DEBUG(F("SensorHandler"), F("Sensor ") + sensorName + F(" ist deaktiviert"));
       continue;
     }
 
@@ -207,6 +227,17 @@ void SensorHandler::handleGetLatestValues() {
       sendChunk(sensor->getStatus(i));
       sendChunk(F("\""));
 
+      // Sample statistics of the last cycle make noisy channels visible
+      sendChunk(F(",\"samples\":"));
+      sendChunk(String(measurementData.sampleCounts[i]));
+      sendChunk(F(",\"variance\":"));
+      float variance = measurementData.variances[i];
+      if (!isnan(variance) && isfinite(variance)) {
+        sendChunk(String(variance, 4));
+      } else {
+        sendChunk(F("null"));
+      }
+
       const auto& config = sensor->config();
       if (i < config.measurements.size()) {
         sendChunk(F(",\"absoluteMin\":"));
@@ -286,12 +317,93 @@ void SensorHandler::handleGetLatestValues() {
     sendChunk(String(ESP.getHeapFragmentation()));
     sendChunk(F(",\"rebootCount\":"));
     sendChunk(String(Helper::getRebootCount()));
+    sendChunk(F(",\"loopsPerSecond\":"));
+    sendChunk(String(Helper::getLoopsPerSecond()));
     sendChunk(F(",\"version\":\""));
     sendChunk(VERSION);
     sendChunk(F("\",\"buildDate\":\""));
     sendChunk(F(__DATE__));
     sendChunk(F("\",\"processedSensors\":"));
     sendChunk(String(processedSensors));
+    {
+      const auto& stats = SensorPersistence::getFlushStats();
+      sendChunk(F(",\"persistence\":{\"pending\":"));
+      sendChunk(String(SensorPersistence::getPendingUpdateCount()));
+      sendChunk(F(",\"flushes\":"));
+      sendChunk(String(stats.flushCount));
+      sendChunk(F(",\"commits\":"));
+      sendChunk(String(stats.commits));
+      sendChunk(F(",\"bytesWritten\":"));
+      sendChunk(String(stats.bytesWritten));
+      sendChunk(F(",\"highWater\":"));
+      sendChunk(String(stats.pendingHighWater));
+      sendChunk(F(",\"coalescingRatio\":"));
+      sendChunk(String(stats.coalescingRatio(), 3));
+      const auto storeStats = SensorPersistence::getStoreStats();
+      sendChunk(F(",\"storeBytes\":"));
+      sendChunk(String(storeStats.logBytes));
+      sendChunk(F(",\"storeRecords\":"));
+      sendChunk(String(storeStats.liveRecords));
+      sendChunk(F(",\"compactions\":"));
+      sendChunk(String(storeStats.compactions));
+      sendChunk(F(",\"mountMs\":"));
+      sendChunk(String(storeStats.mountMs));
+      const auto& loadStats = SensorPersistence::getLoadStats();
+      sendChunk(F(",\"loadMs\":"));
+      sendChunk(String(loadStats.loadMs));
+      sendChunk(F(",\"loadHeapPeak\":"));
+      sendChunk(String(loadStats.heapPeak()));
+      sendChunk(F("}"));
+    }
+    {
+      const auto throughput = SensorManagerLimiter::getInstance().getThroughput();
+      sendChunk(F(",\"throughput\":{\"cyclesPerMin\":"));
+      sendChunk(String(throughput.cyclesPerMinute));
+      sendChunk(F(",\"valuesPerMin\":"));
+      sendChunk(String(throughput.valuesPerMinute));
+      sendChunk(F(",\"totalCycles\":"));
+      sendChunk(String(throughput.totalCycles));
+      sendChunk(F(",\"activeSlots\":"));
+      sendChunk(String(throughput.activeSlots));
+      sendChunk(F(",\"maxParallel\":"));
+      sendChunk(String(throughput.maxParallel));
+      sendChunk(F("}"));
+    }
+    {
+      // Per sensor: start lateness (start - due) and end-to-end cycle latency
+      sendChunk(F(",\"cycles\":{"));
+      bool firstCycle = true;
+      for (const auto& sensor : sensors) {
+        if (!sensor) {
+          continue;
+        }
+        const auto* cycleManager = _sensorManager.getCycleManager(sensor->getHandle());
+        if (!cycleManager) {
+          continue;
+        }
+        const auto& cycleStats = cycleManager->getCycleStats();
+        String entry = firstCycle ? F("\"") : F(",\"");
+        entry += sensor->getId();
+        entry += F("\":{\"count\":");
+        entry += String(cycleStats.completedCycles);
+        entry += F(",\"lateMs\":");
+        entry += String(cycleStats.lastLateness);
+        entry += F(",\"lateMeanMs\":");
+        entry += String(cycleStats.meanLateness, 0);
+        entry += F(",\"lateMaxMs\":");
+        entry += String(cycleStats.maxLateness);
+        entry += F(",\"lastMs\":");
+        entry += String(cycleStats.lastLatency);
+        entry += F(",\"meanMs\":");
+        entry += String(cycleStats.meanLatency, 0);
+        entry += F(",\"maxMs\":");
+        entry += String(cycleStats.maxLatency);
+        entry += F("}");
+        sendChunk(entry);
+        firstCycle = false;
+      }
+      sendChunk(F("}"));
+    }
     sendChunk(F("}}"));
   } catch (...) {
     logger.error(F("SensorHandler"), F("Fehler beim Systeminfo-Zugriff"));
@@ -369,3 +481,202 @@ void SensorHandler::createSensorListSection() const {
   Component::sendChunk(_server, F("    </div>\n"));
   Component::sendChunk(_server, F("</section>\n"));
 }
+
+void SensorHandler::handleGetHistory() {
+  uint32_t since = 0;
+  if (_server.hasArg(F("since"))) {
+    since = strtoul(_server.arg(F("since")).c_str(), nullptr, 10);
+  }
+  size_t limit = MeasurementHistory::CAPACITY;
+  if (_server.hasArg(F("limit"))) {
+    long requested = _server.arg(F("limit")).toInt();
+    if (requested > 0) {
+      limit = static_cast<size_t>(requested);
+    }
+  }
+  // Explicit resolution wins; with since= the finest tier that covers the
+  // range within limit points is chosen; otherwise raw samples are sent
+  HistoryResolution fixedResolution = HistoryResolution::RAW;
+  bool hasFixedResolution = _server.hasArg(F("resolution")) &&
+                            MeasurementHistory::resolutionFromString(
+                                _server.arg(F("resolution")), fixedResolution);
+  bool autoResolution = !hasFixedResolution && _server.hasArg(F("since"));
+  String sensorFilter = _server.arg(F("sensor"));
+  int measurementFilter = _server.hasArg(F("measurement")) ? _server.arg(F("measurement")).toInt()
+                                                           : -1;
+  uint32_t now = static_cast<uint32_t>(Helper::getCurrentTime());
+
+  beginChunkedResponse(F("application/json"));
+  sendChunk(F("{\"now\":"));
+  sendChunk(String(now));
+  sendChunk(F(",\"series\":["));
+
+  const MeasurementHistory& history = MeasurementHistory::getInstance();
+  bool firstSeries = true;
+  for (size_t ch = 0; ch < MeasurementHistory::CHANNEL_COUNT; ch++) {
+    if (!history.isChannelUsed(ch)) {
+      continue;
+    }
+    const char* sensorId = history.getSensorId(ch);
+    size_t measurementIndex = history.getMeasurementIndex(ch);
+    if ((!sensorFilter.isEmpty() && !sensorFilter.equals(sensorId)) ||
+        (measurementFilter >= 0 && static_cast<size_t>(measurementFilter) != measurementIndex)) {
+      continue;
+    }
+
+    HistoryResolution resolution = fixedResolution;
+    if (autoResolution) {
+      resolution = history.selectResolution(ch, since, now, limit);
+    }
+
+    String header = firstSeries ? F("{\"sensor\":\"") : F(",{\"sensor\":\"");
+    header += escapeJson(sensorId);
+    header += F("\",\"measurement\":");
+    header += String(measurementIndex);
+    Sensor* sensor = _sensorManager.getSensor(String(sensorId));
+    if (sensor && measurementIndex < sensor->config().measurements.size()) {
+      // Field names and units are set by the user
+      header += F(",\"fieldName\":\"");
+      header += escapeJson(sensor->config().measurements[measurementIndex].fieldName);
+      header += F("\",\"unit\":\"");
+      header += escapeJson(sensor->config().measurements[measurementIndex].unit);
+      header += F("\"");
+    }
+    header += F(",\"resolution\":\"");
+    header += MeasurementHistory::resolutionToString(resolution);
+    header += F("\",\"samples\":[");
+    sendChunk(header);
+    firstSeries = false;
+
+    // Batch samples into a fixed buffer to keep the number of chunks small.
+    // Raw samples are [ts,value], aggregates [start,min,max,mean,count].
+    char buffer[256];
+    size_t used = 0;
+    bool firstSample = true;
+    auto flushIfNeeded = [&]() {
+      if (used > sizeof(buffer) - 64) {
+        buffer[used] = '\0';
+        sendChunk(String(buffer));
+        used = 0;
+      }
+    };
+    if (resolution == HistoryResolution::RAW) {
+      history.forEachSince(ch, since, limit, [&](uint32_t ts, float value) {
+        flushIfNeeded();
+        int written;
+        if (isnan(value)) {
+          written = snprintf(buffer + used, sizeof(buffer) - used, "%s[%u,null]",
+                             firstSample ? "" : ",", static_cast<unsigned>(ts));
+        } else {
+          written = snprintf(buffer + used, sizeof(buffer) - used, "%s[%u,%.2f]",
+                             firstSample ? "" : ",", static_cast<unsigned>(ts), value);
+        }
+        if (written > 0) {
+          used += static_cast<size_t>(written);
+        }
+        firstSample = false;
+      });
+    } else {
+      history.forEachAggregate(ch, resolution, since, limit, [&](const HistoryAggregate& agg) {
+        flushIfNeeded();
+        int written = snprintf(buffer + used, sizeof(buffer) - used, "%s[%u,%.2f,%.2f,%.2f,%u]",
+                               firstSample ? "" : ",", static_cast<unsigned>(agg.start), agg.min,
+                               agg.max, agg.mean, static_cast<unsigned>(agg.count));
+        if (written > 0) {
+          used += static_cast<size_t>(written);
+        }
+        firstSample = false;
+      });
+    }
+    if (used > 0) {
+      buffer[used] = '\0';
+      sendChunk(String(buffer));
+    }
+    sendChunk(F("]}"));
+    yield();
+  }
+
+  sendChunk(F("]}"));
+  endChunkedResponse();
+}
+
+void SensorHandler::handleGetArchive() {
+  if (!_server.hasArg(F("sensor")) || !_server.hasArg(F("measurement"))) {
+    _server.send(400, F("application/json"),
+                 F("{\"error\":\"Parameter sensor und measurement erforderlich\"}"));
+    return;
+  }
+  String sensorId = _server.arg(F("sensor"));
+  // Archived IDs are short identifiers like "ANALOG"; anything else can
+  // match no block and must not reach the JSON unescaped
+  bool validId = sensorId.length() > 0 && sensorId.length() < TimeSeriesStore::SENSOR_ID_LEN;
+  for (size_t i = 0; validId && i < sensorId.length(); i++) {
+    char c = sensorId.charAt(i);
+    validId = isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '-';
+  }
+  if (!validId) {
+    _server.send(400, F("application/json"), F("{\"error\":\"Ungültige Sensor-ID\"}"));
+    return;
+  }
+  size_t measurementIndex = static_cast<size_t>(_server.arg(F("measurement")).toInt());
+  uint32_t from = 0;
+  if (_server.hasArg(F("from"))) {
+    from = strtoul(_server.arg(F("from")).c_str(), nullptr, 10);
+  }
+  uint32_t to = UINT32_MAX;
+  if (_server.hasArg(F("to"))) {
+    to = strtoul(_server.arg(F("to")).c_str(), nullptr, 10);
+  }
+  size_t limit = ARCHIVE_DEFAULT_LIMIT;
+  if (_server.hasArg(F("limit"))) {
+    long requested = _server.arg(F("limit")).toInt();
+    if (requested > 0) {
+      limit = min(static_cast<size_t>(requested), ARCHIVE_MAX_LIMIT);
+    }
+  }
+
+  beginChunkedResponse(F("application/json"));
+  String header = F("{\"sensor\":\"");
+  header += sensorId;
+  header += F("\",\"measurement\":");
+  header += String(measurementIndex);
+  header += F(",\"samples\":[");
+  sendChunk(header);
+
+  char buffer[256];
+  size_t used = 0;
+  bool firstSample = true;
+  size_t count = TimeSeriesStore::getInstance().query(
+      sensorId, measurementIndex, from, to, limit, [&](uint32_t ts, float value) {
+        if (used > sizeof(buffer) - 48) {
+          buffer[used] = '\0';
+          sendChunk(String(buffer));
+          used = 0;
+          yield();
+        }
+        int written;
+        if (isnan(value)) {
+          written = snprintf(buffer + used, sizeof(buffer) - used, "%s[%u,null]",
+                             firstSample ? "" : ",", static_cast<unsigned>(ts));
+        } else {
+          written = snprintf(buffer + used, sizeof(buffer) - used, "%s[%u,%.2f]",
+                             firstSample ? "" : ",", static_cast<unsigned>(ts), value);
+        }
+        if (written > 0) {
+          used += static_cast<size_t>(written);
+        }
+        firstSample = false;
+      });
+  if (used > 0) {
+    buffer[used] = '\0';
+    sendChunk(String(buffer));
+  }
+
+  String footer = F("],\"count\":");
+  footer += String(count);
+  footer += F(",\"queryMs\":");
+  footer += String(TimeSeriesStore::getInstance().getStats().lastQueryMs);
+  footer += F("}");
+  sendChunk(footer);
+  endChunkedResponse();
+}
@@ -54,7 +54,7 @@ public:
   SensorHandler(ESP8266WebServer& server, WebAuth& auth, CSSService& cssService,
                 SensorManager& sensorManager)
       : BaseHandler(server), _auth(auth), _cssService(cssService), _sensorManager(sensorManager) {
-    logger.debug(F("SensorHandler"), F("Initialisiere SensorHandler"));
+    LOG_DEBUG(F("SensorHandler"), F("Initialisiere SensorHandler"));
   }
 
   /**
@@ -117,6 +117,26 @@ private:
    */
   void handleGetLatestValues();
 
+  /**
+   * @brief Handle requests for the RAM measurement history (/api/history)
+   * @details Streams stored samples as JSON. Query parameters:
+   *          - since: only samples newer than this epoch second (default 0)
+   *          - limit: maximum points per measurement (default raw capacity)
+   *          - resolution: raw, minute, hour or day; without it a query with
+   *            since= picks the tier via MeasurementHistory::selectResolution
+   *          - sensor / measurement: optional filter for one measurement
+   */
+  void handleGetHistory();
+
+  /**
+   * @brief Handle requests for the flash archive (/api/history/archive)
+   * @details Streams [ts,value] samples from TimeSeriesStore. Query parameters:
+   *          - sensor / measurement: required, selects the measurement
+   *          - from / to: epoch second range (inclusive, default: everything)
+   *          - limit: maximum number of samples (default 1000, max 5000)
+   */
+  void handleGetArchive();
+
   /**
    * @brief Create login redirect URL
    * @return URL string for login redirect
@@ -18,6 +18,7 @@
 #include "managers/manager_display.h"
 #endif
 #include "utils/critical_section.h"
+#include "utils/file_io_queue.h"
 // Flash persistence used to check for existing backup and restore after FS update
 #include "../../utils/flash_persistence.h"
 
@@ -46,12 +47,12 @@ void WebOTAHandler::handleStatus() {
 
   String response;
   serializeJson(doc, response);
-  logger.debug(F("WebOTAHandler"), F("Status-Antwort: ") + response);
+  LOG_DEBUG(F("WebOTAHandler"), F("Status-Antwort: ") + response);
   sendJsonResponse(200, response);
 }
 
 RouterResult WebOTAHandler::onRegisterRoutes(WebRouter& router) {
-  logger.debug(F("WebOTAHandler"), F("Registriere OTA-Routen"));
+  LOG_DEBUG(F("WebOTAHandler"), F("Registriere OTA-Routen"));
 
   // Register status endpoint
   auto result = router.addRoute(HTTP_GET, "/status", [this]() { handleStatus(); });
@@ -231,6 +232,7 @@ TypedResult<ResourceError, void> WebOTAHandler::endUpdate(bool reboot) {
 
   if (reboot) {
     logger.info(F("WebOTAHandler"), F("Update erfolgreich, Neustart..."));
+    FileIoQueue::getInstance().flushAll();
     delay(1000);
     ESP.restart();
   }
@@ -267,7 +269,7 @@ void WebOTAHandler::handleUpdateUpload() {
     logger.info(F("WebOTAHandler"), F("Upload gestartet: ") + filename + F(" (Typ: ") +
                                         String(isFilesystem ? F("Dateisystem") : F("Firmware")) +
                                         F(")"));
-    logger.debug(F("WebOTAHandler"), F("Inhaltlänge: ") + String(contentLength) + F(" Bytes"));
+    LOG_DEBUG(F("WebOTAHandler"), F("Inhaltlänge: ") + String(contentLength) + F(" Bytes"));
 
     // FLASH-BASED PERSISTENCE: Config backup was already created BEFORE reboot
     // (in ConfigManager::setUpdateFlags when the update flag was set)
@@ -289,14 +291,14 @@ void WebOTAHandler::handleUpdateUpload() {
         CriticalSection cs;
         FSInfo fs_info;
         if (LittleFS.info(fs_info)) {
-          logger.debug(F("WebOTAHandler"),
-                       F("Dateisystem gesamt: ") + String(fs_info.totalBytes) + F(" Bytes"));
-          logger.debug(F("WebOTAHandler"),
-                       F("Dateisystem belegt: ") + String(fs_info.usedBytes) + F(" Bytes"));
+          LOG_DEBUG(F("WebOTAHandler"),
+                    F("Dateisystem gesamt: ") + String(fs_info.totalBytes) + F(" Bytes"));
+          LOG_DEBUG(F("WebOTAHandler"),
+                    F("Dateisystem belegt: ") + String(fs_info.usedBytes) + F(" Bytes"));
           freeSpace = fs_info.totalBytes;
 
           if (contentLength > fs_info.totalBytes) {
-            logger.debug(F("WebOTAHandler"), F("Inhaltslänge an Dateisystemgröße angepasst"));
+            LOG_DEBUG(F("WebOTAHandler"), F("Inhaltslänge an Dateisystemgröße angepasst"));
             contentLength = fs_info.totalBytes;
           }
         } else {
@@ -307,15 +309,15 @@ void WebOTAHandler::handleUpdateUpload() {
       }
     } else {
       freeSpace = ESP.getFreeSketchSpace();
-      logger.debug(F("WebOTAHandler"),
-                   F("Freier Sketch-Speicher: ") + String(freeSpace) + F(" Bytes"));
+      LOG_DEBUG(F("WebOTAHandler"),
+                F("Freier Sketch-Speicher: ") + String(freeSpace) + F(" Bytes"));
     }
 
-    logger.debug(F("WebOTAHandler"),
-                 F("Update-Modus: ") +
-                     String(ConfigMgr.getDoFirmwareUpgrade() ? F("minimal") : F("normal")));
-    logger.debug(F("WebOTAHandler"),
-                 F("Endgültige Inhaltslänge: ") + String(contentLength) + F(" Bytes"));
+    LOG_DEBUG(F("WebOTAHandler"),
+              F("Update-Modus: ") +
+                  String(ConfigMgr.getDoFirmwareUpgrade() ? F("minimal") : F("normal")));
+    LOG_DEBUG(F("WebOTAHandler"),
+              F("Endgültige Inhaltslänge: ") + String(contentLength) + F(" Bytes"));
 
     if (contentLength > freeSpace) {
       String error = F("Nicht genug Speicherplatz - benötigt: ") + String(contentLength) +
@@ -326,14 +328,17 @@ void WebOTAHandler::handleUpdateUpload() {
     }
 
     uint8_t command = isFilesystem ? U_FS : U_FLASH;
-    logger.debug(F("WebOTAHandler"), F("Update-Befehl: ") + String(command) +
-                                         F(", Inhaltslänge: ") + String(contentLength) +
-                                         F(", verfügbarer Speicher: ") + String(freeSpace));
+    LOG_DEBUG(F("WebOTAHandler"), F("Update-Befehl: ") + String(command) +
+                                      F(", Inhaltslänge: ") + String(contentLength) +
+                                      F(", verfügbarer Speicher: ") + String(freeSpace));
 
     // Note: Preferences backup/restore happens BEFORE Update.begin()
     // The backup file was created before first reboot and already restored above
     // After filesystem update, Preferences will be intact from the restore
 
+    // Queued files must reach LittleFS before the update starts
+    FileIoQueue::getInstance().flushAll();
+
     if (!Update.begin(contentLength, command)) {
       String error = F("Start des Updates fehlgeschlagen: ") + String(Update.getError());
       logger.error(F("WebOTAHandler"), error);
@@ -346,7 +351,7 @@ void WebOTAHandler::handleUpdateUpload() {
 
     if (_server.hasArg("md5")) {
       Update.setMD5(_server.arg("md5").c_str());
-      logger.debug(F("WebOTAHandler"), F("MD5 gesetzt: ") + _server.arg("md5"));
+      LOG_DEBUG(F("WebOTAHandler"), F("MD5 gesetzt: ") + _server.arg("md5"));
     }
 
     _status.inProgress = true;
@@ -478,10 +483,10 @@ void WebOTAHandler::handleUpdateUpload() {
         // upload reported, the expected total we set in begin(), and the
         // numeric Update error code returned by the Update API.
         logger.error(F("WebOTAHandler"), F("Update.end() gab einen Fehler zurück"));
-        logger.debug(F("WebOTAHandler"),
-                     F("Hochgeladene Gesamtgröße: ") + String(upload.totalSize) +
-                         F(", erwartet (status totalSize): ") + String(_status.totalSize));
-        logger.debug(F("WebOTAHandler"), F("Update Fehlercode: ") + String(Update.getError()));
+        LOG_DEBUG(F("WebOTAHandler"),
+                  F("Hochgeladene Gesamtgröße: ") + String(upload.totalSize) +
+                      F(", erwartet (status totalSize): ") + String(_status.totalSize));
+        LOG_DEBUG(F("WebOTAHandler"), F("Update Fehlercode: ") + String(Update.getError()));
         String error = F("Update fehlgeschlagen: ") + String(Update.getError());
         logger.error(F("WebOTAHandler"), error);
 
@@ -6,10 +6,11 @@
 #include "logger/logger.h"
 #include "managers/manager_resource.h"
 #include "utils/critical_section.h"
+#include "utils/file_io_queue.h"
 #include "web/core/components.h"
 
 CSSService::CSSService(ESP8266WebServer& server) : BaseHandler(server) {
-  logger.debug(F("CSSService"), F("Initialisiere CSS-Service"));
+  LOG_DEBUG(F("CSSService"), F("Initialisiere CSS-Service"));
   initModules();
 }
 
@@ -34,6 +35,7 @@ HandlerResult CSSService::handlePost(const String& uri, const std::map<String, S
 }
 
 bool CSSService::createBackup(const String& path) const {
+  FileIoQueue::getInstance().flush(path.c_str());
   CriticalSection cs;
 
   if (!LittleFS.exists(path)) {
@@ -75,6 +77,7 @@ bool CSSService::createBackup(const String& path) const {
 }
 
 String CSSService::loadCSS(const String& path) const {
+  FileIoQueue::getInstance().flush(path.c_str());
   CriticalSection cs;
 
   if (!LittleFS.exists(path)) {
@@ -94,19 +97,8 @@ String CSSService::loadCSS(const String& path) const {
 }
 
 bool CSSService::saveCSS(const String& path, const String& content) const {
-  CriticalSection cs;
-
-  File file = LittleFS.open(path, "w");
-  if (!file) {
-    logger.error(F("CSSService"),
-                 String(F("Öffnen der CSS-Datei zum Schreiben fehlgeschlagen: ")) + path);
-    return false;
-  }
-
-  size_t written = file.print(content);
-  file.close();
-
-  if (written != content.length()) {
+  // Written from loop() by the I/O queue, not while the request is served
+  if (!FileIoQueue::getInstance().write(path.c_str(), content)) {
     logger.error(F("CSSService"), F("Vollständiges Schreiben der CSS-Inhalte fehlgeschlagen"));
     return false;
   }
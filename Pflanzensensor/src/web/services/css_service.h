@@ -156,8 +156,8 @@ private:
    * @param path Path where CSS content should be saved
    * @param content CSS content to save
    * @return true if save was successful, false on error
-   * @details Writes CSS content to the specified file.
-   *          Creates parent directories if needed.
+   * @details Queues the content in FileIoQueue; the file is written from
+   *          loop() after the request has been served.
    */
   bool saveCSS(const String& path, const String& content) const;
 
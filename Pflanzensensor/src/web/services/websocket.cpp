@@ -12,7 +12,7 @@ WebSocketService& WebSocketService::getInstance() {
 
 bool WebSocketService::init(uint16_t port, WebSocketEventHandler handler) {
   if (_wsServer) {
-    logger.debug(F("Websocket"), F("WebSocket-Server bereits initialisiert"));
+    LOG_DEBUG(F("Websocket"), F("WebSocket-Server bereits initialisiert"));
     return true;
   }
 
@@ -61,27 +61,6 @@ void WebSocketService::stop() {
 
 WebSocketService::~WebSocketService() { stop(); }
 
-bool WebSocketService::RingBuffer::write(const char* data, size_t len) {
-  if (len > RING_BUFFER_SIZE - ((writePos - readPos) % RING_BUFFER_SIZE)) {
-    return false;
-  }
-  for (size_t i = 0; i < len; i++) {
-    buffer[writePos % RING_BUFFER_SIZE] = data[i];
-    writePos++;
-  }
-  return true;
-}
-
-size_t WebSocketService::RingBuffer::read(char* data, size_t maxLen) {
-  size_t available = (writePos - readPos) % RING_BUFFER_SIZE;
-  size_t len = min(available, maxLen);
-  for (size_t i = 0; i < len; i++) {
-    data[i] = buffer[readPos % RING_BUFFER_SIZE];
-    readPos++;
-  }
-  return len;
-}
-
 void WebSocketService::loop() {
   if (_wsServer) {
     _wsServer->loop();
@@ -122,13 +101,13 @@ bool WebSocketService::sendBIN(uint8_t num, const uint8_t* data, size_t len) {
 }
 
 bool WebSocketService::isClientConnected(uint8_t num) const {
-  if (num >= 3) // our bitmask only supports up to 3 clients
+  if (num >= MAX_CLIENTS)
     return false;
   return (m_connectedClients & (1UL << num)) != 0;
 }
 
 void WebSocketService::setClientConnected(uint8_t num, bool connected) {
-  if (num >= 3) // our bitmask only supports up to 3 clients
+  if (num >= MAX_CLIENTS)
     return;
   if (connected) {
     m_connectedClients |= (1UL << num);
@@ -14,11 +14,17 @@
 #include "logger/logger.h"           // For logger
 #include "managers/manager_config.h" // For ConfigMgr
 
+// Check if WEBSOCKET_MAX_CLIENTS is defined
+#ifndef WEBSOCKET_MAX_CLIENTS
+#define WEBSOCKET_MAX_CLIENTS 2
+#warning "WEBSOCKET_MAX_CLIENTS not defined in config file, defaulting to 2 clients"
+#endif
+
 class WebSocketService {
 public:
-  static constexpr size_t MAX_CLIENTS = 1;
-  // Reduced ring buffer to save RAM on ESP8266
-  static constexpr size_t RING_BUFFER_SIZE = 512;
+  static constexpr size_t MAX_CLIENTS = WEBSOCKET_MAX_CLIENTS;
+  static_assert(MAX_CLIENTS <= WEBSOCKETS_SERVER_CLIENT_MAX,
+                "WEBSOCKET_MAX_CLIENTS exceeds WEBSOCKETS_SERVER_CLIENT_MAX");
   // Keep messages reasonably sized to avoid large static buffers
   static constexpr size_t MAX_MESSAGE_SIZE = 256;
 
@@ -56,18 +62,8 @@ private:
   WebSocketService(const WebSocketService&) = delete;
   WebSocketService& operator=(const WebSocketService&) = delete;
 
-  struct RingBuffer {
-    char buffer[RING_BUFFER_SIZE];
-    size_t readPos = 0;
-    size_t writePos = 0;
-
-    bool write(const char* data, size_t len);
-    size_t read(char* data, size_t maxLen);
-  };
-
   std::unique_ptr<WebSocketsServer> _wsServer;
   WebSocketEventHandler _eventHandler;
-  RingBuffer m_ringBuffer;
   // Use a wider bitmask to safely support multiple client ids without UB
   // when shifting bits. Keep memory small but sufficient for expected clients.
   uint32_t m_connectedClients = 0;